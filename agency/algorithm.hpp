@@ -0,0 +1,18 @@
+/// \file
+/// \brief Include this file to use any of Agency's parallel algorithms.
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/algorithm/binary_search.hpp>
+#include <agency/algorithm/histogram.hpp>
+#include <agency/algorithm/inclusive_scan_by_key.hpp>
+#include <agency/algorithm/merge.hpp>
+#include <agency/algorithm/nth_element.hpp>
+#include <agency/algorithm/partial_sort.hpp>
+#include <agency/algorithm/reduce_by_key.hpp>
+#include <agency/algorithm/segmented_reduce.hpp>
+#include <agency/algorithm/set_operations.hpp>
+#include <agency/algorithm/top_k.hpp>
+
@@ -0,0 +1,267 @@
+/// \file
+/// \brief Include this file to use the batch versions of lower_bound() and upper_bound().
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <vector>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+namespace binary_search_detail
+{
+
+
+// below this many elements per agent, searches are performed sequentially
+constexpr std::size_t min_values_per_agent = 1 << 10;
+
+
+// lower_bound_predicate is true for the elements which precede value's lower bound
+template<class T, class Compare>
+struct lower_bound_predicate
+{
+  const T& value;
+  Compare comp;
+
+  template<class U>
+  bool operator()(const U& x) const
+  {
+    return comp(x, value);
+  }
+};
+
+
+// upper_bound_predicate is true for the elements which precede value's upper bound
+template<class T, class Compare>
+struct upper_bound_predicate
+{
+  const T& value;
+  Compare comp;
+
+  template<class U>
+  bool operator()(const U& x) const
+  {
+    return !comp(value, x);
+  }
+};
+
+
+struct lower_bound_search
+{
+  template<class T, class Compare>
+  lower_bound_predicate<T,Compare> predicate(const T& value, Compare comp) const
+  {
+    return lower_bound_predicate<T,Compare>{value, comp};
+  }
+};
+
+
+struct upper_bound_search
+{
+  template<class T, class Compare>
+  upper_bound_predicate<T,Compare> predicate(const T& value, Compare comp) const
+  {
+    return upper_bound_predicate<T,Compare>{value, comp};
+  }
+};
+
+
+// gallop() returns the partition point of [first, first + n) under pred, which is known to be no less than hint
+// the search probes exponentially growing distances from hint before bisecting, so its cost is
+// logarithmic in the distance of the result from hint rather than in n
+template<class RandomAccessIterator, class Predicate>
+std::size_t gallop(RandomAccessIterator first, std::size_t n, std::size_t hint, Predicate pred)
+{
+  std::size_t lo = hint;
+  std::size_t hi = hint;
+
+  for(std::size_t step = 1; hi < n && pred(first[hi]); step *= 2)
+  {
+    lo = hi + 1;
+    hi = hint + step;
+  }
+
+  hi = detail::min(hi, n);
+
+  return std::partition_point(first + lo, first + hi, pred) - first;
+}
+
+
+// compare_values_at orders indices by the values they locate
+template<class RandomAccessIterator, class Compare>
+struct compare_values_at
+{
+  RandomAccessIterator values_first;
+  Compare comp;
+
+  bool operator()(std::size_t a, std::size_t b) const
+  {
+    return comp(values_first[a], values_first[b]);
+  }
+};
+
+
+struct search_chunk_functor
+{
+  template<class Agent, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class Search, class Compare>
+  void operator()(Agent& self,
+                  RandomAccessIterator1 first, std::size_t n,
+                  RandomAccessIterator2 values_first, std::size_t num_values,
+                  std::size_t chunk_size,
+                  RandomAccessIterator3 result,
+                  Search search,
+                  Compare comp)
+  {
+    std::size_t begin = detail::min(num_values, chunk_size * self.rank());
+    std::size_t end   = detail::min(num_values, begin + chunk_size);
+
+    std::size_t position = 0;
+
+    if(std::is_sorted(values_first + begin, values_first + end, comp))
+    {
+      // consecutive sorted queries gallop forward from each other's results
+      for(std::size_t i = begin; i < end; ++i)
+      {
+        position = gallop(first, n, position, search.predicate(values_first[i], comp));
+        result[i] = position;
+      }
+    }
+    else
+    {
+      // visit the queries in sorted order so that the searches sweep the input once, front to back
+      std::vector<std::size_t> order(end - begin);
+      std::iota(order.begin(), order.end(), begin);
+
+      std::sort(order.begin(), order.end(), compare_values_at<RandomAccessIterator2,Compare>{values_first, comp});
+
+      for(std::size_t i : order)
+      {
+        position = gallop(first, n, position, search.predicate(values_first[i], comp));
+        result[i] = position;
+      }
+    }
+  }
+};
+
+
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class Search, class Compare>
+RandomAccessIterator3 batch_search(ExecutionPolicy&& policy,
+                                   RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                   RandomAccessIterator2 values_first, RandomAccessIterator2 values_last,
+                                   RandomAccessIterator3 result,
+                                   Search search,
+                                   Compare comp)
+{
+  std::size_t n = last - first;
+  std::size_t num_values = values_last - values_first;
+
+  if(num_values == 0) return result;
+
+  std::size_t num_agents = detail::num_agents_for(policy, num_values, min_values_per_agent);
+  std::size_t chunk_size = detail::ceil_div(num_values, num_agents);
+
+  agency::bulk_invoke(policy(num_agents), search_chunk_functor(), first, n, values_first, num_values, chunk_size, result, search, comp);
+
+  return result + num_values;
+}
+
+
+} // end binary_search_detail
+} // end detail
+
+
+/// \brief Finds the lower bound of each of a batch of values within a sorted range in parallel.
+///
+/// For each value `values_first[i]`, `lower_bound` writes to `result[i]` the index within `[first, last)` of the first element
+/// which is not less than the value under `comp`.
+///
+/// The values are divided evenly among the policy's execution agents. Rather than performing an independent binary search of the entire
+/// input for each value, each agent visits its values in sorted order and begins each search at the previous value's result,
+/// galloping forward from it. The agent's searches thus sweep the input once, touching neighboring elements in turn, and each search
+/// costs time logarithmic in the distance between consecutive results.
+///
+/// \param policy An execution policy whose agents perform the searches.
+/// \param first The beginning of the sorted range to search.
+/// \param last The end of the sorted range to search.
+/// \param values_first The beginning of the values to search for.
+/// \param values_last The end of the values to search for.
+/// \param result The beginning of the range receiving each value's lower bound index.
+/// \param comp A strict weak ordering by which `[first, last)` is sorted.
+/// \return The end of the output range.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class Compare>
+RandomAccessIterator3 lower_bound(ExecutionPolicy&& policy,
+                                  RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                  RandomAccessIterator2 values_first, RandomAccessIterator2 values_last,
+                                  RandomAccessIterator3 result,
+                                  Compare comp)
+{
+  return detail::binary_search_detail::batch_search(policy, first, last, values_first, values_last, result, detail::binary_search_detail::lower_bound_search(), comp);
+}
+
+
+/// \brief Finds the lower bound of each of a batch of values within a sorted range in parallel using `operator<`.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3>
+RandomAccessIterator3 lower_bound(ExecutionPolicy&& policy,
+                                  RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                  RandomAccessIterator2 values_first, RandomAccessIterator2 values_last,
+                                  RandomAccessIterator3 result)
+{
+  using value_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
+
+  return agency::lower_bound(std::forward<ExecutionPolicy>(policy), first, last, values_first, values_last, result, std::less<value_type>());
+}
+
+
+/// \brief Finds the upper bound of each of a batch of values within a sorted range in parallel.
+///
+/// For each value `values_first[i]`, `upper_bound` writes to `result[i]` the index within `[first, last)` of the first element
+/// which is greater than the value under `comp`.
+///
+/// The searches are performed like `lower_bound`'s.
+///
+/// \param policy An execution policy whose agents perform the searches.
+/// \param first The beginning of the sorted range to search.
+/// \param last The end of the sorted range to search.
+/// \param values_first The beginning of the values to search for.
+/// \param values_last The end of the values to search for.
+/// \param result The beginning of the range receiving each value's upper bound index.
+/// \param comp A strict weak ordering by which `[first, last)` is sorted.
+/// \return The end of the output range.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class Compare>
+RandomAccessIterator3 upper_bound(ExecutionPolicy&& policy,
+                                  RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                  RandomAccessIterator2 values_first, RandomAccessIterator2 values_last,
+                                  RandomAccessIterator3 result,
+                                  Compare comp)
+{
+  return detail::binary_search_detail::batch_search(policy, first, last, values_first, values_last, result, detail::binary_search_detail::upper_bound_search(), comp);
+}
+
+
+/// \brief Finds the upper bound of each of a batch of values within a sorted range in parallel using `operator<`.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3>
+RandomAccessIterator3 upper_bound(ExecutionPolicy&& policy,
+                                  RandomAccessIterator1 first, RandomAccessIterator1 last,
+                                  RandomAccessIterator2 values_first, RandomAccessIterator2 values_last,
+                                  RandomAccessIterator3 result)
+{
+  using value_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
+
+  return agency::upper_bound(std::forward<ExecutionPolicy>(policy), first, last, values_first, values_last, result, std::less<value_type>());
+}
+
+
+} // end agency
+
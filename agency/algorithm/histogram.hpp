@@ -0,0 +1,340 @@
+/// \file
+/// \brief Include this file to use histogram().
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/shared.hpp>
+#include <agency/algorithm/merge.hpp>
+#include <agency/container/array.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/execution/execution_policy/execution_policy_traits.hpp>
+#include <agency/experimental/span.hpp>
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <vector>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+namespace histogram_detail
+{
+
+
+// concurrent agents count into bins in group-shared memory when there are at most this many bins
+constexpr std::size_t max_shared_bins = 256;
+
+
+template<class Range>
+using range_count_t = decay_t<decltype(*std::begin(std::declval<Range&>()))>;
+
+
+// each agent counts its chunk of the input into its own row of privatized bins
+struct count_into_private_bins_functor
+{
+  template<class Agent, class RandomAccessIterator, class Count, class KeyFunction>
+  void operator()(Agent& self, RandomAccessIterator first, std::size_t n, std::size_t chunk_size, Count* private_bins, std::size_t num_bins, KeyFunction key_fn)
+  {
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    Count* bins = private_bins + self.rank() * num_bins;
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      std::size_t bin = static_cast<std::size_t>(key_fn(first[i]));
+
+      if(bin < num_bins)
+      {
+        ++bins[bin];
+      }
+    }
+  }
+};
+
+
+// each agent sums a slice of the bins across every row of privatized bins
+struct sum_private_bins_functor
+{
+  template<class Agent, class Count, class RandomAccessIterator>
+  void operator()(Agent& self, const Count* private_bins, std::size_t num_rows, std::size_t num_bins, std::size_t slice_size, RandomAccessIterator result)
+  {
+    std::size_t begin = detail::min(num_bins, slice_size * self.rank());
+    std::size_t end   = detail::min(num_bins, begin + slice_size);
+
+    for(std::size_t bin = begin; bin < end; ++bin)
+    {
+      Count sum = 0;
+      for(std::size_t row = 0; row < num_rows; ++row)
+      {
+        sum += private_bins[row * num_bins + bin];
+      }
+
+      result[bin] = sum;
+    }
+  }
+};
+
+
+// each concurrent agent counts its chunk into bins in registers, then combines
+// them into the group's bins in shared memory, so atomic updates happen once per bin per agent
+// rather than once per element
+struct count_into_shared_bins_functor
+{
+  template<class ConcurrentAgent, class RandomAccessIterator, class RandomAccessIterator2, class KeyFunction>
+  void operator()(ConcurrentAgent& self, RandomAccessIterator first, std::size_t n, std::size_t chunk_size, RandomAccessIterator2 result, std::size_t num_bins, KeyFunction key_fn)
+  {
+    using count_type = typename std::iterator_traits<RandomAccessIterator2>::value_type;
+
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    agency::array<count_type, max_shared_bins> private_bins{};
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      std::size_t bin = static_cast<std::size_t>(key_fn(first[i]));
+
+      if(bin < num_bins)
+      {
+        ++private_bins[bin];
+      }
+    }
+
+    shared_array<std::atomic<count_type>, max_shared_bins> shared_bins(self);
+
+    for(std::size_t bin = 0; bin < num_bins; ++bin)
+    {
+      if(private_bins[bin])
+      {
+        shared_bins[bin].fetch_add(private_bins[bin], std::memory_order_relaxed);
+      }
+    }
+
+    self.wait();
+
+    // each agent stores a slice of the shared bins
+    std::size_t group_size = self.group_size();
+    std::size_t slice_size = (num_bins + group_size - 1) / group_size;
+    std::size_t bins_begin = detail::min(num_bins, slice_size * self.rank());
+    std::size_t bins_end   = detail::min(num_bins, bins_begin + slice_size);
+
+    for(std::size_t bin = bins_begin; bin < bins_end; ++bin)
+    {
+      result[bin] = shared_bins[bin].load(std::memory_order_relaxed);
+    }
+  }
+};
+
+
+struct compute_and_sort_keys_functor
+{
+  template<class Agent, class RandomAccessIterator, class KeyFunction>
+  void operator()(Agent& self, RandomAccessIterator first, std::size_t n, std::size_t chunk_size, std::size_t* keys, KeyFunction key_fn)
+  {
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      keys[i] = static_cast<std::size_t>(key_fn(first[i]));
+    }
+
+    std::sort(keys + begin, keys + end);
+  }
+};
+
+
+// each agent counts a slice of the bins by searching for the bins' boundaries in the sorted keys
+struct count_sorted_keys_functor
+{
+  template<class Agent, class RandomAccessIterator>
+  void operator()(Agent& self, const std::size_t* sorted_keys, std::size_t n, std::size_t num_bins, std::size_t slice_size, RandomAccessIterator result)
+  {
+    using count_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+    std::size_t begin = detail::min(num_bins, slice_size * self.rank());
+    std::size_t end   = detail::min(num_bins, begin + slice_size);
+
+    const std::size_t* bin_begin = std::lower_bound(sorted_keys, sorted_keys + n, begin);
+
+    for(std::size_t bin = begin; bin < end; ++bin)
+    {
+      const std::size_t* bin_end = std::upper_bound(bin_begin, sorted_keys + n, bin);
+
+      result[bin] = static_cast<count_type>(bin_end - bin_begin);
+
+      bin_begin = bin_end;
+    }
+  }
+};
+
+
+template<class ExecutionPolicy, class RandomAccessIterator, class BinRange, class KeyFunction>
+void privatized_histogram(ExecutionPolicy&& policy, RandomAccessIterator first, std::size_t n, std::size_t num_agents, BinRange& bins, KeyFunction key_fn)
+{
+  using count_type = range_count_t<BinRange>;
+
+  std::size_t num_bins = bins.size();
+  std::size_t chunk_size = detail::ceil_div(n, num_agents);
+
+  std::vector<count_type> private_bins(num_agents * num_bins, count_type(0));
+  count_type* private_bins_ptr = private_bins.data();
+
+  agency::bulk_invoke(policy(num_agents), count_into_private_bins_functor(), first, n, chunk_size, private_bins_ptr, num_bins, key_fn);
+
+  std::size_t num_merging_agents = detail::num_agents_for(policy, num_bins * num_agents);
+  std::size_t slice_size = detail::ceil_div(num_bins, num_merging_agents);
+  const count_type* const_private_bins_ptr = private_bins_ptr;
+
+  agency::bulk_invoke(policy(num_merging_agents), sum_private_bins_functor(), const_private_bins_ptr, num_agents, num_bins, slice_size, std::begin(bins));
+}
+
+
+template<class ExecutionPolicy, class RandomAccessIterator, class BinRange, class KeyFunction>
+void sort_based_histogram(ExecutionPolicy&& policy, RandomAccessIterator first, std::size_t n, std::size_t num_agents, BinRange& bins, KeyFunction key_fn)
+{
+  std::size_t num_bins = bins.size();
+  std::size_t chunk_size = detail::ceil_div(n, num_agents);
+
+  std::vector<std::size_t> keys(n);
+  std::size_t* keys_ptr = keys.data();
+
+  agency::bulk_invoke(policy(num_agents), compute_and_sort_keys_functor(), first, n, chunk_size, keys_ptr, key_fn);
+
+  std::vector<experimental::span<std::size_t>> sorted_chunks;
+  for(std::size_t begin = 0; begin < n; begin += chunk_size)
+  {
+    sorted_chunks.emplace_back(keys_ptr + begin, detail::min(n - begin, chunk_size));
+  }
+
+  std::vector<std::size_t> sorted_keys(n);
+  agency::multiway_merge(policy, sorted_chunks, sorted_keys.begin());
+
+  std::size_t num_counting_agents = detail::num_agents_for(policy, num_bins);
+  std::size_t slice_size = detail::ceil_div(num_bins, num_counting_agents);
+  const std::size_t* sorted_keys_ptr = sorted_keys.data();
+
+  agency::bulk_invoke(policy(num_counting_agents), count_sorted_keys_functor(), sorted_keys_ptr, n, num_bins, slice_size, std::begin(bins));
+}
+
+
+template<class ExecutionPolicy, class BinRange>
+struct can_use_shared_bins : std::integral_constant<
+  bool,
+  policy_is_concurrent<decay_t<ExecutionPolicy>>::value and
+  std::is_integral<range_count_t<BinRange>>::value
+>
+{};
+
+
+template<class ExecutionPolicy, class RandomAccessIterator, class BinRange, class KeyFunction,
+         __AGENCY_REQUIRES(can_use_shared_bins<ExecutionPolicy,BinRange>::value)>
+bool try_shared_histogram(ExecutionPolicy&& policy, RandomAccessIterator first, std::size_t n, std::size_t num_agents, BinRange& bins, KeyFunction key_fn)
+{
+  if(bins.size() > max_shared_bins) return false;
+
+  std::size_t chunk_size = detail::ceil_div(n, num_agents);
+
+  agency::bulk_invoke(policy(num_agents), count_into_shared_bins_functor(), first, n, chunk_size, std::begin(bins), bins.size(), key_fn);
+
+  return true;
+}
+
+
+template<class ExecutionPolicy, class RandomAccessIterator, class BinRange, class KeyFunction,
+         __AGENCY_REQUIRES(!can_use_shared_bins<ExecutionPolicy,BinRange>::value)>
+bool try_shared_histogram(ExecutionPolicy&&, RandomAccessIterator, std::size_t, std::size_t, BinRange&, KeyFunction)
+{
+  return false;
+}
+
+
+struct identity_key
+{
+  template<class T>
+  const T& operator()(const T& x) const
+  {
+    return x;
+  }
+};
+
+
+} // end histogram_detail
+} // end detail
+
+
+/// \brief Counts the elements of a range falling into each of a collection of bins in parallel.
+///
+/// `histogram` assigns each element `x` of `[first, last)` to the bin `key_fn(x)` and replaces the contents of
+/// `bins` with the number of elements assigned to each bin. Elements whose bin is not less than `bins.size()` are not counted.
+///
+/// To avoid contention on shared counters, elements are counted without synchronization into bins private to each agent
+/// and the private bins are summed afterward. The implementation chooses among three strategies:
+///   * When the policy's agents are concurrent and there are few bins, each agent's private counts are combined once
+///     per bin into a group-wide `shared_array` of counters before being written to `bins`.
+///   * When there are fewer bins than elements per agent, each agent counts into its own row of privatized bins
+///     and the rows are summed in parallel.
+///   * Otherwise, privatized bins would be mostly empty, so the bin indices are sorted instead and each bin's count is
+///     found by binary search.
+///
+/// \param policy An execution policy whose agents perform the counting.
+/// \param first The beginning of the input range.
+/// \param last The end of the input range.
+/// \param bins A random access range of counters, e.g. `std::vector<std::size_t>`.
+/// \param key_fn A function mapping each input element to the integral index of its bin.
+template<class ExecutionPolicy, class RandomAccessIterator, class BinRange, class KeyFunction>
+void histogram(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last, BinRange& bins, KeyFunction key_fn)
+{
+  using count_type = detail::histogram_detail::range_count_t<BinRange>;
+
+  std::size_t n = last - first;
+  std::size_t num_bins = bins.size();
+
+  if(num_bins == 0) return;
+
+  if(n == 0)
+  {
+    std::fill(std::begin(bins), std::end(bins), count_type(0));
+    return;
+  }
+
+  std::size_t num_agents = detail::num_agents_for(policy, n);
+
+  if(detail::histogram_detail::try_shared_histogram(policy, first, n, num_agents, bins, key_fn))
+  {
+    return;
+  }
+
+  if(num_bins <= n / num_agents)
+  {
+    detail::histogram_detail::privatized_histogram(policy, first, n, num_agents, bins, key_fn);
+  }
+  else
+  {
+    detail::histogram_detail::sort_based_histogram(policy, first, n, num_agents, bins, key_fn);
+  }
+}
+
+
+/// \brief Counts the occurrences of each bin index in a range in parallel.
+///
+/// This overload of `histogram` treats each element of `[first, last)` as the index of its bin.
+template<class ExecutionPolicy, class RandomAccessIterator, class BinRange>
+void histogram(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last, BinRange& bins)
+{
+  agency::histogram(std::forward<ExecutionPolicy>(policy), first, last, bins, detail::histogram_detail::identity_key());
+}
+
+
+} // end agency
+
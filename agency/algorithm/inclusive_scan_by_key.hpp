@@ -0,0 +1,200 @@
+/// \file
+/// \brief Include this file to use inclusive_scan_by_key().
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <agency/experimental/optional.hpp>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+namespace inclusive_scan_by_key_detail
+{
+
+
+// a chunk's summary records whether any segment begins within the chunk
+// and the reduction of the chunk's trailing elements, which belong to the chunk's last segment
+template<class T>
+struct chunk_summary
+{
+  bool has_head;
+  experimental::optional<T> trailing_partial_sum;
+};
+
+
+template<class T>
+struct summarize_chunk_functor
+{
+  __agency_exec_check_disable__
+  template<class Agent, class RandomAccessIterator1, class RandomAccessIterator2, class BinaryPredicate, class BinaryOperation>
+  __AGENCY_ANNOTATION
+  chunk_summary<T> operator()(Agent& self, RandomAccessIterator1 keys_first, RandomAccessIterator2 values_first, std::size_t n, std::size_t chunk_size, BinaryPredicate pred, BinaryOperation op)
+  {
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    chunk_summary<T> result{false, experimental::nullopt};
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      if(i == 0 || !pred(keys_first[i-1], keys_first[i]))
+      {
+        result.has_head = true;
+        result.trailing_partial_sum = T(values_first[i]);
+      }
+      else
+      {
+        result.trailing_partial_sum = result.trailing_partial_sum ? T(op(*result.trailing_partial_sum, values_first[i])) : T(values_first[i]);
+      }
+    }
+
+    return result;
+  }
+};
+
+
+struct scan_chunk_functor
+{
+  __agency_exec_check_disable__
+  template<class Agent,
+           class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3,
+           class T,
+           class BinaryPredicate, class BinaryOperation>
+  __AGENCY_ANNOTATION
+  void operator()(Agent& self,
+                  RandomAccessIterator1 keys_first, RandomAccessIterator2 values_first, std::size_t n, std::size_t chunk_size,
+                  RandomAccessIterator3 result,
+                  const experimental::optional<T>* carries,
+                  BinaryPredicate pred, BinaryOperation op)
+  {
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    if(begin == end) return;
+
+    // the carry is the running sum of the segment this chunk begins within
+    const experimental::optional<T>& carry = carries[self.rank()];
+
+    T running = (begin != 0 && carry && pred(keys_first[begin-1], keys_first[begin])) ?
+      T(op(*carry, values_first[begin])) :
+      T(values_first[begin]);
+
+    result[begin] = running;
+
+    for(std::size_t i = begin + 1; i < end; ++i)
+    {
+      running = pred(keys_first[i-1], keys_first[i]) ? T(op(running, values_first[i])) : T(values_first[i]);
+
+      result[i] = running;
+    }
+  }
+};
+
+
+} // end inclusive_scan_by_key_detail
+} // end detail
+
+
+/// \brief Computes an inclusive scan of each group of consecutive equivalent keys in parallel.
+///
+/// For each maximal group of consecutive keys in `[keys_first, keys_last)` which are equivalent under `pred`,
+/// `inclusive_scan_by_key` computes an inclusive prefix sum under `op` of the group's associated values and writes it
+/// to the corresponding positions of the range beginning at `result`. `result` may equal `values_first`.
+///
+/// The input is divided evenly among the policy's execution agents without regard to where groups begin.
+/// A first pass reduces the trailing group of each chunk. Serially combining these sums yields the running sum
+/// which each chunk's leading group carries in from previous chunks. A second pass then scans each chunk independently.
+///
+/// \param policy An execution policy whose agents perform the scan.
+/// \param keys_first The beginning of the key range.
+/// \param keys_last The end of the key range.
+/// \param values_first The beginning of the value range.
+/// \param result The beginning of the output range.
+/// \param pred A binary predicate which returns `true` when two consecutive keys belong to the same group.
+/// \param op An associative binary operation.
+/// \return `result + (keys_last - keys_first)`
+template<class ExecutionPolicy,
+         class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3,
+         class BinaryPredicate, class BinaryOperation>
+RandomAccessIterator3 inclusive_scan_by_key(ExecutionPolicy&& policy,
+                                            RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last,
+                                            RandomAccessIterator2 values_first,
+                                            RandomAccessIterator3 result,
+                                            BinaryPredicate pred,
+                                            BinaryOperation op)
+{
+  using value_type = typename std::iterator_traits<RandomAccessIterator2>::value_type;
+
+  std::size_t n = keys_last - keys_first;
+
+  if(n == 0) return result;
+
+  std::size_t num_agents = detail::num_agents_for(policy, n);
+  std::size_t chunk_size = detail::ceil_div(n, num_agents);
+
+  auto summaries = agency::bulk_invoke(policy(num_agents), detail::inclusive_scan_by_key_detail::summarize_chunk_functor<value_type>(), keys_first, values_first, n, chunk_size, pred, op);
+
+  // each chunk's carry is the running sum at the end of the previous chunk
+  std::vector<experimental::optional<value_type>> carries(num_agents);
+  for(std::size_t i = 1; i < num_agents; ++i)
+  {
+    const auto& prev = summaries[i-1];
+
+    if(!prev.has_head && carries[i-1])
+    {
+      // the previous chunk has no heads, so its segment continues from the chunk before it
+      if(prev.trailing_partial_sum)
+      {
+        carries[i] = value_type(op(*carries[i-1], *prev.trailing_partial_sum));
+      }
+      else
+      {
+        carries[i] = carries[i-1];
+      }
+    }
+    else
+    {
+      carries[i] = prev.trailing_partial_sum;
+    }
+  }
+
+  const experimental::optional<value_type>* carries_ptr = carries.data();
+
+  agency::bulk_invoke(policy(num_agents), detail::inclusive_scan_by_key_detail::scan_chunk_functor(), keys_first, values_first, n, chunk_size, result, carries_ptr, pred, op);
+
+  return result + n;
+}
+
+
+/// \brief Computes an inclusive scan of each group of consecutive equal keys in parallel using `operator==` and `operator+`.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3>
+RandomAccessIterator3 inclusive_scan_by_key(ExecutionPolicy&& policy,
+                                            RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last,
+                                            RandomAccessIterator2 values_first,
+                                            RandomAccessIterator3 result)
+{
+  using key_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
+  using value_type = typename std::iterator_traits<RandomAccessIterator2>::value_type;
+
+  return agency::inclusive_scan_by_key(std::forward<ExecutionPolicy>(policy),
+                                       keys_first, keys_last,
+                                       values_first,
+                                       result,
+                                       std::equal_to<key_type>(),
+                                       std::plus<value_type>());
+}
+
+
+} // end agency
+
@@ -0,0 +1,445 @@
+/// \file
+/// \brief Include this file to use merge(), merge_by_key(), and multiway_merge().
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/detail/algorithm/merge_path.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <agency/tuple.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+namespace merge_detail
+{
+
+
+// each agent of merge_functor merges one equally-sized slice of the output
+// the agent finds the beginning and end of its slice within each input with merge_path(),
+// so agents never need to communicate
+struct merge_functor
+{
+  __agency_exec_check_disable__
+  template<class Agent, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class Compare>
+  __AGENCY_ANNOTATION
+  void operator()(Agent& self,
+                  RandomAccessIterator1 first1, std::size_t n1,
+                  RandomAccessIterator2 first2, std::size_t n2,
+                  RandomAccessIterator3 result,
+                  std::size_t slice_size,
+                  Compare comp)
+  {
+    std::size_t n = n1 + n2;
+    std::size_t diagonal_begin = detail::min(n, slice_size * self.rank());
+    std::size_t diagonal_end   = detail::min(n, diagonal_begin + slice_size);
+
+    std::size_t i_begin = detail::merge_path(first1, n1, first2, n2, diagonal_begin, comp);
+    std::size_t i_end   = detail::merge_path(first1, n1, first2, n2, diagonal_end, comp);
+
+    std::size_t j_begin = diagonal_begin - i_begin;
+    std::size_t j_end   = diagonal_end - i_end;
+
+    detail::serial_merge_n(first1 + i_begin, first1 + i_end,
+                           first2 + j_begin, first2 + j_end,
+                           diagonal_end - diagonal_begin,
+                           result + diagonal_begin,
+                           comp);
+  }
+};
+
+
+struct merge_by_key_functor
+{
+  __agency_exec_check_disable__
+  template<class Agent,
+           class RandomAccessIterator1, class RandomAccessIterator2,
+           class RandomAccessIterator3, class RandomAccessIterator4,
+           class RandomAccessIterator5, class RandomAccessIterator6,
+           class Compare>
+  __AGENCY_ANNOTATION
+  void operator()(Agent& self,
+                  RandomAccessIterator1 keys_first1, std::size_t n1,
+                  RandomAccessIterator2 keys_first2, std::size_t n2,
+                  RandomAccessIterator3 values_first1,
+                  RandomAccessIterator4 values_first2,
+                  RandomAccessIterator5 keys_result,
+                  RandomAccessIterator6 values_result,
+                  std::size_t slice_size,
+                  Compare comp)
+  {
+    std::size_t n = n1 + n2;
+    std::size_t diagonal_begin = detail::min(n, slice_size * self.rank());
+    std::size_t diagonal_end   = detail::min(n, diagonal_begin + slice_size);
+
+    std::size_t i_begin = detail::merge_path(keys_first1, n1, keys_first2, n2, diagonal_begin, comp);
+    std::size_t i_end   = detail::merge_path(keys_first1, n1, keys_first2, n2, diagonal_end, comp);
+
+    std::size_t j_begin = diagonal_begin - i_begin;
+    std::size_t j_end   = diagonal_end - i_end;
+
+    detail::serial_merge_by_key_n(keys_first1 + i_begin, keys_first1 + i_end,
+                                  keys_first2 + j_begin, keys_first2 + j_end,
+                                  values_first1 + i_begin,
+                                  values_first2 + j_begin,
+                                  diagonal_end - diagonal_begin,
+                                  keys_result + diagonal_begin,
+                                  values_result + diagonal_begin,
+                                  comp);
+  }
+};
+
+
+// the stable order of a k-way merge breaks ties between equivalent elements
+// by the index of the range they come from
+//
+// multiway_rank() returns the position of firsts[j][p] in that order, i.e. its index in the merged output
+template<class RandomAccessIterator, class Compare>
+std::size_t multiway_rank(const RandomAccessIterator* firsts, const std::size_t* sizes, std::size_t k,
+                          std::size_t j, std::size_t p,
+                          Compare comp)
+{
+  const auto& value = firsts[j][p];
+
+  std::size_t result = p;
+
+  for(std::size_t i = 0; i < k; ++i)
+  {
+    if(i < j)
+    {
+      // count the elements of range i which are not greater than value
+      result += std::upper_bound(firsts[i], firsts[i] + sizes[i], value, comp) - firsts[i];
+    }
+    else if(i > j)
+    {
+      // count the elements of range i which are less than value
+      result += std::lower_bound(firsts[i], firsts[i] + sizes[i], value, comp) - firsts[i];
+    }
+  }
+
+  return result;
+}
+
+
+// multiway_merge_path() generalizes merge_path() to k ranges
+// for each range j, it computes the number of elements of range j which precede the diagonal-th element of the merge
+// the sum of these co-ranks is diagonal
+template<class RandomAccessIterator, class Compare>
+void multiway_merge_path(const RandomAccessIterator* firsts, const std::size_t* sizes, std::size_t k,
+                         std::size_t diagonal,
+                         std::size_t* co_ranks,
+                         Compare comp)
+{
+  for(std::size_t j = 0; j < k; ++j)
+  {
+    // find the first position of range j whose rank is at least diagonal
+    std::size_t lo = 0;
+    std::size_t hi = detail::min(sizes[j], diagonal);
+
+    while(lo < hi)
+    {
+      std::size_t mid = lo + (hi - lo) / 2;
+
+      if(multiway_rank(firsts, sizes, k, j, mid, comp) < diagonal)
+      {
+        lo = mid + 1;
+      }
+      else
+      {
+        hi = mid;
+      }
+    }
+
+    co_ranks[j] = lo;
+  }
+}
+
+
+// orders the indices of ranges in a min-heap by the element at the head of each range
+template<class RandomAccessIterator, class Compare>
+struct multiway_heap_compare
+{
+  const RandomAccessIterator* heads;
+  Compare comp;
+
+  bool operator()(std::size_t a, std::size_t b) const
+  {
+    // std::push_heap() builds a max-heap, so return true when a's head should be merged after b's head
+    if(comp(*heads[b], *heads[a])) return true;
+    if(comp(*heads[a], *heads[b])) return false;
+    return b < a;
+  }
+};
+
+
+struct multiway_merge_functor
+{
+  template<class Agent, class RandomAccessIterator, class OutputIterator, class Compare>
+  void operator()(Agent& self,
+                  const RandomAccessIterator* firsts, const std::size_t* sizes, std::size_t k,
+                  std::size_t n,
+                  OutputIterator result,
+                  std::size_t slice_size,
+                  Compare comp)
+  {
+    std::size_t diagonal_begin = detail::min(n, slice_size * self.rank());
+    std::size_t diagonal_end   = detail::min(n, diagonal_begin + slice_size);
+
+    if(diagonal_begin == diagonal_end) return;
+
+    std::vector<std::size_t> begin(k), end(k);
+    multiway_merge_path(firsts, sizes, k, diagonal_begin, begin.data(), comp);
+    multiway_merge_path(firsts, sizes, k, diagonal_end, end.data(), comp);
+
+    std::vector<RandomAccessIterator> heads(k), tails(k);
+    std::vector<std::size_t> heap;
+    heap.reserve(k);
+
+    multiway_heap_compare<RandomAccessIterator,Compare> heap_comp{heads.data(), comp};
+
+    for(std::size_t j = 0; j < k; ++j)
+    {
+      heads[j] = firsts[j] + begin[j];
+      tails[j] = firsts[j] + end[j];
+
+      if(heads[j] != tails[j])
+      {
+        heap.push_back(j);
+        std::push_heap(heap.begin(), heap.end(), heap_comp);
+      }
+    }
+
+    result += diagonal_begin;
+
+    while(!heap.empty())
+    {
+      std::pop_heap(heap.begin(), heap.end(), heap_comp);
+      std::size_t j = heap.back();
+
+      *result = *heads[j];
+      ++result;
+      ++heads[j];
+
+      if(heads[j] != tails[j])
+      {
+        std::push_heap(heap.begin(), heap.end(), heap_comp);
+      }
+      else
+      {
+        heap.pop_back();
+      }
+    }
+  }
+};
+
+
+template<class Iterator>
+using iterator_value_less = std::less<typename std::iterator_traits<Iterator>::value_type>;
+
+
+// multiway_merge_n() writes only the first n elements of the merge of ranges to result
+// because each agent's slice of the output is located independently, no work is spent on the remainder of the merge
+template<class ExecutionPolicy, class RangeOfRanges, class RandomAccessIterator, class Compare>
+RandomAccessIterator multiway_merge_n(ExecutionPolicy&& policy, const RangeOfRanges& ranges, std::size_t n, RandomAccessIterator result, Compare comp)
+{
+  using input_iterator = decltype(std::begin(*std::begin(ranges)));
+
+  std::vector<input_iterator> firsts;
+  std::vector<std::size_t> sizes;
+  std::size_t total_size = 0;
+
+  for(const auto& rng : ranges)
+  {
+    firsts.push_back(std::begin(rng));
+    sizes.push_back(std::end(rng) - std::begin(rng));
+    total_size += sizes.back();
+  }
+
+  n = detail::min(n, total_size);
+
+  if(n == 0) return result;
+
+  std::size_t num_agents = detail::num_agents_for(policy, n);
+  std::size_t slice_size = detail::ceil_div(n, num_agents);
+
+  const input_iterator* firsts_ptr = firsts.data();
+  const std::size_t* sizes_ptr = sizes.data();
+
+  agency::bulk_invoke(policy(num_agents), multiway_merge_functor(), firsts_ptr, sizes_ptr, firsts.size(), n, result, slice_size, comp);
+
+  return result + n;
+}
+
+
+} // end merge_detail
+} // end detail
+
+
+/// \brief Merges two sorted ranges in parallel.
+///
+/// `merge` merges the sorted ranges `[first1, last1)` and `[first2, last2)` into a single sorted range beginning at `result`.
+/// The merge is stable: equivalent elements from the first range precede those from the second.
+///
+/// The output is divided into equally-sized slices, one per execution agent. Each agent locates the
+/// portion of each input range which contributes to its slice with a binary search along a diagonal of
+/// the "merge path", so agents require no synchronization among themselves.
+///
+/// \param policy An execution policy whose agents perform the merge.
+/// \param first1 The beginning of the first input range.
+/// \param last1 The end of the first input range.
+/// \param first2 The beginning of the second input range.
+/// \param last2 The end of the second input range.
+/// \param result The beginning of the output range.
+/// \param comp A strict weak ordering by which both input ranges are sorted.
+/// \return `result + (last1 - first1) + (last2 - first2)`
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class Compare>
+RandomAccessIterator3 merge(ExecutionPolicy&& policy,
+                            RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                            RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                            RandomAccessIterator3 result,
+                            Compare comp)
+{
+  std::size_t n1 = last1 - first1;
+  std::size_t n2 = last2 - first2;
+  std::size_t n = n1 + n2;
+
+  if(n == 0) return result;
+
+  std::size_t num_agents = detail::num_agents_for(policy, n);
+  std::size_t slice_size = detail::ceil_div(n, num_agents);
+
+  agency::bulk_invoke(policy(num_agents), detail::merge_detail::merge_functor(), first1, n1, first2, n2, result, slice_size, comp);
+
+  return result + n;
+}
+
+
+/// \brief Merges two sorted ranges in parallel using `operator<`.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3>
+RandomAccessIterator3 merge(ExecutionPolicy&& policy,
+                            RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                            RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                            RandomAccessIterator3 result)
+{
+  return agency::merge(std::forward<ExecutionPolicy>(policy), first1, last1, first2, last2, result, detail::merge_detail::iterator_value_less<RandomAccessIterator1>());
+}
+
+
+/// \brief Merges two sorted ranges of keys and their associated values in parallel.
+///
+/// `merge_by_key` merges the sorted key ranges `[keys_first1, keys_last1)` and `[keys_first2, keys_last2)`
+/// into `keys_result` exactly as `merge` would. Each key's value, found at the same position of the value range
+/// beginning at `values_first1` or `values_first2`, is copied to the corresponding position beginning at `values_result`.
+///
+/// \return A `tuple` of the ends of the key and value output ranges.
+template<class ExecutionPolicy,
+         class RandomAccessIterator1, class RandomAccessIterator2,
+         class RandomAccessIterator3, class RandomAccessIterator4,
+         class RandomAccessIterator5, class RandomAccessIterator6,
+         class Compare>
+tuple<RandomAccessIterator5,RandomAccessIterator6>
+  merge_by_key(ExecutionPolicy&& policy,
+               RandomAccessIterator1 keys_first1, RandomAccessIterator1 keys_last1,
+               RandomAccessIterator2 keys_first2, RandomAccessIterator2 keys_last2,
+               RandomAccessIterator3 values_first1,
+               RandomAccessIterator4 values_first2,
+               RandomAccessIterator5 keys_result,
+               RandomAccessIterator6 values_result,
+               Compare comp)
+{
+  std::size_t n1 = keys_last1 - keys_first1;
+  std::size_t n2 = keys_last2 - keys_first2;
+  std::size_t n = n1 + n2;
+
+  if(n == 0) return agency::make_tuple(keys_result, values_result);
+
+  std::size_t num_agents = detail::num_agents_for(policy, n);
+  std::size_t slice_size = detail::ceil_div(n, num_agents);
+
+  agency::bulk_invoke(policy(num_agents), detail::merge_detail::merge_by_key_functor(),
+    keys_first1, n1,
+    keys_first2, n2,
+    values_first1,
+    values_first2,
+    keys_result,
+    values_result,
+    slice_size,
+    comp
+  );
+
+  return agency::make_tuple(keys_result + n, values_result + n);
+}
+
+
+/// \brief Merges two sorted ranges of keys and their associated values in parallel using `operator<`.
+template<class ExecutionPolicy,
+         class RandomAccessIterator1, class RandomAccessIterator2,
+         class RandomAccessIterator3, class RandomAccessIterator4,
+         class RandomAccessIterator5, class RandomAccessIterator6>
+tuple<RandomAccessIterator5,RandomAccessIterator6>
+  merge_by_key(ExecutionPolicy&& policy,
+               RandomAccessIterator1 keys_first1, RandomAccessIterator1 keys_last1,
+               RandomAccessIterator2 keys_first2, RandomAccessIterator2 keys_last2,
+               RandomAccessIterator3 values_first1,
+               RandomAccessIterator4 values_first2,
+               RandomAccessIterator5 keys_result,
+               RandomAccessIterator6 values_result)
+{
+  return agency::merge_by_key(std::forward<ExecutionPolicy>(policy),
+                              keys_first1, keys_last1,
+                              keys_first2, keys_last2,
+                              values_first1, values_first2,
+                              keys_result, values_result,
+                              detail::merge_detail::iterator_value_less<RandomAccessIterator1>());
+}
+
+
+/// \brief Merges `k` sorted ranges in parallel.
+///
+/// `multiway_merge` merges each of the sorted ranges in `ranges` into a single sorted range beginning at `result`.
+/// The merge is stable: equivalent elements appear in the order of the ranges they come from.
+///
+/// Like `merge`, the output is divided into equally-sized slices, one per execution agent, and each
+/// agent independently locates the beginning and end of its slice within every input range with a binary search.
+/// Within its slice, each agent merges the `k` inputs through a heap.
+///
+/// \param policy An execution policy whose agents perform the merge.
+/// \param ranges A collection of sorted ranges with random access iterators, e.g. `std::vector<std::vector<T>>`.
+/// \param result The beginning of the output range.
+/// \param comp A strict weak ordering by which every input range is sorted.
+/// \return The end of the output range.
+template<class ExecutionPolicy, class RangeOfRanges, class RandomAccessIterator, class Compare>
+RandomAccessIterator multiway_merge(ExecutionPolicy&& policy, const RangeOfRanges& ranges, RandomAccessIterator result, Compare comp)
+{
+  std::size_t n = 0;
+  for(const auto& rng : ranges)
+  {
+    n += std::end(rng) - std::begin(rng);
+  }
+
+  return detail::merge_detail::multiway_merge_n(std::forward<ExecutionPolicy>(policy), ranges, n, result, comp);
+}
+
+
+/// \brief Merges `k` sorted ranges in parallel using `operator<`.
+template<class ExecutionPolicy, class RangeOfRanges, class RandomAccessIterator>
+RandomAccessIterator multiway_merge(ExecutionPolicy&& policy, const RangeOfRanges& ranges, RandomAccessIterator result)
+{
+  using input_iterator = decltype(std::begin(*std::begin(ranges)));
+
+  return agency::multiway_merge(std::forward<ExecutionPolicy>(policy), ranges, result, detail::merge_detail::iterator_value_less<input_iterator>());
+}
+
+
+} // end agency
+
@@ -0,0 +1,245 @@
+/// \file
+/// \brief Include this file to use nth_element().
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+namespace nth_element_detail
+{
+
+
+// below this many elements, selection proceeds sequentially
+constexpr std::size_t sequential_cutoff = 1 << 14;
+
+// the number of elements sampled to choose splitters
+constexpr std::size_t sample_size = 1024;
+
+// the splitters are this many sample positions below and above the sample's estimate of the nth element
+constexpr std::size_t splitter_distance = 16;
+
+
+// each element falls into one of three buckets relative to the splitters lo and hi:
+// less than lo, greater than hi, or between them
+struct bucket_counts
+{
+  std::size_t less;
+  std::size_t middle;
+  std::size_t greater;
+};
+
+
+struct count_buckets_functor
+{
+  template<class Agent, class RandomAccessIterator, class T, class Compare>
+  bucket_counts operator()(Agent& self, RandomAccessIterator first, std::size_t n, std::size_t chunk_size, const T& lo, const T& hi, Compare comp)
+  {
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    bucket_counts result{0, 0, 0};
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      if(comp(first[i], lo))
+      {
+        ++result.less;
+      }
+      else if(comp(hi, first[i]))
+      {
+        ++result.greater;
+      }
+      else
+      {
+        ++result.middle;
+      }
+    }
+
+    return result;
+  }
+};
+
+
+// each agent copies its chunk's elements into their buckets' regions of the result
+struct scatter_buckets_functor
+{
+  template<class Agent, class RandomAccessIterator1, class RandomAccessIterator2, class T, class Compare>
+  void operator()(Agent& self, RandomAccessIterator1 first, std::size_t n, std::size_t chunk_size, const bucket_counts* offsets, const T& lo, const T& hi, RandomAccessIterator2 result, Compare comp)
+  {
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    bucket_counts position = offsets[self.rank()];
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      if(comp(first[i], lo))
+      {
+        result[position.less++] = first[i];
+      }
+      else if(comp(hi, first[i]))
+      {
+        result[position.greater++] = first[i];
+      }
+      else
+      {
+        result[position.middle++] = first[i];
+      }
+    }
+  }
+};
+
+
+struct copy_chunk_functor
+{
+  template<class Agent, class RandomAccessIterator1, class RandomAccessIterator2>
+  void operator()(Agent& self, RandomAccessIterator1 first, std::size_t n, std::size_t chunk_size, RandomAccessIterator2 result)
+  {
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    std::copy(first + begin, first + end, result + begin);
+  }
+};
+
+
+} // end nth_element_detail
+} // end detail
+
+
+/// \brief Partially orders a range around its nth element in parallel.
+///
+/// After `nth_element` returns, the element at `nth` is the element which would occupy that position if `[first, last)` were sorted by `comp`.
+/// No element of `[first, nth)` is greater than `*nth`, and no element of `[nth + 1, last)` is less than `*nth`.
+///
+/// Each round of the parallel selection sorts a small, evenly-spaced sample of the range and chooses from it a pair of
+/// splitters which bracket the sample's estimate of the nth element. The policy's agents count and then partition the range
+/// into the elements below, between, and above the splitters, and selection continues only within the bucket which contains
+/// the nth position. Usually, that bucket is much smaller than the range. Once the remaining range is small, selection finishes
+/// sequentially with `std::nth_element`.
+///
+/// \param policy An execution policy whose agents perform the selection.
+/// \param first The beginning of the range.
+/// \param nth The position to select.
+/// \param last The end of the range.
+/// \param comp A strict weak ordering.
+template<class ExecutionPolicy, class RandomAccessIterator, class Compare>
+void nth_element(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last, Compare comp)
+{
+  using namespace detail::nth_element_detail;
+  using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+  std::vector<value_type> buffer;
+  std::vector<value_type> sample;
+
+  while(nth != last)
+  {
+    std::size_t n = last - first;
+    std::size_t num_agents = detail::num_agents_for(policy, n);
+
+    if(n <= sequential_cutoff || num_agents == 1)
+    {
+      std::nth_element(first, nth, last, comp);
+      return;
+    }
+
+    // estimate the nth element's neighborhood from a sorted sample
+    sample.clear();
+    for(std::size_t i = 0; i < sample_size; ++i)
+    {
+      sample.push_back(first[i * n / sample_size]);
+    }
+    std::sort(sample.begin(), sample.end(), comp);
+
+    std::size_t estimate = (nth - first) * sample_size / n;
+    const value_type& lo = sample[estimate > splitter_distance ? estimate - splitter_distance : 0];
+    const value_type& hi = sample[detail::min(sample_size - 1, estimate + splitter_distance)];
+
+    std::size_t chunk_size = detail::ceil_div(n, num_agents);
+
+    auto counts = agency::bulk_invoke(policy(num_agents), count_buckets_functor(), first, n, chunk_size, lo, hi, comp);
+
+    bucket_counts totals{0, 0, 0};
+    for(std::size_t i = 0; i < num_agents; ++i)
+    {
+      totals.less    += counts[i].less;
+      totals.middle  += counts[i].middle;
+      totals.greater += counts[i].greater;
+    }
+
+    // when the splitters fail to divide the range, finish sequentially
+    if(totals.less == n || totals.middle == n || totals.greater == n)
+    {
+      // if the range is entirely between equivalent splitters, it is already partitioned
+      if(totals.middle == n && !comp(lo, hi)) return;
+
+      std::nth_element(first, nth, last, comp);
+      return;
+    }
+
+    // scan the bucket counts into each agent's output positions
+    std::vector<bucket_counts> offsets(num_agents);
+    bucket_counts position{0, totals.less, totals.less + totals.middle};
+    for(std::size_t i = 0; i < num_agents; ++i)
+    {
+      offsets[i] = position;
+      position.less    += counts[i].less;
+      position.middle  += counts[i].middle;
+      position.greater += counts[i].greater;
+    }
+
+    buffer.resize(n);
+    const bucket_counts* offsets_ptr = offsets.data();
+
+    agency::bulk_invoke(policy(num_agents), scatter_buckets_functor(), first, n, chunk_size, offsets_ptr, lo, hi, buffer.begin(), comp);
+
+    agency::bulk_invoke(policy(num_agents), copy_chunk_functor(), buffer.begin(), n, chunk_size, first);
+
+    // continue within the bucket containing nth
+    std::size_t r = nth - first;
+    if(r < totals.less)
+    {
+      last = first + totals.less;
+    }
+    else if(r < totals.less + totals.middle)
+    {
+      last = first + totals.less + totals.middle;
+      first += totals.less;
+
+      // when the splitters are equivalent, every element of the middle bucket is the nth element
+      if(!comp(lo, hi)) return;
+    }
+    else
+    {
+      first += totals.less + totals.middle;
+    }
+  }
+}
+
+
+/// \brief Partially orders a range around its nth element in parallel using `operator<`.
+template<class ExecutionPolicy, class RandomAccessIterator>
+void nth_element(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator nth, RandomAccessIterator last)
+{
+  using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+  agency::nth_element(std::forward<ExecutionPolicy>(policy), first, nth, last, std::less<value_type>());
+}
+
+
+} // end agency
+
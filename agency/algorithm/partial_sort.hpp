@@ -0,0 +1,112 @@
+/// \file
+/// \brief Include this file to use partial_sort().
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/algorithm/merge.hpp>
+#include <agency/algorithm/nth_element.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <agency/experimental/span.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+namespace partial_sort_detail
+{
+
+
+struct sort_chunk_functor
+{
+  template<class Agent, class RandomAccessIterator, class Compare>
+  void operator()(Agent& self, RandomAccessIterator first, std::size_t n, std::size_t chunk_size, Compare comp)
+  {
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    std::sort(first + begin, first + end, comp);
+  }
+};
+
+
+// sorts [first, first + n) by sorting each agent's chunk and then merging the sorted chunks
+template<class ExecutionPolicy, class RandomAccessIterator, class Compare>
+void sort_n(ExecutionPolicy&& policy, RandomAccessIterator first, std::size_t n, Compare comp)
+{
+  using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+  std::size_t num_agents = detail::num_agents_for(policy, n);
+
+  if(num_agents == 1)
+  {
+    std::sort(first, first + n, comp);
+    return;
+  }
+
+  std::size_t chunk_size = detail::ceil_div(n, num_agents);
+
+  agency::bulk_invoke(policy(num_agents), sort_chunk_functor(), first, n, chunk_size, comp);
+
+  // move the sorted chunks out of the way so they can be merged back into place
+  std::vector<value_type> buffer(std::make_move_iterator(first), std::make_move_iterator(first + n));
+
+  std::vector<experimental::span<value_type>> sorted_chunks;
+  for(std::size_t begin = 0; begin < n; begin += chunk_size)
+  {
+    sorted_chunks.emplace_back(buffer.data() + begin, detail::min(n - begin, chunk_size));
+  }
+
+  agency::multiway_merge(policy, sorted_chunks, first, comp);
+}
+
+
+} // end partial_sort_detail
+} // end detail
+
+
+/// \brief Sorts the smallest elements of a range in parallel.
+///
+/// After `partial_sort` returns, `[first, middle)` contains the `middle - first` smallest elements of `[first, last)`, sorted by `comp`.
+/// The order of the remaining elements is unspecified.
+///
+/// The range is never sorted in its entirety. `nth_element` first gathers the smallest elements into `[first, middle)` by parallel selection,
+/// and then only those elements are sorted.
+///
+/// \param policy An execution policy whose agents perform the sort.
+/// \param first The beginning of the range.
+/// \param middle The end of the subrange to sort.
+/// \param last The end of the range.
+/// \param comp A strict weak ordering.
+template<class ExecutionPolicy, class RandomAccessIterator, class Compare>
+void partial_sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last, Compare comp)
+{
+  if(first == middle) return;
+
+  agency::nth_element(policy, first, middle - 1, last, comp);
+
+  detail::partial_sort_detail::sort_n(policy, first, middle - first, comp);
+}
+
+
+/// \brief Sorts the smallest elements of a range in parallel using `operator<`.
+template<class ExecutionPolicy, class RandomAccessIterator>
+void partial_sort(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator middle, RandomAccessIterator last)
+{
+  using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+  agency::partial_sort(std::forward<ExecutionPolicy>(policy), first, middle, last, std::less<value_type>());
+}
+
+
+} // end agency
+
@@ -0,0 +1,241 @@
+/// \file
+/// \brief Include this file to use reduce_by_key().
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <agency/experimental/optional.hpp>
+#include <agency/tuple.hpp>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+namespace reduce_by_key_detail
+{
+
+
+// a chunk's summary records how many segments begin within the chunk
+// and the reduction of the elements which precede the first of them
+// those elements belong to a segment which began in some previous chunk
+template<class T>
+struct chunk_summary
+{
+  std::size_t num_heads;
+  experimental::optional<T> leading_partial_sum;
+};
+
+
+template<class T>
+struct summarize_chunk_functor
+{
+  __agency_exec_check_disable__
+  template<class Agent, class RandomAccessIterator1, class RandomAccessIterator2, class BinaryPredicate, class BinaryOperation>
+  __AGENCY_ANNOTATION
+  chunk_summary<T> operator()(Agent& self, RandomAccessIterator1 keys_first, RandomAccessIterator2 values_first, std::size_t n, std::size_t chunk_size, BinaryPredicate pred, BinaryOperation op)
+  {
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    chunk_summary<T> result{0, experimental::nullopt};
+
+    for(std::size_t i = begin; i < end; ++i)
+    {
+      if(i == 0 || !pred(keys_first[i-1], keys_first[i]))
+      {
+        ++result.num_heads;
+      }
+      else if(result.num_heads == 0)
+      {
+        result.leading_partial_sum = result.leading_partial_sum ? T(op(*result.leading_partial_sum, values_first[i])) : T(values_first[i]);
+      }
+    }
+
+    return result;
+  }
+};
+
+
+struct reduce_chunk_functor
+{
+  __agency_exec_check_disable__
+  template<class Agent,
+           class RandomAccessIterator1, class RandomAccessIterator2,
+           class RandomAccessIterator3, class RandomAccessIterator4,
+           class T,
+           class BinaryPredicate, class BinaryOperation>
+  __AGENCY_ANNOTATION
+  void operator()(Agent& self,
+                  RandomAccessIterator1 keys_first, RandomAccessIterator2 values_first, std::size_t n, std::size_t chunk_size,
+                  RandomAccessIterator3 keys_result, RandomAccessIterator4 values_result,
+                  const std::size_t* output_offsets,
+                  const experimental::optional<T>* carries,
+                  BinaryPredicate pred, BinaryOperation op)
+  {
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    // skip the elements which belong to the previous chunk's last segment
+    std::size_t i = begin;
+    while(i < end && i != 0 && pred(keys_first[i-1], keys_first[i]))
+    {
+      ++i;
+    }
+
+    std::size_t out = output_offsets[self.rank()];
+
+    while(i < end)
+    {
+      // i is the head of a segment
+      keys_result[out] = keys_first[i];
+      T sum = values_first[i];
+
+      for(++i; i < end && pred(keys_first[i-1], keys_first[i]); ++i)
+      {
+        sum = op(sum, values_first[i]);
+      }
+
+      // when the segment continues beyond this chunk, fold in the following chunks' contributions
+      if(i == end && carries[self.rank()])
+      {
+        sum = op(sum, *carries[self.rank()]);
+      }
+
+      values_result[out] = sum;
+      ++out;
+    }
+  }
+};
+
+
+} // end reduce_by_key_detail
+} // end detail
+
+
+/// \brief Reduces each group of consecutive equivalent keys in parallel.
+///
+/// For each maximal group of consecutive keys in `[keys_first, keys_last)` which are equivalent under `pred`,
+/// `reduce_by_key` writes the group's first key to `keys_result` and the reduction under `op` of the group's
+/// associated values to `values_result`.
+///
+/// The input is divided evenly among the policy's execution agents without regard to where groups begin,
+/// so a group may span several agents' chunks. A first pass counts the groups beginning within each chunk
+/// and reduces the leading elements of groups which began in some previous chunk. Each agent then reduces
+/// the groups beginning within its chunk and folds in the partial sums of the following chunks when its last
+/// group crosses its chunk's boundary.
+///
+/// \param policy An execution policy whose agents perform the reduction.
+/// \param keys_first The beginning of the key range.
+/// \param keys_last The end of the key range.
+/// \param values_first The beginning of the value range.
+/// \param keys_result The beginning of the range receiving each group's first key.
+/// \param values_result The beginning of the range receiving each group's reduction.
+/// \param pred A binary predicate which returns `true` when two consecutive keys belong to the same group.
+/// \param op An associative binary operation.
+/// \return A `tuple` of the ends of the key and value output ranges.
+template<class ExecutionPolicy,
+         class RandomAccessIterator1, class RandomAccessIterator2,
+         class RandomAccessIterator3, class RandomAccessIterator4,
+         class BinaryPredicate, class BinaryOperation>
+tuple<RandomAccessIterator3,RandomAccessIterator4>
+  reduce_by_key(ExecutionPolicy&& policy,
+                RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last,
+                RandomAccessIterator2 values_first,
+                RandomAccessIterator3 keys_result,
+                RandomAccessIterator4 values_result,
+                BinaryPredicate pred,
+                BinaryOperation op)
+{
+  using value_type = typename std::iterator_traits<RandomAccessIterator2>::value_type;
+
+  std::size_t n = keys_last - keys_first;
+
+  if(n == 0) return agency::make_tuple(keys_result, values_result);
+
+  std::size_t num_agents = detail::num_agents_for(policy, n);
+  std::size_t chunk_size = detail::ceil_div(n, num_agents);
+
+  auto summaries = agency::bulk_invoke(policy(num_agents), detail::reduce_by_key_detail::summarize_chunk_functor<value_type>(), keys_first, values_first, n, chunk_size, pred, op);
+
+  // scan the number of segments preceding each chunk
+  std::vector<std::size_t> output_offsets(num_agents);
+  std::size_t num_segments = 0;
+  for(std::size_t i = 0; i < num_agents; ++i)
+  {
+    output_offsets[i] = num_segments;
+    num_segments += summaries[i].num_heads;
+  }
+
+  // each chunk's carry is the combined contribution of the following chunks to its last segment
+  std::vector<experimental::optional<value_type>> carries(num_agents);
+  for(std::size_t i = num_agents - 1; i > 0; --i)
+  {
+    const auto& next = summaries[i];
+
+    if(next.num_heads == 0 && carries[i])
+    {
+      // the next chunk has no heads, so the segment continues through it
+      if(next.leading_partial_sum)
+      {
+        carries[i-1] = value_type(op(*next.leading_partial_sum, *carries[i]));
+      }
+      else
+      {
+        carries[i-1] = carries[i];
+      }
+    }
+    else
+    {
+      carries[i-1] = next.leading_partial_sum;
+    }
+  }
+
+  const std::size_t* output_offsets_ptr = output_offsets.data();
+  const experimental::optional<value_type>* carries_ptr = carries.data();
+
+  agency::bulk_invoke(policy(num_agents), detail::reduce_by_key_detail::reduce_chunk_functor(),
+    keys_first, values_first, n, chunk_size,
+    keys_result, values_result,
+    output_offsets_ptr,
+    carries_ptr,
+    pred, op
+  );
+
+  return agency::make_tuple(keys_result + num_segments, values_result + num_segments);
+}
+
+
+/// \brief Reduces each group of consecutive equal keys in parallel using `operator==` and `operator+`.
+template<class ExecutionPolicy,
+         class RandomAccessIterator1, class RandomAccessIterator2,
+         class RandomAccessIterator3, class RandomAccessIterator4>
+tuple<RandomAccessIterator3,RandomAccessIterator4>
+  reduce_by_key(ExecutionPolicy&& policy,
+                RandomAccessIterator1 keys_first, RandomAccessIterator1 keys_last,
+                RandomAccessIterator2 values_first,
+                RandomAccessIterator3 keys_result,
+                RandomAccessIterator4 values_result)
+{
+  using key_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
+  using value_type = typename std::iterator_traits<RandomAccessIterator2>::value_type;
+
+  return agency::reduce_by_key(std::forward<ExecutionPolicy>(policy),
+                               keys_first, keys_last,
+                               values_first,
+                               keys_result, values_result,
+                               std::equal_to<key_type>(),
+                               std::plus<value_type>());
+}
+
+
+} // end agency
+
@@ -0,0 +1,238 @@
+/// \file
+/// \brief Include this file to use segmented_reduce().
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <agency/experimental/optional.hpp>
+#include <agency/experimental/segmented_array.hpp>
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+namespace segmented_reduce_detail
+{
+
+
+// a chunk's summary records whether any segment begins within the chunk
+// and the reduction of the elements which precede the first such segment
+template<class T>
+struct chunk_summary
+{
+  bool has_segment_begin;
+  experimental::optional<T> leading_partial_sum;
+};
+
+
+template<class T>
+struct summarize_chunk_functor
+{
+  __agency_exec_check_disable__
+  template<class Agent, class RandomAccessIterator1, class RandomAccessIterator2, class BinaryOperation>
+  __AGENCY_ANNOTATION
+  chunk_summary<T> operator()(Agent& self,
+                              RandomAccessIterator1 values_first,
+                              RandomAccessIterator2 offsets_first, std::size_t num_segments,
+                              std::size_t n, std::size_t chunk_size,
+                              BinaryOperation op)
+  {
+    std::size_t base = offsets_first[0];
+    std::size_t begin = base + detail::min(n, chunk_size * self.rank());
+    std::size_t end   = base + detail::min(n, begin - base + chunk_size);
+
+    // find the first segment which begins at or after this chunk's beginning
+    std::size_t next_segment_begin = *std::lower_bound(offsets_first, offsets_first + num_segments + 1, begin);
+
+    chunk_summary<T> result{next_segment_begin < end, experimental::nullopt};
+
+    std::size_t leading_end = detail::min(next_segment_begin, end);
+    for(std::size_t i = begin; i < leading_end; ++i)
+    {
+      result.leading_partial_sum = result.leading_partial_sum ? T(op(*result.leading_partial_sum, values_first[i])) : T(values_first[i]);
+    }
+
+    return result;
+  }
+};
+
+
+struct reduce_chunk_functor
+{
+  __agency_exec_check_disable__
+  template<class Agent, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class T, class BinaryOperation>
+  __AGENCY_ANNOTATION
+  void operator()(Agent& self,
+                  RandomAccessIterator1 values_first,
+                  RandomAccessIterator2 offsets_first, std::size_t num_segments,
+                  std::size_t n, std::size_t chunk_size,
+                  std::size_t num_agents,
+                  RandomAccessIterator3 result,
+                  const experimental::optional<T>* carries,
+                  const T& init,
+                  BinaryOperation op)
+  {
+    std::size_t base = offsets_first[0];
+    std::size_t begin = base + detail::min(n, chunk_size * self.rank());
+    std::size_t end   = base + detail::min(n, begin - base + chunk_size);
+
+    // this agent owns the segments which begin within its chunk
+    // the last agent also owns the empty segments at the very end of the input
+    std::size_t first_segment = std::lower_bound(offsets_first, offsets_first + num_segments, begin) - offsets_first;
+    std::size_t last_segment = (self.rank() + 1 == num_agents) ?
+      num_segments :
+      std::lower_bound(offsets_first, offsets_first + num_segments, end) - offsets_first;
+
+    for(std::size_t s = first_segment; s < last_segment; ++s)
+    {
+      std::size_t segment_end = offsets_first[s+1];
+
+      T sum = init;
+      for(std::size_t i = offsets_first[s]; i < detail::min(segment_end, end); ++i)
+      {
+        sum = op(sum, values_first[i]);
+      }
+
+      // when the segment continues beyond this chunk, fold in the following chunks' contributions
+      if(segment_end > end && carries[self.rank()])
+      {
+        sum = op(sum, *carries[self.rank()]);
+      }
+
+      result[s] = sum;
+    }
+  }
+};
+
+
+struct reduce_segment_functor
+{
+  __agency_exec_check_disable__
+  template<class Agent, class SegmentIterator, class RandomAccessIterator, class T, class BinaryOperation>
+  __AGENCY_ANNOTATION
+  void operator()(Agent& self, SegmentIterator segments_first, RandomAccessIterator result, const T& init, BinaryOperation op)
+  {
+    const auto& segment = segments_first[self.rank()];
+
+    T sum = init;
+    for(const auto& x : segment)
+    {
+      sum = op(sum, x);
+    }
+
+    result[self.rank()] = sum;
+  }
+};
+
+
+} // end segmented_reduce_detail
+} // end detail
+
+
+/// \brief Reduces each segment of a range in parallel.
+///
+/// `segmented_reduce` treats the range of values beginning at `values_first` as a sequence of segments described by the
+/// nondecreasing offsets `[offsets_first, offsets_last)`. Segment `s` is the range `[values_first + offsets_first[s], values_first + offsets_first[s+1])`,
+/// so there are `(offsets_last - offsets_first) - 1` segments. For each segment `s`, `segmented_reduce` writes `init` combined under `op`
+/// with each of the segment's values to `result[s]`. Empty segments produce `init`.
+///
+/// Elements, rather than segments, are divided evenly among the policy's execution agents, so the work remains
+/// balanced no matter how segment sizes vary. When a segment spans several agents' chunks, the agent owning its first
+/// chunk folds in the partial sums of the remaining chunks.
+///
+/// \param policy An execution policy whose agents perform the reduction.
+/// \param values_first The beginning of the value range.
+/// \param offsets_first The beginning of the segment offsets.
+/// \param offsets_last The end of the segment offsets.
+/// \param result The beginning of the range receiving each segment's reduction.
+/// \param init The initial value of each segment's reduction.
+/// \param op An associative binary operation.
+/// \return The end of the output range.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class T, class BinaryOperation>
+RandomAccessIterator3 segmented_reduce(ExecutionPolicy&& policy,
+                                       RandomAccessIterator1 values_first,
+                                       RandomAccessIterator2 offsets_first, RandomAccessIterator2 offsets_last,
+                                       RandomAccessIterator3 result,
+                                       T init,
+                                       BinaryOperation op)
+{
+  if(offsets_last - offsets_first < 2) return result;
+
+  std::size_t num_segments = (offsets_last - offsets_first) - 1;
+  std::size_t n = offsets_first[num_segments] - offsets_first[0];
+
+  std::size_t num_agents = detail::num_agents_for(policy, n);
+  std::size_t chunk_size = detail::ceil_div<std::size_t>(n, num_agents);
+
+  auto summaries = agency::bulk_invoke(policy(num_agents), detail::segmented_reduce_detail::summarize_chunk_functor<T>(), values_first, offsets_first, num_segments, n, chunk_size, op);
+
+  // each chunk's carry is the combined contribution of the following chunks to its last segment
+  std::vector<experimental::optional<T>> carries(num_agents);
+  for(std::size_t i = num_agents - 1; i > 0; --i)
+  {
+    const auto& next = summaries[i];
+
+    if(!next.has_segment_begin && carries[i])
+    {
+      // no segment begins in the next chunk, so the segment continues through it
+      if(next.leading_partial_sum)
+      {
+        carries[i-1] = T(op(*next.leading_partial_sum, *carries[i]));
+      }
+      else
+      {
+        carries[i-1] = carries[i];
+      }
+    }
+    else
+    {
+      carries[i-1] = next.leading_partial_sum;
+    }
+  }
+
+  const experimental::optional<T>* carries_ptr = carries.data();
+
+  agency::bulk_invoke(policy(num_agents), detail::segmented_reduce_detail::reduce_chunk_functor(), values_first, offsets_first, num_segments, n, chunk_size, num_agents, result, carries_ptr, init, op);
+
+  return result + num_segments;
+}
+
+
+/// \brief Reduces each segment of a `segmented_array` in parallel.
+///
+/// This overload of `segmented_reduce` reduces each segment of `array` where it lives: a single execution agent
+/// traverses each segment's contiguous storage and writes `init` combined with the segment's elements under `op` to `result[s]`.
+///
+/// \param policy An execution policy whose agents perform the reduction.
+/// \param array The `segmented_array` to reduce.
+/// \param result The beginning of the range receiving each segment's reduction.
+/// \param init The initial value of each segment's reduction.
+/// \param op An associative binary operation.
+/// \return The end of the output range.
+template<class ExecutionPolicy, class T, template<class> class InnerAlloc, template<class> class OuterAlloc, class RandomAccessIterator, class U, class BinaryOperation>
+RandomAccessIterator segmented_reduce(ExecutionPolicy&& policy,
+                                      const experimental::segmented_array<T,InnerAlloc,OuterAlloc>& array,
+                                      RandomAccessIterator result,
+                                      U init,
+                                      BinaryOperation op)
+{
+  std::size_t num_segments = array.segments().size();
+
+  if(num_segments == 0) return result;
+
+  agency::bulk_invoke(policy(num_segments), detail::segmented_reduce_detail::reduce_segment_functor(), array.segments_begin(), result, init, op);
+
+  return result + num_segments;
+}
+
+
+} // end agency
+
@@ -0,0 +1,329 @@
+/// \file
+/// \brief Include this file to use set_intersection(), set_union(), and set_difference().
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/detail/algorithm/merge_path.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+namespace set_operations_detail
+{
+
+
+// counting_output_iterator counts the elements written through it and discards them
+class counting_output_iterator
+{
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    struct assign_and_count
+    {
+      std::size_t* count;
+
+      template<class T>
+      void operator=(const T&)
+      {
+        ++*count;
+      }
+    };
+
+    counting_output_iterator()
+      : count_(0)
+    {}
+
+    assign_and_count operator*()
+    {
+      return assign_and_count{&count_};
+    }
+
+    counting_output_iterator& operator++()
+    {
+      return *this;
+    }
+
+    counting_output_iterator& operator++(int)
+    {
+      return *this;
+    }
+
+    std::size_t count() const
+    {
+      return count_;
+    }
+
+  private:
+    std::size_t count_;
+};
+
+
+struct set_intersection_operation
+{
+  template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+  OutputIterator operator()(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2, OutputIterator result, Compare comp) const
+  {
+    return std::set_intersection(first1, last1, first2, last2, result, comp);
+  }
+};
+
+
+struct set_union_operation
+{
+  template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+  OutputIterator operator()(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2, OutputIterator result, Compare comp) const
+  {
+    return std::set_union(first1, last1, first2, last2, result, comp);
+  }
+};
+
+
+struct set_difference_operation
+{
+  template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+  OutputIterator operator()(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2, OutputIterator result, Compare comp) const
+  {
+    return std::set_difference(first1, last1, first2, last2, result, comp);
+  }
+};
+
+
+// each agent's chunk of the two inputs lies between the balanced paths of two consecutive diagonals
+template<class RandomAccessIterator1, class RandomAccessIterator2, class Compare>
+co_rank<std::size_t,std::size_t> chunk_begin(RandomAccessIterator1 first1, std::size_t n1, RandomAccessIterator2 first2, std::size_t n2, std::size_t chunk_size, std::size_t rank, Compare comp)
+{
+  std::size_t diagonal = detail::min(n1 + n2, chunk_size * rank);
+
+  return detail::balanced_path(first1, n1, first2, n2, diagonal, comp);
+}
+
+
+struct count_chunk_functor
+{
+  template<class Agent, class RandomAccessIterator1, class RandomAccessIterator2, class SetOperation, class Compare>
+  std::size_t operator()(Agent& self,
+                         RandomAccessIterator1 first1, std::size_t n1,
+                         RandomAccessIterator2 first2, std::size_t n2,
+                         std::size_t chunk_size,
+                         SetOperation set_operation,
+                         Compare comp)
+  {
+    auto begin = chunk_begin(first1, n1, first2, n2, chunk_size, self.rank(), comp);
+    auto end   = chunk_begin(first1, n1, first2, n2, chunk_size, self.rank() + 1, comp);
+
+    return set_operation(first1 + begin.first, first1 + end.first,
+                         first2 + begin.second, first2 + end.second,
+                         counting_output_iterator(),
+                         comp).count();
+  }
+};
+
+
+struct write_chunk_functor
+{
+  template<class Agent, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class SetOperation, class Compare>
+  void operator()(Agent& self,
+                  RandomAccessIterator1 first1, std::size_t n1,
+                  RandomAccessIterator2 first2, std::size_t n2,
+                  std::size_t chunk_size,
+                  const std::size_t* output_offsets,
+                  RandomAccessIterator3 result,
+                  SetOperation set_operation,
+                  Compare comp)
+  {
+    auto begin = chunk_begin(first1, n1, first2, n2, chunk_size, self.rank(), comp);
+    auto end   = chunk_begin(first1, n1, first2, n2, chunk_size, self.rank() + 1, comp);
+
+    set_operation(first1 + begin.first, first1 + end.first,
+                  first2 + begin.second, first2 + end.second,
+                  result + output_offsets[self.rank()],
+                  comp);
+  }
+};
+
+
+// set_operation() partitions the inputs among the policy's agents along the balanced path,
+// counts each chunk's output, and then writes each chunk's output at its offset
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class SetOperation, class Compare>
+RandomAccessIterator3 set_operation(ExecutionPolicy&& policy,
+                                    RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                    RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                                    RandomAccessIterator3 result,
+                                    SetOperation set_operation,
+                                    Compare comp)
+{
+  std::size_t n1 = last1 - first1;
+  std::size_t n2 = last2 - first2;
+
+  std::size_t num_agents = detail::num_agents_for(policy, n1 + n2);
+
+  if(num_agents == 1)
+  {
+    return set_operation(first1, last1, first2, last2, result, comp);
+  }
+
+  std::size_t chunk_size = detail::ceil_div(n1 + n2, num_agents);
+
+  auto counts = agency::bulk_invoke(policy(num_agents), count_chunk_functor(), first1, n1, first2, n2, chunk_size, set_operation, comp);
+
+  // scan the chunks' output sizes into their offsets
+  std::vector<std::size_t> output_offsets(num_agents);
+  std::size_t output_size = 0;
+  for(std::size_t i = 0; i < num_agents; ++i)
+  {
+    output_offsets[i] = output_size;
+    output_size += counts[i];
+  }
+
+  const std::size_t* output_offsets_ptr = output_offsets.data();
+
+  agency::bulk_invoke(policy(num_agents), write_chunk_functor(), first1, n1, first2, n2, chunk_size, output_offsets_ptr, result, set_operation, comp);
+
+  return result + output_size;
+}
+
+
+} // end set_operations_detail
+} // end detail
+
+
+/// \brief Computes the intersection of two sorted ranges in parallel.
+///
+/// `set_intersection` writes the elements of `[first1, last1)` which are also found in `[first2, last2)` to `result`, in order.
+/// Like `std::set_intersection`, if an element is found `m` times in the first range and `n` times in the second range,
+/// the first `min(m, n)` of its occurrences in the first range are written.
+///
+/// The merged inputs are divided evenly among the policy's execution agents along a balanced path: a merge path which never
+/// separates the `k`th occurrence of an element in the first range from its `k`th occurrence in the second. Each agent counts its
+/// chunk's output, and then, after the counts are scanned, writes its chunk's output at its offset.
+///
+/// \param policy An execution policy whose agents perform the intersection.
+/// \param first1 The beginning of the first sorted range.
+/// \param last1 The end of the first sorted range.
+/// \param first2 The beginning of the second sorted range.
+/// \param last2 The end of the second sorted range.
+/// \param result The beginning of the output range.
+/// \param comp A strict weak ordering by which both ranges are sorted.
+/// \return The end of the output range.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class Compare>
+RandomAccessIterator3 set_intersection(ExecutionPolicy&& policy,
+                                       RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                       RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                                       RandomAccessIterator3 result,
+                                       Compare comp)
+{
+  return detail::set_operations_detail::set_operation(policy, first1, last1, first2, last2, result, detail::set_operations_detail::set_intersection_operation(), comp);
+}
+
+
+/// \brief Computes the intersection of two sorted ranges in parallel using `operator<`.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3>
+RandomAccessIterator3 set_intersection(ExecutionPolicy&& policy,
+                                       RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                       RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                                       RandomAccessIterator3 result)
+{
+  using value_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
+
+  return agency::set_intersection(std::forward<ExecutionPolicy>(policy), first1, last1, first2, last2, result, std::less<value_type>());
+}
+
+
+/// \brief Computes the union of two sorted ranges in parallel.
+///
+/// `set_union` writes the elements found in either `[first1, last1)` or `[first2, last2)` to `result`, in order.
+/// Like `std::set_union`, if an element is found `m` times in the first range and `n` times in the second range,
+/// all `m` of its occurrences in the first range are written, followed by the last `max(n - m, 0)` of its occurrences in the second.
+///
+/// The inputs are partitioned among the policy's agents like `set_intersection`.
+///
+/// \param policy An execution policy whose agents perform the union.
+/// \param first1 The beginning of the first sorted range.
+/// \param last1 The end of the first sorted range.
+/// \param first2 The beginning of the second sorted range.
+/// \param last2 The end of the second sorted range.
+/// \param result The beginning of the output range.
+/// \param comp A strict weak ordering by which both ranges are sorted.
+/// \return The end of the output range.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class Compare>
+RandomAccessIterator3 set_union(ExecutionPolicy&& policy,
+                                RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                                RandomAccessIterator3 result,
+                                Compare comp)
+{
+  return detail::set_operations_detail::set_operation(policy, first1, last1, first2, last2, result, detail::set_operations_detail::set_union_operation(), comp);
+}
+
+
+/// \brief Computes the union of two sorted ranges in parallel using `operator<`.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3>
+RandomAccessIterator3 set_union(ExecutionPolicy&& policy,
+                                RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                                RandomAccessIterator3 result)
+{
+  using value_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
+
+  return agency::set_union(std::forward<ExecutionPolicy>(policy), first1, last1, first2, last2, result, std::less<value_type>());
+}
+
+
+/// \brief Computes the difference of two sorted ranges in parallel.
+///
+/// `set_difference` writes the elements of `[first1, last1)` which are not found in `[first2, last2)` to `result`, in order.
+/// Like `std::set_difference`, if an element is found `m` times in the first range and `n` times in the second range,
+/// the last `max(m - n, 0)` of its occurrences in the first range are written.
+///
+/// The inputs are partitioned among the policy's agents like `set_intersection`.
+///
+/// \param policy An execution policy whose agents perform the difference.
+/// \param first1 The beginning of the first sorted range.
+/// \param last1 The end of the first sorted range.
+/// \param first2 The beginning of the second sorted range.
+/// \param last2 The end of the second sorted range.
+/// \param result The beginning of the output range.
+/// \param comp A strict weak ordering by which both ranges are sorted.
+/// \return The end of the output range.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3, class Compare>
+RandomAccessIterator3 set_difference(ExecutionPolicy&& policy,
+                                     RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                     RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                                     RandomAccessIterator3 result,
+                                     Compare comp)
+{
+  return detail::set_operations_detail::set_operation(policy, first1, last1, first2, last2, result, detail::set_operations_detail::set_difference_operation(), comp);
+}
+
+
+/// \brief Computes the difference of two sorted ranges in parallel using `operator<`.
+template<class ExecutionPolicy, class RandomAccessIterator1, class RandomAccessIterator2, class RandomAccessIterator3>
+RandomAccessIterator3 set_difference(ExecutionPolicy&& policy,
+                                     RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                                     RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                                     RandomAccessIterator3 result)
+{
+  using value_type = typename std::iterator_traits<RandomAccessIterator1>::value_type;
+
+  return agency::set_difference(std::forward<ExecutionPolicy>(policy), first1, last1, first2, last2, result, std::less<value_type>());
+}
+
+
+} // end agency
+
@@ -0,0 +1,132 @@
+/// \file
+/// \brief Include this file to use top_k().
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/algorithm/merge.hpp>
+#include <agency/algorithm/partial_sort.hpp>
+#include <agency/container/vector.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <agency/experimental/span.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+namespace top_k_detail
+{
+
+
+template<class Range>
+using range_value_t = typename std::iterator_traits<decltype(std::begin(std::declval<const Range&>()))>::value_type;
+
+
+// each agent selects the best elements of its chunk through a bounded heap
+// and writes them, sorted, to its own region of region_size candidates
+struct select_candidates_functor
+{
+  template<class Agent, class RandomAccessIterator, class T, class Compare>
+  std::size_t operator()(Agent& self, RandomAccessIterator first, std::size_t n, std::size_t chunk_size, std::size_t region_size, T* candidates, Compare comp)
+  {
+    std::size_t begin = detail::min(n, chunk_size * self.rank());
+    std::size_t end   = detail::min(n, begin + chunk_size);
+
+    T* candidates_begin = candidates + self.rank() * region_size;
+
+    return std::partial_sort_copy(first + begin, first + end, candidates_begin, candidates_begin + region_size, comp) - candidates_begin;
+  }
+};
+
+
+} // end top_k_detail
+} // end detail
+
+
+/// \brief Selects the first `k` elements of a range in the order given by a comparison, in parallel.
+///
+/// `top_k` returns a `vector` of the `k` elements of `range` which would come first if `range` were sorted by `comp`, in that order.
+/// If `range` has fewer than `k` elements, all of them are returned. `range` itself is not modified.
+///
+/// Each of the policy's agents keeps a bounded heap of the best `k` elements of its chunk of the input. The agents' sorted candidates
+/// are then combined with a parallel multiway merge which produces only the first `k` merged elements, so the input is never sorted.
+/// When `k` exceeds half of the input, the heaps would retain most of it, so a copy of the input is instead partially sorted with `partial_sort`.
+///
+/// \param policy An execution policy whose agents perform the selection.
+/// \param range A range with random access iterators.
+/// \param k The number of elements to select.
+/// \param comp A strict weak ordering.
+/// \return A `vector` of the selected elements.
+template<class ExecutionPolicy, class Range, class Compare>
+vector<detail::top_k_detail::range_value_t<Range>>
+  top_k(ExecutionPolicy&& policy, const Range& range, std::size_t k, Compare comp)
+{
+  using value_type = detail::top_k_detail::range_value_t<Range>;
+
+  auto first = std::begin(range);
+  std::size_t n = std::end(range) - first;
+
+  k = detail::min(k, n);
+
+  vector<value_type> result(k);
+
+  if(k == 0) return result;
+
+  if(k > n / 2)
+  {
+    std::vector<value_type> buffer(first, first + n);
+
+    agency::partial_sort(policy, buffer.begin(), buffer.begin() + k, buffer.end(), comp);
+
+    std::move(buffer.begin(), buffer.begin() + k, result.begin());
+
+    return result;
+  }
+
+  std::size_t num_agents = detail::num_agents_for(policy, n);
+  std::size_t chunk_size = detail::ceil_div(n, num_agents);
+
+  // no agent contributes more candidates than the elements of its chunk, so the candidates never outnumber the input
+  std::size_t region_size = detail::min(k, chunk_size);
+
+  std::vector<value_type> candidates(num_agents * region_size);
+  value_type* candidates_ptr = candidates.data();
+
+  auto num_candidates = agency::bulk_invoke(policy(num_agents), detail::top_k_detail::select_candidates_functor(), first, n, chunk_size, region_size, candidates_ptr, comp);
+
+  std::vector<experimental::span<value_type>> sorted_candidates;
+  for(std::size_t i = 0; i < num_agents; ++i)
+  {
+    sorted_candidates.emplace_back(candidates_ptr + i * region_size, num_candidates[i]);
+  }
+
+  detail::merge_detail::multiway_merge_n(policy, sorted_candidates, k, result.begin(), comp);
+
+  return result;
+}
+
+
+/// \brief Selects the `k` largest elements of a range in parallel.
+///
+/// This overload of `top_k` returns the `k` largest elements of `range` in descending order.
+template<class ExecutionPolicy, class Range>
+vector<detail::top_k_detail::range_value_t<Range>>
+  top_k(ExecutionPolicy&& policy, const Range& range, std::size_t k)
+{
+  using value_type = detail::top_k_detail::range_value_t<Range>;
+
+  return agency::top_k(std::forward<ExecutionPolicy>(policy), range, k, std::greater<value_type>());
+}
+
+
+} // end agency
+
@@ -0,0 +1,14 @@
+/// \file
+/// \brief Include this file to use any component of Agency which requires C++20 coroutines.
+///
+/// Including `<agency/coroutine.hpp>` recursively includes the header files organized beneath `<agency/coroutine/*>`.
+/// These provide `agency::task`, a coroutine type which executes on an executor, and `agency::future_awaiter`, which allows
+/// Futures to be `co_await`ed.
+///
+
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/coroutine/future_awaiter.hpp>
+#include <agency/coroutine/task.hpp>
+
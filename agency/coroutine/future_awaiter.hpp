@@ -0,0 +1,184 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+
+#ifndef __AGENCY_HAS_COROUTINES
+#error "<agency/coroutine/future_awaiter.hpp> requires C++20 coroutines (typically enabled with -std=c++20)."
+#endif
+
+#include <agency/detail/requires.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/future.hpp>
+#include <agency/future/always_ready_future.hpp>
+#include <agency/future/variant_future.hpp>
+#include <agency/future/detail/is_ready.hpp>
+#include <agency/future/detail/future_poller.hpp>
+
+#include <coroutine>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace agency
+{
+namespace detail
+{
+namespace future_awaiter_detail
+{
+
+
+template<class T>
+struct has_schedule_impl
+{
+  template<class Promise,
+           class = decltype(std::declval<Promise&>().schedule(std::declval<std::coroutine_handle<>>()))
+          >
+  static std::true_type test(int);
+
+  template<class>
+  static std::false_type test(...);
+
+  using type = decltype(test<T>(0));
+};
+
+
+template<class T>
+using has_schedule = typename has_schedule_impl<T>::type;
+
+
+// a coroutine whose promise has a .schedule() member, such as agency::task, chooses where it is resumed
+template<class Promise,
+         __AGENCY_REQUIRES(has_schedule<Promise>::value)
+        >
+void resume(std::coroutine_handle<Promise> coro)
+{
+  coro.promise().schedule(coro);
+}
+
+
+// other coroutines are resumed on the thread which observes the awaited future become ready
+template<class Promise,
+         __AGENCY_REQUIRES(!has_schedule<Promise>::value)
+        >
+void resume(std::coroutine_handle<Promise> coro)
+{
+  coro.resume();
+}
+
+
+template<class Future, class Promise>
+struct pending_resume : future_poller::pending
+{
+  Future& future;
+  std::coroutine_handle<Promise> coro;
+
+  pending_resume(Future& f, std::coroutine_handle<Promise> c)
+    : future(f), coro(c)
+  {}
+
+  bool is_ready()
+  {
+    return detail::is_ready(future);
+  }
+
+  void complete()
+  {
+    future_awaiter_detail::resume(coro);
+  }
+};
+
+
+} // end future_awaiter_detail
+} // end detail
+
+
+/// \brief `future_awaiter` adapts a Future for use with `co_await`.
+///
+/// `co_await`ing a `future_awaiter` suspends the awaiting coroutine until its future becomes ready, without blocking the
+/// awaiting thread, and then yields the future's result. If the future is already ready, as an `always_ready_future` always
+/// is, the awaiting coroutine is not suspended at all.
+///
+/// Because most futures cannot notify their client when they become ready, a suspended coroutine's future is polled
+/// by a single background thread. A coroutine whose promise has a `.schedule(coroutine_handle)` member, such as
+/// `agency::task`'s, is resumed by that member. Other coroutines are resumed on the polling thread.
+///
+/// Futures which provide no means of querying their readiness are treated as ready, and are waited on by `await_resume()`.
+///
+/// \tparam Future The type of Future to adapt.
+template<class Future>
+class future_awaiter
+{
+  public:
+    using value_type = future_value_t<Future>;
+
+    explicit future_awaiter(Future&& future)
+      : future_(std::move(future))
+    {}
+
+    bool await_ready() const
+    {
+      return detail::is_ready(future_);
+    }
+
+    template<class Promise>
+    void await_suspend(std::coroutine_handle<Promise> coro)
+    {
+      using pending_type = detail::future_awaiter_detail::pending_resume<Future,Promise>;
+
+      // note that coro may be resumed, and this object destroyed, before submit() returns
+      detail::system_future_poller().submit(std::unique_ptr<detail::future_poller::pending>(new pending_type(future_, coro)));
+    }
+
+    value_type await_resume()
+    {
+      return future_.get();
+    }
+
+  private:
+    Future future_;
+};
+
+
+/// \brief Returns a `future_awaiter` which consumes the given future.
+///
+/// `make_awaitable()` allows futures which do not belong to Agency, such as `std::future`, to be `co_await`ed.
+template<class Future,
+         __AGENCY_REQUIRES(is_future<detail::decay_t<Future>>::value)
+        >
+future_awaiter<detail::decay_t<Future>> make_awaitable(Future&& future)
+{
+  return future_awaiter<detail::decay_t<Future>>(std::move(future));
+}
+
+
+// always_ready_future and variant_future are awaitable directly
+// co_await consumes the future, as does .get()
+
+template<class T>
+future_awaiter<always_ready_future<T>> operator co_await(always_ready_future<T>&& future)
+{
+  return future_awaiter<always_ready_future<T>>(std::move(future));
+}
+
+template<class T>
+future_awaiter<always_ready_future<T>> operator co_await(always_ready_future<T>& future)
+{
+  return future_awaiter<always_ready_future<T>>(std::move(future));
+}
+
+
+template<class Future, class... Futures>
+future_awaiter<variant_future<Future,Futures...>> operator co_await(variant_future<Future,Futures...>&& future)
+{
+  return future_awaiter<variant_future<Future,Futures...>>(std::move(future));
+}
+
+template<class Future, class... Futures>
+future_awaiter<variant_future<Future,Futures...>> operator co_await(variant_future<Future,Futures...>& future)
+{
+  return future_awaiter<variant_future<Future,Futures...>>(std::move(future));
+}
+
+
+} // end agency
+
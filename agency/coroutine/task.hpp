@@ -0,0 +1,475 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+
+#ifndef __AGENCY_HAS_COROUTINES
+#error "<agency/coroutine/task.hpp> requires C++20 coroutines (typically enabled with -std=c++20)."
+#endif
+
+#include <agency/detail/requires.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/detail/concurrency/latch.hpp>
+#include <agency/detail/concurrency/thread_pool.hpp>
+#include <agency/async.hpp>
+#include <agency/experimental/optional.hpp>
+#include <agency/future.hpp>
+#include <agency/coroutine/future_awaiter.hpp>
+#include <agency/future/detail/future_poller.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <future>
+#include <type_traits>
+#include <utility>
+
+namespace agency
+{
+
+
+template<class T>
+class task;
+
+
+namespace detail
+{
+namespace task_detail
+{
+
+
+template<class T>
+struct is_task : std::false_type {};
+
+template<class T>
+struct is_task<task<T>> : std::true_type {};
+
+
+struct resume_coroutine
+{
+  std::coroutine_handle<> coro;
+
+  void operator()() const
+  {
+    coro.resume();
+  }
+};
+
+
+// resumes a coroutine by submitting it to an executor
+template<class Executor>
+struct schedule_on_executor
+{
+  Executor exec;
+
+  void operator()(std::coroutine_handle<> coro)
+  {
+    // the future returned by async() may block in its destructor, so hand it off rather than destroying it here
+    detail::discard_when_ready(agency::async(exec, resume_coroutine{coro}));
+  }
+};
+
+
+class task_promise_base
+{
+  public:
+    task_promise_base()
+      : scheduler_(schedule_on_executor<thread_pool_executor>{thread_pool_executor()}),
+        waiter_(nullptr),
+        done_(false)
+    {}
+
+    std::suspend_always initial_suspend() noexcept
+    {
+      return {};
+    }
+
+    struct final_awaiter
+    {
+      bool await_ready() noexcept
+      {
+        return false;
+      }
+
+      template<class Promise>
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> coro) noexcept
+      {
+        return coro.promise().complete();
+      }
+
+      void await_resume() noexcept {}
+    };
+
+    final_awaiter final_suspend() noexcept
+    {
+      return {};
+    }
+
+    void unhandled_exception()
+    {
+      exception_ = std::current_exception();
+    }
+
+    // futures are awaited without blocking
+    template<class Future,
+             __AGENCY_REQUIRES(
+               is_future<decay_t<Future>>::value &&
+               !is_task<decay_t<Future>>::value
+             )>
+    future_awaiter<decay_t<Future>> await_transform(Future&& future)
+    {
+      return future_awaiter<decay_t<Future>>(std::move(future));
+    }
+
+    // other awaitables are awaited as usual
+    template<class Awaitable,
+             __AGENCY_REQUIRES(
+               !is_future<decay_t<Awaitable>>::value ||
+               is_task<decay_t<Awaitable>>::value
+             )>
+    Awaitable&& await_transform(Awaitable&& awaitable)
+    {
+      return std::forward<Awaitable>(awaitable);
+    }
+
+    // resumes coro, which is this promise's coroutine, on this promise's executor
+    void schedule(std::coroutine_handle<> coro)
+    {
+      // coro may resume and replace scheduler_ before the scheduler returns, so invoke a copy
+      auto scheduler = scheduler_;
+      scheduler(coro);
+    }
+
+    template<class Executor>
+    void set_executor(const Executor& exec)
+    {
+      scheduler_ = schedule_on_executor<Executor>{exec};
+    }
+
+    void set_scheduler(const task_promise_base& other)
+    {
+      scheduler_ = other.scheduler_;
+    }
+
+    void set_continuation(std::coroutine_handle<> continuation)
+    {
+      continuation_ = continuation;
+    }
+
+    void set_waiter(latch* waiter)
+    {
+      waiter_ = waiter;
+    }
+
+    bool is_ready() const
+    {
+      return done_.load(std::memory_order_acquire);
+    }
+
+  protected:
+    void rethrow_if_exception()
+    {
+      if(exception_)
+      {
+        std::rethrow_exception(exception_);
+      }
+    }
+
+  private:
+    // returns the coroutine to resume now that this promise's coroutine is complete
+    std::coroutine_handle<> complete() noexcept
+    {
+      std::coroutine_handle<> continuation = continuation_;
+      latch* waiter = waiter_;
+
+      done_.store(true, std::memory_order_release);
+
+      if(waiter)
+      {
+        // the waiter may destroy this coroutine as soon as it is released, so this is the last access of this object
+        waiter->count_down(1);
+      }
+
+      return continuation ? continuation : std::noop_coroutine();
+    }
+
+    std::function<void(std::coroutine_handle<>)> scheduler_;
+    std::coroutine_handle<> continuation_;
+    latch* waiter_;
+    std::atomic<bool> done_;
+    std::exception_ptr exception_;
+};
+
+
+template<class T>
+class task_promise : public task_promise_base
+{
+  public:
+    task<T> get_return_object();
+
+    template<class U,
+             __AGENCY_REQUIRES(std::is_constructible<T,U&&>::value)
+            >
+    void return_value(U&& value)
+    {
+      value_.emplace(std::forward<U>(value));
+    }
+
+    T result()
+    {
+      rethrow_if_exception();
+      return std::move(*value_);
+    }
+
+  private:
+    experimental::optional<T> value_;
+};
+
+
+template<>
+class task_promise<void> : public task_promise_base
+{
+  public:
+    task<void> get_return_object();
+
+    void return_void() {}
+
+    void result()
+    {
+      rethrow_if_exception();
+    }
+};
+
+
+template<class Executor>
+class resume_on_awaiter
+{
+  public:
+    explicit resume_on_awaiter(const Executor& exec)
+      : exec_(exec)
+    {}
+
+    bool await_ready() const
+    {
+      return false;
+    }
+
+    template<class Promise,
+             __AGENCY_REQUIRES(std::is_base_of<task_promise_base, Promise>::value)
+            >
+    void await_suspend(std::coroutine_handle<Promise> coro)
+    {
+      // the task continues to resume on exec after its subsequent suspensions
+      coro.promise().set_executor(exec_);
+      coro.promise().schedule(coro);
+    }
+
+    template<class Promise,
+             __AGENCY_REQUIRES(!std::is_base_of<task_promise_base, Promise>::value)
+            >
+    void await_suspend(std::coroutine_handle<Promise> coro)
+    {
+      schedule_on_executor<Executor> scheduler{exec_};
+      scheduler(coro);
+    }
+
+    void await_resume() {}
+
+  private:
+    Executor exec_;
+};
+
+
+} // end task_detail
+} // end detail
+
+
+/// \brief `task` is the type of a coroutine which executes asynchronously on an executor.
+///
+/// A `task` does not begin executing until it is either `co_await`ed by another coroutine or waited on by `.wait()` or `.get()`.
+/// It begins executing on the thread which starts it. Within a `task`, `co_await` accepts any Future, including those returned
+/// by `bulk_async()` and `bulk_then()`. Awaiting a Future which is not yet ready suspends the `task` without blocking its thread,
+/// and the `task` is resumed on its executor once the Future becomes ready. Awaiting a Future which is already ready, such as
+/// an `always_ready_future`, does not suspend the `task`.
+///
+/// A `task`'s executor is the system thread pool by default. `co_await resume_on(exec)` transfers the `task` to `exec` and makes
+/// `exec` the `task`'s executor from then on. A `task` started by another `task` inherits its executor.
+///
+/// A `task` must not be destroyed while it is executing.
+///
+/// \tparam T The type of the result of the `task`'s coroutine.
+template<class T>
+class task
+{
+  public:
+    using promise_type = detail::task_detail::task_promise<T>;
+
+    using value_type = T;
+
+    task()
+      : coro_(),
+        started_(false)
+    {}
+
+    task(task&& other)
+      : coro_(other.coro_),
+        started_(other.started_)
+    {
+      other.coro_ = nullptr;
+    }
+
+    task& operator=(task&& other)
+    {
+      if(this != &other)
+      {
+        if(coro_) coro_.destroy();
+
+        coro_ = other.coro_;
+        started_ = other.started_;
+        other.coro_ = nullptr;
+      }
+
+      return *this;
+    }
+
+    ~task()
+    {
+      if(coro_) coro_.destroy();
+    }
+
+    bool valid() const
+    {
+      return static_cast<bool>(coro_);
+    }
+
+    bool is_ready() const
+    {
+      return valid() && coro_.promise().is_ready();
+    }
+
+    /// \brief Starts this `task` if it has not already been started, and blocks the calling thread until it completes.
+    void wait()
+    {
+      if(!valid())
+      {
+        throw std::future_error(std::future_errc::no_state);
+      }
+
+      if(!started_)
+      {
+        started_ = true;
+
+        detail::latch waiter(1);
+        coro_.promise().set_waiter(&waiter);
+        coro_.resume();
+        waiter.wait();
+      }
+    }
+
+    /// \brief Waits for this `task` to complete and returns its result, invalidating this `task`.
+    T get()
+    {
+      wait();
+
+      task consumed = std::move(*this);
+      return consumed.coro_.promise().result();
+    }
+
+  private:
+    friend promise_type;
+
+    explicit task(std::coroutine_handle<promise_type> coro)
+      : coro_(coro),
+        started_(false)
+    {}
+
+    struct awaiter
+    {
+      std::coroutine_handle<promise_type> coro;
+
+      bool await_ready() const
+      {
+        return coro.promise().is_ready();
+      }
+
+      template<class Promise>
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> awaiting)
+      {
+        inherit_scheduler(awaiting.promise());
+        coro.promise().set_continuation(awaiting);
+
+        // start this task by transferring control to it
+        return coro;
+      }
+
+      T await_resume()
+      {
+        return coro.promise().result();
+      }
+
+      template<class Promise,
+               __AGENCY_REQUIRES(std::is_base_of<detail::task_detail::task_promise_base, Promise>::value)
+              >
+      void inherit_scheduler(Promise& awaiting_promise)
+      {
+        coro.promise().set_scheduler(awaiting_promise);
+      }
+
+      template<class Promise,
+               __AGENCY_REQUIRES(!std::is_base_of<detail::task_detail::task_promise_base, Promise>::value)
+              >
+      void inherit_scheduler(Promise&) {}
+    };
+
+  public:
+    /// \brief Starts this `task` and suspends the awaiting coroutine until it completes.
+    ///
+    /// The awaiting coroutine resumes on the thread which completes this `task`.
+    awaiter operator co_await()
+    {
+      started_ = true;
+      return awaiter{coro_};
+    }
+
+  private:
+    std::coroutine_handle<promise_type> coro_;
+    bool started_;
+};
+
+
+namespace detail
+{
+namespace task_detail
+{
+
+
+template<class T>
+task<T> task_promise<T>::get_return_object()
+{
+  return task<T>(std::coroutine_handle<task_promise<T>>::from_promise(*this));
+}
+
+
+inline task<void> task_promise<void>::get_return_object()
+{
+  return task<void>(std::coroutine_handle<task_promise<void>>::from_promise(*this));
+}
+
+
+} // end task_detail
+} // end detail
+
+
+/// \brief Returns an awaitable which transfers the awaiting coroutine to the given executor.
+///
+/// When the awaiting coroutine is an `agency::task`, `exec` also becomes the executor on which the `task` is resumed after
+/// each of its subsequent suspensions.
+template<class Executor>
+detail::task_detail::resume_on_awaiter<Executor> resume_on(const Executor& exec)
+{
+  return detail::task_detail::resume_on_awaiter<Executor>(exec);
+}
+
+
+} // end agency
+
@@ -5,7 +5,11 @@
 #include <agency/detail/algorithm/copy.hpp>
 #include <agency/detail/algorithm/destroy.hpp>
 #include <agency/detail/algorithm/equal.hpp>
+#include <agency/detail/algorithm/lower_bound.hpp>
 #include <agency/detail/algorithm/max.hpp>
+#include <agency/detail/algorithm/merge_path.hpp>
 #include <agency/detail/algorithm/min.hpp>
 #include <agency/detail/algorithm/move.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <agency/detail/algorithm/upper_bound.hpp>
 
@@ -6,6 +6,7 @@
 #include <agency/execution/execution_policy/detail/simple_sequenced_policy.hpp>
 #include <agency/detail/type_traits.hpp>
 #include <agency/detail/iterator/iterator_traits.hpp>
+#include <agency/detail/iterator/unwrap_contiguous_iterator.hpp>
 #include <cassert>
 #include <cstdio>
 
@@ -56,7 +57,10 @@ template<class ExecutionPolicy, class RandomAccessIterator, class Size, class...
 __AGENCY_ANNOTATION
 RandomAccessIterator construct_n(ExecutionPolicy&& policy, RandomAccessIterator first, Size n, RandomAccessIterators... iters)
 {
-  agency::bulk_invoke(policy(n), construct_n_detail::construct_n_functor(), first, iters...);
+  if(n == 0) return first;
+
+  // unwrap contiguous iterators so that each agent indexes pointers
+  agency::bulk_invoke(policy(n), construct_n_detail::construct_n_functor(), detail::unwrap_contiguous_iterator(first), detail::unwrap_contiguous_iterator(iters)...);
 
   return first + n;
 }
@@ -7,6 +7,7 @@
 #include <agency/execution/execution_policy.hpp>
 #include <agency/detail/type_traits.hpp>
 #include <agency/detail/iterator/iterator_traits.hpp>
+#include <agency/detail/iterator/unwrap_contiguous_iterator.hpp>
 #include <agency/tuple.hpp>
 
 namespace agency
@@ -59,8 +60,11 @@ template<class ExecutionPolicy, class RandomAccessIterator1, class Size, class R
 __AGENCY_ANNOTATION
 tuple<RandomAccessIterator1,RandomAccessIterator2> default_copy_n(ExecutionPolicy&& policy, RandomAccessIterator1 first, Size n, RandomAccessIterator2 result)
 {
-  agency::bulk_invoke(policy(n), default_copy_n_detail::copy_n_functor(), first, result);
-  
+  if(n == 0) return agency::make_tuple(first, result);
+
+  // unwrap contiguous iterators so that each agent indexes pointers
+  agency::bulk_invoke(policy(n), default_copy_n_detail::copy_n_functor(), detail::unwrap_contiguous_iterator(first), detail::unwrap_contiguous_iterator(result));
+
   return agency::make_tuple(first + n, result + n);
 }
 
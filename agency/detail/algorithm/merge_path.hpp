@@ -0,0 +1,185 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/algorithm/lower_bound.hpp>
+#include <agency/detail/algorithm/max.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/upper_bound.hpp>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+
+
+// merge_path() returns the co-rank of diagonal within the merge of [first1, first1 + n1) and [first2, first2 + n2)
+// i.e., the number of elements of the first range which precede the diagonal-th element of the stable merge
+// the number of elements of the second range which precede it is diagonal - merge_path(...)
+__agency_exec_check_disable__
+template<class RandomAccessIterator1, class Size1, class RandomAccessIterator2, class Size2, class Compare>
+__AGENCY_ANNOTATION
+Size1 merge_path(RandomAccessIterator1 first1, Size1 n1, RandomAccessIterator2 first2, Size2 n2, Size1 diagonal, Compare comp)
+{
+  Size1 lo = diagonal > Size1(n2) ? diagonal - Size1(n2) : Size1(0);
+  Size1 hi = detail::min(diagonal, n1);
+
+  while(lo < hi)
+  {
+    Size1 mid = lo + (hi - lo) / 2;
+
+    // ties are broken in favor of the first range, so the merge is stable
+    if(comp(first2[diagonal - 1 - mid], first1[mid]))
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
+  }
+
+  return lo;
+}
+
+
+// a co_rank locates a split of two ranges: the number of elements of each range which precede it
+template<class Size1, class Size2>
+struct co_rank
+{
+  Size1 first;
+  Size2 second;
+};
+
+
+// balance_equivalents() moves the split (i, j) of the merge of [first1, first1 + n1) and [first2, first2 + n2)
+// so that it does not separate the kth element equivalent to value in the first range from the kth such element of the second
+// value is the element which follows the split in the stable merge
+__agency_exec_check_disable__
+template<class RandomAccessIterator1, class Size1, class RandomAccessIterator2, class Size2, class T, class Compare>
+__AGENCY_ANNOTATION
+co_rank<Size1,Size2> balance_equivalents(RandomAccessIterator1 first1, Size1 n1, RandomAccessIterator2 first2, Size2 n2, Size1 i, Size2 j, const T& value, Compare comp)
+{
+  // find the runs of elements equivalent to value in each range
+  Size1 begin1 = detail::lower_bound_n(first1, i, value, comp);
+  Size1 end1   = i + detail::upper_bound_n(first1 + i, n1 - i, value, comp);
+  Size2 begin2 = detail::lower_bound_n(first2, j, value, comp);
+  Size2 end2   = j + detail::upper_bound_n(first2 + j, n2 - j, value, comp);
+
+  // the number of the runs' elements which precede the split
+  std::size_t r = (i - begin1) + (j - begin2);
+
+  // order the runs' elements so that each pair of kth elements is adjacent, followed by the leftovers of the longer run
+  // a split between the elements of a pair is moved past the pair
+  std::size_t num_pairs = detail::min<std::size_t>(end1 - begin1, end2 - begin2);
+
+  std::size_t a = 0, b = 0;
+  if(r < 2 * num_pairs)
+  {
+    a = b = (r + 1) / 2;
+  }
+  else
+  {
+    a = std::size_t(end1 - begin1) > num_pairs ? r - num_pairs : num_pairs;
+    b = std::size_t(end2 - begin2) > num_pairs ? r - num_pairs : num_pairs;
+  }
+
+  return co_rank<Size1,Size2>{Size1(begin1 + a), Size2(begin2 + b)};
+}
+
+
+// balanced_path() is like merge_path() except that it never separates the kth of a group of equivalent elements
+// of the first range from the kth of the second range, which is the pairing used by set operations
+// so, the returned split may include one element beyond the diagonal
+__agency_exec_check_disable__
+template<class RandomAccessIterator1, class Size1, class RandomAccessIterator2, class Size2, class Compare>
+__AGENCY_ANNOTATION
+co_rank<Size1,Size2> balanced_path(RandomAccessIterator1 first1, Size1 n1, RandomAccessIterator2 first2, Size2 n2, Size1 diagonal, Compare comp)
+{
+  Size1 i = detail::merge_path(first1, n1, first2, n2, diagonal, comp);
+  Size2 j = Size2(diagonal - i);
+
+  if(i == n1 && j == n2)
+  {
+    return co_rank<Size1,Size2>{i, j};
+  }
+
+  // balance the equivalents of the element which follows the split
+  if(i < n1 && (j == n2 || !comp(first2[j], first1[i])))
+  {
+    return detail::balance_equivalents(first1, n1, first2, n2, i, j, first1[i], comp);
+  }
+
+  return detail::balance_equivalents(first1, n1, first2, n2, i, j, first2[j], comp);
+}
+
+
+// serial_merge_n() merges n elements of the ranges beginning at first1 and first2 into result
+// it stops reading from the first range at last1 and from the second range at last2
+__agency_exec_check_disable__
+template<class RandomAccessIterator1, class RandomAccessIterator2, class Size, class RandomAccessIterator3, class Compare>
+__AGENCY_ANNOTATION
+void serial_merge_n(RandomAccessIterator1 first1, RandomAccessIterator1 last1,
+                    RandomAccessIterator2 first2, RandomAccessIterator2 last2,
+                    Size n,
+                    RandomAccessIterator3 result,
+                    Compare comp)
+{
+  for(Size i = 0; i < n; ++i, ++result)
+  {
+    if(first2 != last2 && (first1 == last1 || comp(*first2, *first1)))
+    {
+      *result = *first2;
+      ++first2;
+    }
+    else
+    {
+      *result = *first1;
+      ++first1;
+    }
+  }
+}
+
+
+// serial_merge_by_key_n() is like serial_merge_n() except that it also
+// moves each key's associated value into values_result
+__agency_exec_check_disable__
+template<class RandomAccessIterator1, class RandomAccessIterator2,
+         class RandomAccessIterator3, class RandomAccessIterator4,
+         class Size,
+         class RandomAccessIterator5, class RandomAccessIterator6,
+         class Compare>
+__AGENCY_ANNOTATION
+void serial_merge_by_key_n(RandomAccessIterator1 keys_first1, RandomAccessIterator1 keys_last1,
+                           RandomAccessIterator2 keys_first2, RandomAccessIterator2 keys_last2,
+                           RandomAccessIterator3 values_first1,
+                           RandomAccessIterator4 values_first2,
+                           Size n,
+                           RandomAccessIterator5 keys_result,
+                           RandomAccessIterator6 values_result,
+                           Compare comp)
+{
+  for(Size i = 0; i < n; ++i, ++keys_result, ++values_result)
+  {
+    if(keys_first2 != keys_last2 && (keys_first1 == keys_last1 || comp(*keys_first2, *keys_first1)))
+    {
+      *keys_result = *keys_first2;
+      *values_result = *values_first2;
+      ++keys_first2;
+      ++values_first2;
+    }
+    else
+    {
+      *keys_result = *keys_first1;
+      *values_result = *values_first1;
+      ++keys_first1;
+      ++values_first1;
+    }
+  }
+}
+
+
+} // end detail
+} // end agency
+
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/execution/execution_policy/execution_policy_traits.hpp>
+#include <agency/execution/executor/customization_points/unit_shape.hpp>
+#include <agency/detail/algorithm/max.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <thread>
+#include <cstddef>
+
+
+namespace agency
+{
+namespace detail
+{
+
+
+// the default number of elements below which a parallel algorithm will not create another agent
+constexpr std::size_t default_min_elements_per_agent = 1 << 14;
+
+
+template<class Size>
+__AGENCY_ANNOTATION
+Size ceil_div(Size n, Size d)
+{
+  return (n + d - 1) / d;
+}
+
+
+// num_agents_for() returns the number of agents a parallel algorithm should create
+// under policy to process n elements when each agent should receive at least
+// min_elements_per_agent elements
+//
+// the result is never smaller than one nor larger than the number of threads
+// the policy's executor can run concurrently, so each agent's slice of the input
+// is as large as possible
+template<class ExecutionPolicy,
+         __AGENCY_REQUIRES(
+           policy_is_sequenced<decay_t<ExecutionPolicy>>::value
+         )>
+std::size_t num_agents_for(const ExecutionPolicy&, std::size_t, std::size_t = default_min_elements_per_agent)
+{
+  return 1;
+}
+
+
+template<class ExecutionPolicy,
+         __AGENCY_REQUIRES(
+           !policy_is_sequenced<decay_t<ExecutionPolicy>>::value
+         )>
+std::size_t num_agents_for(const ExecutionPolicy& policy, std::size_t n, std::size_t min_elements_per_agent = default_min_elements_per_agent)
+{
+  std::size_t hw_concurrency = std::thread::hardware_concurrency();
+
+  // executors which don't know their width report a unit shape of one,
+  // so fall back to the number of hardware threads in that case
+  std::size_t max_agents = detail::max<std::size_t>(agency::unit_shape(policy.executor()), hw_concurrency);
+  max_agents = detail::max<std::size_t>(max_agents, 1);
+
+  std::size_t num_agents = ceil_div<std::size_t>(n, detail::max<std::size_t>(min_elements_per_agent, 1));
+
+  return detail::max<std::size_t>(1, detail::min(num_agents, max_agents));
+}
+
+
+} // end detail
+} // end agency
+
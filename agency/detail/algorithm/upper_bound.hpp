@@ -0,0 +1,40 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+
+namespace agency
+{
+namespace detail
+{
+
+
+// upper_bound_n() returns the index of the first element of [first, first + n) which is greater than value
+__agency_exec_check_disable__
+template<class RandomAccessIterator, class Size, class T, class Compare>
+__AGENCY_ANNOTATION
+Size upper_bound_n(RandomAccessIterator first, Size n, const T& value, Compare comp)
+{
+  Size lo = 0;
+  Size hi = n;
+
+  while(lo < hi)
+  {
+    Size mid = lo + (hi - lo) / 2;
+
+    if(comp(value, first[mid]))
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
+  }
+
+  return lo;
+}
+
+
+} // end detail
+} // end agency
+
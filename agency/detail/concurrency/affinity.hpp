@@ -0,0 +1,83 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace agency
+{
+namespace detail
+{
+
+
+// restricts the calling thread to the given cpus
+// returns false if the request could not be honored, e.g. because the platform
+// offers no way to set thread affinity or because a cpu lies outside the process's cpuset
+// an empty list of cpus leaves the calling thread's affinity unchanged
+inline bool bind_this_thread(const std::vector<int>& cpus)
+{
+  if(cpus.empty()) return false;
+
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  for(int cpu : cpus)
+  {
+    if(cpu >= 0 && cpu < CPU_SETSIZE)
+    {
+      CPU_SET(cpu, &set);
+    }
+  }
+
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+
+// returns the cpus on which the calling process may run, e.g. as restricted by taskset or a container's cpuset
+// where the platform cannot report this, every cpu counted by std::thread::hardware_concurrency() is returned
+inline std::vector<int> this_process_cpus()
+{
+  std::vector<int> result;
+
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  if(sched_getaffinity(0, sizeof(set), &set) == 0)
+  {
+    for(int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+      if(CPU_ISSET(cpu, &set)) result.push_back(cpu);
+    }
+  }
+#endif
+
+  if(result.empty())
+  {
+    int num_cpus = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for(int cpu = 0; cpu < num_cpus; ++cpu)
+    {
+      result.push_back(cpu);
+    }
+  }
+
+  return result;
+}
+
+
+} // end detail
+} // end agency
+
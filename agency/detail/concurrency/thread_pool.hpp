@@ -8,6 +8,8 @@
 #include <agency/execution/executor/flattened_executor.hpp>
 #include <agency/detail/concurrency/latch.hpp>
 #include <agency/detail/concurrency/concurrent_queue.hpp>
+#include <agency/detail/concurrency/affinity.hpp>
+#include <agency/detail/concurrency/thread_pool_config.hpp>
 #include <agency/detail/unique_function.hpp>
 #include <agency/future.hpp>
 #include <agency/detail/type_traits.hpp>
@@ -17,6 +19,9 @@
 #include <algorithm>
 #include <memory>
 #include <future>
+#include <mutex>
+#include <map>
+#include <string>
 
 
 namespace agency
@@ -41,12 +46,36 @@ class thread_pool
     };
 
   public:
-    explicit thread_pool(size_t num_threads = std::max(1u, std::thread::hardware_concurrency()))
+    // creates a thread pool described by the default thread_pool_config
+    thread_pool()
+      : thread_pool(thread_pool_config())
+    {}
+
+    // creates num_threads unbound threads
+    explicit thread_pool(size_t num_threads)
+      : thread_pool(std::vector<std::vector<int>>(num_threads))
+    {}
+
+    // creates one thread per element of cpus and binds each thread to its cpu
+    // binding is best effort: a thread which cannot be bound runs wherever the operating system places it
+    explicit thread_pool(const std::vector<int>& cpus)
+      : thread_pool(pin_to_each(cpus))
+    {}
+
+    explicit thread_pool(const thread_pool_config& config)
+      : thread_pool(config.placement())
+    {}
+
+    // creates one thread per element of placement and binds each thread to the cpus of its element
+    // threads whose element is empty are not bound
+    explicit thread_pool(const std::vector<std::vector<int>>& placement)
     {
-      for(size_t i = 0; i < num_threads; ++i)
+      for(const std::vector<int>& cpus : placement)
       {
-        threads_.emplace_back([this]
+        threads_.emplace_back([this,cpus]
         {
+          if(!cpus.empty()) bind_this_thread(cpus);
+
           work();
         });
       }
@@ -108,6 +137,18 @@ class thread_pool
 
 
   private:
+    static std::vector<std::vector<int>> pin_to_each(const std::vector<int>& cpus)
+    {
+      std::vector<std::vector<int>> result;
+
+      for(int cpu : cpus)
+      {
+        result.push_back(std::vector<int>(1, cpu));
+      }
+
+      return result;
+    }
+
     inline void work()
     {
       unique_function<void()> task;
@@ -115,6 +156,10 @@ class thread_pool
       while(tasks_.wait_and_pop(task))
       {
         task();
+
+        // destroy the task now rather than when the next task arrives,
+        // so that the state it captured is released as soon as the task is complete
+        task = nullptr;
       }
     }
 
@@ -124,18 +169,99 @@ class thread_pool
 
 
 
+namespace thread_pool_detail
+{
+
+
+struct system_thread_pool_state
+{
+  std::mutex mutex;
+  bool created = false;
+  thread_pool_config config = thread_pool_config::from_environment();
+
+  // returns the configuration with which to create the system thread pool
+  // after this call, the configuration may no longer change
+  thread_pool_config freeze()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    created = true;
+    return config;
+  }
+};
+
+
+inline system_thread_pool_state& system_state()
+{
+  static system_thread_pool_state result;
+  return result;
+}
+
+
+} // end thread_pool_detail
+
+
+// replaces the configuration of the system_thread_pool(), which by default is thread_pool_config::from_environment()
+// because the pool is created on first use, this must be called before any work is submitted to it
+// returns false, and has no effect, when the pool already exists
+inline bool configure_system_thread_pool(const thread_pool_config& config)
+{
+  thread_pool_detail::system_thread_pool_state& state = thread_pool_detail::system_state();
+
+  std::lock_guard<std::mutex> lock(state.mutex);
+
+  if(state.created) return false;
+
+  state.config = config;
+  return true;
+}
+
+
 inline thread_pool& system_thread_pool()
 {
-  static thread_pool resource;
+  static thread_pool resource(thread_pool_detail::system_state().freeze());
   return resource;
 }
 
 
+// returns the thread pool with the given name, creating it from config if it does not exist yet
+// pools are never destroyed before program exit, so work in one named pool is isolated from the system_thread_pool()
+// and from other named pools
+inline std::shared_ptr<thread_pool> named_thread_pool(const std::string& name, const thread_pool_config& config = thread_pool_config())
+{
+  static std::mutex mutex;
+  static std::map<std::string, std::shared_ptr<thread_pool>> pools;
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  std::shared_ptr<thread_pool>& result = pools[name];
+
+  if(!result)
+  {
+    result = std::make_shared<thread_pool>(config);
+  }
+
+  return result;
+}
+
+
 class thread_pool_executor
 {
   public:
     using execution_category = parallel_execution_tag;
 
+    // a default-constructed thread_pool_executor submits work to the system_thread_pool()
+    thread_pool_executor() = default;
+
+    // creates a thread_pool_executor which submits work to pool and shares ownership of it
+    explicit thread_pool_executor(std::shared_ptr<thread_pool> pool)
+      : pool_(std::move(pool))
+    {}
+
+    thread_pool& pool() const
+    {
+      return pool_ ? *pool_ : system_thread_pool();
+    }
+
     template<class Function, class ResultFactory, class SharedFactory>
     result_of_t<ResultFactory()>
       bulk_sync_execute(Function f, size_t n, ResultFactory result_factory, SharedFactory shared_factory)
@@ -154,7 +280,7 @@ class thread_pool_executor
 
         for(size_t idx = 0; idx < n; ++idx)
         {
-          system_thread_pool().submit([=,&result,&shared_arg,&work_remaining] () mutable
+          pool().submit([=,&result,&shared_arg,&work_remaining] () mutable
           {
             f(idx, result, shared_arg);
 
@@ -223,7 +349,7 @@ class thread_pool_executor
       // submit n tasks to the thread pool
       for(size_t idx = 0; idx < n; ++idx)
       {
-        system_thread_pool().submit([=]() mutable
+        pool().submit([=]() mutable
         {
 // nvcc makes this lambda's constructors __host__ __device__ when
 // any of its captures' constructors are __host__ __device__. This causes nvcc
@@ -284,7 +410,7 @@ class thread_pool_executor
       // submit n tasks to the thread pool
       for(size_t idx = 0; idx < n; ++idx)
       {
-        system_thread_pool().submit([=]() mutable
+        pool().submit([=]() mutable
         {
 // nvcc makes this lambda's constructors __host__ __device__ when
 // any of its captures' constructors are __host__ __device__. This causes nvcc
@@ -312,8 +438,11 @@ class thread_pool_executor
 
     size_t unit_shape() const
     {
-      return system_thread_pool().size();
+      return pool().size();
     }
+
+  private:
+    std::shared_ptr<thread_pool> pool_;
 };
 
 
@@ -327,6 +456,16 @@ using parallel_thread_pool_executor = agency::flattened_executor<
 >;
 
 
+// returns a parallel_thread_pool_executor which submits work to pool
+// e.g., make_parallel_thread_pool_executor(named_thread_pool("io"))
+inline parallel_thread_pool_executor make_parallel_thread_pool_executor(std::shared_ptr<thread_pool> pool)
+{
+  using scoped_type = parallel_thread_pool_executor::base_executor_type;
+
+  return parallel_thread_pool_executor(scoped_type(thread_pool_executor(std::move(pool)), agency::this_thread::parallel_executor()));
+}
+
+
 // compose thread_pool_executor with other fancy executors
 // to yield a parallel_vector_thread_pool_executor
 using parallel_vector_thread_pool_executor = agency::flattened_executor<
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/concurrency/affinity.hpp>
+#include <agency/detail/concurrency/topology.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+
+namespace agency
+{
+namespace detail
+{
+
+
+namespace thread_pool_config_detail
+{
+
+
+inline bool environment_flag(const char* name, bool default_value)
+{
+  const char* value = std::getenv(name);
+
+  if(value == nullptr) return default_value;
+
+  std::string flag(value);
+  return flag == "1" || flag == "true" || flag == "TRUE" || flag == "yes" || flag == "on";
+}
+
+
+inline bool is_secondary_hardware_thread(const cpu_topology& topology, int cpu)
+{
+  for(const processing_unit& unit : topology.processing_units())
+  {
+    if(unit.cpu == cpu) return unit.smt_rank > 0;
+  }
+
+  return false;
+}
+
+
+} // end thread_pool_config_detail
+
+
+// thread_pool_config describes how many threads a thread_pool creates and where they may run
+//
+// the default configuration creates one unpinned thread for each cpu the process may use,
+// limited by the process's cgroup cpu quota, if any
+//
+// from_environment() overrides a configuration with these environment variables:
+//
+//   AGENCY_NUM_THREADS         the number of threads
+//   AGENCY_CPUS                a cpu list such as "0-3,8" naming the cpus the threads may use
+//   AGENCY_PIN_THREADS         when true, each thread is bound to a single cpu
+//   AGENCY_IDLE_SMT_SIBLINGS   when true, only the first hardware thread of each core is used
+struct thread_pool_config
+{
+  // the number of threads; 0 chooses one thread per usable cpu
+  std::size_t num_threads;
+
+  // the cpus the threads may use; empty means the cpus this process may run on
+  std::vector<int> cpus;
+
+  // whether each thread is bound to a single cpu
+  bool pin_threads;
+
+  // whether the second and subsequent hardware threads of each core are left idle
+  bool idle_smt_siblings;
+
+  thread_pool_config()
+    : num_threads(0),
+      pin_threads(false),
+      idle_smt_siblings(false)
+  {}
+
+  static thread_pool_config from_environment(thread_pool_config config = thread_pool_config())
+  {
+    if(const char* num_threads = std::getenv("AGENCY_NUM_THREADS"))
+    {
+      int n = std::atoi(num_threads);
+      if(n > 0) config.num_threads = static_cast<std::size_t>(n);
+    }
+
+    if(const char* cpus = std::getenv("AGENCY_CPUS"))
+    {
+      std::vector<int> parsed = parse_cpu_list(cpus);
+      if(!parsed.empty()) config.cpus = parsed;
+    }
+
+    config.pin_threads = thread_pool_config_detail::environment_flag("AGENCY_PIN_THREADS", config.pin_threads);
+    config.idle_smt_siblings = thread_pool_config_detail::environment_flag("AGENCY_IDLE_SMT_SIBLINGS", config.idle_smt_siblings);
+
+    return config;
+  }
+
+  // returns, for each thread to create, the cpus that thread should be bound to
+  // an empty set of cpus means the thread should not be bound
+  std::vector<std::vector<int>> placement(const cpu_topology& topology = system_topology(), std::size_t cpu_limit = cgroup_cpu_limit()) const
+  {
+    std::vector<int> usable_cpus = cpus.empty() ? this_process_cpus() : cpus;
+
+    if(idle_smt_siblings)
+    {
+      std::vector<int> primary_cpus;
+
+      for(int cpu : usable_cpus)
+      {
+        if(!thread_pool_config_detail::is_secondary_hardware_thread(topology, cpu)) primary_cpus.push_back(cpu);
+      }
+
+      if(!primary_cpus.empty()) usable_cpus = primary_cpus;
+    }
+
+    std::size_t n = num_threads;
+
+    if(n == 0)
+    {
+      n = usable_cpus.size();
+
+      if(cpu_limit > 0) n = std::min(n, cpu_limit);
+
+      n = std::max<std::size_t>(n, 1);
+    }
+
+    // threads need binding only when they are pinned or when their cpus differ from the process's
+    bool restricted = !cpus.empty() || idle_smt_siblings;
+
+    std::vector<std::vector<int>> result(n);
+
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      if(pin_threads)
+      {
+        result[i].push_back(usable_cpus[i % usable_cpus.size()]);
+      }
+      else if(restricted)
+      {
+        result[i] = usable_cpus;
+      }
+    }
+
+    return result;
+  }
+};
+
+
+} // end detail
+} // end agency
+
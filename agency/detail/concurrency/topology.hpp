@@ -0,0 +1,414 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+
+#include <thread>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <initializer_list>
+
+
+namespace agency
+{
+namespace detail
+{
+
+
+// describes where a single logical cpu sits within the machine
+struct processing_unit
+{
+  // the cpu's id as used by the operating system, e.g. in a cpu_set_t
+  int cpu;
+
+  // the ids of the core and socket containing the cpu
+  int core;
+  int package;
+
+  // the NUMA node whose memory is closest to the cpu
+  int numa_node;
+
+  // the smallest cpu id sharing the cpu's last level cache
+  int l3_domain;
+
+  // the position of the cpu among the hardware threads of its core
+  // cpus with smt_rank 0 are the first hardware thread of each core
+  int smt_rank;
+};
+
+
+namespace topology_detail
+{
+
+
+inline bool read_file(const std::string& filename, std::string& result)
+{
+  std::ifstream file(filename.c_str());
+
+  if(!file) return false;
+
+  std::stringstream contents;
+  contents << file.rdbuf();
+  result = contents.str();
+
+  return true;
+}
+
+
+inline int read_int(const std::string& filename, int default_value)
+{
+  std::string contents;
+
+  if(!read_file(filename, contents) || contents.empty()) return default_value;
+
+  return std::atoi(contents.c_str());
+}
+
+
+} // end topology_detail
+
+
+// parses a Linux cpu list such as "0-3,8,10-11" into the ascending list of ids it names
+inline std::vector<int> parse_cpu_list(const std::string& list)
+{
+  std::vector<int> result;
+
+  std::stringstream ranges(list);
+  std::string range;
+
+  while(std::getline(ranges, range, ','))
+  {
+    if(range.find_first_of("0123456789") == std::string::npos) continue;
+
+    int first = std::atoi(range.c_str());
+    int last = first;
+
+    std::size_t dash = range.find('-');
+    if(dash != std::string::npos)
+    {
+      last = std::atoi(range.c_str() + dash + 1);
+    }
+
+    for(int i = first; i <= last; ++i)
+    {
+      result.push_back(i);
+    }
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+
+  return result;
+}
+
+
+// cpu_topology describes the processing units of a machine
+// and groups them into the domains which share a NUMA node or an L3 cache
+class cpu_topology
+{
+  public:
+    cpu_topology() = default;
+
+    explicit cpu_topology(std::vector<processing_unit> units)
+      : units_(std::move(units))
+    {
+      std::sort(units_.begin(), units_.end(), [](const processing_unit& a, const processing_unit& b)
+      {
+        return a.cpu < b.cpu;
+      });
+    }
+
+    // describes a machine with num_cpus cpus, each its own core, sharing a single package, node, and cache
+    // this is the description used when the operating system offers nothing better
+    static cpu_topology uniform(std::size_t num_cpus = std::max(1u, std::thread::hardware_concurrency()))
+    {
+      std::vector<processing_unit> units;
+
+      for(std::size_t i = 0; i < num_cpus; ++i)
+      {
+        int cpu = static_cast<int>(i);
+        units.push_back(processing_unit{cpu, cpu, 0, 0, 0, 0});
+      }
+
+      return cpu_topology(std::move(units));
+    }
+
+    // discovers the topology of the online cpus from the sysfs tree rooted at sysfs_root
+    // missing files are tolerated, so that partially-populated trees (e.g. inside containers) still yield a sensible topology
+    static cpu_topology discover(const std::string& sysfs_root = "/sys")
+    {
+      using namespace topology_detail;
+
+      const std::string cpu_root = sysfs_root + "/devices/system/cpu/";
+      const std::string node_root = sysfs_root + "/devices/system/node/";
+
+      std::string online;
+      if(!read_file(cpu_root + "online", online))
+      {
+        return uniform();
+      }
+
+      std::vector<int> cpus = parse_cpu_list(online);
+      if(cpus.empty())
+      {
+        return uniform();
+      }
+
+      // map each cpu to its NUMA node
+      std::vector<int> node_of_cpu(cpus.back() + 1, 0);
+
+      std::string nodes;
+      if(read_file(node_root + "online", nodes))
+      {
+        for(int node : parse_cpu_list(nodes))
+        {
+          std::string node_cpus;
+          if(read_file(node_root + "node" + std::to_string(node) + "/cpulist", node_cpus))
+          {
+            for(int cpu : parse_cpu_list(node_cpus))
+            {
+              if(cpu < static_cast<int>(node_of_cpu.size()))
+              {
+                node_of_cpu[cpu] = node;
+              }
+            }
+          }
+        }
+      }
+
+      std::vector<processing_unit> units;
+
+      for(int cpu : cpus)
+      {
+        const std::string this_cpu = cpu_root + "cpu" + std::to_string(cpu) + "/";
+
+        processing_unit unit;
+        unit.cpu = cpu;
+        unit.core = read_int(this_cpu + "topology/core_id", cpu);
+        unit.package = read_int(this_cpu + "topology/physical_package_id", 0);
+        unit.numa_node = node_of_cpu[cpu];
+
+        // a cpu's rank among its core's hardware threads is its position within its sibling list
+        unit.smt_rank = 0;
+        std::string siblings;
+        if(read_file(this_cpu + "topology/thread_siblings_list", siblings))
+        {
+          std::vector<int> sibling_cpus = parse_cpu_list(siblings);
+          unit.smt_rank = static_cast<int>(std::lower_bound(sibling_cpus.begin(), sibling_cpus.end(), cpu) - sibling_cpus.begin());
+        }
+
+        // without a level 3 cache, treat the whole package as a single cache domain
+        unit.l3_domain = -1;
+        for(int index = 0; ; ++index)
+        {
+          const std::string this_cache = this_cpu + "cache/index" + std::to_string(index) + "/";
+
+          int level = read_int(this_cache + "level", -1);
+          if(level < 0) break;
+
+          std::string shared_cpus;
+          if(level == 3 && read_file(this_cache + "shared_cpu_list", shared_cpus))
+          {
+            std::vector<int> sharers = parse_cpu_list(shared_cpus);
+            unit.l3_domain = sharers.empty() ? cpu : sharers.front();
+          }
+        }
+
+        units.push_back(unit);
+      }
+
+      for(processing_unit& unit : units)
+      {
+        if(unit.l3_domain < 0)
+        {
+          // name the domain after the package's first cpu
+          auto first = std::find_if(units.begin(), units.end(), [&](const processing_unit& other)
+          {
+            return other.package == unit.package;
+          });
+
+          unit.l3_domain = first->cpu;
+        }
+      }
+
+      return cpu_topology(std::move(units));
+    }
+
+    const std::vector<processing_unit>& processing_units() const
+    {
+      return units_;
+    }
+
+    std::size_t size() const
+    {
+      return units_.size();
+    }
+
+    // returns the number of distinct cores
+    std::size_t num_cores() const
+    {
+      return count_distinct([](const processing_unit& unit)
+      {
+        return static_cast<long long>(unit.package) << 32 | static_cast<unsigned int>(unit.core);
+      });
+    }
+
+    // returns the cpus of each NUMA node, ordered by node id
+    std::vector<std::vector<int>> numa_nodes() const
+    {
+      return group_by([](const processing_unit& unit)
+      {
+        return static_cast<long long>(unit.numa_node);
+      });
+    }
+
+    // returns the ids of the NUMA nodes in the same order as numa_nodes()
+    std::vector<int> numa_node_ids() const
+    {
+      std::vector<int> result;
+
+      for(const std::vector<int>& node : numa_nodes())
+      {
+        result.push_back(find(node.front()).numa_node);
+      }
+
+      return result;
+    }
+
+    // returns the cpus of each group sharing an L3 cache, ordered by each group's first cpu
+    std::vector<std::vector<int>> l3_domains() const
+    {
+      return group_by([](const processing_unit& unit)
+      {
+        return static_cast<long long>(unit.l3_domain);
+      });
+    }
+
+    const processing_unit& find(int cpu) const
+    {
+      return *std::lower_bound(units_.begin(), units_.end(), cpu, [](const processing_unit& unit, int cpu)
+      {
+        return unit.cpu < cpu;
+      });
+    }
+
+  private:
+    template<class KeyFunction>
+    std::vector<std::vector<int>> group_by(KeyFunction key) const
+    {
+      std::vector<long long> keys;
+      for(const processing_unit& unit : units_)
+      {
+        keys.push_back(key(unit));
+      }
+
+      std::sort(keys.begin(), keys.end());
+      keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+      std::vector<std::vector<int>> result(keys.size());
+      for(const processing_unit& unit : units_)
+      {
+        std::size_t group = std::lower_bound(keys.begin(), keys.end(), key(unit)) - keys.begin();
+        result[group].push_back(unit.cpu);
+      }
+
+      return result;
+    }
+
+    template<class KeyFunction>
+    std::size_t count_distinct(KeyFunction key) const
+    {
+      return group_by(key).size();
+    }
+
+    std::vector<processing_unit> units_;
+};
+
+
+// returns the number of cpus' worth of time the calling process's cgroup may consume, rounded up,
+// or 0 when the cgroup imposes no quota
+// both the unified (v2) hierarchy's cpu.max and the v1 hierarchy's cpu.cfs_quota_us are understood
+inline std::size_t cgroup_cpu_limit(const std::string& sysfs_root = "/sys", const std::string& proc_root = "/proc")
+{
+  using namespace topology_detail;
+
+  const std::string cgroup_root = sysfs_root + "/fs/cgroup";
+
+  long long quota = -1;
+  long long period = 0;
+
+  // v2: the process's cgroup is named by the "0::" line of /proc/self/cgroup
+  std::vector<std::string> candidates;
+
+  std::string memberships;
+  if(read_file(proc_root + "/self/cgroup", memberships))
+  {
+    std::stringstream lines(memberships);
+    std::string line;
+    while(std::getline(lines, line))
+    {
+      if(line.compare(0, 3, "0::") == 0 && line.size() > 4)
+      {
+        candidates.push_back(cgroup_root + line.substr(3) + "/cpu.max");
+      }
+    }
+  }
+
+  candidates.push_back(cgroup_root + "/cpu.max");
+
+  for(const std::string& candidate : candidates)
+  {
+    std::string contents;
+    if(read_file(candidate, contents))
+    {
+      // the format is "<quota> <period>" where quota may be "max"
+      std::stringstream fields(contents);
+      std::string quota_field;
+      fields >> quota_field >> period;
+
+      if(quota_field != "max")
+      {
+        quota = std::atoll(quota_field.c_str());
+      }
+
+      break;
+    }
+  }
+
+  // v1
+  if(period == 0)
+  {
+    for(const char* controller : {"/cpu/", "/cpu,cpuacct/"})
+    {
+      std::string quota_contents, period_contents;
+      if(read_file(cgroup_root + controller + "cpu.cfs_quota_us", quota_contents) &&
+         read_file(cgroup_root + controller + "cpu.cfs_period_us", period_contents))
+      {
+        quota = std::atoll(quota_contents.c_str());
+        period = std::atoll(period_contents.c_str());
+        break;
+      }
+    }
+  }
+
+  if(quota <= 0 || period <= 0) return 0;
+
+  return static_cast<std::size_t>((quota + period - 1) / period);
+}
+
+
+// returns the topology of this machine, discovered once on first use
+inline const cpu_topology& system_topology()
+{
+  static const cpu_topology result = cpu_topology::discover();
+  return result;
+}
+
+
+} // end detail
+} // end agency
+
@@ -15,3 +15,8 @@
 #  define __agency_exec_check_disable__
 #endif // __agency_exec_check_disable__
 
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#  if __has_include(<coroutine>)
+#    define __AGENCY_HAS_COROUTINES
+#  endif
+#endif // __AGENCY_HAS_COROUTINES
@@ -8,4 +8,5 @@
 #include <agency/detail/iterator/iterator_traits.hpp>
 #include <agency/detail/iterator/move_iterator.hpp>
 #include <agency/detail/iterator/reverse_iterator.hpp>
+#include <agency/detail/iterator/unwrap_contiguous_iterator.hpp>
 
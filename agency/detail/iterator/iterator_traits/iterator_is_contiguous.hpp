@@ -3,16 +3,44 @@
 #include <agency/detail/config.hpp>
 #include <agency/detail/type_traits.hpp>
 #include <type_traits>
+#include <iterator>
+#include <vector>
 
 namespace agency
 {
 namespace detail
 {
+namespace iterator_is_contiguous_detail
+{
+
+
+template<class Iterator, class = void>
+struct is_vector_iterator : std::false_type {};
+
+// std::vector<bool>'s iterators refer to bits, so they are excluded
+template<class Iterator>
+struct is_vector_iterator<Iterator, void_t<typename std::iterator_traits<Iterator>::value_type>>
+  : std::integral_constant<
+      bool,
+      !std::is_same<typename std::iterator_traits<Iterator>::value_type, bool>::value &&
+      (std::is_same<Iterator, typename std::vector<typename std::iterator_traits<Iterator>::value_type>::iterator>::value ||
+       std::is_same<Iterator, typename std::vector<typename std::iterator_traits<Iterator>::value_type>::const_iterator>::value)
+    >
+{};
+
+
+} // end iterator_is_contiguous_detail
 
 
-// XXX for the moment, only consider pointers to be contiguous iterators
+// contiguous iterators refer to elements stored adjacently in memory, so they may be replaced by pointers
+// without contiguous_iterator_tag, recognize pointers and the iterators of std::vector
 template<class Iterator>
-using iterator_is_contiguous = std::is_pointer<Iterator>;
+struct iterator_is_contiguous : std::integral_constant<
+  bool,
+  std::is_pointer<Iterator>::value ||
+  iterator_is_contiguous_detail::is_vector_iterator<Iterator>::value
+>
+{};
 
 
 template<class... Iterators>
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/detail/iterator/iterator_traits/iterator_is_contiguous.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace agency
+{
+namespace detail
+{
+namespace unwrap_contiguous_iterator_detail
+{
+
+
+// iterators which are composed of other iterators, such as zip_with_iterator, may
+// provide a member function unwrap_contiguous() which returns an equivalent iterator
+// composed of pointers
+template<class Iterator>
+using member_unwrap_contiguous_t = decltype(std::declval<const Iterator&>().unwrap_contiguous());
+
+template<class Iterator>
+using has_member_unwrap_contiguous = is_detected<member_unwrap_contiguous_t, Iterator>;
+
+
+} // end unwrap_contiguous_iterator_detail
+
+
+// unwrap_contiguous_iterator() returns an iterator equivalent to iter which is made of pointers when possible:
+// a contiguous iterator becomes a pointer, an iterator with a member unwrap_contiguous() becomes the result of that function,
+// and any other iterator, including a pointer, is returned unchanged
+// algorithms call it once before a loop so that the loop indexes pointers, which compilers are able to vectorize
+// iter must be dereferenceable unless it is a pointer
+__agency_exec_check_disable__
+template<class Iterator,
+         __AGENCY_REQUIRES(
+           iterator_is_contiguous<Iterator>::value &&
+           !std::is_pointer<Iterator>::value
+         )>
+__AGENCY_ANNOTATION
+auto unwrap_contiguous_iterator(Iterator iter) ->
+  decltype(&*iter)
+{
+  return &*iter;
+}
+
+
+__agency_exec_check_disable__
+template<class Iterator,
+         __AGENCY_REQUIRES(
+           !iterator_is_contiguous<Iterator>::value &&
+           unwrap_contiguous_iterator_detail::has_member_unwrap_contiguous<Iterator>::value
+         )>
+__AGENCY_ANNOTATION
+auto unwrap_contiguous_iterator(Iterator iter) ->
+  decltype(iter.unwrap_contiguous())
+{
+  return iter.unwrap_contiguous();
+}
+
+
+template<class Iterator,
+         __AGENCY_REQUIRES(
+           std::is_pointer<Iterator>::value ||
+           (!iterator_is_contiguous<Iterator>::value &&
+            !unwrap_contiguous_iterator_detail::has_member_unwrap_contiguous<Iterator>::value)
+         )>
+__AGENCY_ANNOTATION
+Iterator unwrap_contiguous_iterator(Iterator iter)
+{
+  return iter;
+}
+
+
+template<class Iterator>
+using unwrap_contiguous_iterator_t = decltype(detail::unwrap_contiguous_iterator(std::declval<Iterator>()));
+
+
+} // end detail
+} // end agency
+
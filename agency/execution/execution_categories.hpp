@@ -86,7 +86,7 @@ namespace detail
 // unsequenced_execution_tag < parallel_execution_tag
 // dynamic_execution_tag     < unsequenced_execution_tag
 //
-// XXX figure out how scoped_execution_tag sorts
+// scoped_execution_tag<A1,B1> < scoped_execution_tag<A2,B2> when A1 < A2 and B1 < B2
 
 // in general, categories are not weaker than another
 template<class ExecutionCategory1, class ExecutionCategory2>
@@ -122,6 +122,19 @@ struct is_weaker_than<parallel_execution_tag, sequenced_execution_tag> : std::tr
 template<>
 struct is_weaker_than<parallel_execution_tag, concurrent_execution_tag> : std::true_type {};
 
+// a scoped category is weaker than another scoped category when both its outer and inner categories are weaker
+template<class OuterCategory1, class InnerCategory1, class OuterCategory2, class InnerCategory2>
+struct is_weaker_than<scoped_execution_tag<OuterCategory1,InnerCategory1>, scoped_execution_tag<OuterCategory2,InnerCategory2>>
+  : std::integral_constant<
+      bool,
+      is_weaker_than<OuterCategory1,OuterCategory2>::value && is_weaker_than<InnerCategory1,InnerCategory2>::value
+    >
+{};
+
+// introduce this specialization to disambiguate two other specializations
+template<class OuterCategory, class InnerCategory>
+struct is_weaker_than<scoped_execution_tag<OuterCategory,InnerCategory>, scoped_execution_tag<OuterCategory,InnerCategory>> : std::true_type {};
+
 
 template<class ExecutionCategory>
 struct is_scoped_execution_category : std::false_type {};
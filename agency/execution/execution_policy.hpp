@@ -105,6 +105,8 @@
 #include <agency/execution/execution_policy/parallel_execution_policy.hpp>
 #include <agency/execution/execution_policy/sequenced_execution_policy.hpp>
 #include <agency/execution/execution_policy/unsequenced_execution_policy.hpp>
+#include <agency/execution/execution_agent/experimental/static_parallel_agent.hpp>
+#include <agency/execution/executor/experimental/unrolling_executor.hpp>
 
 // XXX the stuff defined down there should be moved into separate headers
 
@@ -165,6 +167,33 @@ class static_concurrent_execution_policy : public detail::basic_static_execution
 };
 
 
+// static_parallel_execution_policy creates groups of exactly group_size agents which execute on an unrolling_executor
+// because the group size is a compile-time constant, the loop which invokes the group's agents is fully unrolled
+// when nested inside another policy, e.g. par(n, static_parallel_execution_policy<4>()), each outer agent's inner
+// group is executed by a loop with a constant trip count
+template<size_t group_size, size_t grain_size = 1>
+class static_parallel_execution_policy : public detail::basic_static_execution_policy<
+  agency::parallel_execution_policy,
+  group_size,
+  grain_size,
+  static_parallel_agent<group_size, grain_size>,
+  unrolling_executor<group_size>
+>
+{
+  private:
+    using super_t = detail::basic_static_execution_policy<
+      agency::parallel_execution_policy,
+      group_size,
+      grain_size,
+      static_parallel_agent<group_size, grain_size>,
+      unrolling_executor<group_size>
+    >;
+
+  public:
+    using super_t::super_t;
+};
+
+
 } // end experimental
 } // end agency
 
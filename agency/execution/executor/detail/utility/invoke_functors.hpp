@@ -21,6 +21,14 @@ struct ignore_unit_result_parameter_and_invoke
   __AGENCY_ANNOTATION
   ignore_unit_result_parameter_and_invoke() = default;
 
+  // because of its user-declared constructors, this type is not an aggregate in C++20
+  // so, provide a constructor for brace-initialization from a Function
+  __agency_exec_check_disable__
+  __AGENCY_ANNOTATION
+  ignore_unit_result_parameter_and_invoke(const Function& function)
+    : f(function)
+  {}
+
   __agency_exec_check_disable__
   __AGENCY_ANNOTATION
   ignore_unit_result_parameter_and_invoke(const ignore_unit_result_parameter_and_invoke&) = default;
@@ -47,6 +55,12 @@ struct ignore_unit_result_parameter_and_invoke<Function,void>
   __AGENCY_ANNOTATION
   ignore_unit_result_parameter_and_invoke() = default;
 
+  __agency_exec_check_disable__
+  __AGENCY_ANNOTATION
+  ignore_unit_result_parameter_and_invoke(const Function& function)
+    : f(function)
+  {}
+
   __agency_exec_check_disable__
   __AGENCY_ANNOTATION
   ignore_unit_result_parameter_and_invoke(const ignore_unit_result_parameter_and_invoke&) = default;
@@ -14,6 +14,9 @@
 #include <agency/execution/executor/customization_points.hpp>
 #include <agency/detail/scoped_in_place_type.hpp>
 #include <agency/tuple.hpp>
+#include <atomic>
+#include <exception>
+#include <future>
 
 
 namespace agency
@@ -70,11 +73,24 @@ class executor_array
       : inner_executors_(n, exec)
     {}
 
+    __agency_exec_check_disable__
+    __AGENCY_ANNOTATION
+    executor_array(const outer_executor_type& outer_exec, size_t n, const inner_executor_type& exec = inner_executor_type())
+      : outer_executor_(outer_exec),
+        inner_executors_(n, exec)
+    {}
+
     template<class Iterator>
     executor_array(Iterator executors_begin, Iterator executors_end)
       : inner_executors_(executors_begin, executors_end)
     {}
 
+    template<class Iterator>
+    executor_array(const outer_executor_type& outer_exec, Iterator executors_begin, Iterator executors_end)
+      : outer_executor_(outer_exec),
+        inner_executors_(executors_begin, executors_end)
+    {}
+
     template<class T>
     using future = executor_future_t<outer_executor_type,T>;
 
@@ -150,6 +166,12 @@ class executor_array
     // because work gets issued immediately to the outer_executor via execute()
     struct eager_strategy {};
 
+    // eager implementation of then_execute() which tracks the completion of the inner executors' agents with a single atomic counter
+    // applicable whenever eager_strategy is, both executors' futures are std::futures so that the result may be
+    // fulfilled by a promise from whichever thread completes the last agent, and the inner executor's futures may be
+    // discarded without waiting
+    struct counting_strategy {};
+
     // XXX make this functor public to accomodate nvcc's requirement
     //     on types used to instantiate __global__ function templates
     template<class Function, class... InnerFactories>
@@ -415,6 +437,221 @@ class executor_array
       return eager_bulk_then_execute(f, shape, predecessor, result_factory, outer_factory, inner_factories...);
     }
 
+  public:
+    // XXX these types are public to accomodate nvcc's requirement
+    //     on types used to instantiate __global__ function templates
+
+    // the state shared by all of the inner groups created by counting_bulk_then_execute()
+    // each agent counts itself out after it returns, so completion does not depend on how an inner executor
+    // creates and destroys shared parameters. the last agent to complete fulfills the promise with the result,
+    // or with the first exception encountered, and destroys the state
+    template<class SharedFuture, class Result, class OuterShared>
+    struct counting_state
+    {
+      SharedFuture predecessor;
+      std::atomic<size_t> agents_remaining;
+      Result result;
+      OuterShared outer_shared_arg;
+      std::atomic<bool> failed;
+      std::exception_ptr exception;
+      std::promise<Result> promise;
+
+      template<class ResultFactory, class OuterFactory>
+      counting_state(const SharedFuture& predecessor, size_t num_groups, size_t group_size, ResultFactory result_factory, OuterFactory outer_factory)
+        : predecessor(predecessor),
+          agents_remaining(num_groups * group_size),
+          result(result_factory()),
+          outer_shared_arg(outer_factory()),
+          failed(false)
+      {}
+
+      // records the current exception if it is the first
+      void add_current_exception()
+      {
+        if(!failed.exchange(true))
+        {
+          exception = std::current_exception();
+        }
+      }
+
+      void agent_complete()
+      {
+        if(agents_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          if(exception)
+          {
+            promise.set_exception(exception);
+          }
+          else
+          {
+            promise.set_value(std::move(result));
+          }
+
+          delete this;
+        }
+      }
+    };
+
+    // waits for a predecessor without observing its value or exception
+    template<class SharedFuture>
+    struct wait_for_predecessor
+    {
+      mutable SharedFuture predecessor;
+
+      void operator()() const
+      {
+        predecessor.wait();
+      }
+    };
+
+    template<class Function, class State, class... InnerFactories>
+    struct counting_bulk_then_execute_functor
+    {
+      executor_array& exec;
+      mutable Function f;
+      std::shared_future<void>& predecessor_ready;
+      State* state;
+      tuple<InnerFactories...> inner_factories;
+      outer_shape_type outer_shape;
+      inner_shape_type inner_shape;
+
+      struct inner_functor
+      {
+        mutable Function f;
+        outer_index_type outer_idx;
+        State* state;
+
+        template<class... Args>
+        void invoke(std::true_type, const index_type& idx, Args&... inner_shared_args) const
+        {
+          // rethrow the predecessor's exception, if any
+          state->predecessor.get();
+
+          agency::detail::invoke(f, idx, state->result, state->outer_shared_arg, inner_shared_args...);
+        }
+
+        template<class... Args>
+        void invoke(std::false_type, const index_type& idx, Args&... inner_shared_args) const
+        {
+          using predecessor_type = detail::future_value_t<decltype(state->predecessor)>;
+          predecessor_type& predecessor = const_cast<predecessor_type&>(state->predecessor.get());
+
+          agency::detail::invoke(f, idx, predecessor, state->result, state->outer_shared_arg, inner_shared_args...);
+        }
+
+        template<class... Args,
+                 class = typename std::enable_if<
+                   sizeof...(Args) == sizeof...(InnerFactories)
+                 >::type>
+        void operator()(const inner_index_type& inner_idx, Args&... inner_shared_args) const
+        {
+          using predecessor_is_void = std::is_void<detail::future_value_t<decltype(state->predecessor)>>;
+
+          try
+          {
+            invoke(predecessor_is_void(), make_index(outer_idx, inner_idx), inner_shared_args...);
+          }
+          catch(...)
+          {
+            state->add_current_exception();
+          }
+
+          state->agent_complete();
+        }
+      };
+
+      template<size_t... Indices>
+      void impl(detail::index_sequence<Indices...>, const outer_index_type& outer_idx) const
+      {
+        auto inner_executor_idx = exec.select_inner_executor(outer_idx, outer_shape);
+
+        detail::bulk_continuation_executor_adaptor<inner_executor_type> adapted_inner_executor(exec.inner_executor(inner_executor_idx));
+
+        // each group receives its own handle to the shared future, in case the inner executor consumes it
+        std::shared_future<void> group_predecessor_ready = predecessor_ready;
+
+        // the future returned here is discarded: the group's agents signal its completion through state
+        detail::bulk_then_execute_with_void_result(
+          adapted_inner_executor,
+          inner_functor{f,outer_idx,state},
+          inner_shape,
+          group_predecessor_ready,
+          agency::get<Indices>(inner_factories)...
+        );
+      }
+
+      void operator()(const outer_index_type& outer_idx) const
+      {
+        impl(detail::index_sequence_for<InnerFactories...>(), outer_idx);
+      }
+    };
+
+  private:
+    template<class Function, class Future, class ResultFactory, class OuterFactory, class... InnerFactories>
+    std::future<detail::result_of_t<ResultFactory()>>
+      counting_bulk_then_execute(Function f, shape_type shape, Future& predecessor, ResultFactory result_factory, OuterFactory outer_factory, InnerFactories... inner_factories)
+    {
+      // like eager_bulk_then_execute(), this implementation issues each outer agent's inner group immediately
+      // rather than collecting one future per group and waiting on them, each agent decrements a single counter
+      // upon returning, and the last agent fulfills the result's promise
+      // the predecessor is shared once, rather than once per outer agent
+
+      outer_shape_type outer_shape = this->outer_shape(shape);
+      inner_shape_type inner_shape = this->inner_shape(shape);
+
+      using result_type = detail::result_of_t<ResultFactory()>;
+      using outer_shared_arg_type = detail::result_of_t<OuterFactory()>;
+
+      size_t num_groups = detail::index_space_size(outer_shape);
+      size_t group_size = detail::index_space_size(inner_shape);
+
+      // groups without agents would never complete, so none are launched
+      if(num_groups == 0 || group_size == 0)
+      {
+        std::promise<result_type> promise;
+
+        // there are no groups to wait for, but the result must still wait for the predecessor
+        try
+        {
+          predecessor.get();
+          promise.set_value(result_factory());
+        }
+        catch(...)
+        {
+          promise.set_exception(std::current_exception());
+        }
+
+        return promise.get_future();
+      }
+
+      auto shared_predecessor = future_traits<Future>::share(predecessor);
+      using shared_future_type = decltype(shared_predecessor);
+
+      using state_type = counting_state<shared_future_type, result_type, outer_shared_arg_type>;
+
+      state_type* state = new state_type(shared_predecessor, num_groups, group_size, result_factory, outer_factory);
+      std::future<result_type> result_future = state->promise.get_future();
+
+      // the groups wait for a deferred future which becomes ready along with the predecessor but never contains its exception
+      // so that each group's agents are invoked, and count themselves out, even when the predecessor fails
+      // the agents retrieve the predecessor's value, or rethrow its exception, through state
+      std::shared_future<void> predecessor_ready = std::async(std::launch::deferred, wait_for_predecessor<shared_future_type>{shared_predecessor}).share();
+
+      using functor_type = counting_bulk_then_execute_functor<Function,state_type,InnerFactories...>;
+      functor_type functor{*this, f, predecessor_ready, state, agency::make_tuple(inner_factories...), outer_shape, inner_shape};
+
+      detail::bulk_sync_execute_with_auto_result_and_without_shared_parameters(outer_executor(), functor, outer_shape);
+
+      return result_future;
+    }
+
+    template<class Function, class Future, class ResultFactory, class OuterFactory, class... InnerFactories>
+    std::future<detail::result_of_t<ResultFactory()>>
+      bulk_then_execute_impl(counting_strategy, Function f, shape_type shape, Future& predecessor, ResultFactory result_factory, OuterFactory outer_factory, InnerFactories... inner_factories)
+    {
+      return counting_bulk_then_execute(f, shape, predecessor, result_factory, outer_factory, inner_factories...);
+    }
+
   public:
     template<class Function, class Future, class ResultFactory, class OuterFactory, class... InnerFactories,
              __AGENCY_REQUIRES(sizeof...(InnerFactories) == inner_depth)
@@ -438,7 +675,17 @@ class executor_array
         std::is_same<inner_execution_category, sequenced_execution_tag> // XXX this should really check whether the inner executor's async_execute() method executes concurrently with the caller 
       >::value,
       lazy_strategy,
-      eager_strategy
+      typename std::conditional<
+        detail::conjunction<
+          std::is_same<future<int>, std::future<int>>,
+          std::is_same<executor_future_t<inner_executor_type,int>, std::future<int>>,
+          // concurrent executors return futures from std::async, whose destructors block
+          // so discarding them, as counting_strategy does, would serialize the inner groups
+          std::integral_constant<bool, !std::is_same<inner_execution_category, concurrent_execution_tag>::value>
+        >::value,
+        counting_strategy,
+        eager_strategy
+      >::type
     >::type;
 
     // XXX eliminate this when we eliminate .then_execute()
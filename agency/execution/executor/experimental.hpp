@@ -1,5 +1,8 @@
 #pragma once
 
 #include <agency/detail/config.hpp>
+#include <agency/execution/executor/experimental/affinity_executor.hpp>
+#include <agency/execution/executor/experimental/execution_graph.hpp>
 #include <agency/execution/executor/experimental/unrolling_executor.hpp>
+#include <agency/execution/executor/experimental/visit_executor.hpp>
 
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/concurrency/affinity.hpp>
+#include <agency/detail/concurrency/thread_pool.hpp>
+#include <agency/detail/concurrency/topology.hpp>
+#include <agency/execution/executor/executor_array.hpp>
+#include <agency/execution/executor/parallel_executor.hpp>
+#include <agency/execution/executor/sequenced_executor.hpp>
+#include <agency/memory/allocator/detail/numa_allocator.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace agency
+{
+namespace experimental
+{
+
+
+namespace detail
+{
+namespace affinity_executor_detail
+{
+
+
+// launches each domain's group from the calling thread
+// its category is parallel rather than sequenced so that executor_array issues every domain's work eagerly,
+// instead of waiting for one domain to finish before starting the next
+class launching_executor : public agency::sequenced_executor
+{
+  public:
+    using execution_category = parallel_execution_tag;
+};
+
+
+// the cpus and NUMA node of each domain an affinity_executor occupies
+struct domain_list
+{
+  std::vector<std::vector<int>> cpus;
+  std::vector<int> nodes;
+};
+
+
+// restricts each of the domains to the allowed cpus and drops the domains which are left empty
+// when no domain contains an allowed cpu, the allowed cpus form a single domain
+// an empty list of allowed cpus leaves the domains unrestricted
+inline domain_list restrict_domains(const agency::detail::cpu_topology& topology,
+                                    const std::vector<std::vector<int>>& domains,
+                                    std::vector<int> allowed_cpus)
+{
+  std::sort(allowed_cpus.begin(), allowed_cpus.end());
+
+  domain_list result;
+
+  for(const std::vector<int>& domain : domains)
+  {
+    std::vector<int> cpus = domain;
+
+    if(!allowed_cpus.empty())
+    {
+      cpus.clear();
+      std::set_intersection(domain.begin(), domain.end(), allowed_cpus.begin(), allowed_cpus.end(), std::back_inserter(cpus));
+    }
+
+    if(!cpus.empty())
+    {
+      result.cpus.push_back(cpus);
+      result.nodes.push_back(topology.find(cpus.front()).numa_node);
+    }
+  }
+
+  if(result.cpus.empty())
+  {
+    result.cpus.push_back(allowed_cpus);
+    result.nodes.push_back(0);
+  }
+
+  return result;
+}
+
+
+// returns, for each thread of a domain's pool, the cpus that thread should be bound to
+// each thread is pinned to one of the domain's cpus unless the cpus of all domains exceed cpu_limit,
+// in which case the domain receives its share of cpu_limit threads, each bound to all of the domain's cpus
+inline std::vector<std::vector<int>> domain_placement(const std::vector<int>& domain_cpus, std::size_t total_cpus, std::size_t cpu_limit)
+{
+  if(cpu_limit == 0 || cpu_limit >= total_cpus)
+  {
+    std::vector<std::vector<int>> result;
+
+    for(int cpu : domain_cpus)
+    {
+      result.push_back(std::vector<int>(1, cpu));
+    }
+
+    return result;
+  }
+
+  std::size_t num_threads = std::max<std::size_t>(1, domain_cpus.size() * cpu_limit / total_cpus);
+
+  return std::vector<std::vector<int>>(num_threads, domain_cpus);
+}
+
+
+} // end affinity_executor_detail
+} // end detail
+
+
+// names the kind of hardware domain which each of an affinity_executor's inner executors occupies
+enum class affinity_domain
+{
+  numa_node,
+  l3_cache
+};
+
+
+// affinity_executor is an executor_array whose inner executors are parallel executors, each of which
+// owns a thread pool bound to the cpus of a single NUMA node or L3 cache domain
+//
+// because executor_array maps outer index i onto inner executor i % size(), a scoped policy such as
+// par(exec.size(), par(n)).on(exec) runs the i-th outer group on the i-th domain's cpus
+// memory allocated by exec.domain_allocator<T>(i) prefers the same domain's NUMA node, so a group which
+// processes data allocated this way touches local memory
+//
+// only the cpus this process may run on are used: each domain is restricted to allowed_cpus, domains without
+// an allowed cpu are omitted, and when the cgroup's cpu quota is smaller than the allowed cpus, the domains' pools
+// share cpu_limit threads among them rather than creating one thread per cpu
+class affinity_executor : public executor_array<agency::parallel_executor, detail::affinity_executor_detail::launching_executor>
+{
+  private:
+    using super_t = executor_array<agency::parallel_executor, detail::affinity_executor_detail::launching_executor>;
+
+  public:
+    explicit affinity_executor(affinity_domain domain = affinity_domain::numa_node,
+                               const agency::detail::cpu_topology& topology = agency::detail::system_topology(),
+                               const std::vector<int>& allowed_cpus = agency::detail::this_process_cpus(),
+                               std::size_t cpu_limit = agency::detail::cgroup_cpu_limit())
+      : affinity_executor(topology.size() > 0 ? topology : agency::detail::cpu_topology::uniform(),
+                          domain,
+                          allowed_cpus,
+                          cpu_limit)
+    {}
+
+    // returns the cpus of the i-th domain
+    const std::vector<int>& cpus(std::size_t i) const
+    {
+      return domain_cpus_[i];
+    }
+
+    // returns the NUMA node of the i-th domain
+    int numa_node(std::size_t i) const
+    {
+      return domain_nodes_[i];
+    }
+
+    // returns an allocator whose allocations prefer the i-th domain's NUMA node
+    template<class T>
+    agency::detail::numa_allocator<T> domain_allocator(std::size_t i) const
+    {
+      return agency::detail::numa_allocator<T>(agency::detail::numa_resource(numa_node(i)));
+    }
+
+  private:
+    affinity_executor(const agency::detail::cpu_topology& topology, affinity_domain domain, const std::vector<int>& allowed_cpus, std::size_t cpu_limit)
+      : affinity_executor(detail::affinity_executor_detail::restrict_domains(topology,
+                                                                             domain == affinity_domain::numa_node ? topology.numa_nodes() : topology.l3_domains(),
+                                                                             allowed_cpus),
+                          cpu_limit)
+    {}
+
+    affinity_executor(const detail::affinity_executor_detail::domain_list& domains, std::size_t cpu_limit)
+      : affinity_executor(make_inner_executors(domains.cpus, cpu_limit), domains)
+    {}
+
+    affinity_executor(const std::vector<agency::parallel_executor>& inner_executors,
+                      const detail::affinity_executor_detail::domain_list& domains)
+      : super_t(inner_executors.begin(), inner_executors.end()),
+        domain_cpus_(domains.cpus),
+        domain_nodes_(domains.nodes)
+    {}
+
+    static std::vector<agency::parallel_executor> make_inner_executors(const std::vector<std::vector<int>>& domain_cpus, std::size_t cpu_limit)
+    {
+      std::size_t total_cpus = 0;
+      for(const std::vector<int>& cpus : domain_cpus)
+      {
+        total_cpus += cpus.size();
+      }
+
+      std::vector<agency::parallel_executor> result;
+
+      for(const std::vector<int>& cpus : domain_cpus)
+      {
+        std::vector<std::vector<int>> placement = detail::affinity_executor_detail::domain_placement(cpus, total_cpus, cpu_limit);
+
+        result.push_back(agency::detail::make_parallel_thread_pool_executor(std::make_shared<agency::detail::thread_pool>(placement)));
+      }
+
+      return result;
+    }
+
+    std::vector<std::vector<int>> domain_cpus_;
+    std::vector<int> domain_nodes_;
+};
+
+
+} // end experimental
+} // end agency
+
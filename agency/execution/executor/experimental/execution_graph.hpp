@@ -0,0 +1,475 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/detail/integer_sequence.hpp>
+#include <agency/experimental/optional.hpp>
+#include <agency/execution/executor/executor_traits.hpp>
+#include <agency/execution/executor/customization_points/bulk_sync_execute.hpp>
+#include <agency/execution/executor/customization_points/max_shape_dimensions.hpp>
+#include <agency/execution/executor/customization_points/unit_shape.hpp>
+#include <agency/tuple.hpp>
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace agency
+{
+namespace experimental
+{
+
+
+class execution_graph;
+
+template<class T>
+class graph_future;
+
+template<class Executor>
+class graph_executor;
+
+
+namespace detail
+{
+namespace execution_graph_detail
+{
+
+
+// a graph_slot holds the value produced by a node of an execution_graph
+// the slot outlives each replay of the graph, so the value is constructed once and reused by later replays
+class graph_slot_base
+{
+  public:
+    virtual ~graph_slot_base() {}
+};
+
+
+template<class T>
+class graph_slot : public graph_slot_base
+{
+  public:
+    graph_slot() = default;
+
+    template<class... Args>
+    explicit graph_slot(Args&&... args)
+      : value_(experimental::in_place, std::forward<Args>(args)...)
+    {}
+
+    bool has_value() const
+    {
+      return value_.has_value();
+    }
+
+    T& value()
+    {
+      return *value_;
+    }
+
+    template<class Factory>
+    T& value_or_construct(Factory& factory)
+    {
+      if(!value_)
+      {
+        value_.emplace(factory());
+      }
+
+      return *value_;
+    }
+
+  private:
+    experimental::optional<T> value_;
+};
+
+
+// void predecessors carry no value, but graph_slot<void> gives every node a uniform predecessor type
+template<>
+class graph_slot<void> : public graph_slot_base {};
+
+
+// a node of an execution_graph
+class graph_node
+{
+  public:
+    virtual ~graph_node() {}
+
+    virtual void execute() = 0;
+};
+
+
+// returns a factory which yields a pointer to the result object stored in a slot
+// the executor's result is then this pointer, rather than a freshly-constructed result object
+template<class T>
+struct result_pointer_factory
+{
+  T* result;
+
+  T* operator()() const
+  {
+    return result;
+  }
+};
+
+
+// calls the captured function with the predecessor's value, the result stored in its slot, and the shared parameters
+template<class Function, class Predecessor, class Result>
+struct node_function
+{
+  Function* f;
+  Predecessor* predecessor;
+
+  template<class Index, class... SharedParameters>
+  void operator()(const Index& idx, Result*& result, SharedParameters&... shared_parameters) const
+  {
+    (*f)(idx, *predecessor, *result, shared_parameters...);
+  }
+};
+
+
+template<class Function, class Result>
+struct node_function<Function, void, Result>
+{
+  Function* f;
+
+  template<class Index, class... SharedParameters>
+  void operator()(const Index& idx, Result*& result, SharedParameters&... shared_parameters) const
+  {
+    (*f)(idx, *result, shared_parameters...);
+  }
+};
+
+
+// a bulk_then_node replays a single bulk_then_execute() call with agency::bulk_sync_execute()
+template<class Executor, class Function, class Predecessor, class ResultFactory, class... SharedFactories>
+class bulk_then_node : public graph_node
+{
+  public:
+    using result_type = agency::detail::result_of_t<ResultFactory()>;
+    using shape_type = executor_shape_t<Executor>;
+
+    bulk_then_node(const Executor& exec,
+                   Function f,
+                   shape_type shape,
+                   std::shared_ptr<graph_slot<Predecessor>> predecessor,
+                   std::shared_ptr<graph_slot<result_type>> result,
+                   ResultFactory result_factory,
+                   SharedFactories... shared_factories)
+      : exec_(exec),
+        f_(f),
+        shape_(shape),
+        predecessor_(predecessor),
+        result_(result),
+        result_factory_(result_factory),
+        shared_factories_(shared_factories...)
+    {}
+
+    void execute()
+    {
+      execute_impl(agency::detail::make_index_sequence<sizeof...(SharedFactories)>());
+    }
+
+  private:
+    template<class P = Predecessor,
+             __AGENCY_REQUIRES(!std::is_void<P>::value)
+            >
+    node_function<Function, P, result_type> make_node_function()
+    {
+      return node_function<Function, P, result_type>{&f_, &predecessor_->value()};
+    }
+
+    template<class P = Predecessor,
+             __AGENCY_REQUIRES(std::is_void<P>::value)
+            >
+    node_function<Function, void, result_type> make_node_function()
+    {
+      return node_function<Function, void, result_type>{&f_};
+    }
+
+    template<size_t... Indices>
+    void execute_impl(agency::detail::index_sequence<Indices...>)
+    {
+      result_type* result = &result_->value_or_construct(result_factory_);
+
+      agency::bulk_sync_execute(exec_, make_node_function(), shape_, result_pointer_factory<result_type>{result}, agency::get<Indices>(shared_factories_)...);
+    }
+
+    Executor exec_;
+    Function f_;
+    shape_type shape_;
+    std::shared_ptr<graph_slot<Predecessor>> predecessor_;
+    std::shared_ptr<graph_slot<result_type>> result_;
+    ResultFactory result_factory_;
+    agency::tuple<SharedFactories...> shared_factories_;
+};
+
+
+} // end execution_graph_detail
+} // end detail
+
+
+/// \brief `graph_future` names the value produced by a node of an `execution_graph`.
+///
+/// A `graph_future` is ready only after the `execution_graph` which produces it has been replayed.
+/// Unlike other futures, `.get()` does not consume a `graph_future`: each replay updates the value it names.
+template<class T>
+class graph_future
+{
+  public:
+    graph_future() = default;
+
+    template<class... Args>
+    static graph_future make_ready(Args&&... args)
+    {
+      return graph_future(std::make_shared<detail::execution_graph_detail::graph_slot<T>>(std::forward<Args>(args)...));
+    }
+
+    bool valid() const
+    {
+      return static_cast<bool>(slot_);
+    }
+
+    bool is_ready() const
+    {
+      return valid() && slot_->has_value();
+    }
+
+    void wait() const
+    {
+      // a graph_future is waited upon by replaying its execution_graph
+    }
+
+    // returns a copy of the value produced by the most recent replay
+    T get() const
+    {
+      if(!is_ready())
+      {
+        throw std::future_error(std::future_errc::no_state);
+      }
+
+      return slot_->value();
+    }
+
+  private:
+    template<class> friend class graph_future;
+    template<class> friend class graph_executor;
+
+    explicit graph_future(std::shared_ptr<detail::execution_graph_detail::graph_slot<T>> slot)
+      : slot_(std::move(slot))
+    {}
+
+    std::shared_ptr<detail::execution_graph_detail::graph_slot<T>> slot_;
+};
+
+
+template<>
+class graph_future<void>
+{
+  public:
+    graph_future() = default;
+
+    // a graph_future<void> may name the node producing a value of any type
+    template<class T>
+    graph_future(graph_future<T>&& other)
+      : slot_(std::move(other.slot_))
+    {}
+
+    static graph_future make_ready()
+    {
+      return graph_future(std::make_shared<detail::execution_graph_detail::graph_slot<void>>());
+    }
+
+    bool valid() const
+    {
+      return static_cast<bool>(slot_);
+    }
+
+    void wait() const
+    {
+      // a graph_future is waited upon by replaying its execution_graph
+    }
+
+    void get() const
+    {
+      if(!valid())
+      {
+        throw std::future_error(std::future_errc::no_state);
+      }
+    }
+
+  private:
+    template<class> friend class graph_future;
+    template<class> friend class graph_executor;
+
+    explicit graph_future(std::shared_ptr<detail::execution_graph_detail::graph_slot_base> slot)
+      : slot_(std::move(slot))
+    {}
+
+    std::shared_ptr<detail::execution_graph_detail::graph_slot_base> slot_;
+};
+
+
+/// \brief `execution_graph` records bulk work issued through a `graph_executor` and replays it on demand.
+///
+/// Capturing work into an `execution_graph` is analogous to capturing a CUDA graph. Calls to `bulk_async()` and
+/// `bulk_then()` issued through the executor returned by `.capture(exec)` do not execute. Instead, each call records a node
+/// which remembers its function, shape, shared parameter factories and predecessor, and returns a `graph_future` naming
+/// the node's result. Each call to `.replay()` executes every node through `exec` in the order it was recorded, which is
+/// always an order in which each node follows its predecessor.
+///
+/// Replaying avoids the costs which re-issuing the same work would incur each time: functions are not rewrapped,
+/// no futures are created, and each node's result object is constructed once, on the first replay, and reused
+/// thereafter. Because agency's control structures assign each agent's result to its own element of the result
+/// object, reusing it is equivalent to constructing a fresh one.
+///
+/// Work is captured as it is issued, so its parameters, including pointers to data, are fixed at capture time.
+/// `bulk_invoke()` cannot be captured, because it must return its result immediately.
+///
+///     agency::experimental::execution_graph graph;
+///     auto exec = graph.capture(agency::parallel_executor());
+///
+///     auto stage1 = agency::bulk_async(agency::par(n).on(exec), stage1_function, data);
+///     auto stage2 = agency::bulk_then(agency::par(n).on(exec), stage2_function, stage1, data);
+///
+///     for(int i = 0; i < num_iterations; ++i)
+///     {
+///       graph.replay();
+///     }
+class execution_graph
+{
+  public:
+    execution_graph() = default;
+
+    execution_graph(execution_graph&&) = default;
+
+    execution_graph& operator=(execution_graph&&) = default;
+
+    /// \brief Returns an executor which records work issued through it into this `execution_graph`.
+    /// The recorded work executes on `exec` when this `execution_graph` is replayed.
+    template<class Executor>
+    graph_executor<Executor> capture(const Executor& exec)
+    {
+      return graph_executor<Executor>(exec, *this);
+    }
+
+    /// \brief Returns the number of nodes recorded into this `execution_graph`.
+    std::size_t size() const
+    {
+      return nodes_.size();
+    }
+
+    /// \brief Executes each recorded node, in the order it was recorded.
+    void replay()
+    {
+      for(auto& node : nodes_)
+      {
+        node->execute();
+      }
+    }
+
+    /// \brief Discards every recorded node.
+    void clear()
+    {
+      nodes_.clear();
+    }
+
+  private:
+    template<class> friend class graph_executor;
+
+    void insert(std::unique_ptr<detail::execution_graph_detail::graph_node>&& node)
+    {
+      nodes_.push_back(std::move(node));
+    }
+
+    std::vector<std::unique_ptr<detail::execution_graph_detail::graph_node>> nodes_;
+};
+
+
+/// \brief `graph_executor` records the bulk work issued through it into an `execution_graph`.
+///
+/// `graph_executor` adopts the execution category, shape and index types of its base executor.
+/// Its associated future is `graph_future`. `graph_executor`s are created by `execution_graph::capture()`.
+template<class Executor>
+class graph_executor
+{
+  public:
+    using base_executor_type = Executor;
+    using execution_category = executor_execution_category_t<base_executor_type>;
+    using shape_type = executor_shape_t<base_executor_type>;
+    using index_type = executor_index_t<base_executor_type>;
+
+    template<class T>
+    using future = graph_future<T>;
+
+  private:
+    static constexpr std::size_t execution_depth = executor_execution_depth<base_executor_type>::value;
+
+  public:
+    graph_executor(const base_executor_type& base_executor, execution_graph& graph)
+      : base_executor_(base_executor),
+        graph_(&graph)
+    {}
+
+    const base_executor_type& base_executor() const
+    {
+      return base_executor_;
+    }
+
+    execution_graph& graph() const
+    {
+      return *graph_;
+    }
+
+    shape_type unit_shape() const
+    {
+      return agency::unit_shape(base_executor_);
+    }
+
+    shape_type max_shape_dimensions() const
+    {
+      return agency::max_shape_dimensions(base_executor_);
+    }
+
+    template<class Function, class T, class ResultFactory, class... SharedFactories,
+             __AGENCY_REQUIRES(execution_depth == sizeof...(SharedFactories))
+            >
+    graph_future<agency::detail::result_of_t<ResultFactory()>>
+      bulk_then_execute(Function f, shape_type shape, graph_future<T>& predecessor, ResultFactory result_factory, SharedFactories... shared_factories) const
+    {
+      using namespace detail::execution_graph_detail;
+
+      using result_type = agency::detail::result_of_t<ResultFactory()>;
+      using node_type = bulk_then_node<base_executor_type, Function, T, ResultFactory, SharedFactories...>;
+
+      std::shared_ptr<graph_slot<T>> predecessor_slot = predecessor_slot_of(predecessor);
+      std::shared_ptr<graph_slot<result_type>> result_slot = std::make_shared<graph_slot<result_type>>();
+
+      std::unique_ptr<graph_node> node(new node_type(base_executor_, f, shape, predecessor_slot, result_slot, result_factory, shared_factories...));
+      graph_->insert(std::move(node));
+
+      return graph_future<result_type>(result_slot);
+    }
+
+  private:
+    template<class T>
+    static std::shared_ptr<detail::execution_graph_detail::graph_slot<T>> predecessor_slot_of(graph_future<T>& predecessor)
+    {
+      return predecessor.slot_;
+    }
+
+    static std::shared_ptr<detail::execution_graph_detail::graph_slot<void>> predecessor_slot_of(graph_future<void>&)
+    {
+      // void predecessors carry no value to read, and the recording order already places the node after its predecessor
+      return nullptr;
+    }
+
+    base_executor_type base_executor_;
+    execution_graph* graph_;
+};
+
+
+} // end experimental
+} // end agency
+
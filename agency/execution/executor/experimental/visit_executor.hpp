@@ -0,0 +1,78 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/execution/executor/variant_executor.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace agency
+{
+namespace experimental
+{
+namespace detail
+{
+namespace visit_executor_detail
+{
+
+
+template<class T>
+struct is_variant_executor : std::false_type {};
+
+template<class... Executors>
+struct is_variant_executor<agency::variant_executor<Executors...>> : std::true_type {};
+
+
+} // end visit_executor_detail
+} // end detail
+
+
+// visit_executor(f, exec) calls f with the statically-typed executor underlying exec and returns the result
+//
+// when exec is a variant_executor, f receives its active alternative, so work issued by f avoids
+// the per-call dispatch of variant_executor's customization points
+// otherwise, f receives exec itself
+//
+// this allows generic code to hoist dispatch out of a loop without knowing whether its executor is a variant:
+//
+//   experimental::visit_executor(loop_body, exec);
+//
+// where loop_body::operator() is a template which issues each iteration's work through the executor it receives
+__agency_exec_check_disable__
+template<class Function, class Executor,
+         __AGENCY_REQUIRES(
+           !detail::visit_executor_detail::is_variant_executor<agency::detail::decay_t<Executor>>::value
+         )>
+__AGENCY_ANNOTATION
+agency::detail::result_of_t<Function&(Executor&)>
+  visit_executor(Function&& f, Executor& exec)
+{
+  return f(exec);
+}
+
+
+__agency_exec_check_disable__
+template<class Function, class... Executors>
+__AGENCY_ANNOTATION
+auto visit_executor(Function&& f, agency::variant_executor<Executors...>& exec) ->
+  decltype(exec.visit(f))
+{
+  return exec.visit(f);
+}
+
+
+__agency_exec_check_disable__
+template<class Function, class... Executors>
+__AGENCY_ANNOTATION
+auto visit_executor(Function&& f, const agency::variant_executor<Executors...>& exec) ->
+  decltype(exec.visit(f))
+{
+  return exec.visit(f);
+}
+
+
+} // end experimental
+} // end agency
+
@@ -106,6 +106,29 @@ class variant_executor
       return variant_.index();
     }
 
+    /// visit() calls f with the active alternative executor and returns the result.
+    /// Every customization point of variant_executor dispatches on the active alternative each time it is called.
+    /// When many operations are issued through the same variant_executor, visit() hoists that dispatch out of the loop:
+    /// f is instantiated once per alternative and may issue its work through a statically-typed executor.
+    /// f must return the same type for every alternative.
+    __agency_exec_check_disable__
+    template<class Function>
+    __AGENCY_ANNOTATION
+    detail::result_of_t<Function&(Executor&)>
+      visit(Function&& f)
+    {
+      return experimental::visit(f, variant_);
+    }
+
+    __agency_exec_check_disable__
+    template<class Function>
+    __AGENCY_ANNOTATION
+    detail::result_of_t<Function&(const Executor&)>
+      visit(Function&& f) const
+    {
+      return experimental::visit(f, variant_);
+    }
+
     // customization points follow in alphabetical order
     //
     // the implementation of each follows the same pattern:
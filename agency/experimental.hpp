@@ -3,11 +3,17 @@
 #include <agency/detail/config.hpp>
 #include <agency/experimental/bounded_integer.hpp>
 #include <agency/experimental/ndarray.hpp>
+#include <agency/experimental/ndarray/copy.hpp>
+#include <agency/experimental/ndarray/stencil.hpp>
 #include <agency/experimental/optional.hpp>
+#include <agency/experimental/pipeline.hpp>
 #include <agency/experimental/ranges.hpp>
 #include <agency/experimental/segmented_array.hpp>
+#include <agency/experimental/segmented_array/algorithm.hpp>
 #include <agency/experimental/short_vector.hpp>
+#include <agency/experimental/soa_vector.hpp>
 #include <agency/experimental/span.hpp>
+#include <agency/experimental/tile_bulk_invoke.hpp>
 #include <agency/experimental/tiled_array.hpp>
 #include <agency/experimental/variant.hpp>
 
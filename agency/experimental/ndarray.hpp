@@ -1,5 +1,11 @@
 #pragma once
 
+#include <agency/experimental/ndarray/layout.hpp>
 #include <agency/experimental/ndarray/ndarray.hpp>
 #include <agency/experimental/ndarray/ndarray_ref.hpp>
+#include <agency/experimental/ndarray/subarray.hpp>
+#include <agency/experimental/ndarray/tile.hpp>
+
+// ndarray/copy.hpp and ndarray/stencil.hpp launch execution agents, so they are included by agency/experimental.hpp rather than here,
+// where it would form a cycle with the executors which include this header
 
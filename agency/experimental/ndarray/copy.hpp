@@ -0,0 +1,361 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/execution/execution_policy.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <agency/experimental/ndarray/layout.hpp>
+#include <agency/experimental/ndarray/ndarray_ref.hpp>
+#include <agency/experimental/ndarray/subarray.hpp>
+#include <agency/experimental/ndarray/detail/transpose_block.hpp>
+#include <agency/container/array.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+namespace agency
+{
+namespace experimental
+{
+namespace detail
+{
+namespace ndarray_copy_detail
+{
+
+
+// the extent of the square tiles along the source's and destination's fastest-varying dimensions
+// a tile of the source and a tile of the destination together occupy 16 KB when the elements are doubles
+constexpr std::size_t tile_extent = 32;
+
+// when the source and destination vary fastest along the same dimension, each tile is a run of this many elements instead
+constexpr std::size_t run_length = tile_extent * tile_extent;
+
+// below this many tiles per agent, tiles are copied sequentially
+constexpr std::size_t min_tiles_per_agent = 16;
+
+
+// copy_tile_elementwise() copies the ni x nj elements (i,j) from src[i * src_stride_i + j * src_stride_j] to dst[i * dst_stride_i + j * dst_stride_j]
+// dimension i is the source's fastest-varying dimension and dimension j is the destination's
+//
+// the tile is small enough that the source's rows touched by the inner loop all remain in cache,
+// so each cache line of the source and of the destination is transferred from memory once
+template<class T, class U>
+void copy_tile_elementwise(const T* src, std::size_t src_stride_i, std::size_t src_stride_j,
+                           U* dst, std::size_t dst_stride_i, std::size_t dst_stride_j,
+                           std::size_t ni, std::size_t nj)
+{
+  if(ni == 1 && src_stride_j == 1 && dst_stride_j == 1)
+  {
+    std::copy(src, src + nj, dst);
+    return;
+  }
+
+  for(std::size_t i = 0; i < ni; ++i)
+  {
+    for(std::size_t j = 0; j < nj; ++j)
+    {
+      dst[i * dst_stride_i + j * dst_stride_j] = src[i * src_stride_i + j * src_stride_j];
+    }
+  }
+}
+
+
+template<class T, class U>
+void copy_tile(const T* src, std::size_t src_stride_i, std::size_t src_stride_j,
+               U* dst, std::size_t dst_stride_i, std::size_t dst_stride_j,
+               std::size_t ni, std::size_t nj,
+               std::false_type)
+{
+  ndarray_copy_detail::copy_tile_elementwise(src, src_stride_i, src_stride_j, dst, dst_stride_i, dst_stride_j, ni, nj);
+}
+
+
+// when the source is contiguous along i and the destination is contiguous along j,
+// the interior of the tile is transposed in square blocks held in vector registers
+template<class T, class U>
+void copy_tile(const T* src, std::size_t src_stride_i, std::size_t src_stride_j,
+               U* dst, std::size_t dst_stride_i, std::size_t dst_stride_j,
+               std::size_t ni, std::size_t nj,
+               std::true_type)
+{
+  using block = transpose_block<U>;
+  const std::size_t width = block::width;
+
+  if(src_stride_i != 1 || dst_stride_j != 1)
+  {
+    ndarray_copy_detail::copy_tile_elementwise(src, src_stride_i, src_stride_j, dst, dst_stride_i, dst_stride_j, ni, nj);
+    return;
+  }
+
+  std::size_t ni_blocked = ni - ni % width;
+  std::size_t nj_blocked = nj - nj % width;
+
+  for(std::size_t i = 0; i < ni_blocked; i += width)
+  {
+    for(std::size_t j = 0; j < nj_blocked; j += width)
+    {
+      block::apply(src + i + j * src_stride_j, src_stride_j, dst + i * dst_stride_i + j, dst_stride_i);
+    }
+  }
+
+  // the ragged edges of the tile
+  ndarray_copy_detail::copy_tile_elementwise(src + nj_blocked * src_stride_j, 1, src_stride_j,
+                                             dst + nj_blocked, dst_stride_i, 1,
+                                             ni, nj - nj_blocked);
+
+  ndarray_copy_detail::copy_tile_elementwise(src + ni_blocked, 1, src_stride_j,
+                                             dst + ni_blocked * dst_stride_i, dst_stride_i, 1,
+                                             ni - ni_blocked, nj_blocked);
+}
+
+
+// tiles are transposed in blocks when the source and destination have the same type, for which transpose_block is wider than one element
+template<class T, class U>
+void copy_tile(const T* src, std::size_t src_stride_i, std::size_t src_stride_j,
+               U* dst, std::size_t dst_stride_i, std::size_t dst_stride_j,
+               std::size_t ni, std::size_t nj)
+{
+  using is_blocked = std::integral_constant<
+    bool,
+    std::is_same<typename std::remove_const<T>::type, U>::value && (transpose_block<U>::width > 1)
+  >;
+
+  ndarray_copy_detail::copy_tile(src, src_stride_i, src_stride_j, dst, dst_stride_i, dst_stride_j, ni, nj, is_blocked());
+}
+
+
+// a copy_plan divides a copy into tiles
+// the tiles span dimensions i and j and a single index of every other dimension
+template<std::size_t Rank>
+struct copy_plan
+{
+  agency::array<std::size_t, Rank> extents;
+  agency::array<std::size_t, Rank> src_strides;
+  agency::array<std::size_t, Rank> dst_strides;
+
+  // dimension j is the destination's fastest-varying dimension
+  // dimension i is the source's, unless it coincides with j, in which case tiles span a single i of extent one
+  std::size_t i_dimension;
+  std::size_t j_dimension;
+
+  std::size_t extent_i, src_stride_i, dst_stride_i;
+  std::size_t extent_j, src_stride_j, dst_stride_j;
+
+  std::size_t tile_extent_i, num_tiles_i;
+  std::size_t tile_extent_j, num_tiles_j;
+
+  std::size_t num_tiles;
+};
+
+
+// returns the dimension with the smallest stride, ignoring dimensions of extent one, which are never traversed
+template<class Array>
+std::size_t fastest_dimension(const Array& extents, const Array& strides)
+{
+  std::size_t result = extents.size() - 1;
+
+  for(std::size_t d = extents.size(); d > 0; --d)
+  {
+    if(extents[d-1] > 1 && (extents[result] <= 1 || strides[d-1] < strides[result]))
+    {
+      result = d-1;
+    }
+  }
+
+  return result;
+}
+
+
+template<std::size_t Rank>
+copy_plan<Rank> make_copy_plan(const agency::array<std::size_t, Rank>& extents,
+                               const agency::array<std::size_t, Rank>& src_strides,
+                               const agency::array<std::size_t, Rank>& dst_strides)
+{
+  copy_plan<Rank> result;
+
+  result.extents = extents;
+  result.src_strides = src_strides;
+  result.dst_strides = dst_strides;
+
+  result.j_dimension = ndarray_copy_detail::fastest_dimension(extents, dst_strides);
+  result.i_dimension = ndarray_copy_detail::fastest_dimension(extents, src_strides);
+
+  result.extent_j     = extents[result.j_dimension];
+  result.src_stride_j = src_strides[result.j_dimension];
+  result.dst_stride_j = dst_strides[result.j_dimension];
+
+  if(result.i_dimension != result.j_dimension)
+  {
+    result.extent_i     = extents[result.i_dimension];
+    result.src_stride_i = src_strides[result.i_dimension];
+    result.dst_stride_i = dst_strides[result.i_dimension];
+
+    result.tile_extent_i = tile_extent;
+    result.tile_extent_j = tile_extent;
+  }
+  else
+  {
+    result.extent_i     = 1;
+    result.src_stride_i = 0;
+    result.dst_stride_i = 0;
+
+    result.tile_extent_i = 1;
+    result.tile_extent_j = run_length;
+  }
+
+  result.num_tiles_i = (result.extent_i + result.tile_extent_i - 1) / result.tile_extent_i;
+  result.num_tiles_j = (result.extent_j + result.tile_extent_j - 1) / result.tile_extent_j;
+
+  result.num_tiles = result.num_tiles_i * result.num_tiles_j;
+  for(std::size_t d = 0; d < Rank; ++d)
+  {
+    if(d != result.i_dimension && d != result.j_dimension)
+    {
+      result.num_tiles *= extents[d];
+    }
+  }
+
+  return result;
+}
+
+
+struct copy_tiles_functor
+{
+  template<class Agent, class T, class U, std::size_t Rank>
+  void operator()(Agent& self, const T* src, U* dst, const copy_plan<Rank>& plan, std::size_t tiles_per_agent)
+  {
+    std::size_t begin = agency::detail::min(plan.num_tiles, tiles_per_agent * self.rank());
+    std::size_t end   = agency::detail::min(plan.num_tiles, begin + tiles_per_agent);
+
+    for(std::size_t tile = begin; tile < end; ++tile)
+    {
+      // decode the tile's position, with j varying fastest
+      std::size_t t = tile;
+
+      std::size_t tile_j = t % plan.num_tiles_j;
+      t /= plan.num_tiles_j;
+
+      std::size_t tile_i = t % plan.num_tiles_i;
+      t /= plan.num_tiles_i;
+
+      std::size_t j = tile_j * plan.tile_extent_j;
+      std::size_t i = tile_i * plan.tile_extent_i;
+
+      std::size_t src_offset = i * plan.src_stride_i + j * plan.src_stride_j;
+      std::size_t dst_offset = i * plan.dst_stride_i + j * plan.dst_stride_j;
+
+      for(std::size_t d = Rank; d > 0; --d)
+      {
+        if(d-1 != plan.i_dimension && d-1 != plan.j_dimension)
+        {
+          std::size_t x = t % plan.extents[d-1];
+          t /= plan.extents[d-1];
+
+          src_offset += x * plan.src_strides[d-1];
+          dst_offset += x * plan.dst_strides[d-1];
+        }
+      }
+
+      std::size_t ni = agency::detail::min(plan.tile_extent_i, plan.extent_i - i);
+      std::size_t nj = agency::detail::min(plan.tile_extent_j, plan.extent_j - j);
+
+      ndarray_copy_detail::copy_tile(src + src_offset, plan.src_stride_i, plan.src_stride_j,
+                                     dst + dst_offset, plan.dst_stride_i, plan.dst_stride_j,
+                                     ni, nj);
+    }
+  }
+};
+
+
+} // end ndarray_copy_detail
+} // end detail
+
+
+/// \brief Copies the elements of one array into another in parallel, converting between their layouts.
+///
+/// `copy` assigns `dst[idx] = src[idx]` for each index `idx` of `src`'s shape, which must equal `dst`'s shape.
+/// The arrays' layouts may differ: copying a `row_major` array into a `column_major` array, or into a strided view
+/// such as the result of `transpose` or `permute_axes`, converts the elements' order in memory.
+///
+/// When the source and destination vary fastest along different dimensions, a naive copy touches one of them with a
+/// large stride, and each of its cache lines is fetched once for every element. `copy` instead divides the arrays into
+/// 32 x 32 tiles spanning both fastest-varying dimensions, small enough that the tile of each array stays in cache while
+/// it is copied. The tiles are divided evenly among the policy's execution agents. On x86 targets with SSE2 or AVX,
+/// tiles of four- or eight-byte arithmetic elements are transposed in square blocks held in vector registers.
+///
+/// Both arrays' layouts must report their strides, as `row_major`, `column_major`, `strided`, and `padded_row_major` do.
+/// The arrays must not overlap.
+///
+/// \param policy An execution policy whose agents perform the copy.
+/// \param src The array to copy from.
+/// \param dst The array to copy to.
+template<class ExecutionPolicy, class T, class U, class Shape, class Index, class Layout1, class Layout2,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+void copy(ExecutionPolicy&& policy, const basic_ndarray_ref<T,Shape,Index,Layout1>& src, const basic_ndarray_ref<U,Shape,Index,Layout2>& dst)
+{
+  auto extents = detail::layout_detail::to_array(src.shape());
+
+  for(std::size_t d = 0; d < extents.size(); ++d)
+  {
+    if(extents[d] == 0) return;
+  }
+
+  auto plan = detail::ndarray_copy_detail::make_copy_plan(extents, src.mapping().strides(), dst.mapping().strides());
+
+  std::size_t num_agents = agency::detail::num_agents_for(policy, plan.num_tiles, detail::ndarray_copy_detail::min_tiles_per_agent);
+  std::size_t tiles_per_agent = agency::detail::ceil_div(plan.num_tiles, num_agents);
+
+  const T* src_ptr = src.data();
+  U* dst_ptr = dst.data();
+
+  agency::bulk_invoke(policy(num_agents), detail::ndarray_copy_detail::copy_tiles_functor(), src_ptr, dst_ptr, plan, tiles_per_agent);
+}
+
+
+/// \brief Copies the elements of an array into another array whose dimensions are reordered, in parallel.
+///
+/// `permute_axes(policy, src, axes, dst)` is equivalent to `copy(policy, permute_axes(src, axes), dst)`:
+/// dimension `i` of `dst` is dimension `axes[i]` of `src`.
+///
+/// \param policy An execution policy whose agents perform the copy.
+/// \param src The array to copy from.
+/// \param axes The permutation of `src`'s dimensions.
+/// \param dst The array to copy to.
+template<class ExecutionPolicy, class T, class U, class Shape, class Index, class Layout1, class Layout2,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+void permute_axes(ExecutionPolicy&& policy,
+                  const basic_ndarray_ref<T,Shape,Index,Layout1>& src,
+                  const agency::array<std::size_t, agency::detail::shape_size<Shape>::value>& axes,
+                  const basic_ndarray_ref<U,Shape,Index,Layout2>& dst)
+{
+  experimental::copy(std::forward<ExecutionPolicy>(policy), experimental::permute_axes(src, axes), dst);
+}
+
+
+/// \brief Copies the transpose of an array into another array in parallel.
+///
+/// `transpose(policy, src, dst)` is equivalent to `copy(policy, transpose(src), dst)`:
+/// for rank-2 arrays, `dst[{j,i}]` receives `src[{i,j}]`.
+///
+/// \param policy An execution policy whose agents perform the copy.
+/// \param src The array to transpose.
+/// \param dst The array to copy to.
+template<class ExecutionPolicy, class T, class U, class Shape, class Index, class Layout1, class Layout2,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+void transpose(ExecutionPolicy&& policy, const basic_ndarray_ref<T,Shape,Index,Layout1>& src, const basic_ndarray_ref<U,Shape,Index,Layout2>& dst)
+{
+  experimental::copy(std::forward<ExecutionPolicy>(policy), experimental::transpose(src), dst);
+}
+
+
+} // end experimental
+} // end agency
+
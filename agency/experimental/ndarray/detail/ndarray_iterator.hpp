@@ -0,0 +1,183 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/experimental/ndarray/layout.hpp>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace agency
+{
+namespace experimental
+{
+namespace detail
+{
+
+
+// ndarray_iterator traverses the elements of an array with a flat shape in the lexicographic order of their indices,
+// regardless of the order in which its Mapping stores them. Padding between elements is skipped.
+// Each element's address is computed by converting the iterator's position into an Index and mapping
+// that Index to an offset, so traversing a row-major array with a pointer is cheaper.
+template<class T, class Index, class Mapping>
+class ndarray_iterator
+{
+  public:
+    using value_type = typename std::remove_cv<T>::type;
+    using reference = T&;
+    using pointer = T*;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+
+    __AGENCY_ANNOTATION
+    ndarray_iterator() : ndarray_iterator(nullptr, Mapping(), 0) {}
+
+    __AGENCY_ANNOTATION
+    ndarray_iterator(pointer data, const Mapping& mapping, difference_type position)
+      : data_(data),
+        mapping_(mapping),
+        position_(position)
+    {}
+
+    // dereference
+    __AGENCY_ANNOTATION
+    reference operator*() const
+    {
+      return (*this)[0];
+    }
+
+    // subscript
+    __AGENCY_ANNOTATION
+    reference operator[](difference_type n) const
+    {
+      Index idx = layout_detail::lexicographic_unrank<Index>(position_ + n, mapping_.shape());
+      return data_[mapping_(idx)];
+    }
+
+    // pre-increment
+    __AGENCY_ANNOTATION
+    ndarray_iterator& operator++()
+    {
+      ++position_;
+      return *this;
+    }
+
+    // post-increment
+    __AGENCY_ANNOTATION
+    ndarray_iterator operator++(int)
+    {
+      ndarray_iterator result = *this;
+      ++position_;
+      return result;
+    }
+
+    // pre-decrement
+    __AGENCY_ANNOTATION
+    ndarray_iterator& operator--()
+    {
+      --position_;
+      return *this;
+    }
+
+    // post-decrement
+    __AGENCY_ANNOTATION
+    ndarray_iterator operator--(int)
+    {
+      ndarray_iterator result = *this;
+      --position_;
+      return result;
+    }
+
+    // plus-equal
+    __AGENCY_ANNOTATION
+    ndarray_iterator& operator+=(difference_type n)
+    {
+      position_ += n;
+      return *this;
+    }
+
+    // minus-equal
+    __AGENCY_ANNOTATION
+    ndarray_iterator& operator-=(difference_type n)
+    {
+      position_ -= n;
+      return *this;
+    }
+
+    // plus
+    __AGENCY_ANNOTATION
+    ndarray_iterator operator+(difference_type n) const
+    {
+      ndarray_iterator result = *this;
+      result += n;
+      return result;
+    }
+
+    // minus
+    __AGENCY_ANNOTATION
+    ndarray_iterator operator-(difference_type n) const
+    {
+      ndarray_iterator result = *this;
+      result -= n;
+      return result;
+    }
+
+    // difference
+    __AGENCY_ANNOTATION
+    difference_type operator-(const ndarray_iterator& rhs) const
+    {
+      return position_ - rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator==(const ndarray_iterator& rhs) const
+    {
+      return position_ == rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator!=(const ndarray_iterator& rhs) const
+    {
+      return position_ != rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator<(const ndarray_iterator& rhs) const
+    {
+      return position_ < rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator<=(const ndarray_iterator& rhs) const
+    {
+      return position_ <= rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator>(const ndarray_iterator& rhs) const
+    {
+      return position_ > rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator>=(const ndarray_iterator& rhs) const
+    {
+      return position_ >= rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    friend ndarray_iterator operator+(difference_type n, const ndarray_iterator& iter)
+    {
+      return iter + n;
+    }
+
+  private:
+    pointer data_;
+    Mapping mapping_;
+    difference_type position_;
+};
+
+
+} // end detail
+} // end experimental
+} // end agency
+
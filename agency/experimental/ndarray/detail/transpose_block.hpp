@@ -0,0 +1,183 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <cstddef>
+#include <type_traits>
+
+// the in-register transposes below are host-only, so they are disabled when compiling for the device
+#if !defined(__CUDA_ARCH__)
+#  if defined(__AVX__)
+#    include <immintrin.h>
+#    define __AGENCY_NDARRAY_TRANSPOSE_AVX 1
+#  elif defined(__SSE2__)
+#    include <emmintrin.h>
+#    define __AGENCY_NDARRAY_TRANSPOSE_SSE2 1
+#  endif
+#endif
+
+namespace agency
+{
+namespace experimental
+{
+namespace detail
+{
+namespace ndarray_copy_detail
+{
+
+
+// transpose_block<T>::apply() transposes a square block of width x width elements:
+// row r of the block begins at src + r * src_stride and becomes column r of the block beginning at dst,
+// whose rows are dst_stride elements apart.
+//
+// For arithmetic types of four or eight bytes on x86, the block is loaded into vector registers, shuffled, and stored,
+// so that both the loads and the stores are contiguous. The shuffles only move bits, so integers are transposed
+// through the floating point registers of the same width. Otherwise, the block is a single element.
+template<class T, class Enable = void>
+struct transpose_block
+{
+  static constexpr std::size_t width = 1;
+
+  __agency_exec_check_disable__
+  template<class U>
+  __AGENCY_ANNOTATION
+  static void apply(const T* src, std::size_t, U* dst, std::size_t)
+  {
+    *dst = *src;
+  }
+};
+
+
+#if defined(__AGENCY_NDARRAY_TRANSPOSE_AVX)
+
+template<class T>
+struct transpose_block<T, typename std::enable_if<std::is_arithmetic<T>::value && sizeof(T) == 4>::type>
+{
+  static constexpr std::size_t width = 8;
+
+  static void apply(const T* src_, std::size_t src_stride, T* dst_, std::size_t dst_stride)
+  {
+    const float* src = reinterpret_cast<const float*>(src_);
+    float* dst = reinterpret_cast<float*>(dst_);
+
+    __m256 r0 = _mm256_loadu_ps(src + 0 * src_stride);
+    __m256 r1 = _mm256_loadu_ps(src + 1 * src_stride);
+    __m256 r2 = _mm256_loadu_ps(src + 2 * src_stride);
+    __m256 r3 = _mm256_loadu_ps(src + 3 * src_stride);
+    __m256 r4 = _mm256_loadu_ps(src + 4 * src_stride);
+    __m256 r5 = _mm256_loadu_ps(src + 5 * src_stride);
+    __m256 r6 = _mm256_loadu_ps(src + 6 * src_stride);
+    __m256 r7 = _mm256_loadu_ps(src + 7 * src_stride);
+
+    // interleave pairs of rows
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+    // gather 4x4 transposes within each 128-bit lane
+    __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1,0,1,0));
+    __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3,2,3,2));
+    __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1,0,1,0));
+    __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3,2,3,2));
+    __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1,0,1,0));
+    __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3,2,3,2));
+    __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1,0,1,0));
+    __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3,2,3,2));
+
+    // exchange the lanes
+    _mm256_storeu_ps(dst + 0 * dst_stride, _mm256_permute2f128_ps(u0, u4, 0x20));
+    _mm256_storeu_ps(dst + 1 * dst_stride, _mm256_permute2f128_ps(u1, u5, 0x20));
+    _mm256_storeu_ps(dst + 2 * dst_stride, _mm256_permute2f128_ps(u2, u6, 0x20));
+    _mm256_storeu_ps(dst + 3 * dst_stride, _mm256_permute2f128_ps(u3, u7, 0x20));
+    _mm256_storeu_ps(dst + 4 * dst_stride, _mm256_permute2f128_ps(u0, u4, 0x31));
+    _mm256_storeu_ps(dst + 5 * dst_stride, _mm256_permute2f128_ps(u1, u5, 0x31));
+    _mm256_storeu_ps(dst + 6 * dst_stride, _mm256_permute2f128_ps(u2, u6, 0x31));
+    _mm256_storeu_ps(dst + 7 * dst_stride, _mm256_permute2f128_ps(u3, u7, 0x31));
+  }
+};
+
+
+template<class T>
+struct transpose_block<T, typename std::enable_if<std::is_arithmetic<T>::value && sizeof(T) == 8>::type>
+{
+  static constexpr std::size_t width = 4;
+
+  static void apply(const T* src_, std::size_t src_stride, T* dst_, std::size_t dst_stride)
+  {
+    const double* src = reinterpret_cast<const double*>(src_);
+    double* dst = reinterpret_cast<double*>(dst_);
+
+    __m256d r0 = _mm256_loadu_pd(src + 0 * src_stride);
+    __m256d r1 = _mm256_loadu_pd(src + 1 * src_stride);
+    __m256d r2 = _mm256_loadu_pd(src + 2 * src_stride);
+    __m256d r3 = _mm256_loadu_pd(src + 3 * src_stride);
+
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+    _mm256_storeu_pd(dst + 0 * dst_stride, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(dst + 1 * dst_stride, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(dst + 2 * dst_stride, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(dst + 3 * dst_stride, _mm256_permute2f128_pd(t1, t3, 0x31));
+  }
+};
+
+#elif defined(__AGENCY_NDARRAY_TRANSPOSE_SSE2)
+
+template<class T>
+struct transpose_block<T, typename std::enable_if<std::is_arithmetic<T>::value && sizeof(T) == 4>::type>
+{
+  static constexpr std::size_t width = 4;
+
+  static void apply(const T* src_, std::size_t src_stride, T* dst_, std::size_t dst_stride)
+  {
+    const float* src = reinterpret_cast<const float*>(src_);
+    float* dst = reinterpret_cast<float*>(dst_);
+
+    __m128 r0 = _mm_loadu_ps(src + 0 * src_stride);
+    __m128 r1 = _mm_loadu_ps(src + 1 * src_stride);
+    __m128 r2 = _mm_loadu_ps(src + 2 * src_stride);
+    __m128 r3 = _mm_loadu_ps(src + 3 * src_stride);
+
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+    _mm_storeu_ps(dst + 0 * dst_stride, r0);
+    _mm_storeu_ps(dst + 1 * dst_stride, r1);
+    _mm_storeu_ps(dst + 2 * dst_stride, r2);
+    _mm_storeu_ps(dst + 3 * dst_stride, r3);
+  }
+};
+
+
+template<class T>
+struct transpose_block<T, typename std::enable_if<std::is_arithmetic<T>::value && sizeof(T) == 8>::type>
+{
+  static constexpr std::size_t width = 2;
+
+  static void apply(const T* src_, std::size_t src_stride, T* dst_, std::size_t dst_stride)
+  {
+    const double* src = reinterpret_cast<const double*>(src_);
+    double* dst = reinterpret_cast<double*>(dst_);
+
+    __m128d r0 = _mm_loadu_pd(src + 0 * src_stride);
+    __m128d r1 = _mm_loadu_pd(src + 1 * src_stride);
+
+    _mm_storeu_pd(dst + 0 * dst_stride, _mm_unpacklo_pd(r0, r1));
+    _mm_storeu_pd(dst + 1 * dst_stride, _mm_unpackhi_pd(r0, r1));
+  }
+};
+
+#endif
+
+
+} // end ndarray_copy_detail
+} // end detail
+} // end experimental
+} // end agency
+
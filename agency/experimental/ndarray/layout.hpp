@@ -0,0 +1,864 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/detail/shape.hpp>
+#include <agency/detail/index_lexicographical_rank.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/detail/integer_sequence.hpp>
+#include <agency/coordinate/detail/shape/shape_element.hpp>
+#include <agency/coordinate/detail/shape/shape_size.hpp>
+#include <agency/coordinate.hpp>
+#include <agency/container/array.hpp>
+#include <agency/tuple.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <tuple>
+
+namespace agency
+{
+namespace experimental
+{
+namespace detail
+{
+namespace layout_detail
+{
+
+
+// a Shape is flat when it is an integral type or a tuple of integral types
+template<class Shape, class Enable = void>
+struct is_flat_shape : std::false_type {};
+
+template<class Shape>
+struct is_flat_shape<Shape, typename std::enable_if<std::is_integral<Shape>::value>::type> : std::true_type {};
+
+template<class T, std::size_t Rank>
+struct is_flat_shape<point<T,Rank>, typename std::enable_if<std::is_integral<T>::value>::type> : std::true_type {};
+
+template<class... Types>
+struct is_flat_shape<agency::tuple<Types...>> : agency::detail::conjunction<std::is_integral<Types>...> {};
+
+
+// extent<i>() returns the ith element of a flat Shape or Index
+template<std::size_t i, class T,
+         __AGENCY_REQUIRES(std::is_integral<T>::value)>
+__AGENCY_ANNOTATION
+std::size_t extent(const T& x)
+{
+  static_assert(i == 0, "An integral extent has a single dimension.");
+  return x;
+}
+
+template<std::size_t i, class T,
+         __AGENCY_REQUIRES(!std::is_integral<T>::value)>
+__AGENCY_ANNOTATION
+std::size_t extent(const T& x)
+{
+  return agency::get<i>(x);
+}
+
+
+// the ith element of the parameter pack Values
+template<std::size_t i, std::size_t... Values>
+struct pack_element;
+
+template<std::size_t Value, std::size_t... Values>
+struct pack_element<0, Value, Values...> : std::integral_constant<std::size_t, Value> {};
+
+template<std::size_t i, std::size_t Value, std::size_t... Values>
+struct pack_element<i, Value, Values...> : pack_element<i-1, Values...> {};
+
+
+// horner<i>::rank(view) returns ((c0 * e1 + c1) * e2 + c2) ... * ei + ci
+// where cj is view.coordinate<j>() and ej is view.extent<j>()
+// for a rank 2 or rank 3 view, this unrolls into a short chain of multiply-adds
+template<std::size_t i>
+struct horner
+{
+  template<class View>
+  __AGENCY_ANNOTATION
+  static std::size_t rank(const View& view)
+  {
+    return horner<i-1>::rank(view) * view.template extent<i>() + view.template coordinate<i>();
+  }
+};
+
+template<>
+struct horner<0>
+{
+  template<class View>
+  __AGENCY_ANNOTATION
+  static std::size_t rank(const View& view)
+  {
+    return view.template coordinate<0>();
+  }
+};
+
+
+// views an index and shape in their natural order
+template<class Index, class Shape>
+struct lexicographic_view
+{
+  const Index& idx;
+  const Shape& shape;
+
+  template<std::size_t i>
+  __AGENCY_ANNOTATION
+  std::size_t coordinate() const { return layout_detail::extent<i>(idx); }
+
+  template<std::size_t i>
+  __AGENCY_ANNOTATION
+  std::size_t extent() const { return layout_detail::extent<i>(shape); }
+};
+
+
+// views an index and shape with the order of their dimensions reversed
+template<class Index, class Shape>
+struct reversed_view
+{
+  static constexpr std::size_t last = agency::detail::shape_size<Shape>::value - 1;
+
+  const Index& idx;
+  const Shape& shape;
+
+  template<std::size_t i>
+  __AGENCY_ANNOTATION
+  std::size_t coordinate() const { return layout_detail::extent<last - i>(idx); }
+
+  template<std::size_t i>
+  __AGENCY_ANNOTATION
+  std::size_t extent() const { return layout_detail::extent<last - i>(shape); }
+};
+
+
+// like lexicographic_view, except that the extent of the last dimension is replaced by a pitch
+template<class Index, class Shape>
+struct pitched_view
+{
+  static constexpr std::size_t last = agency::detail::shape_size<Shape>::value - 1;
+
+  const Index& idx;
+  const Shape& shape;
+  std::size_t pitch;
+
+  template<std::size_t i>
+  __AGENCY_ANNOTATION
+  std::size_t coordinate() const { return layout_detail::extent<i>(idx); }
+
+  template<std::size_t i>
+  __AGENCY_ANNOTATION
+  std::size_t extent() const { return i == last ? pitch : layout_detail::extent<i>(shape); }
+};
+
+
+// views the index of the tile containing an index within the grid of tiles covering a shape
+template<class Index, class Shape, std::size_t... TileExtents>
+struct tile_grid_view
+{
+  const Index& idx;
+  const Shape& shape;
+
+  template<std::size_t i>
+  __AGENCY_ANNOTATION
+  std::size_t coordinate() const { return layout_detail::extent<i>(idx) / pack_element<i,TileExtents...>::value; }
+
+  template<std::size_t i>
+  __AGENCY_ANNOTATION
+  std::size_t extent() const
+  {
+    return (layout_detail::extent<i>(shape) + pack_element<i,TileExtents...>::value - 1) / pack_element<i,TileExtents...>::value;
+  }
+};
+
+
+// views the position of an index within its tile
+template<class Index, std::size_t... TileExtents>
+struct within_tile_view
+{
+  const Index& idx;
+
+  template<std::size_t i>
+  __AGENCY_ANNOTATION
+  std::size_t coordinate() const { return layout_detail::extent<i>(idx) % pack_element<i,TileExtents...>::value; }
+
+  template<std::size_t i>
+  __AGENCY_ANNOTATION
+  std::size_t extent() const { return pack_element<i,TileExtents...>::value; }
+};
+
+
+// dot<i>::product(idx, strides) returns idx[0] * strides[0] + ... + idx[i] * strides[i]
+template<std::size_t i>
+struct dot
+{
+  template<class Index, class Strides>
+  __AGENCY_ANNOTATION
+  static std::size_t product(const Index& idx, const Strides& strides)
+  {
+    return dot<i-1>::product(idx, strides) + layout_detail::extent<i>(idx) * strides[i];
+  }
+};
+
+template<>
+struct dot<0>
+{
+  template<class Index, class Strides>
+  __AGENCY_ANNOTATION
+  static std::size_t product(const Index& idx, const Strides& strides)
+  {
+    return layout_detail::extent<0>(idx) * strides[0];
+  }
+};
+
+
+// spreads the low 32 bits of x so that one zero bit separates each
+__AGENCY_ANNOTATION
+inline std::uint64_t spread_bits_by_1(std::uint64_t x)
+{
+  x &= 0x00000000ffffffffull;
+  x = (x | (x << 16)) & 0x0000ffff0000ffffull;
+  x = (x | (x <<  8)) & 0x00ff00ff00ff00ffull;
+  x = (x | (x <<  4)) & 0x0f0f0f0f0f0f0f0full;
+  x = (x | (x <<  2)) & 0x3333333333333333ull;
+  x = (x | (x <<  1)) & 0x5555555555555555ull;
+  return x;
+}
+
+
+// spreads the low 21 bits of x so that two zero bits separate each
+__AGENCY_ANNOTATION
+inline std::uint64_t spread_bits_by_2(std::uint64_t x)
+{
+  x &= 0x00000000001fffffull;
+  x = (x | (x << 32)) & 0x001f00000000ffffull;
+  x = (x | (x << 16)) & 0x001f0000ff0000ffull;
+  x = (x | (x <<  8)) & 0x100f00f00f00f00full;
+  x = (x | (x <<  4)) & 0x10c30c30c30c30c3ull;
+  x = (x | (x <<  2)) & 0x1249249249249249ull;
+  return x;
+}
+
+
+// interleaves the bits of an index's coordinates
+// the last dimension occupies the lowest bit, as it would in a row-major layout
+template<class Index>
+__AGENCY_ANNOTATION
+std::size_t morton_rank(const Index& idx, std::integral_constant<std::size_t,1>)
+{
+  return layout_detail::extent<0>(idx);
+}
+
+template<class Index>
+__AGENCY_ANNOTATION
+std::size_t morton_rank(const Index& idx, std::integral_constant<std::size_t,2>)
+{
+  return (spread_bits_by_1(layout_detail::extent<0>(idx)) << 1) |
+          spread_bits_by_1(layout_detail::extent<1>(idx));
+}
+
+template<class Index>
+__AGENCY_ANNOTATION
+std::size_t morton_rank(const Index& idx, std::integral_constant<std::size_t,3>)
+{
+  return (spread_bits_by_2(layout_detail::extent<0>(idx)) << 2) |
+         (spread_bits_by_2(layout_detail::extent<1>(idx)) << 1) |
+          spread_bits_by_2(layout_detail::extent<2>(idx));
+}
+
+
+// to_array<i>::fill() copies the first i+1 elements of a flat Shape into an array
+template<std::size_t i>
+struct to_array_impl
+{
+  template<class Shape, class Array>
+  __AGENCY_ANNOTATION
+  static void fill(const Shape& shape, Array& result)
+  {
+    to_array_impl<i-1>::fill(shape, result);
+    result[i] = layout_detail::extent<i>(shape);
+  }
+};
+
+template<>
+struct to_array_impl<0>
+{
+  template<class Shape, class Array>
+  __AGENCY_ANNOTATION
+  static void fill(const Shape& shape, Array& result)
+  {
+    result[0] = layout_detail::extent<0>(shape);
+  }
+};
+
+
+// returns the extents of a flat Shape as an array
+template<class Shape>
+__AGENCY_ANNOTATION
+agency::array<std::size_t, agency::detail::shape_size<Shape>::value> to_array(const Shape& shape)
+{
+  agency::array<std::size_t, agency::detail::shape_size<Shape>::value> result;
+  to_array_impl<agency::detail::shape_size<Shape>::value - 1>::fill(shape, result);
+  return result;
+}
+
+
+// returns the index of the last element of a non-empty shape
+template<class Shape>
+__AGENCY_ANNOTATION
+agency::array<std::size_t, agency::detail::shape_size<Shape>::value> last_index(const Shape& shape)
+{
+  auto result = layout_detail::to_array(shape);
+
+  for(std::size_t i = 0; i < result.size(); ++i)
+  {
+    result[i] -= 1;
+  }
+
+  return result;
+}
+
+
+// from_array() converts an array of extents into a flat Shape
+template<class Shape, class Array, std::size_t... Indices>
+__AGENCY_ANNOTATION
+Shape from_array_impl(const Array& extents, agency::detail::index_sequence<Indices...>)
+{
+  return Shape{static_cast<agency::detail::shape_element_t<Indices,Shape>>(extents[Indices])...};
+}
+
+template<class Shape, class Array>
+__AGENCY_ANNOTATION
+Shape from_array(const Array& extents)
+{
+  return layout_detail::from_array_impl<Shape>(extents, agency::detail::make_index_sequence<agency::detail::shape_size<Shape>::value>());
+}
+
+
+// returns the index whose rank is r in the lexicographic order of the indices of a flat Shape
+// the last dimension varies fastest, as it does in a row-major layout
+template<class Index, class Shape>
+__AGENCY_ANNOTATION
+Index lexicographic_unrank(std::size_t r, const Shape& shape)
+{
+  auto extents = layout_detail::to_array(shape);
+  auto result = extents;
+
+  for(std::size_t i = extents.size(); i > 0; --i)
+  {
+    result[i-1] = r % extents[i-1];
+    r /= extents[i-1];
+  }
+
+  return layout_detail::from_array<Index>(result);
+}
+
+
+// returns the strides of a row-major array with the given extents
+template<class Array>
+__AGENCY_ANNOTATION
+Array row_major_strides(const Array& extents)
+{
+  Array result;
+
+  std::size_t stride = 1;
+  for(std::size_t i = extents.size(); i > 0; --i)
+  {
+    result[i-1] = stride;
+    stride *= extents[i-1];
+  }
+
+  return result;
+}
+
+
+} // end layout_detail
+} // end detail
+
+
+/// \brief The row-major layout, which is the default layout of `basic_ndarray` and `basic_ndarray_ref`.
+///
+/// `row_major` stores elements in the lexicographic order of their indices: the last dimension varies fastest.
+/// It is the only layout which accepts hierarchical shapes. For flat shapes, an index's offset is computed in
+/// Horner form, so a rank-2 index `(i,j)` maps to `i * n1 + j`, and a rank-3 index `(i,j,k)` maps to `(i * n1 + j) * n2 + k`.
+struct row_major
+{
+  template<class Shape>
+  class mapping
+  {
+    public:
+      using shape_type = Shape;
+
+      __AGENCY_ANNOTATION
+      mapping() : mapping(shape_type{}) {}
+
+      __AGENCY_ANNOTATION
+      explicit mapping(const shape_type& shape) : shape_(shape) {}
+
+      template<class OtherShape,
+               __AGENCY_REQUIRES(std::is_convertible<OtherShape,shape_type>::value)>
+      __AGENCY_ANNOTATION
+      mapping(const mapping<OtherShape>& other) : mapping(shape_type(other.shape())) {}
+
+      __AGENCY_ANNOTATION
+      shape_type shape() const
+      {
+        return shape_;
+      }
+
+      /// \brief Returns the number of elements required to store an array with this mapping.
+      __AGENCY_ANNOTATION
+      std::size_t required_span_size() const
+      {
+        return agency::detail::index_space_size(shape_);
+      }
+
+      __AGENCY_ANNOTATION
+      static constexpr bool is_always_exhaustive()
+      {
+        return true;
+      }
+
+      /// \brief Returns the distance in elements between neighbors along each dimension of a flat shape.
+      __AGENCY_ANNOTATION
+      agency::array<std::size_t, agency::detail::shape_size<shape_type>::value> strides() const
+      {
+        return detail::layout_detail::row_major_strides(detail::layout_detail::to_array(shape_));
+      }
+
+      /// \brief Returns the offset of the element at the given index.
+      template<class Index>
+      __AGENCY_ANNOTATION
+      std::size_t operator()(const Index& idx) const
+      {
+        return offset(idx, detail::layout_detail::is_flat_shape<shape_type>());
+      }
+
+    private:
+      template<class Index>
+      __AGENCY_ANNOTATION
+      std::size_t offset(const Index& idx, std::true_type) const
+      {
+        using view_type = detail::layout_detail::lexicographic_view<Index,shape_type>;
+        return detail::layout_detail::horner<agency::detail::shape_size<shape_type>::value - 1>::rank(view_type{idx, shape_});
+      }
+
+      // hierarchical shapes fall back to the general lexicographic rank
+      template<class Index>
+      __AGENCY_ANNOTATION
+      std::size_t offset(const Index& idx, std::false_type) const
+      {
+        return agency::detail::index_lexicographical_rank(idx, shape_);
+      }
+
+      shape_type shape_;
+  };
+};
+
+
+/// \brief The column-major layout, in which the first dimension varies fastest.
+///
+/// A rank-2 index `(i,j)` maps to `j * n0 + i`.
+struct column_major
+{
+  template<class Shape>
+  class mapping
+  {
+    public:
+      static_assert(detail::layout_detail::is_flat_shape<Shape>::value, "column_major requires a flat Shape.");
+
+      using shape_type = Shape;
+
+      __AGENCY_ANNOTATION
+      mapping() : mapping(shape_type{}) {}
+
+      __AGENCY_ANNOTATION
+      explicit mapping(const shape_type& shape) : shape_(shape) {}
+
+      template<class OtherShape,
+               __AGENCY_REQUIRES(std::is_convertible<OtherShape,shape_type>::value)>
+      __AGENCY_ANNOTATION
+      mapping(const mapping<OtherShape>& other) : mapping(shape_type(other.shape())) {}
+
+      __AGENCY_ANNOTATION
+      shape_type shape() const
+      {
+        return shape_;
+      }
+
+      __AGENCY_ANNOTATION
+      std::size_t required_span_size() const
+      {
+        return agency::detail::index_space_size(shape_);
+      }
+
+      __AGENCY_ANNOTATION
+      static constexpr bool is_always_exhaustive()
+      {
+        return true;
+      }
+
+      __AGENCY_ANNOTATION
+      agency::array<std::size_t, agency::detail::shape_size<shape_type>::value> strides() const
+      {
+        auto extents = detail::layout_detail::to_array(shape_);
+
+        agency::array<std::size_t, agency::detail::shape_size<shape_type>::value> result;
+
+        std::size_t stride = 1;
+        for(std::size_t i = 0; i < extents.size(); ++i)
+        {
+          result[i] = stride;
+          stride *= extents[i];
+        }
+
+        return result;
+      }
+
+      template<class Index>
+      __AGENCY_ANNOTATION
+      std::size_t operator()(const Index& idx) const
+      {
+        using view_type = detail::layout_detail::reversed_view<Index,shape_type>;
+        return detail::layout_detail::horner<agency::detail::shape_size<shape_type>::value - 1>::rank(view_type{idx, shape_});
+      }
+
+    private:
+      shape_type shape_;
+  };
+};
+
+
+/// \brief A layout with an explicit stride for each dimension.
+///
+/// An index's offset is the sum of each of its coordinates multiplied by the corresponding stride.
+/// By default, the strides are those of a row-major array of the same shape. `strided` views can describe
+/// subarrays, transposed arrays, and arrays whose rows or columns are padded.
+struct strided
+{
+  template<class Shape>
+  class mapping
+  {
+    public:
+      static_assert(detail::layout_detail::is_flat_shape<Shape>::value, "strided requires a flat Shape.");
+
+      using shape_type = Shape;
+      using strides_type = agency::array<std::size_t, agency::detail::shape_size<Shape>::value>;
+
+      __AGENCY_ANNOTATION
+      mapping() : mapping(shape_type{}) {}
+
+      __AGENCY_ANNOTATION
+      explicit mapping(const shape_type& shape)
+        : shape_(shape)
+      {
+        // default to row-major strides
+        strides_ = detail::layout_detail::row_major_strides(detail::layout_detail::to_array(shape));
+      }
+
+      __AGENCY_ANNOTATION
+      mapping(const shape_type& shape, const strides_type& strides)
+        : shape_(shape), strides_(strides)
+      {}
+
+      template<class OtherShape,
+               __AGENCY_REQUIRES(std::is_convertible<OtherShape,shape_type>::value)>
+      __AGENCY_ANNOTATION
+      mapping(const mapping<OtherShape>& other) : mapping(shape_type(other.shape()), other.strides()) {}
+
+      __AGENCY_ANNOTATION
+      shape_type shape() const
+      {
+        return shape_;
+      }
+
+      __AGENCY_ANNOTATION
+      const strides_type& strides() const
+      {
+        return strides_;
+      }
+
+      __AGENCY_ANNOTATION
+      std::size_t stride(std::size_t dimension) const
+      {
+        return strides_[dimension];
+      }
+
+      /// \brief Returns one more than the largest offset of any index, or zero when the shape is empty.
+      __AGENCY_ANNOTATION
+      std::size_t required_span_size() const
+      {
+        auto extents = detail::layout_detail::to_array(shape_);
+
+        std::size_t result = 1;
+        for(std::size_t i = 0; i < extents.size(); ++i)
+        {
+          if(extents[i] == 0) return 0;
+
+          result += (extents[i] - 1) * strides_[i];
+        }
+
+        return result;
+      }
+
+      __AGENCY_ANNOTATION
+      static constexpr bool is_always_exhaustive()
+      {
+        return false;
+      }
+
+      template<class Index>
+      __AGENCY_ANNOTATION
+      std::size_t operator()(const Index& idx) const
+      {
+        return detail::layout_detail::dot<agency::detail::shape_size<shape_type>::value - 1>::product(idx, strides_);
+      }
+
+    private:
+      shape_type shape_;
+      strides_type strides_;
+  };
+};
+
+
+/// \brief A row-major layout whose rows are padded to a multiple of `Alignment` elements.
+///
+/// The distance between the beginnings of consecutive rows, the leading dimension, may also be given explicitly.
+/// Padding the leading dimension aligns each row and keeps rows of power-of-two lengths from mapping to the same cache sets.
+template<std::size_t Alignment = 1>
+struct padded_row_major
+{
+  template<class Shape>
+  class mapping
+  {
+    public:
+      static_assert(detail::layout_detail::is_flat_shape<Shape>::value, "padded_row_major requires a flat Shape.");
+      static_assert(Alignment > 0, "Alignment must be positive.");
+
+      using shape_type = Shape;
+
+      __AGENCY_ANNOTATION
+      mapping() : mapping(shape_type{}) {}
+
+      __AGENCY_ANNOTATION
+      explicit mapping(const shape_type& shape)
+        : mapping(shape, (row_size(shape) + Alignment - 1) / Alignment * Alignment)
+      {}
+
+      __AGENCY_ANNOTATION
+      mapping(const shape_type& shape, std::size_t leading_dimension)
+        : shape_(shape), leading_dimension_(leading_dimension)
+      {}
+
+      template<class OtherShape,
+               __AGENCY_REQUIRES(std::is_convertible<OtherShape,shape_type>::value)>
+      __AGENCY_ANNOTATION
+      mapping(const mapping<OtherShape>& other) : mapping(shape_type(other.shape()), other.leading_dimension()) {}
+
+      __AGENCY_ANNOTATION
+      shape_type shape() const
+      {
+        return shape_;
+      }
+
+      /// \brief Returns the distance between the beginnings of consecutive rows.
+      __AGENCY_ANNOTATION
+      std::size_t leading_dimension() const
+      {
+        return leading_dimension_;
+      }
+
+      __AGENCY_ANNOTATION
+      agency::array<std::size_t, agency::detail::shape_size<shape_type>::value> strides() const
+      {
+        // the strides are row-major, except that consecutive rows are leading_dimension() elements apart
+        auto extents = detail::layout_detail::to_array(shape_);
+        extents[extents.size() - 1] = leading_dimension_;
+
+        return detail::layout_detail::row_major_strides(extents);
+      }
+
+      __AGENCY_ANNOTATION
+      std::size_t required_span_size() const
+      {
+        std::size_t size = agency::detail::index_space_size(shape_);
+        return size == 0 ? 0 : size / row_size(shape_) * leading_dimension_;
+      }
+
+      __AGENCY_ANNOTATION
+      static constexpr bool is_always_exhaustive()
+      {
+        return false;
+      }
+
+      template<class Index>
+      __AGENCY_ANNOTATION
+      std::size_t operator()(const Index& idx) const
+      {
+        using view_type = detail::layout_detail::pitched_view<Index,shape_type>;
+        return detail::layout_detail::horner<agency::detail::shape_size<shape_type>::value - 1>::rank(view_type{idx, shape_, leading_dimension_});
+      }
+
+    private:
+      __AGENCY_ANNOTATION
+      static std::size_t row_size(const shape_type& shape)
+      {
+        return detail::layout_detail::extent<agency::detail::shape_size<shape_type>::value - 1>(shape);
+      }
+
+      shape_type shape_;
+      std::size_t leading_dimension_;
+  };
+};
+
+
+/// \brief A blocked layout which stores each tile of `TileExtents...` elements contiguously.
+///
+/// Tiles are arranged in row-major order, and so are the elements within each tile. When the shape is not a multiple of the tile
+/// shape, the storage of the partial tiles at its edges is padded. An index's tile and its position within that tile are computed
+/// with divisions and remainders by the compile-time tile extents, which reduce to shifts and masks when the extents are powers of two.
+template<std::size_t... TileExtents>
+struct tiled
+{
+  template<class Shape>
+  class mapping
+  {
+    public:
+      static_assert(detail::layout_detail::is_flat_shape<Shape>::value, "tiled requires a flat Shape.");
+      static_assert(sizeof...(TileExtents) == agency::detail::shape_size<Shape>::value, "The rank of the tile shape must equal the rank of Shape.");
+
+      using shape_type = Shape;
+
+      __AGENCY_ANNOTATION
+      mapping() : mapping(shape_type{}) {}
+
+      __AGENCY_ANNOTATION
+      explicit mapping(const shape_type& shape) : shape_(shape) {}
+
+      template<class OtherShape,
+               __AGENCY_REQUIRES(std::is_convertible<OtherShape,shape_type>::value)>
+      __AGENCY_ANNOTATION
+      mapping(const mapping<OtherShape>& other) : mapping(shape_type(other.shape())) {}
+
+      __AGENCY_ANNOTATION
+      shape_type shape() const
+      {
+        return shape_;
+      }
+
+      /// \brief Returns the number of elements in each tile.
+      __AGENCY_ANNOTATION
+      static constexpr std::size_t tile_size()
+      {
+        return tile_size_impl(TileExtents...);
+      }
+
+      __AGENCY_ANNOTATION
+      std::size_t required_span_size() const
+      {
+        if(agency::detail::index_space_size(shape_) == 0) return 0;
+
+        // the offset just past the last tile's last element
+        return (*this)(detail::layout_detail::last_index(shape_)) / tile_size() * tile_size() + tile_size();
+      }
+
+      __AGENCY_ANNOTATION
+      static constexpr bool is_always_exhaustive()
+      {
+        return false;
+      }
+
+      template<class Index>
+      __AGENCY_ANNOTATION
+      std::size_t operator()(const Index& idx) const
+      {
+        using grid_view_type = detail::layout_detail::tile_grid_view<Index,shape_type,TileExtents...>;
+        using tile_view_type = detail::layout_detail::within_tile_view<Index,TileExtents...>;
+
+        constexpr std::size_t last = agency::detail::shape_size<shape_type>::value - 1;
+
+        return detail::layout_detail::horner<last>::rank(grid_view_type{idx, shape_}) * tile_size() +
+               detail::layout_detail::horner<last>::rank(tile_view_type{idx});
+      }
+
+    private:
+      __AGENCY_ANNOTATION
+      static constexpr std::size_t tile_size_impl()
+      {
+        return 1;
+      }
+
+      template<class... Sizes>
+      __AGENCY_ANNOTATION
+      static constexpr std::size_t tile_size_impl(std::size_t size, Sizes... sizes)
+      {
+        return size * tile_size_impl(sizes...);
+      }
+
+      shape_type shape_;
+  };
+};
+
+
+/// \brief The Z-order layout, which interleaves the bits of an index's coordinates.
+///
+/// Neighboring indices tend to remain nearby in storage along every dimension, not just the last.
+/// `morton` supports ranks 1, 2, and 3. Because an index's offset depends only on its coordinates, arrays
+/// whose extents are not equal powers of two require more storage than they have elements.
+struct morton
+{
+  template<class Shape>
+  class mapping
+  {
+    public:
+      static_assert(detail::layout_detail::is_flat_shape<Shape>::value, "morton requires a flat Shape.");
+      static_assert(agency::detail::shape_size<Shape>::value <= 3, "morton supports ranks 1, 2, and 3.");
+
+      using shape_type = Shape;
+
+      __AGENCY_ANNOTATION
+      mapping() : mapping(shape_type{}) {}
+
+      __AGENCY_ANNOTATION
+      explicit mapping(const shape_type& shape) : shape_(shape) {}
+
+      template<class OtherShape,
+               __AGENCY_REQUIRES(std::is_convertible<OtherShape,shape_type>::value)>
+      __AGENCY_ANNOTATION
+      mapping(const mapping<OtherShape>& other) : mapping(shape_type(other.shape())) {}
+
+      __AGENCY_ANNOTATION
+      shape_type shape() const
+      {
+        return shape_;
+      }
+
+      __AGENCY_ANNOTATION
+      std::size_t required_span_size() const
+      {
+        // offsets increase with each coordinate, so the last index has the largest offset
+        return agency::detail::index_space_size(shape_) == 0 ? 0 : (*this)(detail::layout_detail::last_index(shape_)) + 1;
+      }
+
+      __AGENCY_ANNOTATION
+      static constexpr bool is_always_exhaustive()
+      {
+        return false;
+      }
+
+      template<class Index>
+      __AGENCY_ANNOTATION
+      std::size_t operator()(const Index& idx) const
+      {
+        return detail::layout_detail::morton_rank(idx, std::integral_constant<std::size_t, agency::detail::shape_size<shape_type>::value>());
+      }
+
+    private:
+      shape_type shape_;
+  };
+};
+
+
+} // end experimental
+} // end agency
+
@@ -3,7 +3,9 @@
 #include <agency/detail/config.hpp>
 #include <agency/detail/requires.hpp>
 #include <agency/detail/default_shape.hpp>
+#include <agency/experimental/ndarray/layout.hpp>
 #include <agency/experimental/ndarray/ndarray_ref.hpp>
+#include <agency/memory/detail/storage.hpp>
 #include <agency/memory/allocator/allocator.hpp>
 #include <agency/detail/iterator/constant_iterator.hpp>
 #include <agency/execution/execution_policy/detail/simple_sequenced_policy.hpp>
@@ -21,12 +23,14 @@ namespace experimental
 {
 
 
-template<class T, class Shape = size_t, class Alloc = agency::allocator<T>, class Index = Shape>
+template<class T, class Shape = size_t, class Alloc = agency::allocator<T>, class Index = Shape, class Layout = row_major>
 class basic_ndarray
 {
   private:
-    using storage_type = agency::detail::storage<T,Alloc,Shape>;
-    using all_t = basic_ndarray_ref<T,Shape,Index>;
+    // the storage spans every element of the layout, which may include padding
+    using storage_type = agency::detail::storage<T,Alloc>;
+    using all_t = basic_ndarray_ref<T,Shape,Index,Layout>;
+    using const_all_t = basic_ndarray_ref<const T,Shape,Index,Layout>;
 
   public:
     using value_type = T;
@@ -37,10 +41,19 @@ class basic_ndarray
 
     using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
 
-    using shape_type = typename storage_type::shape_type;
+    using shape_type = Shape;
 
     using index_type = typename all_t::index_type;
 
+    using layout_type = Layout;
+
+    using mapping_type = typename all_t::mapping_type;
+
+    // iterators traverse the elements in the lexicographic order of their indices and skip any padding
+    using iterator = typename all_t::iterator;
+
+    using const_iterator = typename const_all_t::iterator;
+
     // note that basic_ndarray's constructors have __agency_exec_check_disable__
     // because Alloc's constructors may not have __AGENCY_ANNOTATION
 
@@ -51,7 +64,14 @@ class basic_ndarray
     __agency_exec_check_disable__
     __AGENCY_ANNOTATION
     explicit basic_ndarray(const shape_type& shape, const allocator_type& alloc = allocator_type())
-      : storage_(shape, alloc)
+      : basic_ndarray(mapping_type(shape), alloc)
+    {}
+
+    __agency_exec_check_disable__
+    __AGENCY_ANNOTATION
+    explicit basic_ndarray(const mapping_type& mapping, const allocator_type& alloc = allocator_type())
+      : storage_(mapping.required_span_size(), alloc),
+        mapping_(mapping)
     {
       construct_elements();
     }
@@ -59,10 +79,11 @@ class basic_ndarray
     __agency_exec_check_disable__
     __AGENCY_ANNOTATION
     explicit basic_ndarray(const shape_type& shape, const T& val, const allocator_type& alloc = allocator_type())
-      : basic_ndarray(agency::detail::constant_iterator<T>(val,0),
-                      agency::detail::constant_iterator<T>(val, agency::detail::index_space_size(shape)),
-                      alloc)
-    {}
+      : storage_(mapping_type(shape).required_span_size(), alloc),
+        mapping_(shape)
+    {
+      construct_elements(agency::detail::constant_iterator<T>(val,0));
+    }
 
     template<class ExecutionPolicy,
              class Iterator,
@@ -74,7 +95,8 @@ class basic_ndarray
                std::is_convertible<typename std::iterator_traits<Iterator>::value_type, value_type>::value
              )>
     basic_ndarray(ExecutionPolicy&& policy, Iterator first, shape_type shape, const allocator_type& alloc = allocator_type())
-      : storage_(shape, alloc)
+      : storage_(mapping_type(shape).required_span_size(), alloc),
+        mapping_(shape)
     {
       construct_elements(std::forward<ExecutionPolicy>(policy), first);
     }
@@ -106,7 +128,8 @@ class basic_ndarray
              )>
     __AGENCY_ANNOTATION
     basic_ndarray(ExecutionPolicy&& policy, const basic_ndarray& other)
-      : storage_(other.shape(), other.get_allocator())
+      : storage_(other.span_size(), other.get_allocator()),
+        mapping_(other.mapping())
     {
       construct_elements(std::forward<ExecutionPolicy>(policy), other.begin());
     }
@@ -120,7 +143,8 @@ class basic_ndarray
     __agency_exec_check_disable__
     __AGENCY_ANNOTATION
     basic_ndarray(basic_ndarray&& other)
-      : storage_{}
+      : storage_{},
+        mapping_{}
     {
       swap(other);
     }
@@ -152,6 +176,7 @@ class basic_ndarray
     void swap(basic_ndarray& other)
     {
       storage_.swap(other.storage_);
+      agency::detail::adl_swap(mapping_, other.mapping_);
     }
 
 
@@ -171,11 +196,24 @@ class basic_ndarray
     __AGENCY_ANNOTATION
     shape_type shape() const
     {
-      return storage_.shape();
+      return mapping_.shape();
+    }
+
+    __AGENCY_ANNOTATION
+    mapping_type mapping() const
+    {
+      return mapping_;
     }
 
     __AGENCY_ANNOTATION
     std::size_t size() const
+    {
+      return agency::detail::index_space_size(shape());
+    }
+
+    // the number of elements in storage, which exceeds size() when the layout is padded
+    __AGENCY_ANNOTATION
+    std::size_t span_size() const
     {
       return storage_.size();
     }
@@ -193,49 +231,49 @@ class basic_ndarray
     }
 
     __AGENCY_ANNOTATION
-    basic_ndarray_ref<const T,Shape,Index> all() const
+    const_all_t all() const
     {
-      return basic_ndarray_ref<const T,Shape,Index>(data(), shape());
+      return const_all_t(data(), mapping_);
     }
 
     __AGENCY_ANNOTATION
-    basic_ndarray_ref<T,Shape,Index> all()
+    all_t all()
     {
-      return basic_ndarray_ref<T,Shape,Index>(data(), shape());
+      return all_t(data(), mapping_);
     }
 
     __AGENCY_ANNOTATION
-    pointer begin()
+    iterator begin()
     {
-      return all().data();
+      return all().begin();
     }
 
     __AGENCY_ANNOTATION
-    pointer end()
+    iterator end()
     {
       return all().end();
     }
 
     __AGENCY_ANNOTATION
-    const_pointer begin() const
+    const_iterator begin() const
     {
       return all().begin();
     }
 
     __AGENCY_ANNOTATION
-    const_pointer cbegin() const
+    const_iterator cbegin() const
     {
       return begin();
     }
 
     __AGENCY_ANNOTATION
-    const_pointer end() const
+    const_iterator end() const
     {
       return all().end();
     }
 
     __AGENCY_ANNOTATION
-    const_pointer cend() const
+    const_iterator cend() const
     {
       return end();
     }
@@ -244,8 +282,10 @@ class basic_ndarray
     __AGENCY_ANNOTATION
     void clear()
     {
-      agency::detail::destroy(storage_.allocator(), begin(), end());
+      // every element of storage is constructed, including any padding
+      agency::detail::destroy(storage_.allocator(), data(), data() + span_size());
       storage_ = storage_type{};
+      mapping_ = mapping_type{};
     }
 
     __agency_exec_check_disable__
@@ -268,10 +308,11 @@ class basic_ndarray
     __AGENCY_ANNOTATION
     bool operator==(const basic_ndarray& rhs) const
     {
-      return size() == rhs.size() && agency::detail::equal(begin(), end(), rhs.begin());
+      return shape() == rhs.shape() && agency::detail::equal(begin(), end(), rhs.begin());
     }
 
   private:
+    // constructs the element at the ith index in lexicographic order from the ith element of each of iters
     template<class ExecutionPolicy, class... Iterators,
              __AGENCY_REQUIRES(
                is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
@@ -279,6 +320,26 @@ class basic_ndarray
     __AGENCY_ANNOTATION
     void construct_elements(ExecutionPolicy&& policy, Iterators... iters)
     {
+      construct_elements(std::integral_constant<bool, mapping_type::is_always_exhaustive()>(), std::forward<ExecutionPolicy>(policy), iters...);
+    }
+
+    // every element of storage is an element of an exhaustive layout
+    template<class ExecutionPolicy, class... Iterators>
+    __AGENCY_ANNOTATION
+    void construct_elements(std::true_type, ExecutionPolicy&& policy, Iterators... iters)
+    {
+      agency::detail::construct_n(std::forward<ExecutionPolicy>(policy), begin(), size(), iters...);
+    }
+
+    // other layouts may leave padding between elements, which is value-initialized
+    // so that all of storage may be destroyed uniformly. to initialize the padding, all of storage is
+    // value-initialized, and then the elements are destroyed and constructed again from iters
+    template<class ExecutionPolicy, class... Iterators>
+    __AGENCY_ANNOTATION
+    void construct_elements(std::false_type, ExecutionPolicy&& policy, Iterators... iters)
+    {
+      agency::detail::construct_n(policy, data(), span_size());
+      agency::detail::destroy(policy, storage_.allocator(), begin(), end());
       agency::detail::construct_n(std::forward<ExecutionPolicy>(policy), begin(), size(), iters...);
     }
 
@@ -291,11 +352,12 @@ class basic_ndarray
     }
 
     storage_type storage_;
+    mapping_type mapping_;
 };
 
 
-template<class T, size_t rank, class Alloc = agency::allocator<T>>
-using ndarray = basic_ndarray<T, agency::detail::default_shape_t<rank>, Alloc>;
+template<class T, size_t rank, class Alloc = agency::allocator<T>, class Layout = row_major>
+using ndarray = basic_ndarray<T, agency::detail::default_shape_t<rank>, Alloc, agency::detail::default_shape_t<rank>, Layout>;
 
 
 } // end experimental
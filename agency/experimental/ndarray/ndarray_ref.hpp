@@ -3,11 +3,13 @@
 #include <agency/detail/config.hpp>
 #include <agency/detail/requires.hpp>
 #include <agency/detail/shape.hpp>
-#include <agency/detail/index_lexicographical_rank.hpp>
 #include <agency/coordinate/detail/shape/shape_size.hpp>
 #include <agency/coordinate.hpp>
+#include <agency/experimental/ndarray/layout.hpp>
+#include <agency/experimental/ndarray/detail/ndarray_iterator.hpp>
 #include <cstddef>
 #include <tuple>
+#include <type_traits>
 
 namespace agency
 {
@@ -16,7 +18,8 @@ namespace experimental
 
 
 // basic_ndarray_ref is a mutable view of a multidimensional array of elements.
-// The layout of the array elements is in row-major, i.e. the lexicographic order of their multidimensional indices.
+// The Layout of the array elements maps each multidimensional index to an offset from data().
+// By default, the layout is row-major, i.e. the lexicographic order of their multidimensional indices.
 //
 // The dimensionality of the array is given by Shape, which is a generalized shape type.
 // A type is an Shape if
@@ -28,7 +31,7 @@ namespace experimental
 //     the type of their index and the type of the shape of their group
 //     Consistency is important here, but we ought to consider whether it's actually important for agents
 //     to make this distinction
-template<class T, class Shape, class Index = Shape>
+template<class T, class Shape, class Index = Shape, class Layout = row_major>
 class basic_ndarray_ref
 {
   static_assert(agency::detail::index_size<Shape>::value == agency::detail::index_size<Index>::value, "Shape rank must equal Index rank.");
@@ -38,11 +41,18 @@ class basic_ndarray_ref
     using shape_type = Shape;
     using index_type = Index;
     using size_type = decltype(agency::detail::index_space_size(std::declval<shape_type>()));
+    using layout_type = Layout;
+    using mapping_type = typename layout_type::template mapping<shape_type>;
     using reference = element_type&;
     using pointer = element_type*;
 
-    // this iterator traverses in row-major order
-    using iterator = pointer;
+    // iterators traverse the elements in the lexicographic order of their indices and skip any padding
+    // for the default layout, this is storage order, and the iterator is a pointer
+    using iterator = typename std::conditional<
+      std::is_same<layout_type, row_major>::value,
+      pointer,
+      detail::ndarray_iterator<element_type, index_type, mapping_type>
+    >::type;
 
     __AGENCY_ANNOTATION
     basic_ndarray_ref() : basic_ndarray_ref(nullptr) {}
@@ -58,15 +68,18 @@ class basic_ndarray_ref
              __AGENCY_REQUIRES(agency::detail::shape_size<shape_type>::value == agency::detail::shape_size<OtherShape>::value)
             >
     __AGENCY_ANNOTATION
-    basic_ndarray_ref(const basic_ndarray_ref<OtherT,OtherShape,OtherIndex>& other)
-      : basic_ndarray_ref(other.data(), other.shape())
+    basic_ndarray_ref(const basic_ndarray_ref<OtherT,OtherShape,OtherIndex,Layout>& other)
+      : basic_ndarray_ref(other.data(), mapping_type(other.mapping()))
     {}
 
     __AGENCY_ANNOTATION
     explicit basic_ndarray_ref(std::nullptr_t) : basic_ndarray_ref(nullptr, shape_type{}) {}
 
     __AGENCY_ANNOTATION
-    basic_ndarray_ref(pointer ptr, shape_type shape) : data_(ptr), shape_(shape) {}
+    basic_ndarray_ref(pointer ptr, shape_type shape) : basic_ndarray_ref(ptr, mapping_type(shape)) {}
+
+    __AGENCY_ANNOTATION
+    basic_ndarray_ref(pointer ptr, const mapping_type& mapping) : data_(ptr), mapping_(mapping) {}
 
     __AGENCY_ANNOTATION
     constexpr std::size_t rank() const
@@ -79,7 +92,15 @@ class basic_ndarray_ref
     __AGENCY_ANNOTATION
     shape_type shape() const
     {
-      return shape_;
+      return mapping_.shape();
+    }
+
+    /// \brief Returns the mapping from indices to offsets.
+    /// \return The layout mapping of this `basic_ndarray_ref`.
+    __AGENCY_ANNOTATION
+    mapping_type mapping() const
+    {
+      return mapping_;
     }
 
     /// \brief Returns the total number of elements.
@@ -106,35 +127,54 @@ class basic_ndarray_ref
       return data_;
     }
 
+    /// \brief Returns the number of elements spanned by the layout, including any padding.
+    /// \return `mapping().required_span_size()`
+    __AGENCY_ANNOTATION
+    std::size_t span_size() const
+    {
+      return mapping_.required_span_size();
+    }
+
     __AGENCY_ANNOTATION
     reference operator[](const index_type& idx) const
     {
-      auto rank = agency::detail::index_lexicographical_rank(idx, shape());
-      return data_[rank];
+      return data_[mapping_(idx)];
     }
 
     __AGENCY_ANNOTATION
     iterator begin() const
     {
-      return data_;
+      return make_iterator(0, std::is_same<iterator, pointer>());
     }
 
     __AGENCY_ANNOTATION
     iterator end() const
     {
-      return begin() + size();
+      return make_iterator(size(), std::is_same<iterator, pointer>());
     }
 
   private:
+    __AGENCY_ANNOTATION
+    iterator make_iterator(size_type position, std::true_type) const
+    {
+      return data_ + position;
+    }
+
+    __AGENCY_ANNOTATION
+    iterator make_iterator(size_type position, std::false_type) const
+    {
+      return iterator(data_, mapping_, position);
+    }
+
     T* data_;
-    shape_type shape_;
+    mapping_type mapping_;
 };
 
 
 // ndarray_ref is shorthand for a view of a simple n-dimensional array.
 // The Rank indicates which point to use for the basic_ndarray_ref's Shape parameter
-template<class T, size_t rank>
-using ndarray_ref = basic_ndarray_ref<T, point<std::size_t,rank>>;
+template<class T, size_t rank, class Layout = row_major>
+using ndarray_ref = basic_ndarray_ref<T, point<std::size_t,rank>, point<std::size_t,rank>, Layout>;
 
 
 } // end experimental
@@ -0,0 +1,660 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/execution/execution_policy.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/max.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <agency/experimental/ndarray/layout.hpp>
+#include <agency/experimental/ndarray/ndarray_ref.hpp>
+#include <agency/container/array.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace agency
+{
+namespace experimental
+{
+
+
+/// \brief A stencil_neighborhood gives a stencil kernel access to the elements surrounding the point it updates.
+///
+/// `n(di,dj)` returns the element at offset `(di,dj)` from the point, so a 5-point Laplacian is
+///
+///     n(-1,0) + n(1,0) + n(0,-1) + n(0,1) - 4 * n(0,0)
+///
+/// Offsets must lie within the radius given to `stencil`.
+template<class T, std::size_t Rank>
+class stencil_neighborhood
+{
+  public:
+    using value_type = typename std::remove_const<T>::type;
+    using offset_type = agency::array<std::ptrdiff_t, Rank>;
+    using index_type = agency::array<std::size_t, Rank>;
+
+    stencil_neighborhood(const T* center, const offset_type& strides, const index_type& index)
+      : center_(center), strides_(strides), index_(index)
+    {}
+
+    /// \brief Returns the element at the given offset from the point, with one offset per dimension.
+    template<class... Offsets,
+             __AGENCY_REQUIRES(sizeof...(Offsets) == Rank)>
+    const T& operator()(Offsets... offsets) const
+    {
+      std::ptrdiff_t offset_array[] = {static_cast<std::ptrdiff_t>(offsets)...};
+
+      std::ptrdiff_t position = 0;
+      for(std::size_t d = 0; d < Rank; ++d)
+      {
+        position += offset_array[d] * strides_[d];
+      }
+
+      return center_[position];
+    }
+
+    /// \brief Returns the element at the given offset from the point.
+    const T& operator[](const offset_type& offset) const
+    {
+      std::ptrdiff_t position = 0;
+      for(std::size_t d = 0; d < Rank; ++d)
+      {
+        position += offset[d] * strides_[d];
+      }
+
+      return center_[position];
+    }
+
+    /// \brief Returns the element at the point.
+    const T& center() const
+    {
+      return *center_;
+    }
+
+    /// \brief Returns the index of the point within the array.
+    const index_type& index() const
+    {
+      return index_;
+    }
+
+    // moves to the next point along the last dimension
+    void advance()
+    {
+      center_ += strides_[Rank-1];
+      ++index_[Rank-1];
+    }
+
+  private:
+    const T* center_;
+    offset_type strides_;
+    index_type index_;
+};
+
+
+namespace detail
+{
+namespace stencil_detail
+{
+
+
+// the default tile extent along the last dimension, which is traversed by the innermost loop
+constexpr std::size_t default_tile_extent_last = 512;
+
+// the default tile extent along the other dimensions
+// a tile of doubles and its halo occupy roughly 150 KB in two dimensions and 400 KB in three, which fit in L2
+constexpr std::size_t default_tile_extent_2d = 32;
+constexpr std::size_t default_tile_extent_3d = 8;
+
+// when steps are blocked, tiles span at least this many times their halo along the dimensions before the last
+constexpr std::size_t min_tile_extent_per_halo = 4;
+
+
+// a box is the set of indices in [lower, upper)
+template<std::size_t Rank>
+struct box
+{
+  agency::array<std::size_t, Rank> lower;
+  agency::array<std::size_t, Rank> upper;
+
+  bool empty() const
+  {
+    for(std::size_t d = 0; d < Rank; ++d)
+    {
+      if(lower[d] >= upper[d]) return true;
+    }
+
+    return false;
+  }
+
+  std::size_t size() const
+  {
+    if(empty()) return 0;
+
+    std::size_t result = 1;
+    for(std::size_t d = 0; d < Rank; ++d)
+    {
+      result *= upper[d] - lower[d];
+    }
+
+    return result;
+  }
+
+  // returns this box grown by margin in every direction, clipped to the given extents
+  box grow(std::size_t margin, const agency::array<std::size_t, Rank>& extents) const
+  {
+    box result;
+    for(std::size_t d = 0; d < Rank; ++d)
+    {
+      result.lower[d] = lower[d] > margin ? lower[d] - margin : 0;
+      result.upper[d] = agency::detail::min(extents[d], upper[d] + margin);
+    }
+
+    return result;
+  }
+};
+
+
+// a row is a run of points along the last dimension
+// for_each_row() calls f(first, length) for each row of a box, where first is the index of the row's first point
+template<std::size_t Rank, class Function>
+void for_each_row(const box<Rank>& b, Function&& f)
+{
+  if(b.empty()) return;
+
+  agency::array<std::size_t, Rank> first = b.lower;
+  std::size_t length = b.upper[Rank-1] - b.lower[Rank-1];
+
+  for(;;)
+  {
+    f(first, length);
+
+    // advance the index of the row lexicographically over the dimensions before the last
+    std::size_t d = Rank - 1;
+    for(; d > 0; --d)
+    {
+      if(++first[d-1] < b.upper[d-1]) break;
+
+      first[d-1] = b.lower[d-1];
+    }
+
+    if(d == 0) return;
+  }
+}
+
+
+template<std::size_t Rank>
+std::ptrdiff_t offset_of(const agency::array<std::size_t, Rank>& idx, const agency::array<std::ptrdiff_t, Rank>& strides)
+{
+  std::ptrdiff_t result = 0;
+  for(std::size_t d = 0; d < Rank; ++d)
+  {
+    result += static_cast<std::ptrdiff_t>(idx[d]) * strides[d];
+  }
+
+  return result;
+}
+
+
+// update_row() applies the kernel to a row of points, writing each result to dst
+// the points of the row outside of the interior lie within radius of the array's edge, so they are copied from src unchanged
+//
+// src and dst address the point whose index is origin, which is the point at offset zero from them
+template<class T, class U, std::size_t Rank, class Kernel>
+void update_row(const T* src, const agency::array<std::ptrdiff_t, Rank>& src_strides,
+                U* dst, const agency::array<std::ptrdiff_t, Rank>& dst_strides,
+                const agency::array<std::size_t, Rank>& origin,
+                const agency::array<std::size_t, Rank>& first, std::size_t length,
+                const box<Rank>& interior,
+                Kernel& kernel)
+{
+  agency::array<std::size_t, Rank> local = first;
+  for(std::size_t d = 0; d < Rank; ++d)
+  {
+    local[d] -= origin[d];
+  }
+
+  const T* src_row = src + stencil_detail::offset_of(local, src_strides);
+  U* dst_row = dst + stencil_detail::offset_of(local, dst_strides);
+
+  std::ptrdiff_t src_stride = src_strides[Rank-1];
+  std::ptrdiff_t dst_stride = dst_strides[Rank-1];
+
+  bool is_interior_row = true;
+  for(std::size_t d = 0; d + 1 < Rank; ++d)
+  {
+    is_interior_row = is_interior_row && interior.lower[d] <= first[d] && first[d] < interior.upper[d];
+  }
+
+  std::size_t begin = first[Rank-1];
+  std::size_t end = begin + length;
+
+  std::size_t interior_begin = end;
+  std::size_t interior_end = end;
+
+  if(is_interior_row)
+  {
+    interior_begin = agency::detail::min(end, agency::detail::max(begin, interior.lower[Rank-1]));
+    interior_end = agency::detail::min(end, agency::detail::max(interior_begin, interior.upper[Rank-1]));
+  }
+
+  std::ptrdiff_t i = 0;
+  for(; i < static_cast<std::ptrdiff_t>(interior_begin - begin); ++i)
+  {
+    dst_row[i * dst_stride] = src_row[i * src_stride];
+  }
+
+  agency::array<std::size_t, Rank> point = first;
+  point[Rank-1] = interior_begin;
+
+  using neighborhood_type = stencil_neighborhood<typename std::remove_const<T>::type, Rank>;
+
+  if(src_stride == 1 && dst_stride == 1)
+  {
+    // make the unit strides constants the compiler can see, so the loop can be vectorized
+    agency::array<std::ptrdiff_t, Rank> unit_strides = src_strides;
+    unit_strides[Rank-1] = 1;
+
+    neighborhood_type neighborhood(src_row + i, unit_strides, point);
+    for(; i < static_cast<std::ptrdiff_t>(interior_end - begin); ++i, neighborhood.advance())
+    {
+      dst_row[i] = kernel(static_cast<const neighborhood_type&>(neighborhood));
+    }
+  }
+  else
+  {
+    neighborhood_type neighborhood(src_row + i * src_stride, src_strides, point);
+    for(; i < static_cast<std::ptrdiff_t>(interior_end - begin); ++i, neighborhood.advance())
+    {
+      dst_row[i * dst_stride] = kernel(static_cast<const neighborhood_type&>(neighborhood));
+    }
+  }
+
+  for(; i < static_cast<std::ptrdiff_t>(length); ++i)
+  {
+    dst_row[i * dst_stride] = src_row[i * src_stride];
+  }
+}
+
+
+template<class T, class U, std::size_t Rank, class Kernel>
+struct update_row_functor
+{
+  const T* src;
+  const agency::array<std::ptrdiff_t, Rank>& src_strides;
+  U* dst;
+  const agency::array<std::ptrdiff_t, Rank>& dst_strides;
+  const agency::array<std::size_t, Rank>& origin;
+  const box<Rank>& interior;
+  Kernel& kernel;
+
+  void operator()(const agency::array<std::size_t, Rank>& first, std::size_t length) const
+  {
+    stencil_detail::update_row(src, src_strides, dst, dst_strides, origin, first, length, interior, kernel);
+  }
+};
+
+
+template<class T, class U, std::size_t Rank, class Kernel>
+void update_box(const T* src, const agency::array<std::ptrdiff_t, Rank>& src_strides,
+                U* dst, const agency::array<std::ptrdiff_t, Rank>& dst_strides,
+                const agency::array<std::size_t, Rank>& origin,
+                const box<Rank>& b,
+                const box<Rank>& interior,
+                Kernel& kernel)
+{
+  stencil_detail::for_each_row(b, update_row_functor<T,U,Rank,Kernel>{src, src_strides, dst, dst_strides, origin, interior, kernel});
+}
+
+
+template<class T, class U, std::size_t Rank>
+struct copy_row_functor
+{
+  const T* src;
+  const agency::array<std::ptrdiff_t, Rank>& src_strides;
+  const agency::array<std::size_t, Rank>& src_origin;
+  U* dst;
+  const agency::array<std::ptrdiff_t, Rank>& dst_strides;
+  const agency::array<std::size_t, Rank>& dst_origin;
+
+  void operator()(const agency::array<std::size_t, Rank>& first, std::size_t length) const
+  {
+    agency::array<std::size_t, Rank> src_local = first;
+    agency::array<std::size_t, Rank> dst_local = first;
+    for(std::size_t d = 0; d < Rank; ++d)
+    {
+      src_local[d] -= src_origin[d];
+      dst_local[d] -= dst_origin[d];
+    }
+
+    const T* src_row = src + stencil_detail::offset_of(src_local, src_strides);
+    U* dst_row = dst + stencil_detail::offset_of(dst_local, dst_strides);
+
+    for(std::size_t i = 0; i < length; ++i)
+    {
+      dst_row[i * dst_strides[Rank-1]] = src_row[i * src_strides[Rank-1]];
+    }
+  }
+};
+
+
+template<class T, class U, std::size_t Rank>
+void copy_box(const T* src, const agency::array<std::ptrdiff_t, Rank>& src_strides, const agency::array<std::size_t, Rank>& src_origin,
+              U* dst, const agency::array<std::ptrdiff_t, Rank>& dst_strides, const agency::array<std::size_t, Rank>& dst_origin,
+              const box<Rank>& b)
+{
+  stencil_detail::for_each_row(b, copy_row_functor<T,U,Rank>{src, src_strides, src_origin, dst, dst_strides, dst_origin});
+}
+
+
+// a stencil_plan divides an array into tiles
+template<std::size_t Rank>
+struct stencil_plan
+{
+  agency::array<std::size_t, Rank> extents;
+  agency::array<std::ptrdiff_t, Rank> src_strides;
+  agency::array<std::ptrdiff_t, Rank> dst_strides;
+
+  // the points farther than radius from every edge of the array
+  box<Rank> interior;
+  std::size_t radius;
+
+  agency::array<std::size_t, Rank> tile_shape;
+  agency::array<std::size_t, Rank> num_tiles;
+  std::size_t total_num_tiles;
+
+  box<Rank> tile(std::size_t t) const
+  {
+    box<Rank> result;
+
+    // the last dimension varies fastest
+    for(std::size_t d = Rank; d > 0; --d)
+    {
+      std::size_t i = t % num_tiles[d-1];
+      t /= num_tiles[d-1];
+
+      result.lower[d-1] = i * tile_shape[d-1];
+      result.upper[d-1] = agency::detail::min(extents[d-1], result.lower[d-1] + tile_shape[d-1]);
+    }
+
+    return result;
+  }
+};
+
+
+template<std::size_t Rank>
+agency::array<std::ptrdiff_t, Rank> signed_strides(const agency::array<std::size_t, Rank>& strides)
+{
+  agency::array<std::ptrdiff_t, Rank> result;
+  for(std::size_t d = 0; d < result.size(); ++d)
+  {
+    result[d] = static_cast<std::ptrdiff_t>(strides[d]);
+  }
+
+  return result;
+}
+
+
+template<std::size_t Rank>
+stencil_plan<Rank> make_stencil_plan(const agency::array<std::size_t, Rank>& extents,
+                                     const agency::array<std::size_t, Rank>& src_strides,
+                                     const agency::array<std::size_t, Rank>& dst_strides,
+                                     std::size_t radius,
+                                     std::size_t halo = 0)
+{
+  stencil_plan<Rank> result;
+
+  result.extents = extents;
+  result.src_strides = stencil_detail::signed_strides(src_strides);
+  result.dst_strides = stencil_detail::signed_strides(dst_strides);
+  result.radius = radius;
+
+  result.total_num_tiles = 1;
+  for(std::size_t d = 0; d < Rank; ++d)
+  {
+    result.interior.lower[d] = agency::detail::min(radius, extents[d]);
+    result.interior.upper[d] = extents[d] > 2 * radius ? extents[d] - radius : result.interior.lower[d];
+
+    if(d + 1 == Rank)
+    {
+      result.tile_shape[d] = default_tile_extent_last;
+    }
+    else
+    {
+      result.tile_shape[d] = Rank == 2 ? default_tile_extent_2d : default_tile_extent_3d;
+
+      // keep the redundant work of a tile's halo small compared to the tile
+      result.tile_shape[d] = agency::detail::max(result.tile_shape[d], min_tile_extent_per_halo * halo);
+    }
+
+    result.num_tiles[d] = (extents[d] + result.tile_shape[d] - 1) / result.tile_shape[d];
+    result.total_num_tiles *= result.num_tiles[d];
+  }
+
+  return result;
+}
+
+
+// each agent updates its tiles directly from src to dst
+struct stencil_step_functor
+{
+  template<class Agent, class T, class U, std::size_t Rank, class Kernel>
+  void operator()(Agent& self, const T* src, U* dst, const stencil_plan<Rank>& plan, std::size_t tiles_per_agent, Kernel kernel)
+  {
+    std::size_t begin = agency::detail::min(plan.total_num_tiles, tiles_per_agent * self.rank());
+    std::size_t end   = agency::detail::min(plan.total_num_tiles, begin + tiles_per_agent);
+
+    agency::array<std::size_t, Rank> origin = {};
+
+    for(std::size_t t = begin; t < end; ++t)
+    {
+      stencil_detail::update_box(src, plan.src_strides, dst, plan.dst_strides, origin, plan.tile(t), plan.interior, kernel);
+    }
+  }
+};
+
+
+// each agent advances its tiles by several steps at once
+//
+// a tile after s steps depends on the points within s * radius of it at the beginning. the agent copies this region
+// into a private buffer, applies the kernel s times to a region which shrinks by radius each time, and writes the tile
+// to dst. neighboring tiles recompute the points of their overlapping halos, but the array is read and written once per s steps
+struct stencil_block_functor
+{
+  template<class Agent, class T, std::size_t Rank, class Kernel>
+  void operator()(Agent& self, const T* src, T* dst, const stencil_plan<Rank>& plan, std::size_t tiles_per_agent, Kernel kernel, std::size_t num_steps)
+  {
+    using value_type = typename std::remove_const<T>::type;
+
+    std::size_t begin = agency::detail::min(plan.total_num_tiles, tiles_per_agent * self.rank());
+    std::size_t end   = agency::detail::min(plan.total_num_tiles, begin + tiles_per_agent);
+
+    if(begin == end) return;
+
+    std::size_t halo = num_steps * plan.radius;
+
+    std::size_t buffer_size = 1;
+    for(std::size_t d = 0; d < Rank; ++d)
+    {
+      buffer_size *= agency::detail::min(plan.extents[d], plan.tile_shape[d] + 2 * halo);
+    }
+
+    std::vector<value_type> buffer0(buffer_size), buffer1(buffer_size);
+
+    for(std::size_t t = begin; t < end; ++t)
+    {
+      box<Rank> tile = plan.tile(t);
+      box<Rank> region = tile.grow(halo, plan.extents);
+
+      // the buffers are row-major over the region
+      agency::array<std::size_t, Rank> region_extents;
+      for(std::size_t d = 0; d < Rank; ++d)
+      {
+        region_extents[d] = region.upper[d] - region.lower[d];
+      }
+
+      agency::array<std::ptrdiff_t, Rank> buffer_strides = stencil_detail::signed_strides(layout_detail::row_major_strides(region_extents));
+
+      // each step reads only the points written by the previous step, so only the first buffer needs the region's initial values
+      stencil_detail::copy_box(src, plan.src_strides, agency::array<std::size_t,Rank>{}, buffer0.data(), buffer_strides, region.lower, region);
+
+      value_type* current = buffer0.data();
+      value_type* next = buffer1.data();
+
+      for(std::size_t step = 1; step <= num_steps; ++step)
+      {
+        box<Rank> valid = tile.grow((num_steps - step) * plan.radius, plan.extents);
+
+        stencil_detail::update_box(const_cast<const value_type*>(current), buffer_strides, next, buffer_strides, region.lower, valid, plan.interior, kernel);
+
+        std::swap(current, next);
+      }
+
+      stencil_detail::copy_box(const_cast<const value_type*>(current), buffer_strides, region.lower, dst, plan.dst_strides, agency::array<std::size_t,Rank>{}, tile);
+    }
+  }
+};
+
+
+template<class ExecutionPolicy, std::size_t Rank>
+std::size_t tiles_per_agent(ExecutionPolicy& policy, const stencil_plan<Rank>& plan, std::size_t& num_agents)
+{
+  num_agents = agency::detail::num_agents_for(policy, plan.total_num_tiles, 1);
+  return agency::detail::ceil_div(plan.total_num_tiles, num_agents);
+}
+
+
+template<class Extents>
+bool is_empty(const Extents& extents)
+{
+  for(std::size_t d = 0; d < extents.size(); ++d)
+  {
+    if(extents[d] == 0) return true;
+  }
+
+  return false;
+}
+
+
+} // end stencil_detail
+} // end detail
+
+
+/// \brief Applies a stencil kernel to each point of an array in parallel.
+///
+/// For each point of `src` farther than `radius` from every edge, `stencil` assigns `dst[idx] = kernel(n)`, where `n` is the
+/// `stencil_neighborhood` of `src` around `idx`. The points within `radius` of an edge are copied from `src` unchanged,
+/// so that `stencil` implements fixed boundary conditions.
+///
+/// Rather than creating one agent per point, `stencil` divides the arrays into tiles of a few hundred kilobytes,
+/// which are divided evenly among the policy's agents. Within a tile, the kernel is applied along rows of the last dimension,
+/// so the neighborhood of each point is found by adding a constant to the previous point's.
+///
+/// Both arrays' layouts must report their strides, as `row_major`, `column_major`, `strided`, and `padded_row_major` do.
+/// The arrays must have the same shape and must not overlap.
+///
+/// \param policy An execution policy whose agents apply the kernel.
+/// \param src The array to read.
+/// \param dst The array to write.
+/// \param radius The largest offset along any dimension which the kernel reads.
+/// \param kernel A function object which receives a `const stencil_neighborhood&` and returns the point's new value.
+template<class ExecutionPolicy, class T, class U, class Shape, class Index, class Layout1, class Layout2, class Kernel,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+void stencil(ExecutionPolicy&& policy,
+             const basic_ndarray_ref<T,Shape,Index,Layout1>& src,
+             const basic_ndarray_ref<U,Shape,Index,Layout2>& dst,
+             std::size_t radius,
+             Kernel kernel)
+{
+  auto extents = detail::layout_detail::to_array(src.shape());
+  if(detail::stencil_detail::is_empty(extents)) return;
+
+  auto plan = detail::stencil_detail::make_stencil_plan(extents, src.mapping().strides(), dst.mapping().strides(), radius);
+
+  std::size_t num_agents = 0;
+  std::size_t tiles_per_agent = detail::stencil_detail::tiles_per_agent(policy, plan, num_agents);
+
+  const T* src_ptr = src.data();
+  U* dst_ptr = dst.data();
+
+  agency::bulk_invoke(policy(num_agents), detail::stencil_detail::stencil_step_functor(), src_ptr, dst_ptr, plan, tiles_per_agent, kernel);
+}
+
+
+/// \brief Applies a stencil kernel to an array repeatedly, alternating between two arrays.
+///
+/// Each step applies `kernel` like the five-parameter `stencil`, reading the array written by the previous step.
+/// The first step reads `a` and writes `b`, the second reads `b` and writes `a`, and so on.
+///
+/// When `steps_per_block` exceeds one, the steps are performed in blocks of `steps_per_block` steps. Within a block,
+/// each tile is copied together with a halo of `steps_per_block * radius` points into a buffer private to the agent
+/// processing it, and advanced by all of the block's steps before it is written. The arrays are thus read and written once
+/// per block rather than once per step, at the expense of recomputing the points of the halos, which overlap neighboring tiles.
+/// This pays off when the kernel is cheap compared to the memory traffic, as for 5-point stencils in two dimensions once the
+/// kernel is vectorized. In three dimensions, the halos are large compared to the tiles, and blocking seldom helps.
+///
+/// \param policy An execution policy whose agents apply the kernel.
+/// \param a The array holding the initial values.
+/// \param b An array of the same shape as `a`, which the steps alternate with `a`.
+/// \param radius The largest offset along any dimension which the kernel reads.
+/// \param kernel A function object which receives a `const stencil_neighborhood&` and returns the point's new value.
+/// \param num_steps The number of steps to perform.
+/// \param steps_per_block The number of steps to perform per pass over the arrays.
+/// \return Whichever of `a` or `b` holds the values after `num_steps` steps.
+template<class ExecutionPolicy, class T, class Shape, class Index, class Layout, class Kernel,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+basic_ndarray_ref<T,Shape,Index,Layout> stencil(ExecutionPolicy&& policy,
+                                                const basic_ndarray_ref<T,Shape,Index,Layout>& a,
+                                                const basic_ndarray_ref<T,Shape,Index,Layout>& b,
+                                                std::size_t radius,
+                                                Kernel kernel,
+                                                std::size_t num_steps,
+                                                std::size_t steps_per_block = 1)
+{
+  basic_ndarray_ref<T,Shape,Index,Layout> src = a;
+  basic_ndarray_ref<T,Shape,Index,Layout> dst = b;
+
+  auto extents = detail::layout_detail::to_array(a.shape());
+  if(detail::stencil_detail::is_empty(extents) || num_steps == 0) return a;
+
+  steps_per_block = agency::detail::max<std::size_t>(steps_per_block, 1);
+
+  std::size_t halo = steps_per_block > 1 ? steps_per_block * radius : 0;
+  auto plan = detail::stencil_detail::make_stencil_plan(extents, a.mapping().strides(), b.mapping().strides(), radius, halo);
+
+  std::size_t num_agents = 0;
+  std::size_t tiles_per_agent = detail::stencil_detail::tiles_per_agent(policy, plan, num_agents);
+
+  for(std::size_t step = 0; step < num_steps; step += steps_per_block)
+  {
+    std::size_t num_block_steps = agency::detail::min(steps_per_block, num_steps - step);
+
+    const T* src_ptr = src.data();
+    T* dst_ptr = dst.data();
+
+    if(num_block_steps == 1)
+    {
+      agency::bulk_invoke(policy(num_agents), detail::stencil_detail::stencil_step_functor(), src_ptr, dst_ptr, plan, tiles_per_agent, kernel);
+    }
+    else
+    {
+      agency::bulk_invoke(policy(num_agents), detail::stencil_detail::stencil_block_functor(), src_ptr, dst_ptr, plan, tiles_per_agent, kernel, num_block_steps);
+    }
+
+    std::swap(src, dst);
+    std::swap(plan.src_strides, plan.dst_strides);
+  }
+
+  return src;
+}
+
+
+} // end experimental
+} // end agency
+
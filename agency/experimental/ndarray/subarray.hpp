@@ -0,0 +1,130 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/experimental/ndarray/layout.hpp>
+#include <agency/experimental/ndarray/ndarray_ref.hpp>
+#include <agency/container/array.hpp>
+#include <cstddef>
+
+namespace agency
+{
+namespace experimental
+{
+
+
+// the functions below create views of part of an array or of its elements in another order
+// the views share the array's elements and carry their own strides, so nothing is copied
+// iterating a view visits only its own elements, in the row-major order of the view's indices
+// they apply to arrays with any layout which reports its strides: row_major, column_major, strided, and padded_row_major
+
+
+/// \brief Returns a view of every `step`th element of each dimension of an array, between two corners.
+///
+/// The view's element `idx` is the array's element `lower + idx * step`, where the multiplication is elementwise.
+/// Along each dimension, the view has `ceil((upper - lower) / step)` elements.
+///
+/// \param ref The array to slice.
+/// \param lower The index of the view's first element.
+/// \param upper An index bounding the view's elements from above, exclusively.
+/// \param step The distance between neighboring elements of the view along each dimension.
+/// \return A strided view of the selected elements.
+template<class T, class Shape, class Index, class Layout>
+__AGENCY_ANNOTATION
+basic_ndarray_ref<T,Shape,Index,strided> slice(const basic_ndarray_ref<T,Shape,Index,Layout>& ref, const Index& lower, const Index& upper, const Index& step)
+{
+  using mapping_type = typename basic_ndarray_ref<T,Shape,Index,strided>::mapping_type;
+
+  auto first = detail::layout_detail::to_array(lower);
+  auto last  = detail::layout_detail::to_array(upper);
+  auto steps = detail::layout_detail::to_array(step);
+
+  auto strides = ref.mapping().strides();
+  auto extents = strides;
+
+  for(std::size_t i = 0; i < extents.size(); ++i)
+  {
+    extents[i] = last[i] > first[i] ? (last[i] - first[i] + steps[i] - 1) / steps[i] : 0;
+    strides[i] *= steps[i];
+  }
+
+  mapping_type mapping(detail::layout_detail::from_array<Shape>(extents), strides);
+
+  return basic_ndarray_ref<T,Shape,Index,strided>(ref.data() + ref.mapping()(lower), mapping);
+}
+
+
+/// \brief Returns a view of the elements of an array between two corners.
+///
+/// \param ref The array to view.
+/// \param lower The index of the view's first element.
+/// \param upper An index bounding the view's elements from above, exclusively.
+/// \return A strided view of the elements whose indices lie in `[lower, upper)`.
+template<class T, class Shape, class Index, class Layout>
+__AGENCY_ANNOTATION
+basic_ndarray_ref<T,Shape,Index,strided> subarray(const basic_ndarray_ref<T,Shape,Index,Layout>& ref, const Index& lower, const Index& upper)
+{
+  agency::array<std::size_t, agency::detail::shape_size<Shape>::value> ones;
+  for(std::size_t i = 0; i < ones.size(); ++i)
+  {
+    ones[i] = 1;
+  }
+
+  return experimental::slice(ref, lower, upper, detail::layout_detail::from_array<Index>(ones));
+}
+
+
+/// \brief Returns a view of an array whose dimensions are reordered.
+///
+/// Dimension `i` of the view is dimension `axes[i]` of `ref`. `axes` must be a permutation of `0, 1, ..., rank - 1`.
+///
+/// \param ref The array to view.
+/// \param axes The permutation of the array's dimensions.
+/// \return A strided view of the array's elements with permuted dimensions.
+template<class T, class Shape, class Index, class Layout>
+__AGENCY_ANNOTATION
+basic_ndarray_ref<T,Shape,Index,strided>
+  permute_axes(const basic_ndarray_ref<T,Shape,Index,Layout>& ref, const agency::array<std::size_t, agency::detail::shape_size<Shape>::value>& axes)
+{
+  using mapping_type = typename basic_ndarray_ref<T,Shape,Index,strided>::mapping_type;
+
+  auto old_extents = detail::layout_detail::to_array(ref.shape());
+  auto old_strides = ref.mapping().strides();
+
+  auto extents = old_extents;
+  auto strides = old_strides;
+
+  for(std::size_t i = 0; i < axes.size(); ++i)
+  {
+    extents[i] = old_extents[axes[i]];
+    strides[i] = old_strides[axes[i]];
+  }
+
+  mapping_type mapping(detail::layout_detail::from_array<Shape>(extents), strides);
+
+  return basic_ndarray_ref<T,Shape,Index,strided>(ref.data(), mapping);
+}
+
+
+/// \brief Returns a view of an array whose dimensions are reversed.
+///
+/// For a rank-2 array, the view's element `(j,i)` is the array's element `(i,j)`.
+///
+/// \param ref The array to transpose.
+/// \return A strided view of the array's elements with reversed dimensions.
+template<class T, class Shape, class Index, class Layout>
+__AGENCY_ANNOTATION
+basic_ndarray_ref<T,Shape,Index,strided> transpose(const basic_ndarray_ref<T,Shape,Index,Layout>& ref)
+{
+  agency::array<std::size_t, agency::detail::shape_size<Shape>::value> axes;
+  for(std::size_t i = 0; i < axes.size(); ++i)
+  {
+    axes[i] = axes.size() - 1 - i;
+  }
+
+  return experimental::permute_axes(ref, axes);
+}
+
+
+} // end experimental
+} // end agency
+
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/experimental/ndarray/layout.hpp>
+#include <agency/experimental/ndarray/ndarray_ref.hpp>
+#include <agency/experimental/ndarray/subarray.hpp>
+#include <agency/coordinate/lattice.hpp>
+#include <cstddef>
+
+namespace agency
+{
+namespace experimental
+{
+
+
+// ndarray_tile_view is a multidimensional array of tiles of an underlying array
+// Each tile is a strided view of a block of the underlying array's elements. The tiles along the
+// upper edges of each dimension are smaller when the underlying array's shape is not a multiple of the tile shape.
+//
+// The tiles are indexed by the points of domain(), so an agent of a multidimensional execution policy
+// parameterized by shape() may select its tile by its own index:
+//
+//   auto tiles = tile(array.all(), {32,32});
+//   bulk_invoke(par2d(tiles.shape()), [=](parallel_agent_2d& self)
+//   {
+//     auto my_tile = tiles[self.index()];
+//     ...
+//   });
+template<class T, class Shape, class Index = Shape, class Layout = row_major>
+class ndarray_tile_view
+{
+  public:
+    using array_type = basic_ndarray_ref<T,Shape,Index,Layout>;
+    using shape_type = Shape;
+    using index_type = Index;
+    using value_type = basic_ndarray_ref<T,Shape,Index,strided>;
+    using reference = value_type;
+
+    __AGENCY_ANNOTATION
+    ndarray_tile_view() = default;
+
+    __AGENCY_ANNOTATION
+    ndarray_tile_view(const array_type& array, const shape_type& tile_shape)
+      : array_(array),
+        tile_shape_(tile_shape)
+    {}
+
+    /// \brief Returns the number of tiles along each dimension.
+    __AGENCY_ANNOTATION
+    shape_type shape() const
+    {
+      auto extents = detail::layout_detail::to_array(array_.shape());
+      auto tile_extents = detail::layout_detail::to_array(tile_shape_);
+
+      for(std::size_t i = 0; i < extents.size(); ++i)
+      {
+        extents[i] = (extents[i] + tile_extents[i] - 1) / tile_extents[i];
+      }
+
+      return detail::layout_detail::from_array<shape_type>(extents);
+    }
+
+    /// \brief Returns the number of tiles.
+    __AGENCY_ANNOTATION
+    std::size_t size() const
+    {
+      return agency::detail::index_space_size(shape());
+    }
+
+    /// \brief Returns the lattice of tile indices.
+    __AGENCY_ANNOTATION
+    lattice<index_type> domain() const
+    {
+      return lattice<index_type>(detail::layout_detail::from_array<index_type>(detail::layout_detail::to_array(shape())));
+    }
+
+    /// \brief Returns the shape of the tiles which are not clipped by the underlying array's edges.
+    __AGENCY_ANNOTATION
+    shape_type tile_shape() const
+    {
+      return tile_shape_;
+    }
+
+    /// \brief Returns the underlying array.
+    __AGENCY_ANNOTATION
+    array_type array() const
+    {
+      return array_;
+    }
+
+    /// \brief Returns a view of the tile at the given index.
+    __AGENCY_ANNOTATION
+    value_type operator[](const index_type& idx) const
+    {
+      auto tile_index = detail::layout_detail::to_array(idx);
+      auto tile_extents = detail::layout_detail::to_array(tile_shape_);
+      auto extents = detail::layout_detail::to_array(array_.shape());
+
+      auto lower = tile_index;
+      auto upper = tile_index;
+
+      for(std::size_t i = 0; i < lower.size(); ++i)
+      {
+        lower[i] = tile_index[i] * tile_extents[i];
+        upper[i] = lower[i] + tile_extents[i] < extents[i] ? lower[i] + tile_extents[i] : extents[i];
+      }
+
+      return experimental::subarray(array_,
+                                    detail::layout_detail::from_array<index_type>(lower),
+                                    detail::layout_detail::from_array<index_type>(upper));
+    }
+
+  private:
+    array_type array_;
+    shape_type tile_shape_;
+};
+
+
+/// \brief Divides an array into a multidimensional array of tiles.
+///
+/// \param array The array to divide.
+/// \param tile_shape The shape of each tile.
+/// \return An `ndarray_tile_view` of `array`'s tiles.
+template<class T, class Shape, class Index, class Layout>
+__AGENCY_ANNOTATION
+ndarray_tile_view<T,Shape,Index,Layout> tile(basic_ndarray_ref<T,Shape,Index,Layout> array, const Shape& tile_shape)
+{
+  return ndarray_tile_view<T,Shape,Index,Layout>(array, tile_shape);
+}
+
+
+} // end experimental
+} // end agency
+
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/bulk_async.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/bulk_then.hpp>
+#include <agency/execution/execution_policy.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace agency
+{
+namespace experimental
+{
+namespace detail
+{
+namespace pipeline_detail
+{
+
+
+// fuses two element-wise stages into a single function
+// each agent passes its own result of first directly to second, so the intermediate result is never stored in a container
+template<class First, class Second>
+struct fused_function
+{
+  First first;
+  Second second;
+
+  template<class Agent, class... Args,
+           class Intermediate = agency::detail::result_of_t<First&(Agent&, Args&&...)>,
+           __AGENCY_REQUIRES(!std::is_void<Intermediate>::value)
+          >
+  __AGENCY_ANNOTATION
+  agency::detail::result_of_t<Second&(Agent&, Intermediate&)>
+    operator()(Agent& self, Args&&... args)
+  {
+    Intermediate intermediate = first(self, std::forward<Args>(args)...);
+    return second(self, intermediate);
+  }
+
+  template<class Agent, class... Args,
+           class Intermediate = agency::detail::result_of_t<First&(Agent&, Args&&...)>,
+           __AGENCY_REQUIRES(std::is_void<Intermediate>::value)
+          >
+  __AGENCY_ANNOTATION
+  agency::detail::result_of_t<Second&(Agent&)>
+    operator()(Agent& self, Args&&... args)
+  {
+    first(self, std::forward<Args>(args)...);
+    return second(self);
+  }
+};
+
+
+// passes the entirety of the predecessor segment's results to each agent as an lvalue, in the same way as bulk_then()
+template<class Function, class Container>
+struct invoke_with_predecessor
+{
+  Function f;
+  Container* predecessor;
+
+  template<class Agent>
+  __AGENCY_ANNOTATION
+  agency::detail::result_of_t<Function&(Agent&, Container&)>
+    operator()(Agent& self)
+  {
+    return f(self, *predecessor);
+  }
+};
+
+
+// the predecessor of a pipeline's first segment
+struct no_predecessor
+{
+  __AGENCY_ANNOTATION
+  static constexpr std::size_t num_segments()
+  {
+    return 0;
+  }
+};
+
+
+// the first segment is invoked without a predecessor
+template<class ExecutionPolicy, class Function>
+auto invoke_segment(const ExecutionPolicy& policy, const no_predecessor&, const Function& f)
+  -> decltype(agency::bulk_invoke(policy, f))
+{
+  return agency::bulk_invoke(policy, f);
+}
+
+
+// a segment following a segment with void results is invoked after its predecessor without a parameter
+template<class ExecutionPolicy, class Predecessor, class Function,
+         __AGENCY_REQUIRES(std::is_void<typename Predecessor::result_type>::value)
+        >
+auto invoke_segment(const ExecutionPolicy& policy, const Predecessor& predecessor, const Function& f)
+  -> decltype(agency::bulk_invoke(policy, f))
+{
+  predecessor.invoke();
+  return agency::bulk_invoke(policy, f);
+}
+
+
+// a segment following a segment with results receives the entirety of those results
+template<class ExecutionPolicy, class Predecessor, class Function,
+         __AGENCY_REQUIRES(!std::is_void<typename Predecessor::result_type>::value)
+        >
+auto invoke_segment(const ExecutionPolicy& policy, const Predecessor& predecessor, const Function& f)
+  -> decltype(agency::bulk_invoke(policy, std::declval<invoke_with_predecessor<Function, typename Predecessor::result_type>>()))
+{
+  typename Predecessor::result_type predecessor_result = predecessor.invoke();
+  return agency::bulk_invoke(policy, invoke_with_predecessor<Function, typename Predecessor::result_type>{f, &predecessor_result});
+}
+
+
+template<class ExecutionPolicy, class Function>
+auto async_segment(const ExecutionPolicy& policy, const no_predecessor&, const Function& f)
+  -> decltype(agency::bulk_async(policy, f))
+{
+  return agency::bulk_async(policy, f);
+}
+
+
+// bulk_then() passes the predecessor future's result, if any, to each agent
+template<class ExecutionPolicy, class Predecessor, class Function>
+auto async_segment(const ExecutionPolicy& policy, const Predecessor& predecessor, const Function& f)
+  -> decltype(agency::bulk_then(policy, f, std::declval<typename Predecessor::future_type&>()))
+{
+  typename Predecessor::future_type predecessor_future = predecessor.async();
+  return agency::bulk_then(policy, f, predecessor_future);
+}
+
+
+} // end pipeline_detail
+} // end detail
+
+
+// a pipeline is a lazily-evaluated chain of bulk stages which execute on the same execution policy
+//
+// consecutive stages added with then() are fused: a single bulk execution executes every stage of a segment, and
+// each agent passes its result of one stage directly to the next stage as f(self, x), where x is that agent's
+// result of the previous stage. the intermediate results are never collected into containers, and there is no
+// barrier or future between fused stages
+//
+// a stage added with barrier_then() begins a new segment. it is executed by a separate bulk execution after the
+// previous segment completes, and each of its agents receives the entirety of the previous segment's results as
+// f(self, results), in the same way as bulk_then()
+//
+// nothing executes until invoke() or async() is called, and a pipeline may be executed any number of times
+template<class ExecutionPolicy, class Predecessor, class Function>
+class pipeline
+{
+  public:
+    using execution_policy_type = ExecutionPolicy;
+
+    using result_type = decltype(
+      detail::pipeline_detail::invoke_segment(std::declval<const ExecutionPolicy&>(), std::declval<const Predecessor&>(), std::declval<const Function&>())
+    );
+
+    using future_type = decltype(
+      detail::pipeline_detail::async_segment(std::declval<const ExecutionPolicy&>(), std::declval<const Predecessor&>(), std::declval<const Function&>())
+    );
+
+    pipeline(const execution_policy_type& policy, const Predecessor& predecessor, const Function& f)
+      : policy_(policy),
+        predecessor_(predecessor),
+        function_(f)
+    {}
+
+    const execution_policy_type& policy() const
+    {
+      return policy_;
+    }
+
+    // returns the number of bulk executions created by each execution of this pipeline
+    __AGENCY_ANNOTATION
+    static constexpr std::size_t num_segments()
+    {
+      return Predecessor::num_segments() + 1;
+    }
+
+    // fuses f with the last stage of this pipeline
+    template<class OtherFunction>
+    pipeline<ExecutionPolicy, Predecessor, detail::pipeline_detail::fused_function<Function,OtherFunction>>
+      then(OtherFunction f) const
+    {
+      using fused_function_type = detail::pipeline_detail::fused_function<Function,OtherFunction>;
+      return pipeline<ExecutionPolicy, Predecessor, fused_function_type>(policy_, predecessor_, fused_function_type{function_, f});
+    }
+
+    // begins a new segment with f after a barrier
+    template<class OtherFunction>
+    pipeline<ExecutionPolicy, pipeline, OtherFunction>
+      barrier_then(OtherFunction f) const
+    {
+      return pipeline<ExecutionPolicy, pipeline, OtherFunction>(policy_, *this, f);
+    }
+
+    // executes each segment with bulk_invoke() and returns the results of the final segment
+    result_type invoke() const
+    {
+      return detail::pipeline_detail::invoke_segment(policy_, predecessor_, function_);
+    }
+
+    // executes the first segment with bulk_async() and each remaining segment with bulk_then()
+    // returns a future corresponding to the results of the final segment
+    future_type async() const
+    {
+      return detail::pipeline_detail::async_segment(policy_, predecessor_, function_);
+    }
+
+  private:
+    execution_policy_type policy_;
+    Predecessor predecessor_;
+    Function function_;
+};
+
+
+// returns a pipeline whose first stage executes f(self) for each agent created by policy
+template<class ExecutionPolicy, class Function,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+pipeline<typename std::decay<ExecutionPolicy>::type, detail::pipeline_detail::no_predecessor, Function>
+  make_pipeline(ExecutionPolicy&& policy, Function f)
+{
+  using result_type = pipeline<typename std::decay<ExecutionPolicy>::type, detail::pipeline_detail::no_predecessor, Function>;
+  return result_type(std::forward<ExecutionPolicy>(policy), detail::pipeline_detail::no_predecessor(), f);
+}
+
+
+} // end experimental
+} // end agency
+
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <agency/experimental/ranges/all.hpp>
+#include <agency/experimental/ranges/block.hpp>
 #include <agency/experimental/ranges/chunk.hpp>
 #include <agency/experimental/ranges/counted.hpp>
 #include <agency/experimental/ranges/flatten.hpp>
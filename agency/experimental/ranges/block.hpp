@@ -0,0 +1,77 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/experimental/ranges/range_traits.hpp>
+#include <agency/detail/iterator/unwrap_contiguous_iterator.hpp>
+#include <agency/container/array.hpp>
+#include <type_traits>
+#include <iterator>
+#include <cstddef>
+
+namespace agency
+{
+namespace experimental
+{
+namespace detail
+{
+
+
+template<std::size_t N, class RandomAccessIterator, class Size>
+__AGENCY_ANNOTATION
+agency::array<typename std::iterator_traits<RandomAccessIterator>::value_type, N>
+  load_block(RandomAccessIterator first, Size count)
+{
+  agency::array<typename std::iterator_traits<RandomAccessIterator>::value_type, N> result;
+
+  for(Size j = 0; j < count; ++j)
+  {
+    result[j] = first[j];
+  }
+
+  return result;
+}
+
+
+} // end detail
+
+
+// for_each_block<N>(rng, f) visits rng in blocks of N consecutive elements
+// for the block beginning at position i, it invokes f(i, pack, count), where pack is an agency::array of N values
+// whose first count elements are rng[i], ..., rng[i + count - 1]
+// count is N for each block but the last, which may be partial
+//
+// when rng's iterator is contiguous per component, as the iterators of zip_with_view and transformed_view are when
+// they are built from spans or vectors, each pack is computed by indexing the components' arrays directly:
+// for a transformed_view of arrays a and b, pack[j] = f(a[i+j], b[i+j]), a loop with a constant trip count which
+// compilers are able to vectorize
+template<std::size_t N, class Range, class Function>
+__AGENCY_ANNOTATION
+void for_each_block(Range&& rng, Function f)
+{
+  static_assert(N > 0, "for_each_block(): N must be positive.");
+
+  using value_type = range_value_t<Range>;
+  static_assert(std::is_default_constructible<value_type>::value, "for_each_block(): Range's value_type must be default constructible.");
+
+  std::size_t n = rng.size();
+
+  if(n == 0) return;
+
+  auto first = agency::detail::unwrap_contiguous_iterator(rng.begin());
+
+  std::size_t i = 0;
+  for(; i + N <= n; i += N)
+  {
+    f(i, detail::load_block<N>(first + i, N), N);
+  }
+
+  if(i < n)
+  {
+    f(i, detail::load_block<N>(first + i, n - i), n - i);
+  }
+}
+
+
+} // end experimental
+} // end agency
+
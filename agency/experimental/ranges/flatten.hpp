@@ -4,6 +4,8 @@
 #include <agency/detail/requires.hpp>
 #include <agency/experimental/ranges/range_traits.hpp>
 #include <agency/experimental/ranges/all.hpp>
+#include <agency/experimental/span.hpp>
+#include <agency/detail/algorithm/upper_bound.hpp>
 #include <type_traits>
 #include <utility>
 
@@ -12,12 +14,36 @@ namespace agency
 {
 namespace experimental
 {
+namespace detail
+{
+namespace flatten_detail
+{
+
+
+struct less
+{
+  template<class T>
+  __AGENCY_ANNOTATION
+  bool operator()(const T& a, const T& b) const
+  {
+    return a < b;
+  }
+};
+
+
+} // end flatten_detail
+} // end detail
 
 
 // flatten_view does not assume the size of the segments are the same
-// operator[] and size() would have more efficient implementations if
-// we made that assumption
-// we should consider another kind of fancy range that would "un-tile" a collection of tiles
+// without further information, operator[] searches the segments linearly and size() sums their sizes
+//
+// two kinds of segment index make random access cheaper:
+//   1. segment offsets, an array of the number of elements preceding each segment, followed by the total,
+//      make operator[] a binary search over the segments and size() O(1)
+//   2. a uniform segment size, shared by every segment but the last, makes operator[] and size() O(1)
+//
+// in any case, iterators track their segment and their position within it, so traversals are O(1) per element
 template<class RangeOfRanges>
 class flatten_view
 {
@@ -49,7 +75,43 @@ class flatten_view
             >
     __AGENCY_ANNOTATION
     flatten_view(OtherRangeOfRanges&& ranges)
-      : segments_(all(ranges))
+      : segments_(all(ranges)),
+        segment_offsets_(),
+        segment_size_(0)
+    {}
+
+    // segment_offsets[i] is the number of elements preceding segment i, and
+    // segment_offsets[ranges.size()] is the total number of elements
+    // the view refers to segment_offsets but does not copy them, so they must outlive the view
+    template<class OtherRangeOfRanges,
+             __AGENCY_REQUIRES(
+               std::is_convertible<
+                 experimental::all_t<OtherRangeOfRanges>,
+                 all_t
+               >::value
+             )
+            >
+    __AGENCY_ANNOTATION
+    flatten_view(OtherRangeOfRanges&& ranges, span<const size_type> segment_offsets)
+      : segments_(all(ranges)),
+        segment_offsets_(segment_offsets),
+        segment_size_(0)
+    {}
+
+    // every segment of ranges but the last has segment_size elements
+    template<class OtherRangeOfRanges,
+             __AGENCY_REQUIRES(
+               std::is_convertible<
+                 experimental::all_t<OtherRangeOfRanges>,
+                 all_t
+               >::value
+             )
+            >
+    __AGENCY_ANNOTATION
+    flatten_view(OtherRangeOfRanges&& ranges, size_type segment_size)
+      : segments_(all(ranges)),
+        segment_offsets_(),
+        segment_size_(segment_size)
     {}
 
     // converting copy constructor
@@ -62,38 +124,113 @@ class flatten_view
              )>
     __AGENCY_ANNOTATION
     flatten_view(const flatten_view<OtherRangeOfRanges>& other)
-      : segments_(other.segments_)
+      : segments_(other.segments_),
+        segment_offsets_(other.segment_offsets_),
+        segment_size_(other.segment_size_)
     {}
 
   private:
     __AGENCY_ANNOTATION
-    reference bracket_operator(size_type element_idx, size_t current_segment_idx) const
+    size_type num_segments() const
+    {
+      return segments_.size();
+    }
+
+    __AGENCY_ANNOTATION
+    size_type segment_size(size_type segment_idx) const
+    {
+      return segments_[segment_idx].size();
+    }
+
+    // a cursor locates an element by its segment and its position within that segment
+    // a cursor is normalized when its segment contains it, or when its segment is one past the last segment
+    struct cursor
+    {
+      size_type segment;
+      size_type offset;
+    };
+
+    // moves a cursor forward across segments until it is normalized
+    // this skips empty segments, so it is O(1) amortized over a traversal
+    __AGENCY_ANNOTATION
+    void normalize(cursor& c) const
+    {
+      while(c.segment < num_segments() && c.offset >= segment_size(c.segment))
+      {
+        c.offset -= segment_size(c.segment);
+        ++c.segment;
+      }
+    }
+
+    // moves a cursor back n elements
+    __AGENCY_ANNOTATION
+    void retreat(cursor& c, size_type n) const
+    {
+      while(n > c.offset)
+      {
+        n -= c.offset;
+        --c.segment;
+        c.offset = segment_size(c.segment);
+      }
+
+      c.offset -= n;
+    }
+
+    // returns the normalized cursor of element i
+    __AGENCY_ANNOTATION
+    cursor locate(size_type i) const
     {
-      auto& segment = segments_[current_segment_idx];
-      auto size = segment.size();
-
-      // if the element is within the current segment, return it
-      // otherwise, recurse
-      // note that attempting to index an element that lies beyond the end of this view
-      // will not terminate the recursion
-      return element_idx < size ?
-        segment[element_idx] :
-        bracket_operator(element_idx - size, current_segment_idx + 1);
+      cursor result{0, i};
+
+      if(segment_offsets_.size() > 0)
+      {
+        // find the last segment which begins at or before i
+        size_type num_offsets = segment_offsets_.size();
+        size_type segment_idx = agency::detail::upper_bound_n(segment_offsets_.data(), num_offsets, i, detail::flatten_detail::less()) - 1;
+
+        result.segment = segment_idx;
+        result.offset = i - segment_offsets_[segment_idx];
+      }
+      else if(segment_size_ > 0)
+      {
+        result.segment = i / segment_size_;
+        result.offset = i % segment_size_;
+
+        // the last segment may be longer than the others
+        if(result.segment >= num_segments() && num_segments() > 0)
+        {
+          result.segment = num_segments() - 1;
+          result.offset = i - result.segment * segment_size_;
+        }
+      }
+
+      // without a segment index, this is a linear search
+      normalize(result);
+
+      return result;
     }
 
   public:
     __AGENCY_ANNOTATION
     reference operator[](size_type i) const
     {
-      // seems like we have to do a linear search through the segments
-      // so, it't not clear this can be computed in O(1)
-      // OTOH, it's not O(N) either (N being the total number of elements viewed by this view)
-      return bracket_operator(i, 0);
+      cursor c = locate(i);
+      return segments_[c.segment][c.offset];
     }
 
     __AGENCY_ANNOTATION
     size_type size() const
     {
+      if(segment_offsets_.size() > 0)
+      {
+        return segment_offsets_[segment_offsets_.size() - 1];
+      }
+
+      if(segment_size_ > 0)
+      {
+        return num_segments() == 0 ? 0 : segment_size_ * (num_segments() - 1) + segment_size(num_segments() - 1);
+      }
+
       size_type result = 0;
       for(auto& segment : segments_)
       {
@@ -103,6 +240,13 @@ class flatten_view
       return result;
     }
 
+    /// \brief Returns this view's segment offsets, which are empty when the view was not given any.
+    __AGENCY_ANNOTATION
+    span<const size_type> segment_offsets() const
+    {
+      return segment_offsets_;
+    }
+
     class iterator
     {
       public:
@@ -116,7 +260,7 @@ class flatten_view
         __AGENCY_ANNOTATION
         reference operator*() const
         {
-          return self_[current_position_];
+          return self_.segments_[cursor_.segment][cursor_.offset];
         }
 
         // pre-increment
@@ -124,6 +268,8 @@ class flatten_view
         iterator operator++()
         {
           ++current_position_;
+          ++cursor_.offset;
+          self_.normalize(cursor_);
           return *this;
         }
 
@@ -132,6 +278,7 @@ class flatten_view
         iterator operator--()
         {
           --current_position_;
+          self_.retreat(cursor_, 1);
           return *this;
         }
 
@@ -140,7 +287,7 @@ class flatten_view
         iterator operator++(int)
         {
           iterator result = *this;
-          current_position_++;
+          ++(*this);
           return result;
         }
 
@@ -149,7 +296,7 @@ class flatten_view
         iterator operator--(int)
         {
           iterator result = *this;
-          current_position_--;
+          --(*this);
           return result;
         }
 
@@ -158,6 +305,18 @@ class flatten_view
         iterator operator+=(size_type n)
         {
           current_position_ += n;
+
+          if(self_.has_segment_index())
+          {
+            cursor_ = self_.locate(current_position_);
+          }
+          else
+          {
+            // search forward from the current segment
+            cursor_.offset += n;
+            self_.normalize(cursor_);
+          }
+
           return *this;
         }
 
@@ -166,6 +325,17 @@ class flatten_view
         iterator operator-=(size_type n)
         {
           current_position_ -= n;
+
+          if(self_.has_segment_index())
+          {
+            cursor_ = self_.locate(current_position_);
+          }
+          else
+          {
+            // search backward from the current segment
+            self_.retreat(cursor_, n);
+          }
+
           return *this;
         }
 
@@ -224,15 +394,16 @@ class flatten_view
         __AGENCY_ANNOTATION
         iterator(size_type current_position, const flatten_view& self)
           : current_position_(current_position),
+            cursor_(self.locate(current_position)),
             self_(self)
         {}
 
-        // XXX a more efficient implementation would track the current segment
-        // XXX and the current position within the segment
-        //     could keep an iterator to the current segment
-        //     would make operator- and operator+= less efficient because they would involve linear searches
+        // the iterator tracks both its position within the view and its cursor,
+        // so that dereference and increment are O(1) and difference is too
         size_type current_position_;
 
+        cursor cursor_;
+
         flatten_view self_;
     };
 
@@ -249,7 +420,15 @@ class flatten_view
     }
 
   private:
+    __AGENCY_ANNOTATION
+    bool has_segment_index() const
+    {
+      return segment_offsets_.size() > 0 || segment_size_ > 0;
+    }
+
     all_t segments_;
+    span<const size_type> segment_offsets_;
+    size_type segment_size_;
 
   public:
     __AGENCY_ANNOTATION
@@ -275,6 +454,47 @@ flatten_view<RangeOfRanges> flatten(RangeOfRanges&& ranges)
 }
 
 
+// flattens ranges, locating elements by binary search of segment_offsets
+// segment_offsets has one more element than ranges: the number of elements preceding each segment, followed by the total
+template<class RangeOfRanges>
+__AGENCY_ANNOTATION
+flatten_view<RangeOfRanges> flatten(RangeOfRanges&& ranges, span<const typename flatten_view<RangeOfRanges>::size_type> segment_offsets)
+{
+  return flatten_view<RangeOfRanges>(std::forward<RangeOfRanges>(ranges), segment_offsets);
+}
+
+
+// flattens ranges whose segments all have segment_size elements, except for the last, locating elements in O(1)
+template<class RangeOfRanges>
+__AGENCY_ANNOTATION
+flatten_view<RangeOfRanges> flatten_uniform(RangeOfRanges&& ranges, typename flatten_view<RangeOfRanges>::size_type segment_size)
+{
+  return flatten_view<RangeOfRanges>(std::forward<RangeOfRanges>(ranges), segment_size);
+}
+
+
+// writes the offsets of each of ranges' segments followed by the total number of elements, suitable for flatten()
+template<class RangeOfRanges, class OutputIterator>
+__AGENCY_ANNOTATION
+OutputIterator segment_offsets(const RangeOfRanges& ranges, OutputIterator result)
+{
+  std::size_t offset = 0;
+
+  for(auto& segment : ranges)
+  {
+    *result = offset;
+    ++result;
+
+    offset += segment.size();
+  }
+
+  *result = offset;
+  ++result;
+
+  return result;
+}
+
+
 } // end experimental
 } // end agency
 
@@ -2,6 +2,11 @@
 
 #include <agency/detail/config.hpp>
 #include <agency/experimental/ranges/chunk.hpp>
+#include <agency/experimental/ranges/range_traits.hpp>
+#include <agency/experimental/span.hpp>
+#include <iterator>
+#include <type_traits>
+#include <cstddef>
 
 namespace agency
 {
@@ -37,6 +42,201 @@ auto tile_evenly(Range&& rng, Difference number_of_chunks) ->
 }
 
 
+// static_tile_view<T,N> views a contiguous array as a sequence of tiles of exactly N elements
+// each tile is a span<T,N>, whose extent is known at compile time, so a loop over a tile's elements has a constant trip count
+// the elements which do not fill a whole tile are excluded from the sequence of tiles and are available through remainder()
+template<class T, std::size_t N>
+class static_tile_view
+{
+  public:
+    static_assert(N > 0, "static_tile_view: N must be positive.");
+
+    static constexpr std::size_t tile_size = N;
+
+    using value_type = span<T,N>;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using size_type = std::size_t;
+
+    class iterator
+    {
+      public:
+        using value_type = span<T,N>;
+        using reference = value_type;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+
+        __AGENCY_ANNOTATION
+        iterator() : iterator(nullptr) {}
+
+        __AGENCY_ANNOTATION
+        explicit iterator(T* data) : data_(data) {}
+
+        __AGENCY_ANNOTATION
+        reference operator*() const
+        {
+          return reference(data_, N);
+        }
+
+        __AGENCY_ANNOTATION
+        reference operator[](difference_type i) const
+        {
+          return reference(data_ + i * difference_type(N), N);
+        }
+
+        __AGENCY_ANNOTATION
+        iterator& operator++()
+        {
+          data_ += N;
+          return *this;
+        }
+
+        __AGENCY_ANNOTATION
+        iterator operator++(int)
+        {
+          iterator result = *this;
+          ++(*this);
+          return result;
+        }
+
+        __AGENCY_ANNOTATION
+        iterator& operator--()
+        {
+          data_ -= N;
+          return *this;
+        }
+
+        __AGENCY_ANNOTATION
+        iterator operator--(int)
+        {
+          iterator result = *this;
+          --(*this);
+          return result;
+        }
+
+        __AGENCY_ANNOTATION
+        iterator& operator+=(difference_type n)
+        {
+          data_ += n * difference_type(N);
+          return *this;
+        }
+
+        __AGENCY_ANNOTATION
+        iterator& operator-=(difference_type n)
+        {
+          return *this += -n;
+        }
+
+        __AGENCY_ANNOTATION
+        iterator operator+(difference_type n) const
+        {
+          iterator result = *this;
+          return result += n;
+        }
+
+        __AGENCY_ANNOTATION
+        iterator operator-(difference_type n) const
+        {
+          iterator result = *this;
+          return result -= n;
+        }
+
+        __AGENCY_ANNOTATION
+        difference_type operator-(const iterator& rhs) const
+        {
+          return (data_ - rhs.data_) / difference_type(N);
+        }
+
+        __AGENCY_ANNOTATION
+        bool operator==(const iterator& rhs) const
+        {
+          return data_ == rhs.data_;
+        }
+
+        __AGENCY_ANNOTATION
+        bool operator!=(const iterator& rhs) const
+        {
+          return data_ != rhs.data_;
+        }
+
+        __AGENCY_ANNOTATION
+        bool operator<(const iterator& rhs) const
+        {
+          return data_ < rhs.data_;
+        }
+
+      private:
+        T* data_;
+    };
+
+    __AGENCY_ANNOTATION
+    static_tile_view() : static_tile_view(span<T>()) {}
+
+    __AGENCY_ANNOTATION
+    explicit static_tile_view(span<T> base)
+      : base_(base)
+    {}
+
+    // the number of whole tiles
+    __AGENCY_ANNOTATION
+    size_type size() const
+    {
+      return size_type(base_.size()) / N;
+    }
+
+    __AGENCY_ANNOTATION
+    iterator begin() const
+    {
+      return iterator(base_.data());
+    }
+
+    __AGENCY_ANNOTATION
+    iterator end() const
+    {
+      return begin() + size();
+    }
+
+    __AGENCY_ANNOTATION
+    reference operator[](size_type i) const
+    {
+      return begin()[i];
+    }
+
+    // the fewer than N elements following the last whole tile
+    __AGENCY_ANNOTATION
+    span<T> remainder() const
+    {
+      return base_.subspan(size() * N, base_.size() - size() * N);
+    }
+
+    __AGENCY_ANNOTATION
+    span<T> base() const
+    {
+      return base_;
+    }
+
+  private:
+    span<T> base_;
+};
+
+
+// tile<N>(rng) views a contiguous range as a static_tile_view of span<T,N> tiles
+// unlike tile(rng, tile_size), whose tiles have a size known only at runtime, the size of these tiles is part of their type
+template<std::size_t N, class Range,
+         class ElementType = typename std::remove_reference<range_reference_t<Range>>::type,
+         class = typename std::enable_if<
+           std::is_convertible<decltype(&*std::declval<Range&>().begin()), ElementType*>::value
+         >::type>
+__AGENCY_ANNOTATION
+static_tile_view<ElementType,N> tile(Range&& rng)
+{
+  // avoid dereferencing begin() when rng is empty
+  ElementType* data = rng.size() ? &*rng.begin() : nullptr;
+  return static_tile_view<ElementType,N>(span<ElementType>(data, rng.size()));
+}
+
+
 } // end experimental
 } // end agency
 
@@ -16,6 +16,8 @@ namespace experimental
 {
 
 
+// small_untiled_view stores at most max_tile_count tiles in place and indexes them statically
+// to view an unbounded number of tiles, use flatten_uniform(tiles, tile_size) instead
 template<class RangeOfRanges, size_t max_tile_count_ = 8>
 class small_untiled_view
 {
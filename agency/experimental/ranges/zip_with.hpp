@@ -1,7 +1,10 @@
 #pragma once
 
 #include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
 #include <agency/experimental/ranges/range_traits.hpp>
+#include <agency/detail/iterator/iterator_traits.hpp>
+#include <agency/detail/iterator/unwrap_contiguous_iterator.hpp>
 #include <agency/tuple.hpp>
 #include <agency/detail/tuple/tuple_utility.hpp>
 #include <type_traits>
@@ -15,6 +18,26 @@ namespace detail
 {
 
 
+// the weakest of several iterator categories
+template<class Category, class... Categories>
+struct common_iterator_category
+{
+  using type = Category;
+};
+
+template<class Category1, class Category2, class... Categories>
+struct common_iterator_category<Category1, Category2, Categories...>
+  : common_iterator_category<
+      typename std::conditional<
+        std::is_convertible<Category1,Category2>::value,
+        Category2,
+        Category1
+      >::type,
+      Categories...
+    >
+{};
+
+
 // XXX TODO: for completeness, the no iterators case
 // XXX       might wish to derive from Function to get the empty base class optimization
 template<class Function, class Iterator, class... Iterators>
@@ -52,7 +75,11 @@ class zip_with_iterator
       typename std::tuple_element<0,iterator_tuple_type>::type
     >::difference_type;
 
-    using iterator_category = typename std::iterator_traits<Iterator>::iterator_category;
+    // a zip_with_iterator can only move as its least capable component can
+    using iterator_category = typename common_iterator_category<
+      typename std::iterator_traits<Iterator>::iterator_category,
+      typename std::iterator_traits<Iterators>::iterator_category...
+    >::type;
 
     __AGENCY_ANNOTATION
     zip_with_iterator(Function f, Iterator iter, Iterators... iters)
@@ -133,12 +160,72 @@ class zip_with_iterator
       return result;
     }
 
+  private:
+    struct subscript_functor
+    {
+      difference_type i;
+
+      template<class OtherIterator>
+      __AGENCY_ANNOTATION
+      typename std::iterator_traits<OtherIterator>::reference
+        operator()(const OtherIterator& iter) const
+      {
+        return iter[i];
+      }
+    };
+
+  public:
     __AGENCY_ANNOTATION
     reference operator[](difference_type i) const
     {
-      auto tmp = *this;
-      tmp += i;
-      return *tmp;
+      // index each component directly rather than advancing a copy of the entire tuple
+      return __tu::tuple_map_with_make(subscript_functor{i}, f_, iterator_tuple_);
+    }
+
+  private:
+    struct unwrap_functor
+    {
+      template<class OtherIterator>
+      __AGENCY_ANNOTATION
+      agency::detail::unwrap_contiguous_iterator_t<OtherIterator>
+        operator()(const OtherIterator& iter) const
+      {
+        return agency::detail::unwrap_contiguous_iterator(iter);
+      }
+    };
+
+    struct make_functor
+    {
+      Function f;
+
+      template<class... OtherIterators>
+      __AGENCY_ANNOTATION
+      zip_with_iterator<Function,OtherIterators...> operator()(OtherIterators... iters) const
+      {
+        return zip_with_iterator<Function,OtherIterators...>(f, iters...);
+      }
+    };
+
+  public:
+    // the type of zip_with_iterator whose components are pointers
+    using unwrapped_iterator = zip_with_iterator<
+      Function,
+      agency::detail::unwrap_contiguous_iterator_t<Iterator>,
+      agency::detail::unwrap_contiguous_iterator_t<Iterators>...
+    >;
+
+    // when each component is contiguous, returns an equivalent zip_with_iterator whose components are pointers
+    // loops over the result index each component array directly, which compilers are able to vectorize
+    // *this must be dereferenceable
+    template<bool Deferred = true,
+             __AGENCY_REQUIRES(
+               Deferred &&
+               agency::detail::iterators_are_contiguous<Iterator,Iterators...>::value
+             )>
+    __AGENCY_ANNOTATION
+    unwrapped_iterator unwrap_contiguous() const
+    {
+      return __tu::tuple_map_with_make(unwrap_functor(), make_functor{f_}, iterator_tuple_);
     }
 
     // these operators are implemented as friend functions to allow interoperation with zip_with_iterators whose
@@ -222,6 +309,26 @@ zip_with_iterator<Function,Iterators...> make_zip_with_iterator(Function f, Iter
 }
 
 
+} // end detail
+
+
+// is_contiguous_per_component<Iterator> reports whether each of Iterator's components refers to
+// elements stored adjacently in memory
+// a contiguous iterator is its own single component, and each component of a zip_with_iterator
+// is one of the iterators it zips
+template<class Iterator>
+struct is_contiguous_per_component : agency::detail::iterator_is_contiguous<Iterator> {};
+
+template<class Function, class... Iterators>
+struct is_contiguous_per_component<detail::zip_with_iterator<Function,Iterators...>>
+  : agency::detail::iterators_are_contiguous<Iterators...>
+{};
+
+
+namespace detail
+{
+
+
 // because the only iterator we use when testing a zip_with_iterator for equality
 // or arithmetic is the first iterator in the tuple, it's wasteful to use
 // a full zip_with_iterator to represent the end of a zip_with_range
@@ -2,12 +2,23 @@
 
 #include <agency/detail/config.hpp>
 #include <agency/detail/requires.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/detail/algorithm/max.hpp>
+#include <agency/detail/algorithm/min.hpp>
+#include <agency/detail/algorithm/num_agents_for.hpp>
+#include <agency/execution/execution_policy/execution_policy_traits.hpp>
 #include <agency/experimental/ranges/range_traits.hpp>
 #include <agency/experimental/ranges/flatten.hpp>
 #include <agency/experimental/ranges/all.hpp>
+#include <agency/experimental/span.hpp>
 #include <agency/container/array.hpp>
 #include <agency/container/vector.hpp>
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace agency
 {
@@ -55,7 +66,7 @@ class segmented_array
         size_type last_segment_size = n - (segment_size * (allocators.size() - 1));
 
         // construct the full segments
-        auto last_alloc = --allocators.end();
+        auto last_alloc = std::prev(allocators.end());
         for(auto alloc = allocators.begin(); alloc != last_alloc; ++alloc)
         {
           segments_.emplace_back(segment_size, val, *alloc);
@@ -77,6 +88,8 @@ class segmented_array
           segments_.emplace_back(1, val, *alloc);
         }
       }
+
+      index_segments();
     }
 
     // constructs a segmented_array with a single segment
@@ -92,24 +105,34 @@ class segmented_array
     using outer_container = vector<inner_container, outer_allocator_type>;
     outer_container segments_;
 
+    // the offset of each segment's first element, followed by the total number of elements
+    // these allow all() to locate elements by binary search rather than by visiting each segment
+    vector<size_type> segment_offsets_;
+
+    void index_segments()
+    {
+      segment_offsets_ = vector<size_type>(segments_.size() + 1);
+      experimental::segment_offsets(segments_, segment_offsets_.begin());
+    }
+
   public:
     using all_t = flatten_view<outer_container>;
 
     all_t all()
     {
-      return flatten(segments_);
+      return flatten(segments_, segment_offsets());
     }
 
     using const_all_t = flatten_view<const outer_container>;
 
     const_all_t all() const
     {
-      return flatten(segments_);
+      return flatten(segments_, segment_offsets());
     }
 
     size_type size() const
     {
-      return all().size();
+      return segment_offsets_.empty() ? 0 : segment_offsets_.back();
     }
 
     using iterator = range_iterator_t<all_t>;
@@ -143,11 +166,24 @@ class segmented_array
       return agency::experimental::all(segments_);
     }
 
+    // a mutable segment is viewed as a span, so that its size cannot change without
+    // the offsets of the segments which follow it changing too
+    span<value_type> segment(size_type i)
+    {
+      return span<value_type>(segments_[i].data(), segments_[i].size());
+    }
+
     const inner_container& segment(size_type i) const
     {
       return segments()[i];
     }
 
+    // returns the position of each segment's first element, followed by size()
+    span<const size_type> segment_offsets() const
+    {
+      return span<const size_type>(segment_offsets_.data(), segment_offsets_.size());
+    }
+
     using segment_iterator = range_iterator_t<segments_view>;
 
     segment_iterator segments_begin() const
@@ -173,6 +209,7 @@ class segmented_array
     void clear()
     {
       segments_.clear();
+      segment_offsets_.clear();
     }
 
     bool operator==(const segmented_array& rhs) const
@@ -182,6 +219,105 @@ class segmented_array
 };
 
 
+namespace detail
+{
+namespace segmented_array_detail
+{
+
+
+// divides each segment of array into chunks of at most chunk_size elements
+// the chunks of segment s are numbered [result[s], result[s+1])
+// empty segments have no chunks
+template<class SegmentedArray>
+std::vector<std::size_t> chunk_segments(const SegmentedArray& array, std::size_t chunk_size)
+{
+  std::size_t num_segments = array.segments().size();
+
+  std::vector<std::size_t> result(num_segments + 1, 0);
+  for(std::size_t s = 0; s < num_segments; ++s)
+  {
+    result[s+1] = result[s] + agency::detail::ceil_div(array.segment(s).size(), chunk_size);
+  }
+
+  return result;
+}
+
+
+// invokes the user's function on the chunk owned by the calling agent
+template<class Function>
+struct invoke_on_chunk
+{
+  Function f;
+
+  template<class SegmentedArray>
+  using element_t = typename std::conditional<
+    std::is_const<SegmentedArray>::value,
+    const typename SegmentedArray::value_type,
+    typename SegmentedArray::value_type
+  >::type;
+
+  template<class Agent, class SegmentedArray, class... Args>
+  auto operator()(Agent& self, SegmentedArray* array, const std::size_t* chunk_offsets, std::size_t chunk_size, Args&&... args) ->
+    decltype(std::declval<Function&>()(self, std::declval<span<element_t<SegmentedArray>>>(), std::size_t(), std::forward<Args>(args)...))
+  {
+    std::size_t num_segments = array->segments().size();
+
+    // find the segment containing this agent's chunk
+    std::size_t s = std::upper_bound(chunk_offsets, chunk_offsets + num_segments + 1, self.rank()) - chunk_offsets - 1;
+
+    auto&& segment = array->segment(s);
+
+    std::size_t begin = (self.rank() - chunk_offsets[s]) * chunk_size;
+    std::size_t end = agency::detail::min<std::size_t>(segment.size(), begin + chunk_size);
+
+    return f(self, span<element_t<SegmentedArray>>(segment.data() + begin, end - begin), array->segment_offsets()[s] + begin, std::forward<Args>(args)...);
+  }
+};
+
+
+template<class ExecutionPolicy, class SegmentedArray, class Function, class... Args>
+auto bulk_invoke_chunks(ExecutionPolicy&& policy, SegmentedArray& array, Function f, Args&&... args) ->
+  decltype(agency::bulk_invoke(policy(std::size_t()), invoke_on_chunk<Function>{f}, &array, std::declval<const std::size_t*>(), std::size_t(), std::forward<Args>(args)...))
+{
+  std::size_t num_agents = agency::detail::num_agents_for(policy, array.size());
+  std::size_t chunk_size = agency::detail::max<std::size_t>(1, agency::detail::ceil_div(array.size(), num_agents));
+
+  std::vector<std::size_t> chunk_offsets = chunk_segments(array, chunk_size);
+
+  return agency::bulk_invoke(policy(chunk_offsets.back()), invoke_on_chunk<Function>{f}, &array, chunk_offsets.data(), chunk_size, std::forward<Args>(args)...);
+}
+
+
+} // end segmented_array_detail
+} // end detail
+
+
+// creates agents which each own a contiguous chunk of a single segment of array and invokes
+// f(self, chunk, first, args...), where chunk is a span of the chunk's elements and first is the
+// position of chunk[0] within array
+// chunks never span two segments, so each agent traverses contiguous memory owned by a single allocator
+// a segment is divided into several chunks only when it is larger than the policy's share of array's elements
+template<class ExecutionPolicy, class T, template<class> class InnerAlloc, template<class> class OuterAlloc, class Function, class... Args,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+auto bulk_invoke(ExecutionPolicy&& policy, segmented_array<T,InnerAlloc,OuterAlloc>& array, Function f, Args&&... args) ->
+  decltype(detail::segmented_array_detail::bulk_invoke_chunks(std::forward<ExecutionPolicy>(policy), array, f, std::forward<Args>(args)...))
+{
+  return detail::segmented_array_detail::bulk_invoke_chunks(std::forward<ExecutionPolicy>(policy), array, f, std::forward<Args>(args)...);
+}
+
+
+template<class ExecutionPolicy, class T, template<class> class InnerAlloc, template<class> class OuterAlloc, class Function, class... Args,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+auto bulk_invoke(ExecutionPolicy&& policy, const segmented_array<T,InnerAlloc,OuterAlloc>& array, Function f, Args&&... args) ->
+  decltype(detail::segmented_array_detail::bulk_invoke_chunks(std::forward<ExecutionPolicy>(policy), array, f, std::forward<Args>(args)...))
+{
+  return detail::segmented_array_detail::bulk_invoke_chunks(std::forward<ExecutionPolicy>(policy), array, f, std::forward<Args>(args)...);
+}
+
+
 } // end experimental
 } // end agency
-
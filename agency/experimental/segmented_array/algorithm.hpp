@@ -0,0 +1,257 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/execution/execution_policy/execution_policy_traits.hpp>
+#include <agency/experimental/segmented_array.hpp>
+#include <agency/experimental/span.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+namespace agency
+{
+namespace experimental
+{
+namespace detail
+{
+namespace segmented_array_algorithm_detail
+{
+
+
+template<class T>
+struct fill_chunk_functor
+{
+  template<class Agent, class U>
+  void operator()(Agent&, span<U> chunk, std::size_t, const T& value)
+  {
+    for(auto& x : chunk)
+    {
+      x = value;
+    }
+  }
+};
+
+
+struct identity
+{
+  template<class T>
+  const T& operator()(const T& x) const
+  {
+    return x;
+  }
+};
+
+
+// writes op(chunk[i]) to result[first + i]
+struct transform_chunk_functor
+{
+  template<class Agent, class T, class RandomAccessIterator, class UnaryFunction>
+  void operator()(Agent&, span<const T> chunk, std::size_t first, RandomAccessIterator result, UnaryFunction op)
+  {
+    result += first;
+
+    for(typename span<const T>::index_type i = 0; i < chunk.size(); ++i)
+    {
+      result[i] = op(chunk[i]);
+    }
+  }
+};
+
+
+// writes op(chunk[i]) to (*output)[first + i]
+// when the output is divided into segments at the same positions as the input, the elements of
+// an input chunk correspond to contiguous elements of a single output segment
+struct transform_chunk_to_segments_functor
+{
+  template<class Agent, class T, class SegmentedArray, class UnaryFunction>
+  void operator()(Agent&, span<const T> chunk, std::size_t first, SegmentedArray* output, bool segments_are_aligned, UnaryFunction op)
+  {
+    if(segments_are_aligned)
+    {
+      auto* result = &output->all()[first];
+
+      for(typename span<const T>::index_type i = 0; i < chunk.size(); ++i)
+      {
+        result[i] = op(chunk[i]);
+      }
+    }
+    else
+    {
+      auto result = output->all().begin() + first;
+
+      for(typename span<const T>::index_type i = 0; i < chunk.size(); ++i, ++result)
+      {
+        *result = op(chunk[i]);
+      }
+    }
+  }
+};
+
+
+// returns the reduction of a chunk's elements
+// chunks are never empty, so the reduction begins with the chunk's first element
+template<class U>
+struct reduce_chunk_functor
+{
+  template<class Agent, class T, class BinaryOperation>
+  U operator()(Agent&, span<const T> chunk, std::size_t, BinaryOperation op)
+  {
+    U result = chunk[0];
+
+    for(typename span<const T>::index_type i = 1; i < chunk.size(); ++i)
+    {
+      result = op(result, chunk[i]);
+    }
+
+    return result;
+  }
+};
+
+
+} // end segmented_array_algorithm_detail
+} // end detail
+
+
+/// \brief Assigns a value to each element of a `segmented_array` in parallel.
+///
+/// Each of the policy's execution agents fills a contiguous chunk of a single segment, so each segment is written
+/// where it lives, at the speed of a contiguous array.
+///
+/// \param policy An execution policy whose agents perform the fill.
+/// \param array The `segmented_array` to fill.
+/// \param value The value to assign.
+template<class ExecutionPolicy, class T, template<class> class InnerAlloc, template<class> class OuterAlloc, class U,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+void fill(ExecutionPolicy&& policy, segmented_array<T,InnerAlloc,OuterAlloc>& array, const U& value)
+{
+  if(array.size() == 0) return;
+
+  experimental::bulk_invoke(std::forward<ExecutionPolicy>(policy), array, detail::segmented_array_algorithm_detail::fill_chunk_functor<U>(), value);
+}
+
+
+/// \brief Applies a function to each element of a `segmented_array` in parallel and stores the results in a range.
+///
+/// `transform` writes `op(input[i])` to `result[i]` for each position `i` of `input`. Each of the policy's execution
+/// agents reads a contiguous chunk of a single segment of `input`.
+///
+/// \param policy An execution policy whose agents perform the transformation.
+/// \param input The `segmented_array` to transform.
+/// \param result The beginning of the output range.
+/// \param op The function to apply.
+/// \return The end of the output range.
+template<class ExecutionPolicy, class T, template<class> class InnerAlloc, template<class> class OuterAlloc, class RandomAccessIterator, class UnaryFunction,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+RandomAccessIterator transform(ExecutionPolicy&& policy, const segmented_array<T,InnerAlloc,OuterAlloc>& input, RandomAccessIterator result, UnaryFunction op)
+{
+  if(input.size() == 0) return result;
+
+  experimental::bulk_invoke(std::forward<ExecutionPolicy>(policy), input, detail::segmented_array_algorithm_detail::transform_chunk_functor(), result, op);
+
+  return result + input.size();
+}
+
+
+/// \brief Applies a function to each element of a `segmented_array` in parallel and stores the results in another `segmented_array`.
+///
+/// `transform` writes `op(input[i])` to `output[i]` for each position `i` of `input`. `output` must have at least as
+/// many elements as `input`. Each of the policy's execution agents reads a contiguous chunk of a single segment of
+/// `input`. When `output`'s segments begin at the same positions as `input`'s, the chunk's results are also written
+/// contiguously to a single segment of `output`.
+///
+/// \param policy An execution policy whose agents perform the transformation.
+/// \param input The `segmented_array` to transform.
+/// \param output The `segmented_array` to receive the results.
+/// \param op The function to apply.
+template<class ExecutionPolicy, class T, template<class> class InnerAlloc1, template<class> class OuterAlloc1,
+         class U, template<class> class InnerAlloc2, template<class> class OuterAlloc2,
+         class UnaryFunction,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+void transform(ExecutionPolicy&& policy, const segmented_array<T,InnerAlloc1,OuterAlloc1>& input, segmented_array<U,InnerAlloc2,OuterAlloc2>& output, UnaryFunction op)
+{
+  assert(output.size() >= input.size());
+
+  if(input.size() == 0) return;
+
+  auto input_offsets = input.segment_offsets();
+  auto output_offsets = output.segment_offsets();
+
+  bool segments_are_aligned = input_offsets.size() == output_offsets.size() && std::equal(input_offsets.begin(), input_offsets.end(), output_offsets.begin());
+
+  experimental::bulk_invoke(std::forward<ExecutionPolicy>(policy), input, detail::segmented_array_algorithm_detail::transform_chunk_to_segments_functor(), &output, segments_are_aligned, op);
+}
+
+
+/// \brief Copies the elements of a `segmented_array` into a range in parallel.
+///
+/// \param policy An execution policy whose agents perform the copy.
+/// \param input The `segmented_array` to copy.
+/// \param result The beginning of the output range.
+/// \return The end of the output range.
+template<class ExecutionPolicy, class T, template<class> class InnerAlloc, template<class> class OuterAlloc, class RandomAccessIterator,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+RandomAccessIterator copy(ExecutionPolicy&& policy, const segmented_array<T,InnerAlloc,OuterAlloc>& input, RandomAccessIterator result)
+{
+  return experimental::transform(std::forward<ExecutionPolicy>(policy), input, result, detail::segmented_array_algorithm_detail::identity());
+}
+
+
+/// \brief Copies the elements of a `segmented_array` into another `segmented_array` in parallel.
+///
+/// `output` must have at least as many elements as `input`.
+///
+/// \param policy An execution policy whose agents perform the copy.
+/// \param input The `segmented_array` to copy.
+/// \param output The `segmented_array` to copy to.
+template<class ExecutionPolicy, class T, template<class> class InnerAlloc1, template<class> class OuterAlloc1,
+         class U, template<class> class InnerAlloc2, template<class> class OuterAlloc2,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+void copy(ExecutionPolicy&& policy, const segmented_array<T,InnerAlloc1,OuterAlloc1>& input, segmented_array<U,InnerAlloc2,OuterAlloc2>& output)
+{
+  experimental::transform(std::forward<ExecutionPolicy>(policy), input, output, detail::segmented_array_algorithm_detail::identity());
+}
+
+
+/// \brief Reduces the elements of a `segmented_array` in parallel.
+///
+/// `reduce` returns `init` combined under `op` with each of `array`'s elements. Each of the policy's execution agents
+/// reduces a contiguous chunk of a single segment, and the chunks' results are combined in order.
+///
+/// \param policy An execution policy whose agents perform the reduction.
+/// \param array The `segmented_array` to reduce.
+/// \param init The initial value of the reduction.
+/// \param op An associative binary operation.
+/// \return The reduction.
+template<class ExecutionPolicy, class T, template<class> class InnerAlloc, template<class> class OuterAlloc, class U, class BinaryOperation,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+U reduce(ExecutionPolicy&& policy, const segmented_array<T,InnerAlloc,OuterAlloc>& array, U init, BinaryOperation op)
+{
+  if(array.size() == 0) return init;
+
+  auto partial_sums = experimental::bulk_invoke(std::forward<ExecutionPolicy>(policy), array, detail::segmented_array_algorithm_detail::reduce_chunk_functor<U>(), op);
+
+  for(const auto& partial_sum : partial_sums)
+  {
+    init = op(init, partial_sum);
+  }
+
+  return init;
+}
+
+
+} // end experimental
+} // end agency
+
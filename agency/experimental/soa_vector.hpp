@@ -0,0 +1,717 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/detail/integer_sequence.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/execution/execution_policy.hpp>
+#include <agency/execution/execution_policy/execution_policy_traits.hpp>
+#include <agency/memory/detail/storage.hpp>
+#include <agency/memory/allocator/detail/aligned_allocator.hpp>
+#include <agency/experimental/span.hpp>
+#include <agency/tuple.hpp>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace agency
+{
+namespace experimental
+{
+namespace detail
+{
+namespace soa_vector_detail
+{
+
+
+// each field's array begins on its own cache line
+template<class T>
+using default_allocator = agency::detail::aligned_allocator<T, 64>;
+
+
+template<class... Args>
+__AGENCY_ANNOTATION
+void swallow(Args&&...)
+{
+}
+
+
+// soa_iterator visits the elements of several parallel arrays, one from each array at a time
+// its reference is a tuple of references to the elements at the iterator's position, so assigning to *iter
+// assigns to each field in turn
+template<class... Types>
+class soa_iterator
+{
+  public:
+    using value_type = agency::tuple<typename std::remove_const<Types>::type...>;
+    using reference = agency::tuple<Types&...>;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+
+    using field_pointers = agency::tuple<Types*...>;
+
+    __AGENCY_ANNOTATION
+    soa_iterator()
+      : fields_(), position_(0)
+    {}
+
+    __AGENCY_ANNOTATION
+    soa_iterator(const field_pointers& fields, difference_type position)
+      : fields_(fields), position_(position)
+    {}
+
+    // converts an iterator over mutable fields into an iterator over const fields
+    template<class... OtherTypes,
+             __AGENCY_REQUIRES(
+               std::is_convertible<agency::tuple<OtherTypes*...>, field_pointers>::value
+             )>
+    __AGENCY_ANNOTATION
+    soa_iterator(const soa_iterator<OtherTypes...>& other)
+      : fields_(other.fields()), position_(other.position())
+    {}
+
+    __AGENCY_ANNOTATION
+    const field_pointers& fields() const
+    {
+      return fields_;
+    }
+
+    __AGENCY_ANNOTATION
+    difference_type position() const
+    {
+      return position_;
+    }
+
+    __AGENCY_ANNOTATION
+    reference operator*() const
+    {
+      return (*this)[0];
+    }
+
+    __AGENCY_ANNOTATION
+    reference operator[](difference_type n) const
+    {
+      return dereference(position_ + n, agency::detail::make_index_sequence<sizeof...(Types)>());
+    }
+
+    __AGENCY_ANNOTATION
+    soa_iterator& operator++()
+    {
+      ++position_;
+      return *this;
+    }
+
+    __AGENCY_ANNOTATION
+    soa_iterator operator++(int)
+    {
+      soa_iterator result = *this;
+      ++position_;
+      return result;
+    }
+
+    __AGENCY_ANNOTATION
+    soa_iterator& operator--()
+    {
+      --position_;
+      return *this;
+    }
+
+    __AGENCY_ANNOTATION
+    soa_iterator operator--(int)
+    {
+      soa_iterator result = *this;
+      --position_;
+      return result;
+    }
+
+    __AGENCY_ANNOTATION
+    soa_iterator& operator+=(difference_type n)
+    {
+      position_ += n;
+      return *this;
+    }
+
+    __AGENCY_ANNOTATION
+    soa_iterator& operator-=(difference_type n)
+    {
+      position_ -= n;
+      return *this;
+    }
+
+    __AGENCY_ANNOTATION
+    soa_iterator operator+(difference_type n) const
+    {
+      return soa_iterator(fields_, position_ + n);
+    }
+
+    __AGENCY_ANNOTATION
+    soa_iterator operator-(difference_type n) const
+    {
+      return soa_iterator(fields_, position_ - n);
+    }
+
+    __AGENCY_ANNOTATION
+    difference_type operator-(const soa_iterator& rhs) const
+    {
+      return position_ - rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator==(const soa_iterator& rhs) const
+    {
+      return position_ == rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator!=(const soa_iterator& rhs) const
+    {
+      return position_ != rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator<(const soa_iterator& rhs) const
+    {
+      return position_ < rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator<=(const soa_iterator& rhs) const
+    {
+      return position_ <= rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator>(const soa_iterator& rhs) const
+    {
+      return position_ > rhs.position_;
+    }
+
+    __AGENCY_ANNOTATION
+    bool operator>=(const soa_iterator& rhs) const
+    {
+      return position_ >= rhs.position_;
+    }
+
+  private:
+    template<size_t... Indices>
+    __AGENCY_ANNOTATION
+    reference dereference(difference_type i, agency::detail::index_sequence<Indices...>) const
+    {
+      return reference(agency::get<Indices>(fields_)[i]...);
+    }
+
+    field_pointers fields_;
+    difference_type position_;
+};
+
+
+// constructs the i-th element of each field from the corresponding component of a tuple
+__agency_exec_check_disable__
+template<class... Types, class Tuple, size_t... Indices>
+__AGENCY_ANNOTATION
+void construct_element(const agency::tuple<Types*...>& fields, std::size_t i, Tuple&& components, agency::detail::index_sequence<Indices...>)
+{
+  soa_vector_detail::swallow(
+    (::new(static_cast<void*>(agency::get<Indices>(fields) + i)) Types(agency::get<Indices>(std::forward<Tuple>(components))), 0)...
+  );
+}
+
+
+// destroys the i-th element of each field
+__agency_exec_check_disable__
+template<class... Types, size_t... Indices>
+__AGENCY_ANNOTATION
+void destroy_element(const agency::tuple<Types*...>& fields, std::size_t i, agency::detail::index_sequence<Indices...>)
+{
+  soa_vector_detail::swallow(
+    (agency::get<Indices>(fields)[i].~Types(), 0)...
+  );
+}
+
+
+// each agent constructs one element of each field from an element of a range of tuples
+struct construct_from_range_functor
+{
+  __agency_exec_check_disable__
+  template<class Agent, class... Types, class RandomAccessIterator>
+  __AGENCY_ANNOTATION
+  void operator()(Agent& self, const agency::tuple<Types*...>& fields, RandomAccessIterator first)
+  {
+    auto i = self.rank();
+
+    soa_vector_detail::construct_element(fields, i, first[i], agency::detail::make_index_sequence<sizeof...(Types)>());
+  }
+};
+
+
+// each agent constructs one element of each field from the corresponding component of value
+struct construct_from_value_functor
+{
+  __agency_exec_check_disable__
+  template<class Agent, class... Types, class Tuple>
+  __AGENCY_ANNOTATION
+  void operator()(Agent& self, const agency::tuple<Types*...>& fields, const Tuple& value)
+  {
+    soa_vector_detail::construct_element(fields, self.rank(), value, agency::detail::make_index_sequence<sizeof...(Types)>());
+  }
+};
+
+
+} // end soa_vector_detail
+} // end detail
+
+
+// basic_soa_vector stores a sequence of tuples as a structure of arrays:
+// the I-th component of each element lives in the I-th of several parallel arrays, called fields
+// each field is allocated separately by an allocator of type Alloc<T>, so a loop over one field touches only that field's memory
+// elements are accessed through tuples of references, and each field is accessible as a span
+template<class Tuple, template<class> class Alloc = detail::soa_vector_detail::default_allocator>
+class basic_soa_vector;
+
+
+template<class... Types, template<class> class Alloc>
+class basic_soa_vector<agency::tuple<Types...>, Alloc>
+{
+  private:
+    template<class T>
+    using storage_type = agency::detail::storage<T, Alloc<T>>;
+
+    using storage_tuple = agency::tuple<storage_type<Types>...>;
+
+    using indices = agency::detail::make_index_sequence<sizeof...(Types)>;
+
+  public:
+    using value_type      = agency::tuple<Types...>;
+    using reference       = agency::tuple<Types&...>;
+    using const_reference = agency::tuple<const Types&...>;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using iterator = detail::soa_vector_detail::soa_iterator<Types...>;
+    using const_iterator = detail::soa_vector_detail::soa_iterator<const Types...>;
+
+    template<std::size_t I>
+    using field_type = typename std::tuple_element<I, value_type>::type;
+
+    static constexpr std::size_t num_fields = sizeof...(Types);
+
+    basic_soa_vector()
+      : storages_(make_storages(0)), size_(0)
+    {}
+
+    explicit basic_soa_vector(size_type count)
+      : basic_soa_vector(sequenced_execution_policy(), count)
+    {}
+
+    // value-initializes count elements in parallel
+    template<class ExecutionPolicy, __AGENCY_REQUIRES(is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value)>
+    basic_soa_vector(ExecutionPolicy&& policy, size_type count)
+      : basic_soa_vector(std::forward<ExecutionPolicy>(policy), count, value_type())
+    {}
+
+    basic_soa_vector(size_type count, const value_type& value)
+      : basic_soa_vector(sequenced_execution_policy(), count, value)
+    {}
+
+    // copy constructs each of count elements from value in parallel
+    // the i-th agent created by policy constructs the i-th element of every field
+    template<class ExecutionPolicy, __AGENCY_REQUIRES(is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value)>
+    basic_soa_vector(ExecutionPolicy&& policy, size_type count, const value_type& value)
+      : storages_(make_storages(count)), size_(0)
+    {
+      if(count > 0)
+      {
+        agency::bulk_invoke(policy(count), detail::soa_vector_detail::construct_from_value_functor(), fields(), value);
+      }
+
+      size_ = count;
+    }
+
+    template<class InputIterator,
+             __AGENCY_REQUIRES(
+               std::is_convertible<
+                 typename std::iterator_traits<InputIterator>::iterator_category,
+                 std::input_iterator_tag
+               >::value
+             )>
+    basic_soa_vector(InputIterator first, InputIterator last)
+      : basic_soa_vector()
+    {
+      for(; first != last; ++first)
+      {
+        emplace_back_from_tuple(*first);
+      }
+    }
+
+    // constructs elements from a range of tuples in parallel
+    // the i-th agent created by policy constructs the i-th element of every field from the components of first[i]
+    template<class ExecutionPolicy,
+             class RandomAccessIterator,
+             __AGENCY_REQUIRES(
+               is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+             ),
+             __AGENCY_REQUIRES(
+               std::is_convertible<
+                 typename std::iterator_traits<RandomAccessIterator>::iterator_category,
+                 std::random_access_iterator_tag
+               >::value
+             )>
+    basic_soa_vector(ExecutionPolicy&& policy, RandomAccessIterator first, RandomAccessIterator last)
+      : storages_(make_storages(last - first)), size_(0)
+    {
+      size_type count = last - first;
+
+      if(count > 0)
+      {
+        agency::bulk_invoke(policy(count), detail::soa_vector_detail::construct_from_range_functor(), fields(), first);
+      }
+
+      size_ = count;
+    }
+
+    basic_soa_vector(const basic_soa_vector& other)
+      : basic_soa_vector(sequenced_execution_policy(), other)
+    {}
+
+    template<class ExecutionPolicy, __AGENCY_REQUIRES(is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value)>
+    basic_soa_vector(ExecutionPolicy&& policy, const basic_soa_vector& other)
+      : basic_soa_vector(std::forward<ExecutionPolicy>(policy), other.begin(), other.end())
+    {}
+
+    basic_soa_vector(basic_soa_vector&& other)
+      : storages_(std::move(other.storages_)),
+        size_(other.size_)
+    {
+      // leave the other vector in a valid state
+      other.size_ = 0;
+    }
+
+    ~basic_soa_vector()
+    {
+      clear();
+    }
+
+    basic_soa_vector& operator=(const basic_soa_vector& other)
+    {
+      basic_soa_vector tmp(other);
+      swap(tmp);
+      return *this;
+    }
+
+    basic_soa_vector& operator=(basic_soa_vector&& other)
+    {
+      basic_soa_vector tmp(std::move(other));
+      swap(tmp);
+      return *this;
+    }
+
+    // element access
+
+    reference operator[](size_type pos)
+    {
+      return begin()[pos];
+    }
+
+    const_reference operator[](size_type pos) const
+    {
+      return begin()[pos];
+    }
+
+    reference front()
+    {
+      return *begin();
+    }
+
+    const_reference front() const
+    {
+      return *begin();
+    }
+
+    reference back()
+    {
+      return end()[-1];
+    }
+
+    const_reference back() const
+    {
+      return end()[-1];
+    }
+
+    // field access
+
+    // returns a pointer to the array of the I-th components of the elements
+    template<std::size_t I>
+    field_type<I>* data()
+    {
+      return agency::get<I>(storages_).data();
+    }
+
+    template<std::size_t I>
+    const field_type<I>* data() const
+    {
+      return agency::get<I>(storages_).data();
+    }
+
+    // returns a span of the I-th components of the elements
+    template<std::size_t I>
+    span<field_type<I>> field()
+    {
+      return span<field_type<I>>(data<I>(), size());
+    }
+
+    template<std::size_t I>
+    span<const field_type<I>> field() const
+    {
+      return span<const field_type<I>>(data<I>(), size());
+    }
+
+    // returns a tuple of spans, one for each field
+    agency::tuple<span<Types>...> spans()
+    {
+      return spans_impl<Types...>(*this, indices());
+    }
+
+    agency::tuple<span<const Types>...> spans() const
+    {
+      return spans_impl<const Types...>(*this, indices());
+    }
+
+    // iterators
+
+    iterator begin()
+    {
+      return iterator(fields(), 0);
+    }
+
+    const_iterator begin() const
+    {
+      return const_iterator(fields(), 0);
+    }
+
+    const_iterator cbegin() const
+    {
+      return begin();
+    }
+
+    iterator end()
+    {
+      return begin() + size();
+    }
+
+    const_iterator end() const
+    {
+      return begin() + size();
+    }
+
+    const_iterator cend() const
+    {
+      return end();
+    }
+
+    // capacity
+
+    bool empty() const
+    {
+      return size() == 0;
+    }
+
+    size_type size() const
+    {
+      return size_;
+    }
+
+    size_type capacity() const
+    {
+      return agency::get<0>(storages_).size();
+    }
+
+    void reserve(size_type new_capacity)
+    {
+      if(new_capacity > capacity())
+      {
+        reallocate(new_capacity);
+      }
+    }
+
+    void shrink_to_fit()
+    {
+      if(capacity() > size())
+      {
+        reallocate(size());
+      }
+    }
+
+    // modifiers
+
+    void clear()
+    {
+      for(size_type i = 0; i < size(); ++i)
+      {
+        detail::soa_vector_detail::destroy_element(fields(), i, indices());
+      }
+
+      size_ = 0;
+    }
+
+    void push_back(const value_type& value)
+    {
+      emplace_back_from_tuple(value);
+    }
+
+    void push_back(value_type&& value)
+    {
+      emplace_back_from_tuple(std::move(value));
+    }
+
+    void pop_back()
+    {
+      --size_;
+      detail::soa_vector_detail::destroy_element(fields(), size(), indices());
+    }
+
+    void resize(size_type count)
+    {
+      resize(count, value_type());
+    }
+
+    void resize(size_type count, const value_type& value)
+    {
+      if(count < size())
+      {
+        while(size() > count)
+        {
+          pop_back();
+        }
+      }
+      else
+      {
+        reserve(count);
+
+        for(size_type i = size(); i < count; ++i)
+        {
+          detail::soa_vector_detail::construct_element(fields(), i, value, indices());
+        }
+
+        size_ = count;
+      }
+    }
+
+    void swap(basic_soa_vector& other)
+    {
+      swap_storages(other, indices());
+      agency::detail::adl_swap(size_, other.size_);
+    }
+
+  private:
+    static storage_tuple make_storages(size_type count)
+    {
+      return storage_tuple(storage_type<Types>(count)...);
+    }
+
+    template<size_t... Indices>
+    agency::tuple<Types*...> fields_impl(agency::detail::index_sequence<Indices...>)
+    {
+      return agency::tuple<Types*...>(agency::get<Indices>(storages_).data()...);
+    }
+
+    template<size_t... Indices>
+    agency::tuple<const Types*...> fields_impl(agency::detail::index_sequence<Indices...>) const
+    {
+      return agency::tuple<const Types*...>(agency::get<Indices>(storages_).data()...);
+    }
+
+    agency::tuple<Types*...> fields()
+    {
+      return fields_impl(indices());
+    }
+
+    agency::tuple<const Types*...> fields() const
+    {
+      return fields_impl(indices());
+    }
+
+    template<class... SpanTypes, class Self, size_t... Indices>
+    static agency::tuple<span<SpanTypes>...> spans_impl(Self& self, agency::detail::index_sequence<Indices...>)
+    {
+      return agency::tuple<span<SpanTypes>...>(self.template field<Indices>()...);
+    }
+
+    template<size_t... Indices>
+    void swap_storages(basic_soa_vector& other, agency::detail::index_sequence<Indices...>)
+    {
+      detail::soa_vector_detail::swallow((agency::get<Indices>(storages_).swap(agency::get<Indices>(other.storages_)), 0)...);
+    }
+
+    template<size_t... Indices>
+    static void move_element(agency::tuple<Types*...> to, agency::tuple<Types*...> from, size_type i, agency::detail::index_sequence<Indices...>)
+    {
+      detail::soa_vector_detail::swallow(
+        (::new(static_cast<void*>(agency::get<Indices>(to) + i)) Types(std::move(agency::get<Indices>(from)[i])), 0)...
+      );
+    }
+
+    // moves the elements into new fields, each with room for new_capacity elements
+    void reallocate(size_type new_capacity)
+    {
+      basic_soa_vector tmp;
+      tmp.storages_ = make_storages(new_capacity);
+
+      for(size_type i = 0; i < size(); ++i)
+      {
+        move_element(tmp.fields(), fields(), i, indices());
+        ++tmp.size_;
+      }
+
+      swap(tmp);
+    }
+
+    // constructs a new last element from the components of a tuple
+    template<class Tuple>
+    void emplace_back_from_tuple(Tuple&& components)
+    {
+      if(size() == capacity())
+      {
+        reserve(capacity() == 0 ? 1 : 2 * capacity());
+      }
+
+      detail::soa_vector_detail::construct_element(fields(), size(), std::forward<Tuple>(components), indices());
+      ++size_;
+    }
+
+    storage_tuple storages_;
+    size_type size_;
+};
+
+
+template<class... Types, template<class> class Alloc>
+bool operator==(const basic_soa_vector<agency::tuple<Types...>,Alloc>& lhs, const basic_soa_vector<agency::tuple<Types...>,Alloc>& rhs)
+{
+  if(lhs.size() != rhs.size()) return false;
+
+  for(std::size_t i = 0; i < lhs.size(); ++i)
+  {
+    if(lhs[i] != rhs[i]) return false;
+  }
+
+  return true;
+}
+
+
+template<class... Types, template<class> class Alloc>
+bool operator!=(const basic_soa_vector<agency::tuple<Types...>,Alloc>& lhs, const basic_soa_vector<agency::tuple<Types...>,Alloc>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+// soa_vector<Types...> is a basic_soa_vector of agency::tuple<Types...> whose fields are each aligned to a cache line
+template<class... Types>
+using soa_vector = basic_soa_vector<agency::tuple<Types...>>;
+
+
+} // end experimental
+} // end agency
+
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/execution/execution_policy.hpp>
+#include <agency/execution/execution_policy/execution_policy_traits.hpp>
+#include <agency/execution/executor/sequenced_executor.hpp>
+#include <agency/experimental/ranges/tile.hpp>
+#include <agency/experimental/span.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace agency
+{
+namespace experimental
+{
+namespace detail
+{
+namespace tile_bulk_invoke_detail
+{
+
+
+// invokes the user's function on the element of a whole tile owned by the calling agent
+// the outer agent selects the tile and the inner static_parallel_agent selects the element
+template<class Function>
+struct invoke_on_tile_element
+{
+  Function f;
+
+  template<class Agent, class T, std::size_t N, class... Args>
+  void operator()(Agent& self, const static_tile_view<T,N>& tiles, Args&&... args)
+  {
+    span<T,N> tile = tiles[self.outer().index()];
+
+    f(self.inner(), tile[self.inner().index()], std::forward<Args>(args)...);
+  }
+};
+
+
+// invokes the user's function on the element of the remainder owned by the calling agent
+template<class Function>
+struct invoke_on_remainder_element
+{
+  Function f;
+
+  template<class Agent, class T, class... Args>
+  void operator()(Agent& self, span<T> remainder, Args&&... args)
+  {
+    f(self, remainder[self.index()], std::forward<Args>(args)...);
+  }
+};
+
+
+} // end tile_bulk_invoke_detail
+} // end detail
+
+
+// creates an agent for each element of tiles' underlying array and invokes f(self, x, args...), where x is that element
+//
+// the elements of each whole tile are visited by a group of N static_parallel_agent<N>s nested within an agent
+// created by policy; because the group executes on an unrolling_executor, the loop over a tile's elements is fully
+// unrolled and has a constant trip count
+//
+// the elements of tiles.remainder() are visited afterward by a group of parallel_agents, so the unrolled loop never
+// needs to guard against a partial tile
+// because static_parallel_agent<N> derives from parallel_agent, a function which accepts a parallel_agent& is able
+// to receive either kind of agent
+template<class ExecutionPolicy, class T, std::size_t N, class Function, class... Args,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+void bulk_invoke(ExecutionPolicy&& policy, static_tile_view<T,N> tiles, Function f, Args&&... args)
+{
+  if(tiles.size() > 0)
+  {
+    agency::bulk_invoke(policy(tiles.size(), static_parallel_execution_policy<N>()),
+                        detail::tile_bulk_invoke_detail::invoke_on_tile_element<Function>{f},
+                        tiles,
+                        args...);
+  }
+
+  span<T> remainder = tiles.remainder();
+
+  if(remainder.size() > 0)
+  {
+    agency::bulk_invoke(agency::par(remainder.size()).on(agency::sequenced_executor()),
+                        detail::tile_bulk_invoke_detail::invoke_on_remainder_element<Function>{f},
+                        remainder,
+                        args...);
+  }
+}
+
+
+} // end experimental
+} // end agency
+
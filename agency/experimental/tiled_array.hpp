@@ -2,17 +2,211 @@
 
 #include <agency/detail/config.hpp>
 #include <agency/detail/requires.hpp>
+#include <agency/bulk_invoke.hpp>
+#include <agency/execution/execution_policy/execution_policy_traits.hpp>
+#include <agency/execution/execution_policy/parallel_execution_policy.hpp>
+#include <agency/execution/execution_policy/sequenced_execution_policy.hpp>
 #include <agency/experimental/ranges/range_traits.hpp>
-#include <agency/experimental/ranges/untile.hpp>
+#include <agency/experimental/ranges/flatten.hpp>
 #include <agency/experimental/ranges/all.hpp>
+#include <agency/experimental/span.hpp>
 #include <agency/container/array.hpp>
 #include <agency/container/vector.hpp>
+#include <iterator>
 #include <memory>
+#include <utility>
 
 namespace agency
 {
 namespace experimental
 {
+namespace detail
+{
+namespace tiled_array_detail
+{
+
+
+// tile_iterator creates tiles on demand
+// the i-th element is a new container of tile_size elements (or last_tile_size elements for the last tile)
+// whose storage comes from the i-th allocator
+// tile_iterator has the category of AllocatorIterator, and the operations which that category requires
+// because a container's elements are constructed from this iterator's elements by the agent which constructs
+// that container's i-th element, each tile is allocated and initialized by that agent
+template<class Container, class AllocatorIterator>
+class tile_iterator
+{
+  public:
+    using value_type = Container;
+    using reference = value_type;
+    using pointer = void;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = typename std::iterator_traits<AllocatorIterator>::iterator_category;
+
+    tile_iterator(std::size_t position, std::size_t num_tiles, std::size_t tile_size, std::size_t last_tile_size, const typename Container::value_type& value, AllocatorIterator allocator)
+      : position_(position),
+        num_tiles_(num_tiles),
+        tile_size_(tile_size),
+        last_tile_size_(last_tile_size),
+        value_(value),
+        allocator_(allocator)
+    {}
+
+    // dereference
+    reference operator*() const
+    {
+      return value_type(size_of(position_), value_, *allocator_);
+    }
+
+    // subscript
+    reference operator[](difference_type n) const
+    {
+      return value_type(size_of(position_ + n), value_, allocator_[n]);
+    }
+
+    // pre-increment
+    tile_iterator& operator++()
+    {
+      ++position_;
+      ++allocator_;
+      return *this;
+    }
+
+    // post-increment
+    tile_iterator operator++(int)
+    {
+      tile_iterator result = *this;
+      ++(*this);
+      return result;
+    }
+
+    // pre-decrement
+    tile_iterator& operator--()
+    {
+      --position_;
+      --allocator_;
+      return *this;
+    }
+
+    // post-decrement
+    tile_iterator operator--(int)
+    {
+      tile_iterator result = *this;
+      --(*this);
+      return result;
+    }
+
+    // plus-equal
+    tile_iterator& operator+=(difference_type n)
+    {
+      position_ += n;
+      std::advance(allocator_, n);
+      return *this;
+    }
+
+    // minus-equal
+    tile_iterator& operator-=(difference_type n)
+    {
+      return *this += -n;
+    }
+
+    // plus
+    tile_iterator operator+(difference_type n) const
+    {
+      tile_iterator result = *this;
+      result += n;
+      return result;
+    }
+
+    // plus
+    friend tile_iterator operator+(difference_type n, const tile_iterator& iter)
+    {
+      return iter + n;
+    }
+
+    // minus
+    tile_iterator operator-(difference_type n) const
+    {
+      tile_iterator result = *this;
+      result -= n;
+      return result;
+    }
+
+    // difference
+    difference_type operator-(const tile_iterator& rhs) const
+    {
+      return difference_type(position_) - difference_type(rhs.position_);
+    }
+
+    // equal
+    bool operator==(const tile_iterator& rhs) const
+    {
+      return position_ == rhs.position_;
+    }
+
+    // not equal
+    bool operator!=(const tile_iterator& rhs) const
+    {
+      return !(*this == rhs);
+    }
+
+    // less
+    bool operator<(const tile_iterator& rhs) const
+    {
+      return position_ < rhs.position_;
+    }
+
+    // less-equal
+    bool operator<=(const tile_iterator& rhs) const
+    {
+      return position_ <= rhs.position_;
+    }
+
+    // greater
+    bool operator>(const tile_iterator& rhs) const
+    {
+      return position_ > rhs.position_;
+    }
+
+    // greater-equal
+    bool operator>=(const tile_iterator& rhs) const
+    {
+      return position_ >= rhs.position_;
+    }
+
+  private:
+    std::size_t size_of(std::size_t tile) const
+    {
+      return tile + 1 < num_tiles_ ? tile_size_ : last_tile_size_;
+    }
+
+    std::size_t position_;
+    std::size_t num_tiles_;
+    std::size_t tile_size_;
+    std::size_t last_tile_size_;
+    typename Container::value_type value_;
+    AllocatorIterator allocator_;
+};
+
+
+// invokes the user's function on the tile owned by the calling agent
+template<class Function>
+struct invoke_on_tile
+{
+  Function f;
+
+  template<class Agent, class TiledArray, class... Args>
+  auto operator()(Agent& self, TiledArray* array, Args&&... args) ->
+    decltype(std::declval<Function&>()(self, std::declval<span<typename TiledArray::value_type>>(), std::forward<Args>(args)...))
+  {
+    auto& tile = array->tile(self.rank());
+
+    return f(self, span<typename TiledArray::value_type>(tile.data(), tile.size()), std::forward<Args>(args)...);
+  }
+};
+
+
+} // end tiled_array_detail
+} // end detail
 
 
 // XXX until this thing can resize, call it an array
@@ -37,62 +231,78 @@ class tiled_array
 
     outer_container tiles_;
 
+    template<class AllocatorIterator>
+    using tile_iterator = detail::tiled_array_detail::tile_iterator<inner_container, AllocatorIterator>;
+
+    // when n is at least the number of allocators, the tile size is chosen to equally distribute the elements
+    // and, if fewer tiles than allocators suffice for that tile size, the trailing allocators go unused
+    // when there are more allocators than there are elements, there is a tile for each element
+    static size_type tile_size_for(size_type n, size_type num_allocators)
+    {
+      return n >= num_allocators ? (n + num_allocators - 1) / num_allocators : 1;
+    }
+
+    template<class ExecutionPolicy, class Range>
+    static outer_container make_tiles(ExecutionPolicy&& policy, size_type n, size_type tile_size, const value_type& val, const Range& allocators)
+    {
+      size_type num_tiles = tile_size == 0 ? 0 : (n + tile_size - 1) / tile_size;
+      size_type last_tile_size = n - tile_size * (num_tiles == 0 ? 0 : num_tiles - 1);
+
+      using allocator_iterator = decltype(allocators.begin());
+
+      tile_iterator<allocator_iterator> first(0, num_tiles, tile_size, last_tile_size, val, allocators.begin());
+      tile_iterator<allocator_iterator> last = first + num_tiles;
+
+      return outer_container(std::forward<ExecutionPolicy>(policy), first, last);
+    }
+
   public:
     tiled_array() : tile_size_(0), tiles_() {}
 
     tiled_array(const tiled_array&) = default;
 
     // constructs a tiled_array with a tile for each allocator
-    template<class Range,
+    // the tiles are created in parallel: the i-th agent created by policy allocates and fills the tile
+    // which uses the i-th allocator
+    // the number of tiles is bounded only by the number of allocators
+    template<class ExecutionPolicy,
+             class Range,
+             __AGENCY_REQUIRES(
+               is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+             ),
              __AGENCY_REQUIRES(
                std::is_constructible<
                  inner_allocator_type,
                  range_value_t<Range>
                >::value
              )>
-    tiled_array(size_type n,
+    tiled_array(ExecutionPolicy&& policy,
+                size_type n,
                 const value_type& val,
                 const Range& allocators)
+      : tile_size_(tile_size_for(n, allocators.size())),
+        tiles_(make_tiles(std::forward<ExecutionPolicy>(policy), n, tile_size_, val, allocators))
     {
-      size_type num_tiles = allocators.size();
-
-      assert(num_tiles > 0 && num_tiles <= all_t::max_tile_count);
-
-      if(n >= allocators.size())
-      {
-        // equally distribute allocations
-        tile_size_ = (n + num_tiles - 1) / num_tiles;
-        size_type last_tile_size = n - (tile_size_ * (allocators.size() - 1));
-
-        // construct the full tiles
-        auto last_alloc = --allocators.end();
-        for(auto alloc = allocators.begin(); alloc != last_alloc; ++alloc)
-        {
-          tiles_.emplace_back(tile_size_, val, *alloc);
-        }
-
-        // construct the last tile
-        tiles_.emplace_back(last_tile_size, val, *last_alloc);
-      }
-      else
-      {
-        // when there are more allocators than there are elements,
-        // just create a tile for each element
-        // an alternative would be to create a single tile using the first allocator
-        // or choose some minimum tile size
-        // we might want a constructor which accepts a tile_size
-        tile_size_ = 1;
-        auto alloc = allocators.begin();
-        for(size_type i = 0; i < n; ++i, ++alloc)
-        {
-          tiles_.emplace_back(tile_size_, val, *alloc);
-        }
-      }
+      assert(allocators.size() > 0);
     }
 
+    // constructs a tiled_array with a tile for each allocator in parallel
+    template<class Range,
+             __AGENCY_REQUIRES(
+               std::is_constructible<
+                 inner_allocator_type,
+                 range_value_t<Range>
+               >::value
+             )>
+    tiled_array(size_type n,
+                const value_type& val,
+                const Range& allocators)
+      : tiled_array(par, n, val, allocators)
+    {}
+
     // constructs a tiled_array with a single tile
     tiled_array(size_type n, const value_type& val = value_type())
-      : tiled_array(n, val, array<inner_allocator_type,1>{inner_allocator_type()})
+      : tiled_array(seq, n, val, array<inner_allocator_type,1>{inner_allocator_type()})
     {}
 
     size_type tile_size() const
@@ -101,23 +311,24 @@ class tiled_array
     }
 
   public:
-    using all_t = small_untiled_view<outer_container>;
+    using all_t = flatten_view<outer_container>;
 
+    // all tiles but the last have tile_size() elements, so all() locates an element with a single division
     all_t all()
     {
-      return untile(tile_size(), tiles_);
+      return flatten_uniform(tiles_, tile_size());
     }
 
-    using const_all_t = small_untiled_view<const outer_container>;
+    using const_all_t = flatten_view<const outer_container>;
 
     const_all_t all() const
     {
-      return untile(tile_size(), tiles_);
+      return flatten_uniform(tiles_, tile_size());
     }
 
     size_type size() const
     {
-      return all().size();
+      return tiles_.empty() ? 0 : tile_size_ * (tiles_.size() - 1) + tiles_.back().size();
     }
 
     using iterator = range_iterator_t<all_t>;
@@ -151,6 +362,16 @@ class tiled_array
       return agency::experimental::all(tiles_);
     }
 
+    size_type num_tiles() const
+    {
+      return tiles_.size();
+    }
+
+    inner_container& tile(size_type i)
+    {
+      return tiles_[i];
+    }
+
     const inner_container& tile(size_type i) const
     {
       return tiles()[i];
@@ -175,9 +396,27 @@ class tiled_array
     {
       return tiles_ == rhs.tiles_;
     }
+
 };
 
 
+// creates an agent for each of array's tiles and invokes f(self, tile, args...),
+// where tile is a span of the elements of the tile whose index is self.rank()
+// the i-th agent operates on the tile which was created by the i-th agent of the
+// policy used to construct array, so when both policies place their agents the same way
+// (e.g., an executor_array whose i-th executor runs near the i-th allocator's memory),
+// each agent works on the memory nearest to it
+template<class ExecutionPolicy, class T, template<class> class InnerAlloc, template<class> class OuterAlloc, class Function, class... Args,
+         __AGENCY_REQUIRES(
+           is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value
+         )>
+auto bulk_invoke(ExecutionPolicy&& policy, tiled_array<T,InnerAlloc,OuterAlloc>& array, Function f, Args&&... args) ->
+  decltype(agency::bulk_invoke(policy(array.num_tiles()), detail::tiled_array_detail::invoke_on_tile<Function>{f}, &array, std::forward<Args>(args)...))
+{
+  return agency::bulk_invoke(policy(array.num_tiles()), detail::tiled_array_detail::invoke_on_tile<Function>{f}, &array, std::forward<Args>(args)...);
+}
+
+
 } // end experimental
 } // end agency
 
@@ -94,27 +94,6 @@ inline std::shared_future<void> make_ready_shared_future()
 }
 
 
-// XXX when_all is supposed to return a future<vector>
-template<typename ForwardIterator>
-std::future<void> when_all(ForwardIterator first, ForwardIterator last)
-{
-  exception_list exceptions = flatten_into_exception_list(first, last);
-
-  std::promise<void> p;
-
-  if(exceptions.size() > 0)
-  {
-    p.set_exception(std::make_exception_ptr(exceptions));
-  }
-  else
-  {
-    p.set_value();
-  }
-
-  return p.get_future();
-}
-
-
 // then() with launch policy for std::future
 template<class T, class Function>
 std::future<detail::result_of_t<Function(std::future<T>&)>>
@@ -108,6 +108,11 @@ class always_ready_future
       // wait() is a no-op: this is always ready
     }
 
+    bool is_ready() const
+    {
+      return true;
+    }
+
     bool valid() const
     {
       return state_.has_value();
@@ -176,6 +181,11 @@ class always_ready_future<void>
       // wait() is a no-op: this is always ready
     }
 
+    bool is_ready() const
+    {
+      return true;
+    }
+
     bool valid() const
     {
       return valid_;
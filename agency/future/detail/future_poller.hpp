@@ -0,0 +1,207 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/future/detail/is_ready.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace agency
+{
+namespace detail
+{
+
+
+// future_poller owns a single thread which polls futures on behalf of clients which must not block on them
+//
+// most of agency's futures (e.g. std::future) provide no means of notifying a client when they become ready
+// instead of dedicating a blocked thread to each such future, the poller periodically queries each pending future's
+// readiness and completes each one as it becomes ready
+// the polling interval backs off exponentially while no pending future becomes ready
+class future_poller
+{
+  public:
+    struct pending
+    {
+      virtual ~pending() {}
+
+      virtual bool is_ready() = 0;
+
+      // complete() is called once, on the poller's thread, after is_ready() has returned true
+      // the poller destroys this object immediately afterward
+      virtual void complete() = 0;
+    };
+
+    future_poller()
+      : stopped_(false),
+        thread_(&future_poller::run, this)
+    {}
+
+    ~future_poller()
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+      }
+
+      cv_.notify_one();
+      thread_.join();
+    }
+
+    void submit(std::unique_ptr<pending> p)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        submitted_.push_back(std::move(p));
+      }
+
+      cv_.notify_one();
+    }
+
+  private:
+    static std::chrono::microseconds min_interval()
+    {
+      return std::chrono::microseconds(1);
+    }
+
+    static std::chrono::microseconds max_interval()
+    {
+      return std::chrono::microseconds(100);
+    }
+
+    void run()
+    {
+      std::vector<std::unique_ptr<pending>> polling;
+      std::vector<std::unique_ptr<pending>> ready;
+      std::chrono::microseconds interval = min_interval();
+
+      std::unique_lock<std::mutex> lock(mutex_);
+
+      while(true)
+      {
+        auto has_work = [this]{ return stopped_ || !submitted_.empty(); };
+
+        if(polling.empty())
+        {
+          // nothing to poll, so sleep until something is submitted
+          cv_.wait(lock, has_work);
+        }
+        else
+        {
+          cv_.wait_for(lock, interval, has_work);
+        }
+
+        if(stopped_) return;
+
+        std::move(submitted_.begin(), submitted_.end(), std::back_inserter(polling));
+        submitted_.clear();
+
+        lock.unlock();
+
+        // partition the pending futures into those which are ready and those which are not
+        auto first_ready = std::stable_partition(polling.begin(), polling.end(), [](const std::unique_ptr<pending>& p)
+        {
+          return !p->is_ready();
+        });
+
+        std::move(first_ready, polling.end(), std::back_inserter(ready));
+        polling.erase(first_ready, polling.end());
+
+        // back off while nothing becomes ready
+        interval = ready.empty() ? std::min(2 * interval, max_interval()) : min_interval();
+
+        for(auto& p : ready)
+        {
+          p->complete();
+        }
+
+        ready.clear();
+
+        lock.lock();
+      }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<std::unique_ptr<pending>> submitted_;
+    bool stopped_;
+    std::thread thread_;
+};
+
+
+inline future_poller& system_future_poller()
+{
+  static future_poller poller;
+  return poller;
+}
+
+
+template<class Future, class Function>
+struct pending_callback : future_poller::pending
+{
+  Future future;
+  Function f;
+
+  pending_callback(Future&& fut, const Function& func)
+    : future(std::move(fut)), f(func)
+  {}
+
+  bool is_ready()
+  {
+    return detail::is_ready(future);
+  }
+
+  void complete()
+  {
+    f(future);
+  }
+};
+
+
+// takes ownership of a future and invokes f(future) once it becomes ready, without blocking the caller
+// when the future is already ready, f is invoked immediately by the caller
+// otherwise, f is invoked by the system_future_poller()'s thread
+template<class Future, class Function>
+void when_ready(Future&& future, Function f)
+{
+  using future_type = typename std::decay<Future>::type;
+
+  if(detail::is_ready(future))
+  {
+    future_type ready_future = std::move(future);
+    f(ready_future);
+  }
+  else
+  {
+    system_future_poller().submit(std::unique_ptr<future_poller::pending>(new pending_callback<future_type,Function>(std::move(future), f)));
+  }
+}
+
+
+struct ignore_future
+{
+  template<class Future>
+  void operator()(Future&) const {}
+};
+
+
+// destroys a future once it becomes ready, without blocking the caller
+// this is useful for futures whose destructor would otherwise block, e.g. those returned by std::async()
+template<class Future>
+void discard_when_ready(Future&& future)
+{
+  detail::when_ready(std::move(future), ignore_future());
+}
+
+
+} // end detail
+} // end agency
+
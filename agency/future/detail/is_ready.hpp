@@ -0,0 +1,77 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+
+#include <chrono>
+#include <future>
+#include <type_traits>
+#include <utility>
+
+namespace agency
+{
+namespace detail
+{
+
+
+template<class T>
+struct has_is_ready_impl
+{
+  template<class Future,
+           class = decltype(std::declval<const Future&>().is_ready())
+          >
+  static std::true_type test(int);
+
+  template<class>
+  static std::false_type test(...);
+
+  using type = decltype(test<T>(0));
+};
+
+
+template<class T>
+using has_is_ready = typename has_is_ready_impl<T>::type;
+
+
+// is_ready() returns whether the result of a future may be retrieved without blocking
+//
+// futures which provide no means of querying their readiness are reported ready,
+// so that a client which polls futures instead simply waits on such a future
+template<class Future,
+         __AGENCY_REQUIRES(has_is_ready<Future>::value)
+        >
+__AGENCY_ANNOTATION
+bool is_ready(const Future& f)
+{
+  return f.is_ready();
+}
+
+
+template<class Future,
+         __AGENCY_REQUIRES(!has_is_ready<Future>::value)
+        >
+__AGENCY_ANNOTATION
+bool is_ready(const Future&)
+{
+  return true;
+}
+
+
+// a deferred std::future is ready in the sense that get() executes its function immediately
+template<class T>
+bool is_ready(const std::future<T>& f)
+{
+  return f.wait_for(std::chrono::seconds(0)) != std::future_status::timeout;
+}
+
+
+template<class T>
+bool is_ready(const std::shared_future<T>& f)
+{
+  return f.wait_for(std::chrono::seconds(0)) != std::future_status::timeout;
+}
+
+
+} // end detail
+} // end agency
+
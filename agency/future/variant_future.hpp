@@ -4,6 +4,7 @@
 #include <agency/detail/requires.hpp>
 #include <agency/detail/type_traits.hpp>
 #include <agency/future/future_traits.hpp>
+#include <agency/future/detail/is_ready.hpp>
 #include <agency/experimental/variant.hpp>
 #include <agency/future.hpp>
 
@@ -105,6 +106,25 @@ class variant_future
       return agency::experimental::visit(visitor, variant_);
     }
 
+  private:
+    struct is_ready_visitor
+    {
+      template<class T>
+      __AGENCY_ANNOTATION
+      bool operator()(const T& f) const
+      {
+        return detail::is_ready(f);
+      }
+    };
+
+  public:
+    __AGENCY_ANNOTATION
+    bool is_ready() const
+    {
+      auto visitor = is_ready_visitor();
+      return agency::experimental::visit(visitor, variant_);
+    }
+
   private:
     struct wait_visitor
     {
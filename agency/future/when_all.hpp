@@ -0,0 +1,356 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/detail/integer_sequence.hpp>
+#include <agency/detail/tuple/tuple_utility.hpp>
+#include <agency/detail/unit.hpp>
+#include <agency/exception_list.hpp>
+#include <agency/experimental/optional.hpp>
+#include <agency/future.hpp>
+#include <agency/future/detail/future_poller.hpp>
+#include <agency/tuple.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace agency
+{
+namespace detail
+{
+namespace when_all_detail
+{
+
+
+// the state shared by the callbacks of the futures passed to when_all()
+// when the last callback completes, the state fulfills its promise with the values collected by the callbacks,
+// or with an exception_list of the exceptions they encountered
+template<class Values, class Result>
+class when_all_state
+{
+  public:
+    when_all_state(std::size_t count)
+      : remaining_(count)
+    {}
+
+    Values& values()
+    {
+      return values_;
+    }
+
+    std::future<Result> get_future()
+    {
+      return promise_.get_future();
+    }
+
+    void add_current_exception()
+    {
+      std::lock_guard<std::mutex> lock(exceptions_mutex_);
+
+      try
+      {
+        throw;
+      }
+      catch(exception_list& e)
+      {
+        detail::move_exceptions(exceptions_, e);
+      }
+      catch(...)
+      {
+        detail::add_current_exception(exceptions_);
+      }
+    }
+
+    // finish(values) converts the collected values into a Result
+    template<class Function>
+    void count_down(Function finish)
+    {
+      if(--remaining_ == 0)
+      {
+        if(exceptions_.size() > 0)
+        {
+          promise_.set_exception(std::make_exception_ptr(std::move(exceptions_)));
+        }
+        else
+        {
+          set_value(finish);
+        }
+      }
+    }
+
+  private:
+    template<class Function,
+             class R = Result,
+             __AGENCY_REQUIRES(!std::is_void<R>::value)
+            >
+    void set_value(Function finish)
+    {
+      promise_.set_value(finish(values_));
+    }
+
+    template<class Function,
+             class R = Result,
+             __AGENCY_REQUIRES(std::is_void<R>::value)
+            >
+    void set_value(Function)
+    {
+      promise_.set_value();
+    }
+
+    std::atomic<std::size_t> remaining_;
+    Values values_;
+    std::mutex exceptions_mutex_;
+    exception_list exceptions_;
+    std::promise<Result> promise_;
+};
+
+
+template<class T>
+using range_values = std::vector<experimental::optional<T>>;
+
+template<class T>
+using range_state = when_all_state<range_values<T>, std::vector<T>>;
+
+
+template<class T>
+struct unwrap_range_values
+{
+  std::vector<T> operator()(range_values<T>& values) const
+  {
+    std::vector<T> result;
+    result.reserve(values.size());
+
+    for(auto& value : values)
+    {
+      result.push_back(std::move(*value));
+    }
+
+    return result;
+  }
+};
+
+
+// collects the value of the i-th future of a range
+template<class T>
+struct collect_range_element
+{
+  std::shared_ptr<range_state<T>> state;
+  std::size_t i;
+
+  template<class Future>
+  void operator()(Future& future) const
+  {
+    try
+    {
+      state->values()[i].emplace(future.get());
+    }
+    catch(...)
+    {
+      state->add_current_exception();
+    }
+
+    state->count_down(unwrap_range_values<T>());
+  }
+};
+
+
+using void_range_state = when_all_state<unit, void>;
+
+
+struct ignore_values
+{
+  template<class Values>
+  void operator()(Values&) const {}
+};
+
+
+struct collect_void_range_element
+{
+  std::shared_ptr<void_range_state> state;
+
+  template<class Future>
+  void operator()(Future& future) const
+  {
+    try
+    {
+      future.get();
+    }
+    catch(...)
+    {
+      state->add_current_exception();
+    }
+
+    state->count_down(ignore_values());
+  }
+};
+
+
+// the values of a variadic when_all() are collected into a tuple of optional values, with void values mapped to void_value
+template<class Future>
+using optional_value = experimental::optional<typename void_to_void_value<future_value_t<Future>>::type>;
+
+template<class... Futures>
+using tuple_values = tuple<optional_value<Futures>...>;
+
+template<class... Futures>
+using tuple_state = when_all_state<tuple_values<Futures...>, when_all_result_t<Futures...>>;
+
+
+template<class... Futures>
+struct unwrap_tuple_values
+{
+  template<std::size_t... Indices>
+  static when_all_result_t<Futures...> impl(index_sequence<Indices...>, tuple_values<Futures...>& values)
+  {
+    tuple_of_future_values<Futures...> unwrapped(std::move(*agency::get<Indices>(values))...);
+
+    // discard void values, and unwrap the tuple when it contains a single element
+    return detail::unwrap_small_tuple(detail::tuple_filter<is_not_void_value>(std::move(unwrapped)));
+  }
+
+  when_all_result_t<Futures...> operator()(tuple_values<Futures...>& values) const
+  {
+    return impl(index_sequence_for<Futures...>(), values);
+  }
+};
+
+
+// collects the value of the I-th future of a variadic when_all()
+template<std::size_t I, class... Futures>
+struct collect_tuple_element
+{
+  std::shared_ptr<tuple_state<Futures...>> state;
+
+  template<class Future>
+  void operator()(Future& future) const
+  {
+    try
+    {
+      agency::get<I>(state->values()).emplace(detail::get_value(future));
+    }
+    catch(...)
+    {
+      state->add_current_exception();
+    }
+
+    state->count_down(unwrap_tuple_values<Futures...>());
+  }
+};
+
+
+template<class... Args>
+void swallow(Args&&...) {}
+
+
+template<class... Futures, std::size_t... Indices>
+std::future<when_all_result_t<Futures...>>
+  when_all_tuple(index_sequence<Indices...>, Futures&... futures)
+{
+  auto state = std::make_shared<tuple_state<Futures...>>(sizeof...(Futures));
+  auto result = state->get_future();
+
+  swallow((detail::when_ready(std::move(futures), collect_tuple_element<Indices,Futures...>{state}), 0)...);
+
+  return result;
+}
+
+
+} // end when_all_detail
+} // end detail
+
+
+/// \brief Returns a future which becomes ready when all of the futures in a range are ready.
+///
+/// `when_all()` consumes each future of `[first, last)`. When every one of them is ready, the resulting future's value is a
+/// `std::vector` of their values, in order. When any of them contains an exception, the resulting future instead contains an
+/// `exception_list` of all their exceptions.
+///
+/// `when_all()` does not block. A callback is attached to each future, and the resulting future is fulfilled by the callback
+/// which observes the last future become ready. A future which is already ready, such as an `always_ready_future`, is consumed
+/// immediately. Other futures are observed by a single background thread which polls their readiness.
+///
+/// \return `std::future<std::vector<T>>`, where `T` is the futures' value type, or `std::future<void>` when `T` is `void`.
+template<class ForwardIterator,
+         class T = future_value_t<typename std::iterator_traits<ForwardIterator>::value_type>,
+         __AGENCY_REQUIRES(!std::is_void<T>::value)
+        >
+std::future<std::vector<T>> when_all(ForwardIterator first, ForwardIterator last)
+{
+  using namespace detail::when_all_detail;
+
+  std::size_t n = std::distance(first, last);
+
+  if(n == 0)
+  {
+    return detail::make_ready_future(std::vector<T>());
+  }
+
+  auto state = std::make_shared<range_state<T>>(n);
+  state->values().resize(n);
+
+  auto result = state->get_future();
+
+  for(std::size_t i = 0; first != last; ++first, ++i)
+  {
+    detail::when_ready(std::move(*first), collect_range_element<T>{state, i});
+  }
+
+  return result;
+}
+
+
+template<class ForwardIterator,
+         class T = future_value_t<typename std::iterator_traits<ForwardIterator>::value_type>,
+         __AGENCY_REQUIRES(std::is_void<T>::value)
+        >
+std::future<void> when_all(ForwardIterator first, ForwardIterator last)
+{
+  using namespace detail::when_all_detail;
+
+  std::size_t n = std::distance(first, last);
+
+  if(n == 0)
+  {
+    return detail::make_ready_future();
+  }
+
+  auto state = std::make_shared<void_range_state>(n);
+  auto result = state->get_future();
+
+  for(; first != last; ++first)
+  {
+    detail::when_ready(std::move(*first), collect_void_range_element{state});
+  }
+
+  return result;
+}
+
+
+/// \brief Returns a future which becomes ready when all of the given futures are ready.
+///
+/// The futures may be of different types. `when_all()` consumes each of them, and does not block.
+/// The resulting future's value is a `tuple` of the futures' non-`void` values, in order. When there is a single
+/// non-`void` value, the resulting future's value is that value itself, and when there is none, the resulting future is
+/// `std::future<void>`. When any future contains an exception, the resulting future instead contains an `exception_list`
+/// of all their exceptions.
+template<class Future, class... Futures,
+         __AGENCY_REQUIRES(
+           detail::conjunction<is_future<Future>, is_future<Futures>...>::value
+         )>
+std::future<detail::when_all_result_t<Future,Futures...>>
+  when_all(Future& future, Futures&... futures)
+{
+  return detail::when_all_detail::when_all_tuple(detail::index_sequence_for<Future,Futures...>(), future, futures...);
+}
+
+
+} // end agency
+
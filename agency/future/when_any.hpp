@@ -0,0 +1,174 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/detail/integer_sequence.hpp>
+#include <agency/future.hpp>
+#include <agency/future/detail/future_poller.hpp>
+#include <agency/future/detail/is_ready.hpp>
+#include <agency/tuple.hpp>
+
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace agency
+{
+
+
+/// \brief `when_any_result` is the value of the future returned by `when_any()`.
+///
+/// `futures` contains the futures passed to `when_any()`, and `index` identifies one of them which is ready.
+/// When `when_any()` receives no futures, `index` is `static_cast<std::size_t>(-1)`.
+template<class Sequence>
+struct when_any_result
+{
+  std::size_t index;
+  Sequence futures;
+};
+
+
+namespace detail
+{
+namespace when_any_detail
+{
+
+
+template<class Future>
+std::size_t first_ready_index(const std::vector<Future>& futures)
+{
+  for(std::size_t i = 0; i < futures.size(); ++i)
+  {
+    if(detail::is_ready(futures[i])) return i;
+  }
+
+  return futures.size();
+}
+
+
+template<class... Futures, std::size_t... Indices>
+std::size_t first_ready_index(index_sequence<Indices...>, const tuple<Futures...>& futures)
+{
+  bool ready[] = {detail::is_ready(agency::get<Indices>(futures))...};
+
+  for(std::size_t i = 0; i < sizeof...(Futures); ++i)
+  {
+    if(ready[i]) return i;
+  }
+
+  return sizeof...(Futures);
+}
+
+
+template<class... Futures>
+std::size_t first_ready_index(const tuple<Futures...>& futures)
+{
+  return when_any_detail::first_ready_index(index_sequence_for<Futures...>(), futures);
+}
+
+
+template<class Future>
+std::size_t size(const std::vector<Future>& futures)
+{
+  return futures.size();
+}
+
+
+template<class... Futures>
+constexpr std::size_t size(const tuple<Futures...>&)
+{
+  return sizeof...(Futures);
+}
+
+
+// a sequence of futures which is ready when any one of its futures is ready
+// this allows the sequence to be observed by when_ready() like a single future
+template<class Sequence>
+struct any_ready
+{
+  Sequence futures;
+
+  bool is_ready() const
+  {
+    return when_any_detail::first_ready_index(futures) < when_any_detail::size(futures);
+  }
+};
+
+
+template<class Sequence>
+struct fulfill_when_any
+{
+  std::shared_ptr<std::promise<when_any_result<Sequence>>> promise;
+
+  void operator()(any_ready<Sequence>& sequence) const
+  {
+    // readiness is permanent, so the future observed to be ready is found again
+    std::size_t index = when_any_detail::first_ready_index(sequence.futures);
+
+    promise->set_value(when_any_result<Sequence>{index, std::move(sequence.futures)});
+  }
+};
+
+
+template<class Sequence>
+std::future<when_any_result<Sequence>> when_any(Sequence&& futures)
+{
+  auto promise = std::make_shared<std::promise<when_any_result<Sequence>>>();
+  auto result = promise->get_future();
+
+  detail::when_ready(any_ready<Sequence>{std::move(futures)}, fulfill_when_any<Sequence>{promise});
+
+  return result;
+}
+
+
+} // end when_any_detail
+} // end detail
+
+
+/// \brief Returns a future which becomes ready when any of the futures in a range is ready.
+///
+/// `when_any()` moves the futures of `[first, last)` into a `std::vector`. When one of them becomes ready, the resulting future
+/// becomes ready, and its value is a `when_any_result` which contains that vector and the index of a ready future within it.
+///
+/// `when_any()` does not block. When none of the futures is ready, they are observed by a single background thread which
+/// polls their readiness, and the resulting future is fulfilled by the callback which observes the first of them become ready.
+template<class ForwardIterator,
+         class Future = typename std::iterator_traits<ForwardIterator>::value_type,
+         __AGENCY_REQUIRES(is_future<Future>::value)
+        >
+std::future<when_any_result<std::vector<Future>>> when_any(ForwardIterator first, ForwardIterator last)
+{
+  std::vector<Future> futures(std::make_move_iterator(first), std::make_move_iterator(last));
+
+  if(futures.empty())
+  {
+    return detail::make_ready_future(when_any_result<std::vector<Future>>{static_cast<std::size_t>(-1), std::move(futures)});
+  }
+
+  return detail::when_any_detail::when_any(std::move(futures));
+}
+
+
+/// \brief Returns a future which becomes ready when any of the given futures is ready.
+///
+/// The futures may be of different types. `when_any()` moves them into a `tuple`, and does not block. When one of them becomes
+/// ready, the resulting future's value is a `when_any_result` which contains that tuple and the index of a ready future within it.
+template<class Future, class... Futures,
+         __AGENCY_REQUIRES(
+           detail::conjunction<is_future<Future>, is_future<Futures>...>::value
+         )>
+std::future<when_any_result<tuple<Future,Futures...>>>
+  when_any(Future& future, Futures&... futures)
+{
+  return detail::when_any_detail::when_any(tuple<Future,Futures...>(std::move(future), std::move(futures)...));
+}
+
+
+} // end agency
+
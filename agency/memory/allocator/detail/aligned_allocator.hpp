@@ -0,0 +1,21 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/memory/allocator/detail/allocator_adaptor.hpp>
+#include <agency/memory/detail/resource/aligned_resource.hpp>
+#include <cstddef>
+
+namespace agency
+{
+namespace detail
+{
+
+
+// aligned_allocator allocates arrays which begin at a multiple of alignment bytes
+template<class T, std::size_t alignment>
+using aligned_allocator = allocator_adaptor<T,aligned_resource<alignment>>;
+
+
+} // end detail
+} // end agency
+
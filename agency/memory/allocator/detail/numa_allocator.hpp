@@ -0,0 +1,21 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/memory/allocator/detail/allocator_adaptor.hpp>
+#include <agency/memory/detail/resource/numa_resource.hpp>
+
+namespace agency
+{
+namespace detail
+{
+
+
+// numa_allocator allocates arrays whose pages prefer the NUMA node named by its resource
+// e.g. numa_allocator<int> alloc(numa_resource(node));
+template<class T>
+using numa_allocator = allocator_adaptor<T,numa_resource>;
+
+
+} // end detail
+} // end agency
+
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/memory/detail/resource/malloc_resource.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace agency
+{
+namespace detail
+{
+
+
+// aligned_resource adapts a memory resource into one whose allocations begin at a multiple of alignment
+// each allocation from the underlying resource is padded so that an aligned address can be found within it,
+// and the underlying allocation's address is recorded in the word immediately preceding the aligned address
+template<std::size_t alignment, class MemoryResource = malloc_resource>
+class aligned_resource : private MemoryResource
+{
+  private:
+    static_assert(alignment > 0 && (alignment & (alignment - 1)) == 0, "aligned_resource: alignment must be a power of two.");
+    static_assert(alignment >= alignof(void*), "aligned_resource: alignment must be at least alignof(void*).");
+
+    using super_t = MemoryResource;
+
+    static constexpr std::size_t padding = alignment - 1 + sizeof(void*);
+
+  public:
+    __agency_exec_check_disable__
+    __AGENCY_ANNOTATION
+    aligned_resource() = default;
+
+    __agency_exec_check_disable__
+    __AGENCY_ANNOTATION
+    aligned_resource(const aligned_resource&) = default;
+
+    __agency_exec_check_disable__
+    __AGENCY_ANNOTATION
+    aligned_resource(const MemoryResource& resource)
+      : super_t(resource)
+    {}
+
+    __agency_exec_check_disable__
+    __AGENCY_ANNOTATION
+    void* allocate(size_t num_bytes)
+    {
+      char* ptr = static_cast<char*>(super_t::allocate(num_bytes + padding));
+
+      if(ptr == nullptr) return nullptr;
+
+      std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr + sizeof(void*));
+      address = (address + alignment - 1) & ~std::uintptr_t(alignment - 1);
+
+      void** result = reinterpret_cast<void**>(address);
+      result[-1] = ptr;
+
+      return result;
+    }
+
+    __agency_exec_check_disable__
+    __AGENCY_ANNOTATION
+    void deallocate(void* ptr, size_t num_bytes)
+    {
+      super_t::deallocate(static_cast<void**>(ptr)[-1], num_bytes + padding);
+    }
+
+    __AGENCY_ANNOTATION
+    const MemoryResource& upstream_resource() const
+    {
+      return *this;
+    }
+
+    __agency_exec_check_disable__
+    __AGENCY_ANNOTATION
+    bool is_equal(const aligned_resource& other) const
+    {
+      return upstream_resource() == other.upstream_resource();
+    }
+};
+
+
+template<std::size_t alignment, class MemoryResource>
+__AGENCY_ANNOTATION
+bool operator==(const aligned_resource<alignment,MemoryResource>& a, const aligned_resource<alignment,MemoryResource>& b)
+{
+  return a.is_equal(b);
+}
+
+template<std::size_t alignment, class MemoryResource>
+__AGENCY_ANNOTATION
+bool operator!=(const aligned_resource<alignment,MemoryResource>& a, const aligned_resource<alignment,MemoryResource>& b)
+{
+  return !(a == b);
+}
+
+
+} // end detail
+} // end agency
+
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/memory/detail/resource/aligned_resource.hpp>
+#include <cstddef>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace agency
+{
+namespace detail
+{
+
+
+// asks the operating system to place the pages spanning [ptr, ptr + num_bytes) on the given NUMA node
+// ptr must be page-aligned
+// returns false when the request cannot be made; the pages are then placed by the default policy,
+// which is first touch on Linux
+inline bool bind_to_numa_node(void* ptr, std::size_t num_bytes, int node)
+{
+#if defined(__linux__) && defined(SYS_mbind)
+  const int mpol_preferred = 1;
+
+  const std::size_t bits_per_word = 8 * sizeof(unsigned long);
+
+  if(node < 0 || static_cast<std::size_t>(node) >= bits_per_word) return false;
+
+  unsigned long node_mask = 1ul << node;
+
+  return syscall(SYS_mbind, ptr, num_bytes, mpol_preferred, &node_mask, bits_per_word, 0) == 0;
+#else
+  (void)ptr;
+  (void)num_bytes;
+  (void)node;
+  return false;
+#endif
+}
+
+
+// numa_resource allocates page-aligned memory whose pages prefer a single NUMA node
+// the preference is advisory: when the node is exhausted, or the platform cannot express the preference,
+// pages are placed wherever they are first touched
+class numa_resource
+{
+  private:
+    static constexpr std::size_t page_size = 4096;
+
+    using upstream_resource_type = aligned_resource<page_size>;
+
+  public:
+    explicit numa_resource(int node = 0)
+      : node_(node)
+    {}
+
+    void* allocate(std::size_t num_bytes)
+    {
+      void* result = upstream_.allocate(num_bytes);
+
+      if(result != nullptr && num_bytes > 0)
+      {
+        bind_to_numa_node(result, num_bytes, node_);
+      }
+
+      return result;
+    }
+
+    void deallocate(void* ptr, std::size_t num_bytes)
+    {
+      upstream_.deallocate(ptr, num_bytes);
+    }
+
+    int node() const
+    {
+      return node_;
+    }
+
+    bool is_equal(const numa_resource& other) const
+    {
+      return node() == other.node();
+    }
+
+  private:
+    upstream_resource_type upstream_;
+    int node_;
+};
+
+
+inline bool operator==(const numa_resource& a, const numa_resource& b)
+{
+  return a.is_equal(b);
+}
+
+inline bool operator!=(const numa_resource& a, const numa_resource& b)
+{
+  return !(a == b);
+}
+
+
+} // end detail
+} // end agency
+
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/execution/execution_policy.hpp>
+#include <agency/omp/execution/executor/parallel_for_executor.hpp>
+#include <agency/omp/execution/executor/simd_executor.hpp>
+
+// scoped_executor's specializations for OpenMP executors must be visible wherever policies are nested
+#include <agency/omp/execution/executor/scoped_executor.hpp>
+
+
+namespace agency
+{
+namespace omp
+{
+
+
+class parallel_execution_policy : public basic_execution_policy<parallel_agent, omp::parallel_executor, parallel_execution_policy>
+{
+  private:
+    using super_t = basic_execution_policy<parallel_agent, omp::parallel_executor, parallel_execution_policy>;
+
+  public:
+    using super_t::basic_execution_policy;
+};
+
+
+const parallel_execution_policy par{};
+
+
+class unsequenced_execution_policy : public basic_execution_policy<unsequenced_agent, omp::unsequenced_executor, unsequenced_execution_policy>
+{
+  private:
+    using super_t = basic_execution_policy<unsequenced_agent, omp::unsequenced_executor, unsequenced_execution_policy>;
+
+  public:
+    using super_t::basic_execution_policy;
+};
+
+
+const unsequenced_execution_policy unseq{};
+
+
+} // end omp
+} // end agency
+
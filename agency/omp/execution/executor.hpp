@@ -0,0 +1,9 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/omp/execution/executor/parallel_for_executor.hpp>
+#include <agency/omp/execution/executor/scoped_executor.hpp>
+#include <agency/omp/execution/executor/simd_executor.hpp>
+#include <agency/omp/execution/executor/task_executor.hpp>
+#include <agency/omp/execution/executor/teams_executor.hpp>
+
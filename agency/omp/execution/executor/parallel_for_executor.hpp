@@ -0,0 +1,232 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/execution/execution_categories.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+namespace agency
+{
+namespace omp
+{
+
+
+/// \brief Names the OpenMP loop schedules with which `parallel_for_executor` may distribute iterations among threads.
+///
+/// These correspond to the kinds accepted by OpenMP's `schedule` clause:
+///
+///   * `static_` divides the iterations into chunks which are assigned to threads round-robin before the loop begins.
+///     When the chunk size is zero, each thread receives a single contiguous block of roughly equal size.
+///   * `dynamic` hands each chunk to the next idle thread.
+///   * `guided` hands out chunks whose sizes shrink as the loop progresses, but never below the chunk size.
+///   * `automatic` defers the choice to the compiler and runtime.
+///   * `runtime` uses the schedule named by the `OMP_SCHEDULE` environment variable.
+enum class schedule_kind
+{
+  static_,
+  dynamic,
+  guided,
+  automatic,
+  runtime
+};
+
+
+namespace detail
+{
+
+
+inline std::size_t max_threads()
+{
+#ifdef _OPENMP
+  return static_cast<std::size_t>(omp_get_max_threads());
+#else
+  return 1;
+#endif
+}
+
+
+// executes f(i) for each i in [0, n) with a parallel for loop using the given schedule
+// a chunk_size of zero requests the schedule's default chunk size
+// num_threads of zero requests the OpenMP runtime's default number of threads
+template<class Function>
+void parallel_for(schedule_kind kind, std::size_t chunk_size, std::size_t num_threads, std::size_t n, Function&& f)
+{
+  int threads = static_cast<int>(num_threads > 0 ? num_threads : max_threads());
+
+  // dynamic and guided schedules default to chunks of a single iteration
+  std::size_t chunk = chunk_size > 0 ? chunk_size : 1;
+
+  switch(kind)
+  {
+    case schedule_kind::static_:
+    {
+      if(chunk_size > 0)
+      {
+        #pragma omp parallel for schedule(static, chunk) num_threads(threads)
+        for(std::size_t i = 0; i < n; ++i)
+        {
+          f(i);
+        }
+      }
+      else
+      {
+        #pragma omp parallel for schedule(static) num_threads(threads)
+        for(std::size_t i = 0; i < n; ++i)
+        {
+          f(i);
+        }
+      }
+
+      break;
+    }
+
+    case schedule_kind::dynamic:
+    {
+      #pragma omp parallel for schedule(dynamic, chunk) num_threads(threads)
+      for(std::size_t i = 0; i < n; ++i)
+      {
+        f(i);
+      }
+
+      break;
+    }
+
+    case schedule_kind::guided:
+    {
+      #pragma omp parallel for schedule(guided, chunk) num_threads(threads)
+      for(std::size_t i = 0; i < n; ++i)
+      {
+        f(i);
+      }
+
+      break;
+    }
+
+    case schedule_kind::automatic:
+    {
+      #pragma omp parallel for schedule(auto) num_threads(threads)
+      for(std::size_t i = 0; i < n; ++i)
+      {
+        f(i);
+      }
+
+      break;
+    }
+
+    case schedule_kind::runtime:
+    {
+      #pragma omp parallel for schedule(runtime) num_threads(threads)
+      for(std::size_t i = 0; i < n; ++i)
+      {
+        f(i);
+      }
+
+      break;
+    }
+  }
+}
+
+
+} // end detail
+
+
+/// \brief `parallel_for_executor` executes bulk work with an OpenMP `parallel for` loop.
+///
+/// By default, `parallel_for_executor` requests a static schedule with the OpenMP runtime's default chunk size and number of threads.
+/// These may be chosen when the executor is constructed:
+///
+///     // hand out chunks of 64 iterations to 8 threads on demand
+///     agency::omp::parallel_for_executor exec(agency::omp::schedule_kind::dynamic, 64, 8);
+class parallel_for_executor
+{
+  public:
+    using execution_category = parallel_execution_tag;
+
+    explicit parallel_for_executor(schedule_kind kind = schedule_kind::static_,
+                                   std::size_t chunk_size = 0,
+                                   std::size_t num_threads = 0)
+      : kind_(kind),
+        chunk_size_(chunk_size),
+        num_threads_(num_threads)
+    {}
+
+    schedule_kind kind() const
+    {
+      return kind_;
+    }
+
+    std::size_t chunk_size() const
+    {
+      return chunk_size_;
+    }
+
+    /// \brief Returns the number of threads requested of the OpenMP runtime, or zero if the runtime's default is requested.
+    std::size_t num_threads() const
+    {
+      return num_threads_;
+    }
+
+    /// \brief Returns the number of threads which will execute this executor's loops.
+    std::size_t unit_shape() const
+    {
+      return num_threads_ > 0 ? num_threads_ : detail::max_threads();
+    }
+
+    std::size_t max_shape_dimensions() const
+    {
+      return std::numeric_limits<std::size_t>::max();
+    }
+
+  private:
+    template<class Function, class Result, class SharedParameter>
+    struct loop_body
+    {
+      Function& f;
+      Result& result;
+      SharedParameter& shared_parm;
+
+      void operator()(std::size_t i) const
+      {
+        f(i, result, shared_parm);
+      }
+    };
+
+  public:
+    template<class Function, class ResultFactory, class SharedFactory>
+    agency::detail::result_of_t<ResultFactory()>
+      bulk_sync_execute(Function f, size_t n, ResultFactory result_factory, SharedFactory shared_factory) const
+    {
+#ifndef _OPENMP
+      static_assert(sizeof(Function) && false, "agency::omp::parallel_for_executor requires C++ OpenMP language extensions (typically enabled with -fopenmp or /openmp).");
+#endif
+
+      auto result = result_factory();
+      auto shared_parm = shared_factory();
+
+      using body_type = loop_body<Function, decltype(result), decltype(shared_parm)>;
+      detail::parallel_for(kind_, chunk_size_, num_threads_, n, body_type{f, result, shared_parm});
+
+      return std::move(result);
+    }
+
+  private:
+    schedule_kind kind_;
+    std::size_t chunk_size_;
+    std::size_t num_threads_;
+};
+
+
+using parallel_executor = parallel_for_executor;
+
+
+} // end omp
+} // end agency
+
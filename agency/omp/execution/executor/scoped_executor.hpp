@@ -0,0 +1,46 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/execution/executor/scoped_executor.hpp>
+#include <agency/omp/execution/executor/parallel_for_executor.hpp>
+#include <agency/omp/execution/executor/simd_executor.hpp>
+#include <agency/omp/execution/executor/teams_executor.hpp>
+
+namespace agency
+{
+
+
+// these specializations map nested OpenMP executors directly onto nested loops,
+// e.g. omp::par(n, omp::unseq(m)) becomes a parallel for loop enclosing a simd loop
+
+
+template<>
+class scoped_executor<omp::parallel_for_executor, omp::parallel_for_executor>
+  : public omp::teams_executor<omp::parallel_for_executor>
+{
+  private:
+    using super_t = omp::teams_executor<omp::parallel_for_executor>;
+
+  public:
+    using super_t::super_t;
+
+    scoped_executor() = default;
+}; // end scoped_executor
+
+
+template<>
+class scoped_executor<omp::parallel_for_executor, omp::simd_executor>
+  : public omp::teams_executor<omp::simd_executor>
+{
+  private:
+    using super_t = omp::teams_executor<omp::simd_executor>;
+
+  public:
+    using super_t::super_t;
+
+    scoped_executor() = default;
+}; // end scoped_executor
+
+
+} // end agency
+
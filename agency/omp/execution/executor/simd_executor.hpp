@@ -0,0 +1,78 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/execution/execution_categories.hpp>
+
+#include <cstddef>
+#include <utility>
+
+
+namespace agency
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// executes f(i) for each i in [0, n) with an OpenMP simd loop
+template<class Function>
+void simd_for(std::size_t n, Function&& f)
+{
+  #pragma omp simd
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    f(i);
+  }
+}
+
+
+} // end detail
+
+
+class simd_executor
+{
+  public:
+    using execution_category = unsequenced_execution_tag;
+
+  private:
+    template<class Function, class Result, class SharedParameter>
+    struct loop_body
+    {
+      Function& f;
+      Result& result;
+      SharedParameter& shared_parm;
+
+      void operator()(std::size_t i) const
+      {
+        f(i, result, shared_parm);
+      }
+    };
+
+  public:
+    template<class Function, class ResultFactory, class SharedFactory>
+    agency::detail::result_of_t<ResultFactory()>
+      bulk_sync_execute(Function f, size_t n, ResultFactory result_factory, SharedFactory shared_factory) const
+    {
+#if _OPENMP < 201307
+      static_assert(sizeof(Function) && false, "agency::omp::simd_executor requires C++ OpenMP 4.0 or better language extensions (typically enabled with -fopenmp or /openmp).");
+#endif
+
+      auto result = result_factory();
+      auto shared_parm = shared_factory();
+
+      using body_type = loop_body<Function, decltype(result), decltype(shared_parm)>;
+      detail::simd_for(n, body_type{f, result, shared_parm});
+
+      return std::move(result);
+    }
+};
+
+
+using unsequenced_executor = simd_executor;
+
+
+} // end omp
+} // end agency
+
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/execution/execution_categories.hpp>
+#include <agency/future.hpp>
+#include <agency/omp/future.hpp>
+#include <agency/omp/execution/executor/parallel_for_executor.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+
+namespace agency
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// executes f(i) for each i in [0, n) with an OpenMP taskloop
+// the calling task waits for the loop's tasks to complete, and may execute other tasks while it waits
+// an exception may not escape a task, so the first exception thrown by f is caught within the loop and rethrown
+// after the loop completes. once an exception has been thrown, the remaining iterations are skipped
+template<class Function>
+void task_for(std::size_t n, const Function& f)
+{
+  const Function* body = &f;
+
+  std::atomic<bool> failed(false);
+  std::exception_ptr first_exception;
+
+  std::atomic<bool>* failed_ptr = &failed;
+  std::exception_ptr* first_exception_ptr = &first_exception;
+
+  #pragma omp taskloop firstprivate(body, failed_ptr, first_exception_ptr)
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    if(failed_ptr->load(std::memory_order_relaxed)) continue;
+
+    try
+    {
+      (*body)(i);
+    }
+    catch(...)
+    {
+      if(!failed_ptr->exchange(true))
+      {
+        *first_exception_ptr = std::current_exception();
+      }
+    }
+  }
+
+  // the taskloop's implicit taskgroup has completed, so first_exception is no longer written
+  if(first_exception)
+  {
+    std::rethrow_exception(first_exception);
+  }
+}
+
+
+} // end detail
+
+
+/// \brief `task_executor` executes bulk work asynchronously as OpenMP tasks.
+///
+/// `task_executor::bulk_then_execute()` creates a single OpenMP task which waits for its predecessor future and then
+/// executes its agents with a `taskloop`. When the predecessor is a `task_future`, the new task names the predecessor's
+/// state in a `depend(in:)` clause and its own state in a `depend(out:)` clause, so that chains of agency continuations
+/// become an OpenMP task graph executed by the threads of the enclosing parallel region. No threads are created.
+///
+/// Work submitted from within a parallel region (typically from a `single` construct) is deferred, and may be freely
+/// interleaved with other OpenMP tasks, e.g. those created by legacy OpenMP code. Work submitted outside of any parallel
+/// region executes immediately on the calling thread, because the runtime has no other threads on which to defer it.
+///
+/// OpenMP orders dependent tasks only when they are created by the same task. A continuation created by some other
+/// task still observes its predecessor's result, but does so by waiting for it.
+class task_executor
+{
+  public:
+    using execution_category = parallel_execution_tag;
+
+    template<class T>
+    using future = task_future<T>;
+
+    std::size_t unit_shape() const
+    {
+      return detail::max_threads();
+    }
+
+  private:
+    template<class Future>
+    static const detail::task_state_base* state_of(Future&)
+    {
+      // foreign futures have no state to depend on
+      return nullptr;
+    }
+
+    template<class T>
+    static const detail::task_state_base* state_of(task_future<T>& fut)
+    {
+      return fut.state();
+    }
+
+    template<class Function, class Predecessor, class Result, class SharedParameter>
+    struct loop_body
+    {
+      Function& f;
+      Predecessor& predecessor;
+      Result& result;
+      SharedParameter& shared_parm;
+
+      void operator()(std::size_t i) const
+      {
+        f(i, predecessor, result, shared_parm);
+      }
+    };
+
+    template<class Function, class Result, class SharedParameter>
+    struct void_predecessor_loop_body
+    {
+      Function& f;
+      Result& result;
+      SharedParameter& shared_parm;
+
+      void operator()(std::size_t i) const
+      {
+        f(i, result, shared_parm);
+      }
+    };
+
+    template<class Function, class Future, class ResultFactory, class SharedFactory>
+    struct bulk_then_task
+    {
+      using result_type = agency::detail::result_of_t<ResultFactory()>;
+      using predecessor_type = typename future_traits<Future>::value_type;
+
+      Function f;
+      std::size_t n;
+      Future predecessor;
+      ResultFactory result_factory;
+      SharedFactory shared_factory;
+      std::shared_ptr<detail::task_state<result_type>> state;
+
+      template<class T = predecessor_type,
+               __AGENCY_REQUIRES(!std::is_void<T>::value)
+              >
+      void run()
+      {
+        T predecessor_value = predecessor.get();
+
+        auto result = result_factory();
+        auto shared_parm = shared_factory();
+
+        using body_type = loop_body<Function, T, decltype(result), decltype(shared_parm)>;
+        detail::task_for(n, body_type{f, predecessor_value, result, shared_parm});
+
+        state->set_value(std::move(result));
+      }
+
+      template<class T = predecessor_type,
+               __AGENCY_REQUIRES(std::is_void<T>::value)
+              >
+      void run()
+      {
+        predecessor.get();
+
+        auto result = result_factory();
+        auto shared_parm = shared_factory();
+
+        using body_type = void_predecessor_loop_body<Function, decltype(result), decltype(shared_parm)>;
+        detail::task_for(n, body_type{f, result, shared_parm});
+
+        state->set_value(std::move(result));
+      }
+
+      void operator()()
+      {
+        try
+        {
+          run();
+        }
+        catch(...)
+        {
+          state->set_exception(std::current_exception());
+        }
+      }
+    };
+
+  public:
+    template<class Function, class Future, class ResultFactory, class SharedFactory>
+    task_future<agency::detail::result_of_t<ResultFactory()>>
+      bulk_then_execute(Function f, std::size_t n, Future& predecessor, ResultFactory result_factory, SharedFactory shared_factory) const
+    {
+#if _OPENMP < 201511
+      static_assert(sizeof(Function) && false, "agency::omp::task_executor requires C++ OpenMP 4.5 or better language extensions (typically enabled with -fopenmp or /openmp).");
+#endif
+
+      using result_type = agency::detail::result_of_t<ResultFactory()>;
+      using task_type = bulk_then_task<Function, Future, ResultFactory, SharedFactory>;
+
+      std::shared_ptr<detail::task_state<result_type>> state = std::make_shared<detail::task_state<result_type>>();
+      task_future<result_type> result(state);
+
+      const detail::task_state_base* predecessor_state = state_of(predecessor);
+      detail::launch_task(predecessor_state, state.get(), new task_type{f, n, std::move(predecessor), result_factory, shared_factory, std::move(state)});
+
+      return result;
+    }
+};
+
+
+} // end omp
+} // end agency
+
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/detail/shape_tuple.hpp>
+#include <agency/detail/index_tuple.hpp>
+#include <agency/execution/execution_categories.hpp>
+#include <agency/execution/executor/customization_points/unit_shape.hpp>
+#include <agency/omp/execution/executor/parallel_for_executor.hpp>
+#include <agency/omp/execution/executor/simd_executor.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+
+namespace agency
+{
+namespace omp
+{
+namespace detail
+{
+
+
+// executes f(i) for each i in [0, n) within a team, using the loop construct corresponding to the team's executor
+template<class Function>
+void team_for(const parallel_for_executor& exec, std::size_t n, Function&& f)
+{
+  detail::parallel_for(exec.kind(), exec.chunk_size(), exec.num_threads(), n, std::forward<Function>(f));
+}
+
+
+template<class Function>
+void team_for(const simd_executor&, std::size_t n, Function&& f)
+{
+  detail::simd_for(n, std::forward<Function>(f));
+}
+
+
+} // end detail
+
+
+/// \brief `teams_executor` executes two-level bulk work with nested OpenMP loops.
+///
+/// Each outer index names a team. Teams are distributed among threads by an outer `parallel for` loop
+/// whose schedule is given by the outer `parallel_for_executor`. The agents of each team are then executed
+/// by an inner loop chosen by `InnerExecutor`:
+///
+///   * `teams_executor<parallel_for_executor>` executes each team with a nested `parallel for` loop, and
+///   * `teams_executor<simd_executor>` executes each team with an `omp simd` loop.
+///
+/// A nested `parallel for` loop only receives more than one thread when the OpenMP runtime permits nested
+/// parallelism, e.g. when `OMP_MAX_ACTIVE_LEVELS` is at least two. Otherwise, each team executes on the thread
+/// which encounters it, which still satisfies the inner executor's parallel guarantee.
+///
+/// `omp::par(n, omp::par(m))` and `omp::par(n, omp::unseq(m))` execute through `teams_executor`.
+template<class InnerExecutor = parallel_for_executor>
+class teams_executor
+{
+  static_assert(std::is_same<InnerExecutor, parallel_for_executor>::value || std::is_same<InnerExecutor, simd_executor>::value,
+                "teams_executor's InnerExecutor must be parallel_for_executor or simd_executor.");
+
+  public:
+    using outer_executor_type = parallel_for_executor;
+    using inner_executor_type = InnerExecutor;
+
+    using outer_execution_category = typename outer_executor_type::execution_category;
+    using inner_execution_category = typename inner_executor_type::execution_category;
+
+    using execution_category = scoped_execution_tag<outer_execution_category, inner_execution_category>;
+
+    using shape_type = agency::detail::scoped_shape_t<outer_execution_category, inner_execution_category, std::size_t, std::size_t>;
+    using index_type = agency::detail::scoped_index_t<outer_execution_category, inner_execution_category, std::size_t, std::size_t>;
+
+    teams_executor(const outer_executor_type& outer_ex = outer_executor_type(),
+                   const inner_executor_type& inner_ex = inner_executor_type())
+      : outer_ex_(outer_ex),
+        inner_ex_(inner_ex)
+    {}
+
+    outer_executor_type& outer_executor()
+    {
+      return outer_ex_;
+    }
+
+    const outer_executor_type& outer_executor() const
+    {
+      return outer_ex_;
+    }
+
+    inner_executor_type& inner_executor()
+    {
+      return inner_ex_;
+    }
+
+    const inner_executor_type& inner_executor() const
+    {
+      return inner_ex_;
+    }
+
+    shape_type unit_shape() const
+    {
+      return shape_type(agency::unit_shape(outer_ex_), agency::unit_shape(inner_ex_));
+    }
+
+    shape_type max_shape_dimensions() const
+    {
+      return shape_type(std::numeric_limits<std::size_t>::max(), std::numeric_limits<std::size_t>::max());
+    }
+
+  private:
+    template<class Function, class Result, class OuterSharedParameter, class InnerSharedParameter>
+    struct agent_body
+    {
+      Function& f;
+      std::size_t team_idx;
+      Result& result;
+      OuterSharedParameter& outer_shared_parm;
+      InnerSharedParameter& inner_shared_parm;
+
+      void operator()(std::size_t agent_idx) const
+      {
+        f(index_type(team_idx, agent_idx), result, outer_shared_parm, inner_shared_parm);
+      }
+    };
+
+    template<class Function, class Result, class OuterSharedParameter, class InnerFactory>
+    struct team_body
+    {
+      const inner_executor_type& inner_ex;
+      Function& f;
+      std::size_t team_size;
+      Result& result;
+      OuterSharedParameter& outer_shared_parm;
+      InnerFactory& inner_factory;
+
+      void operator()(std::size_t team_idx) const
+      {
+        auto inner_shared_parm = inner_factory();
+
+        using body_type = agent_body<Function, Result, OuterSharedParameter, decltype(inner_shared_parm)>;
+        detail::team_for(inner_ex, team_size, body_type{f, team_idx, result, outer_shared_parm, inner_shared_parm});
+      }
+    };
+
+  public:
+    template<class Function, class ResultFactory, class OuterFactory, class InnerFactory>
+    agency::detail::result_of_t<ResultFactory()>
+      bulk_sync_execute(Function f, shape_type shape, ResultFactory result_factory, OuterFactory outer_factory, InnerFactory inner_factory) const
+    {
+#ifndef _OPENMP
+      static_assert(sizeof(Function) && false, "agency::omp::teams_executor requires C++ OpenMP language extensions (typically enabled with -fopenmp or /openmp).");
+#endif
+
+      auto result = result_factory();
+      auto outer_shared_parm = outer_factory();
+
+      std::size_t num_teams = agency::get<0>(shape);
+      std::size_t team_size = agency::get<1>(shape);
+
+      using body_type = team_body<Function, decltype(result), decltype(outer_shared_parm), InnerFactory>;
+      detail::parallel_for(outer_ex_.kind(), outer_ex_.chunk_size(), outer_ex_.num_threads(), num_teams,
+                           body_type{inner_ex_, f, team_size, result, outer_shared_parm, inner_factory});
+
+      return std::move(result);
+    }
+
+  private:
+    outer_executor_type outer_ex_;
+    inner_executor_type inner_ex_;
+};
+
+
+} // end omp
+} // end agency
+
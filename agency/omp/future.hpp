@@ -0,0 +1,304 @@
+#pragma once
+
+#include <agency/detail/config.hpp>
+#include <agency/detail/requires.hpp>
+#include <agency/detail/type_traits.hpp>
+#include <agency/experimental/optional.hpp>
+#include <agency/future.hpp>
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+
+namespace agency
+{
+namespace omp
+{
+
+
+template<class T>
+class task_future;
+
+class task_executor;
+
+
+namespace detail
+{
+
+
+// task_state_base is the state shared by a task_future and the OpenMP task which fulfills it
+// its address names the state in the depend clauses of the tasks which produce and consume it
+class task_state_base
+{
+  public:
+    task_state_base()
+      : ready_(false)
+    {}
+
+    bool is_ready() const
+    {
+      return ready_.load(std::memory_order_acquire);
+    }
+
+    void wait() const
+    {
+      if(is_ready()) return;
+
+      // usually, the task fulfilling this state is a child of the waiting task, so wait for the children to complete
+      #pragma omp taskwait
+
+      // otherwise, the state is fulfilled by a task created elsewhere, which another thread is executing
+      while(!is_ready())
+      {
+        #pragma omp taskyield
+        std::this_thread::yield();
+      }
+    }
+
+    void set_exception(std::exception_ptr e)
+    {
+      exception_ = e;
+      mark_ready();
+    }
+
+  protected:
+    void mark_ready()
+    {
+      ready_.store(true, std::memory_order_release);
+    }
+
+    void rethrow_exception() const
+    {
+      if(exception_)
+      {
+        std::rethrow_exception(exception_);
+      }
+    }
+
+  private:
+    std::atomic<bool> ready_;
+    std::exception_ptr exception_;
+};
+
+
+template<class T>
+class task_state : public task_state_base
+{
+  public:
+    template<class... Args>
+    void set_value(Args&&... args)
+    {
+      value_.emplace(std::forward<Args>(args)...);
+      mark_ready();
+    }
+
+    T get()
+    {
+      wait();
+      rethrow_exception();
+      return std::move(*value_);
+    }
+
+  private:
+    experimental::optional<T> value_;
+};
+
+
+template<>
+class task_state<void> : public task_state_base
+{
+  public:
+    void set_value()
+    {
+      mark_ready();
+    }
+
+    void get()
+    {
+      wait();
+      rethrow_exception();
+    }
+};
+
+
+// calls f(args...) and stores its result in state
+template<class Result, class Function, class... Args>
+void set_result_of(task_state<Result>& state, Function& f, Args&... args)
+{
+  state.set_value(f(args...));
+}
+
+
+template<class Function, class... Args>
+void set_result_of(task_state<void>& state, Function& f, Args&... args)
+{
+  f(args...);
+  state.set_value();
+}
+
+
+// launches *task as an OpenMP task which depends on the predecessor state, if any, and produces the successor state
+// the OpenMP task takes ownership of task
+//
+// outside of a parallel region, the task executes immediately on the calling thread
+// inside of one, it is deferred, and the runtime orders it after any sibling task which produces its predecessor
+template<class Task>
+void launch_task(const task_state_base* predecessor, const task_state_base* successor, Task* task)
+{
+  if(predecessor)
+  {
+    #pragma omp task depend(in: predecessor[0:1]) depend(out: successor[0:1]) firstprivate(task)
+    {
+      (*task)();
+      delete task;
+    }
+  }
+  else
+  {
+    #pragma omp task depend(out: successor[0:1]) firstprivate(task)
+    {
+      (*task)();
+      delete task;
+    }
+  }
+}
+
+
+} // end detail
+
+
+/// \brief `task_future` is the future associated with `omp::task_executor`.
+///
+/// A `task_future` is fulfilled by an OpenMP task. Continuations attached with `.then()` or with
+/// `task_executor::bulk_then_execute()` become OpenMP tasks whose `depend` clauses order them after the task
+/// fulfilling their predecessor, so a chain of continuations becomes an OpenMP task graph.
+template<class T>
+class task_future
+{
+  public:
+    task_future() = default;
+
+    task_future(task_future&&) = default;
+
+    task_future& operator=(task_future&&) = default;
+
+    template<class... Args>
+    static task_future make_ready(Args&&... args)
+    {
+      std::shared_ptr<detail::task_state<T>> state = std::make_shared<detail::task_state<T>>();
+      state->set_value(std::forward<Args>(args)...);
+      return task_future(std::move(state));
+    }
+
+    bool valid() const
+    {
+      return static_cast<bool>(state_);
+    }
+
+    bool is_ready() const
+    {
+      return valid() && state_->is_ready();
+    }
+
+    void wait() const
+    {
+      if(!valid())
+      {
+        throw std::future_error(std::future_errc::no_state);
+      }
+
+      state_->wait();
+    }
+
+    T get()
+    {
+      if(!valid())
+      {
+        throw std::future_error(std::future_errc::no_state);
+      }
+
+      std::shared_ptr<detail::task_state<T>> state = std::move(state_);
+      return state->get();
+    }
+
+  private:
+    template<class Function, class Result>
+    struct then_task
+    {
+      task_future predecessor;
+      Function f;
+      std::shared_ptr<detail::task_state<Result>> state;
+
+      template<class U = T,
+               __AGENCY_REQUIRES(!std::is_void<U>::value)
+              >
+      void run()
+      {
+        U value = predecessor.get();
+        detail::set_result_of(*state, f, value);
+      }
+
+      template<class U = T,
+               __AGENCY_REQUIRES(std::is_void<U>::value)
+              >
+      void run()
+      {
+        predecessor.get();
+        detail::set_result_of(*state, f);
+      }
+
+      void operator()()
+      {
+        try
+        {
+          run();
+        }
+        catch(...)
+        {
+          state->set_exception(std::current_exception());
+        }
+      }
+    };
+
+  public:
+    template<class Function>
+    task_future<agency::detail::result_of_continuation_t<agency::detail::decay_t<Function>, task_future>>
+      then(Function&& f)
+    {
+      using result_type = agency::detail::result_of_continuation_t<agency::detail::decay_t<Function>, task_future>;
+      using task_type = then_task<agency::detail::decay_t<Function>, result_type>;
+
+      std::shared_ptr<detail::task_state<result_type>> state = std::make_shared<detail::task_state<result_type>>();
+      task_future<result_type> result(state);
+
+      const detail::task_state_base* predecessor = state_.get();
+      detail::launch_task(predecessor, state.get(), new task_type{std::move(*this), std::forward<Function>(f), std::move(state)});
+
+      return result;
+    }
+
+  private:
+    template<class> friend class task_future;
+    friend class task_executor;
+
+    explicit task_future(std::shared_ptr<detail::task_state<T>> state)
+      : state_(std::move(state))
+    {}
+
+    const detail::task_state_base* state() const
+    {
+      return state_.get();
+    }
+
+    std::shared_ptr<detail::task_state<T>> state_;
+};
+
+
+} // end omp
+} // end agency
+
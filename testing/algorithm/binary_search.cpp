@@ -0,0 +1,84 @@
+#include <agency/agency.hpp>
+#include <agency/algorithm/binary_search.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <random>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  std::default_random_engine rng;
+
+  for(size_t n : {0, 1, 1000, 1 << 18})
+  {
+    std::vector<int> haystack(n);
+    std::generate(haystack.begin(), haystack.end(), [&]{ return int(rng() % 100000); });
+    std::sort(haystack.begin(), haystack.end());
+
+    for(size_t num_values : {0, 10, 1 << 16})
+    {
+      std::vector<int> values(num_values);
+      std::generate(values.begin(), values.end(), [&]{ return int(rng() % 110000) - 5000; });
+
+      for(bool sorted : {false, true})
+      {
+        if(sorted) std::sort(values.begin(), values.end());
+
+        std::vector<size_t> lower(num_values), upper(num_values);
+
+        auto lower_end = agency::lower_bound(policy, haystack.begin(), haystack.end(), values.begin(), values.end(), lower.begin());
+        auto upper_end = agency::upper_bound(policy, haystack.begin(), haystack.end(), values.begin(), values.end(), upper.begin());
+
+        assert(lower_end == lower.end());
+        assert(upper_end == upper.end());
+
+        for(size_t i = 0; i < num_values; ++i)
+        {
+          assert(lower[i] == size_t(std::lower_bound(haystack.begin(), haystack.end(), values[i]) - haystack.begin()));
+          assert(upper[i] == size_t(std::upper_bound(haystack.begin(), haystack.end(), values[i]) - haystack.begin()));
+        }
+      }
+    }
+  }
+
+  {
+    // test a custom comparison
+
+    std::vector<int> haystack(1 << 16);
+    std::generate(haystack.begin(), haystack.end(), [&]{ return int(rng() % 1000); });
+    std::sort(haystack.begin(), haystack.end(), std::greater<int>());
+
+    std::vector<int> values(1 << 14);
+    std::generate(values.begin(), values.end(), [&]{ return int(rng() % 1000); });
+
+    std::vector<size_t> lower(values.size());
+    agency::lower_bound(policy, haystack.begin(), haystack.end(), values.begin(), values.end(), lower.begin(), std::greater<int>());
+
+    for(size_t i = 0; i < values.size(); ++i)
+    {
+      assert(lower[i] == size_t(std::lower_bound(haystack.begin(), haystack.end(), values[i], std::greater<int>()) - haystack.begin()));
+    }
+  }
+}
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
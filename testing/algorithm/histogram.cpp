@@ -0,0 +1,95 @@
+#include <agency/agency.hpp>
+#include <agency/algorithm/histogram.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+std::vector<size_t> sequential_histogram(const std::vector<int>& data, size_t num_bins)
+{
+  std::vector<size_t> result(num_bins);
+
+  for(int x : data)
+  {
+    if(size_t(x) < num_bins)
+    {
+      ++result[x];
+    }
+  }
+
+  return result;
+}
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  std::default_random_engine rng;
+
+  {
+    // test empty input
+
+    std::vector<int> data;
+    std::vector<size_t> bins(10, 13);
+
+    agency::histogram(policy, data.begin(), data.end(), bins);
+
+    assert(bins == std::vector<size_t>(10, 0));
+  }
+
+  // test a range of bin counts, which exercises each strategy
+  for(size_t num_bins : {1, 7, 256, 1000, 100000})
+  {
+    std::vector<int> data(1 << 18);
+
+    // generate some keys which fall outside of the bins
+    std::generate(data.begin(), data.end(), [&]{ return int(rng() % (num_bins + 3)); });
+
+    std::vector<size_t> expected = sequential_histogram(data, num_bins);
+
+    std::vector<size_t> bins(num_bins, 13);
+    agency::histogram(policy, data.begin(), data.end(), bins);
+
+    assert(bins == expected);
+  }
+
+  {
+    // test a custom key function and counter type
+
+    std::vector<double> data(1 << 17);
+    std::generate(data.begin(), data.end(), [&]{ return double(rng() % 1000) / 1000.; });
+
+    // bin the data into tenths
+    auto key_fn = [](double x) { return int(x * 10); };
+
+    std::vector<int> expected(10);
+    for(double x : data)
+    {
+      ++expected[key_fn(x)];
+    }
+
+    std::vector<int> bins(10);
+    agency::histogram(policy, data.begin(), data.end(), bins, key_fn);
+
+    assert(bins == expected);
+  }
+}
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,95 @@
+#include <agency/agency.hpp>
+#include <agency/algorithm/inclusive_scan_by_key.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+std::vector<int> sequential_inclusive_scan_by_key(const std::vector<int>& keys, const std::vector<int>& values)
+{
+  std::vector<int> result(values.size());
+
+  for(size_t i = 0; i < keys.size(); ++i)
+  {
+    result[i] = (i == 0 || keys[i-1] != keys[i]) ? values[i] : result[i-1] + values[i];
+  }
+
+  return result;
+}
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  std::default_random_engine rng;
+
+  {
+    // test empty input
+
+    std::vector<int> keys, values, result;
+
+    auto end = agency::inclusive_scan_by_key(policy, keys.begin(), keys.end(), values.begin(), result.begin());
+
+    assert(end == result.begin());
+  }
+
+  {
+    // test a single segment spanning the entire input
+
+    std::vector<int> keys(1 << 18, 7), values(1 << 18, 1);
+    std::vector<int> result(keys.size());
+
+    auto end = agency::inclusive_scan_by_key(policy, keys.begin(), keys.end(), values.begin(), result.begin());
+
+    assert(end == result.end());
+    for(size_t i = 0; i < result.size(); ++i)
+    {
+      assert(result[i] == int(i + 1));
+    }
+  }
+
+  {
+    // test segments of random length, some longer than an agent's chunk
+
+    std::vector<int> keys;
+    for(int key = 0; keys.size() < (1 << 18); ++key)
+    {
+      size_t length = (key % 5 == 0) ? (rng() % 50000) : (rng() % 10 + 1);
+      keys.insert(keys.end(), length, key);
+    }
+
+    std::vector<int> values(keys.size());
+    std::generate(values.begin(), values.end(), [&]{ return int(rng() % 10); });
+
+    std::vector<int> expected = sequential_inclusive_scan_by_key(keys, values);
+
+    std::vector<int> result(keys.size());
+    agency::inclusive_scan_by_key(policy, keys.begin(), keys.end(), values.begin(), result.begin());
+
+    assert(result == expected);
+
+    // test in-place
+    agency::inclusive_scan_by_key(policy, keys.begin(), keys.end(), values.begin(), values.begin());
+
+    assert(values == expected);
+  }
+}
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,196 @@
+#include <agency/agency.hpp>
+#include <agency/algorithm/merge.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  std::default_random_engine rng;
+
+  {
+    // test merge with empty ranges
+
+    std::vector<int> a, b, result;
+
+    auto end = agency::merge(policy, a.begin(), a.end(), b.begin(), b.end(), result.begin());
+
+    assert(end == result.begin());
+  }
+
+  {
+    // test merge with one empty range
+
+    std::vector<int> a(100), b;
+    std::iota(a.begin(), a.end(), 0);
+
+    std::vector<int> result(a.size());
+
+    auto end = agency::merge(policy, a.begin(), a.end(), b.begin(), b.end(), result.begin());
+
+    assert(end == result.end());
+    assert(result == a);
+  }
+
+  {
+    // test merge of large ranges with many duplicates
+
+    std::vector<int> a(1 << 16), b((1 << 16) + 37);
+    std::generate(a.begin(), a.end(), [&]{ return rng() % 1000; });
+    std::generate(b.begin(), b.end(), [&]{ return rng() % 1000; });
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+
+    std::vector<int> expected(a.size() + b.size());
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+
+    std::vector<int> result(a.size() + b.size());
+    auto end = agency::merge(policy, a.begin(), a.end(), b.begin(), b.end(), result.begin());
+
+    assert(end == result.end());
+    assert(result == expected);
+  }
+
+  {
+    // test merge with a custom comparison
+
+    std::vector<int> a(1 << 15), b(1 << 14);
+    std::generate(a.begin(), a.end(), [&]{ return rng() % 1000; });
+    std::generate(b.begin(), b.end(), [&]{ return rng() % 1000; });
+    std::sort(a.begin(), a.end(), std::greater<int>());
+    std::sort(b.begin(), b.end(), std::greater<int>());
+
+    std::vector<int> expected(a.size() + b.size());
+    std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin(), std::greater<int>());
+
+    std::vector<int> result(a.size() + b.size());
+    agency::merge(policy, a.begin(), a.end(), b.begin(), b.end(), result.begin(), std::greater<int>());
+
+    assert(result == expected);
+  }
+
+  {
+    // test merge_by_key is stable
+
+    std::vector<int> keys1(1 << 16), keys2(1 << 15);
+    std::generate(keys1.begin(), keys1.end(), [&]{ return rng() % 100; });
+    std::generate(keys2.begin(), keys2.end(), [&]{ return rng() % 100; });
+    std::sort(keys1.begin(), keys1.end());
+    std::sort(keys2.begin(), keys2.end());
+
+    // the values record each key's origin
+    std::vector<int> values1(keys1.size()), values2(keys2.size());
+    std::iota(values1.begin(), values1.end(), 0);
+    std::iota(values2.begin(), values2.end(), int(values1.size()));
+
+    std::vector<std::pair<int,int>> pairs1, pairs2;
+    for(size_t i = 0; i < keys1.size(); ++i) pairs1.emplace_back(keys1[i], values1[i]);
+    for(size_t i = 0; i < keys2.size(); ++i) pairs2.emplace_back(keys2[i], values2[i]);
+
+    std::vector<std::pair<int,int>> expected(pairs1.size() + pairs2.size());
+    std::merge(pairs1.begin(), pairs1.end(), pairs2.begin(), pairs2.end(), expected.begin(), [](const std::pair<int,int>& a, const std::pair<int,int>& b)
+    {
+      return a.first < b.first;
+    });
+
+    std::vector<int> keys_result(expected.size()), values_result(expected.size());
+
+    auto ends = agency::merge_by_key(policy,
+                                     keys1.begin(), keys1.end(),
+                                     keys2.begin(), keys2.end(),
+                                     values1.begin(), values2.begin(),
+                                     keys_result.begin(), values_result.begin());
+
+    assert(agency::get<0>(ends) == keys_result.end());
+    assert(agency::get<1>(ends) == values_result.end());
+
+    for(size_t i = 0; i < expected.size(); ++i)
+    {
+      assert(keys_result[i] == expected[i].first);
+      assert(values_result[i] == expected[i].second);
+    }
+  }
+
+  {
+    // test multiway_merge of many ranges of varying sizes
+
+    std::vector<std::vector<int>> ranges(17);
+
+    size_t n = 0;
+    for(size_t i = 0; i < ranges.size(); ++i)
+    {
+      // leave some ranges empty
+      ranges[i].resize((i % 4 == 3) ? 0 : (rng() % 10000));
+      std::generate(ranges[i].begin(), ranges[i].end(), [&]{ return rng() % 500; });
+      std::sort(ranges[i].begin(), ranges[i].end());
+      n += ranges[i].size();
+    }
+
+    std::vector<int> expected;
+    for(auto& r : ranges)
+    {
+      expected.insert(expected.end(), r.begin(), r.end());
+    }
+    std::stable_sort(expected.begin(), expected.end());
+
+    std::vector<int> result(n);
+    auto end = agency::multiway_merge(policy, ranges, result.begin());
+
+    assert(end == result.end());
+    assert(result == expected);
+  }
+
+  {
+    // test multiway_merge is stable
+
+    using pair = std::pair<int,int>;
+    auto compare_first = [](const pair& a, const pair& b) { return a.first < b.first; };
+
+    std::vector<std::vector<pair>> ranges(5);
+
+    int origin = 0;
+    for(auto& r : ranges)
+    {
+      r.resize(20000);
+      std::generate(r.begin(), r.end(), [&]{ return pair(rng() % 50, origin++); });
+      std::stable_sort(r.begin(), r.end(), compare_first);
+    }
+
+    std::vector<pair> expected;
+    for(auto& r : ranges)
+    {
+      expected.insert(expected.end(), r.begin(), r.end());
+    }
+    std::stable_sort(expected.begin(), expected.end(), compare_first);
+
+    std::vector<pair> result(expected.size());
+    agency::multiway_merge(policy, ranges, result.begin(), compare_first);
+
+    assert(result == expected);
+  }
+}
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,108 @@
+#include <agency/agency.hpp>
+#include <agency/algorithm/nth_element.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <random>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+template<class ExecutionPolicy, class Compare>
+void test_nth_element(ExecutionPolicy policy, std::vector<int> data, size_t nth, Compare comp)
+{
+  std::vector<int> sorted = data;
+  std::sort(sorted.begin(), sorted.end(), comp);
+
+  agency::nth_element(policy, data.begin(), data.begin() + nth, data.end(), comp);
+
+  if(nth < data.size())
+  {
+    assert(data[nth] == sorted[nth]);
+
+    for(size_t i = 0; i < nth; ++i)
+    {
+      assert(!comp(data[nth], data[i]));
+    }
+
+    for(size_t i = nth + 1; i < data.size(); ++i)
+    {
+      assert(!comp(data[i], data[nth]));
+    }
+  }
+
+  // the result is a permutation of the input
+  std::sort(data.begin(), data.end(), comp);
+  assert(data == sorted);
+}
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  std::default_random_engine rng;
+
+  {
+    // test empty input
+    test_nth_element(policy, std::vector<int>(), 0, std::less<int>());
+  }
+
+  {
+    // test small input
+    std::vector<int> data(100);
+    std::generate(data.begin(), data.end(), rng);
+
+    test_nth_element(policy, data, 50, std::less<int>());
+  }
+
+  {
+    // test large input at several positions
+    std::vector<int> data(1 << 18);
+    std::generate(data.begin(), data.end(), rng);
+
+    for(size_t nth : {size_t(0), size_t(1), data.size() / 3, data.size() / 2, data.size() - 1, data.size()})
+    {
+      test_nth_element(policy, data, nth, std::less<int>());
+    }
+  }
+
+  {
+    // test input with many duplicates
+    std::vector<int> data(1 << 18);
+    std::generate(data.begin(), data.end(), [&]{ return int(rng() % 3); });
+
+    test_nth_element(policy, data, data.size() / 2, std::less<int>());
+  }
+
+  {
+    // test input which is entirely equivalent
+    std::vector<int> data(1 << 18, 7);
+
+    test_nth_element(policy, data, 1000, std::less<int>());
+  }
+
+  {
+    // test sorted input with a custom comparison
+    std::vector<int> data(1 << 18);
+    std::iota(data.begin(), data.end(), 0);
+
+    test_nth_element(policy, data, 12345, std::greater<int>());
+  }
+}
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,69 @@
+#include <agency/agency.hpp>
+#include <agency/algorithm/partial_sort.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <random>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  std::default_random_engine rng;
+
+  for(size_t n : {0, 10, 1 << 18})
+  {
+    for(size_t k : {size_t(0), size_t(1), n / 10, n})
+    {
+      if(k > n) continue;
+
+      std::vector<int> data(n);
+      std::generate(data.begin(), data.end(), [&]{ return int(rng() % 100000); });
+
+      std::vector<int> expected = data;
+      std::sort(expected.begin(), expected.end());
+
+      agency::partial_sort(policy, data.begin(), data.begin() + k, data.end());
+
+      assert(std::equal(data.begin(), data.begin() + k, expected.begin()));
+
+      // the result is a permutation of the input
+      std::sort(data.begin(), data.end());
+      assert(data == expected);
+    }
+  }
+
+  {
+    // test a custom comparison
+
+    std::vector<int> data(1 << 17);
+    std::generate(data.begin(), data.end(), rng);
+
+    std::vector<int> expected = data;
+    std::sort(expected.begin(), expected.end(), std::greater<int>());
+
+    agency::partial_sort(policy, data.begin(), data.begin() + 1000, data.end(), std::greater<int>());
+
+    assert(std::equal(data.begin(), data.begin() + 1000, expected.begin()));
+  }
+}
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
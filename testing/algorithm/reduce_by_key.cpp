@@ -0,0 +1,136 @@
+#include <agency/agency.hpp>
+#include <agency/algorithm/reduce_by_key.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <random>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+template<class T>
+void sequential_reduce_by_key(const std::vector<int>& keys, const std::vector<T>& values, std::vector<int>& keys_result, std::vector<T>& values_result)
+{
+  keys_result.clear();
+  values_result.clear();
+
+  for(size_t i = 0; i < keys.size(); ++i)
+  {
+    if(i == 0 || keys[i-1] != keys[i])
+    {
+      keys_result.push_back(keys[i]);
+      values_result.push_back(values[i]);
+    }
+    else
+    {
+      values_result.back() += values[i];
+    }
+  }
+}
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  std::default_random_engine rng;
+
+  {
+    // test empty input
+
+    std::vector<int> keys, values, keys_result, values_result;
+
+    auto ends = agency::reduce_by_key(policy, keys.begin(), keys.end(), values.begin(), keys_result.begin(), values_result.begin());
+
+    assert(agency::get<0>(ends) == keys_result.begin());
+    assert(agency::get<1>(ends) == values_result.begin());
+  }
+
+  {
+    // test a single segment spanning the entire input
+
+    std::vector<int> keys(1 << 18, 7), values(1 << 18, 1);
+    std::vector<int> keys_result(keys.size()), values_result(keys.size());
+
+    auto ends = agency::reduce_by_key(policy, keys.begin(), keys.end(), values.begin(), keys_result.begin(), values_result.begin());
+
+    assert(agency::get<0>(ends) - keys_result.begin() == 1);
+    assert(agency::get<1>(ends) - values_result.begin() == 1);
+    assert(keys_result[0] == 7);
+    assert(values_result[0] == int(keys.size()));
+  }
+
+  {
+    // test segments of random length, some longer than an agent's chunk
+
+    std::vector<int> keys, values;
+    for(int key = 0; keys.size() < (1 << 18); ++key)
+    {
+      size_t length = (key % 5 == 0) ? (rng() % 50000) : (rng() % 10 + 1);
+      keys.insert(keys.end(), length, key);
+    }
+
+    values.resize(keys.size());
+    std::generate(values.begin(), values.end(), [&]{ return int(rng() % 10); });
+
+    std::vector<int> expected_keys, expected_values;
+    sequential_reduce_by_key(keys, values, expected_keys, expected_values);
+
+    std::vector<int> keys_result(keys.size()), values_result(keys.size());
+
+    auto ends = agency::reduce_by_key(policy, keys.begin(), keys.end(), values.begin(), keys_result.begin(), values_result.begin());
+
+    keys_result.erase(agency::get<0>(ends), keys_result.end());
+    values_result.erase(agency::get<1>(ends), values_result.end());
+
+    assert(keys_result == expected_keys);
+    assert(values_result == expected_values);
+  }
+
+  {
+    // test a custom predicate and operation
+
+    std::vector<int> keys(1 << 17), values(1 << 17);
+    for(size_t i = 0; i < keys.size(); ++i)
+    {
+      keys[i] = int(i / 1000);
+    }
+    std::generate(values.begin(), values.end(), [&]{ return int(rng() % 1000); });
+
+    // group keys by their quotient by 10, and find each group's maximum
+    auto same_group = [](int a, int b) { return a / 10 == b / 10; };
+    auto maximum = [](int a, int b) { return std::max(a, b); };
+
+    std::vector<int> keys_result(keys.size()), values_result(keys.size());
+
+    auto ends = agency::reduce_by_key(policy, keys.begin(), keys.end(), values.begin(), keys_result.begin(), values_result.begin(), same_group, maximum);
+
+    size_t num_groups = agency::get<0>(ends) - keys_result.begin();
+    assert(num_groups == (keys.size() + 9999) / 10000);
+
+    for(size_t g = 0; g < num_groups; ++g)
+    {
+      size_t begin = g * 10000;
+      size_t end = std::min(keys.size(), begin + 10000);
+
+      assert(keys_result[g] == keys[begin]);
+      assert(values_result[g] == *std::max_element(values.begin() + begin, values.begin() + end));
+    }
+  }
+}
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+#include <agency/agency.hpp>
+#include <agency/algorithm/segmented_reduce.hpp>
+#include <agency/experimental/segmented_array.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <numeric>
+#include <functional>
+#include <random>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  std::default_random_engine rng;
+
+  {
+    // test no segments
+
+    std::vector<int> values, offsets(1, 0), result;
+
+    auto end = agency::segmented_reduce(policy, values.begin(), offsets.begin(), offsets.end(), result.begin(), 0, std::plus<int>());
+
+    assert(end == result.begin());
+  }
+
+  {
+    // test only empty segments
+
+    std::vector<int> values, offsets(10, 0), result(9);
+
+    auto end = agency::segmented_reduce(policy, values.begin(), offsets.begin(), offsets.end(), result.begin(), 13, std::plus<int>());
+
+    assert(end == result.end());
+    assert(result == std::vector<int>(9, 13));
+  }
+
+  {
+    // test segments of random length, including empty segments and segments longer than an agent's chunk
+
+    std::vector<size_t> offsets(1, 0);
+    while(offsets.back() < (1 << 18))
+    {
+      size_t i = offsets.size();
+      size_t length = (i % 7 == 0) ? 0 : (i % 5 == 0) ? (rng() % 50000) : (rng() % 10 + 1);
+      offsets.push_back(offsets.back() + length);
+    }
+
+    // end with several empty segments
+    offsets.insert(offsets.end(), 3, offsets.back());
+
+    std::vector<int> values(offsets.back());
+    std::generate(values.begin(), values.end(), [&]{ return int(rng() % 10); });
+
+    size_t num_segments = offsets.size() - 1;
+
+    std::vector<int> expected(num_segments);
+    for(size_t s = 0; s < num_segments; ++s)
+    {
+      expected[s] = std::accumulate(values.begin() + offsets[s], values.begin() + offsets[s+1], 1);
+    }
+
+    std::vector<int> result(num_segments);
+    auto end = agency::segmented_reduce(policy, values.begin(), offsets.begin(), offsets.end(), result.begin(), 1, std::plus<int>());
+
+    assert(end == result.end());
+    assert(result == expected);
+  }
+
+  {
+    // test offsets which don't begin at zero
+
+    std::vector<int> values(1 << 17, 1);
+    std::vector<int> offsets = {100, 200, 50000, 50000, 100000, 130000};
+
+    std::vector<int> result(offsets.size() - 1);
+    agency::segmented_reduce(policy, values.begin(), offsets.begin(), offsets.end(), result.begin(), 0, std::plus<int>());
+
+    assert(result == std::vector<int>({100, 49800, 0, 50000, 30000}));
+  }
+
+  {
+    // test segmented_array
+
+    std::vector<agency::allocator<int>> allocators(10);
+
+    agency::experimental::segmented_array<int> array(1000, 1, allocators);
+
+    std::vector<int> result(allocators.size());
+    auto end = agency::segmented_reduce(policy, array, result.begin(), 0, std::plus<int>());
+
+    assert(end == result.end());
+    assert(result == std::vector<int>(allocators.size(), 100));
+  }
+}
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,108 @@
+#include <agency/agency.hpp>
+#include <agency/algorithm/set_operations.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <random>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+template<class ExecutionPolicy>
+void test_set_operations(ExecutionPolicy policy, std::vector<int> a, std::vector<int> b)
+{
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+
+  std::vector<int> expected(a.size() + b.size()), result(a.size() + b.size());
+
+  {
+    // test set_intersection
+    auto expected_end = std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+    auto result_end = agency::set_intersection(policy, a.begin(), a.end(), b.begin(), b.end(), result.begin());
+
+    assert(result_end - result.begin() == expected_end - expected.begin());
+    assert(std::equal(result.begin(), result_end, expected.begin()));
+  }
+
+  {
+    // test set_union
+    auto expected_end = std::set_union(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+    auto result_end = agency::set_union(policy, a.begin(), a.end(), b.begin(), b.end(), result.begin());
+
+    assert(result_end - result.begin() == expected_end - expected.begin());
+    assert(std::equal(result.begin(), result_end, expected.begin()));
+  }
+
+  {
+    // test set_difference
+    auto expected_end = std::set_difference(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+    auto result_end = agency::set_difference(policy, a.begin(), a.end(), b.begin(), b.end(), result.begin());
+
+    assert(result_end - result.begin() == expected_end - expected.begin());
+    assert(std::equal(result.begin(), result_end, expected.begin()));
+  }
+}
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  std::default_random_engine rng;
+
+  for(size_t n1 : {0, 10, 1 << 17})
+  {
+    for(size_t n2 : {0, 10, 1 << 16})
+    {
+      // test keys with few, some, and many duplicates
+      for(int range : {1 << 30, 1 << 12, 4})
+      {
+        std::vector<int> a(n1), b(n2);
+        std::generate(a.begin(), a.end(), [&]{ return int(rng() % range); });
+        std::generate(b.begin(), b.end(), [&]{ return int(rng() % range); });
+
+        test_set_operations(policy, a, b);
+      }
+    }
+  }
+
+  {
+    // test a single key which is repeated in both inputs
+    test_set_operations(policy, std::vector<int>(1 << 17, 13), std::vector<int>(1 << 16, 13));
+    test_set_operations(policy, std::vector<int>(1 << 16, 13), std::vector<int>(1 << 17, 13));
+  }
+
+  {
+    // test a custom comparison
+
+    std::vector<int> a(1 << 17), b(1 << 17);
+    std::generate(a.begin(), a.end(), [&]{ return int(rng() % 1000); });
+    std::generate(b.begin(), b.end(), [&]{ return int(rng() % 1000); });
+    std::sort(a.begin(), a.end(), std::greater<int>());
+    std::sort(b.begin(), b.end(), std::greater<int>());
+
+    std::vector<int> expected(a.size()), result(a.size());
+    auto expected_end = std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), expected.begin(), std::greater<int>());
+    auto result_end = agency::set_intersection(policy, a.begin(), a.end(), b.begin(), b.end(), result.begin(), std::greater<int>());
+
+    assert(result_end - result.begin() == expected_end - expected.begin());
+    assert(std::equal(result.begin(), result_end, expected.begin()));
+  }
+}
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
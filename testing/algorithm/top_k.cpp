@@ -0,0 +1,65 @@
+#include <agency/agency.hpp>
+#include <agency/algorithm/top_k.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <random>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  std::default_random_engine rng;
+
+  for(size_t n : {0, 10, 1 << 18})
+  {
+    std::vector<float> scores(n);
+    std::generate(scores.begin(), scores.end(), [&]{ return float(rng() % 100000); });
+
+    std::vector<float> expected = scores;
+    std::sort(expected.begin(), expected.end(), std::greater<float>());
+
+    for(size_t k : {size_t(0), size_t(1), size_t(100), n / 2, n / 2 + 1, n - n / 4, n, n + 1})
+    {
+      auto result = agency::top_k(policy, scores, k);
+
+      assert(result.size() == std::min(k, n));
+      assert(std::equal(result.begin(), result.end(), expected.begin()));
+    }
+  }
+
+  {
+    // test a custom comparison
+
+    std::vector<int> data(1 << 17);
+    std::generate(data.begin(), data.end(), rng);
+
+    std::vector<int> expected = data;
+    std::sort(expected.begin(), expected.end());
+
+    auto result = agency::top_k(policy, data, 1000, std::less<int>());
+
+    assert(result.size() == 1000);
+    assert(std::equal(result.begin(), result.end(), expected.begin()));
+  }
+}
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,157 @@
+#include <agency/agency.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <cassert>
+
+#ifdef __AGENCY_HAS_COROUTINES
+#include <agency/coroutine.hpp>
+
+
+// a minimal eagerly-started coroutine whose result is observed through a std::future
+// its promise has no .schedule() member, so future_awaiter resumes it on the thread which observes readiness
+template<class T>
+struct eager
+{
+  struct promise_type
+  {
+    std::promise<T> result;
+
+    eager get_return_object()
+    {
+      return eager{result.get_future()};
+    }
+
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+
+    void return_value(T value)
+    {
+      result.set_value(value);
+    }
+
+    void unhandled_exception()
+    {
+      result.set_exception(std::current_exception());
+    }
+  };
+
+  std::future<T> result;
+};
+
+
+eager<std::thread::id> await_always_ready(agency::always_ready_future<int> f)
+{
+  int value = co_await f;
+  assert(value == 13);
+
+  co_return std::this_thread::get_id();
+}
+
+
+void test_always_ready_future()
+{
+  // awaiting an always_ready_future never suspends, so the coroutine completes before returning to its caller
+  auto e = await_always_ready(agency::make_always_ready_future(13));
+
+  assert(e.result.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+  assert(e.result.get() == std::this_thread::get_id());
+}
+
+
+eager<int> await_std_future(std::future<int> f)
+{
+  int value = co_await agency::make_awaitable(f);
+
+  co_return value + 1;
+}
+
+
+void test_std_future()
+{
+  std::promise<int> p;
+
+  auto e = await_std_future(p.get_future());
+
+  // the coroutine is suspended until its future becomes ready
+  assert(e.result.wait_for(std::chrono::milliseconds(10)) == std::future_status::timeout);
+
+  p.set_value(41);
+
+  assert(e.result.get() == 42);
+}
+
+
+eager<int> await_variant_future(agency::variant_future<std::future<int>, agency::always_ready_future<int>> f)
+{
+  int value = co_await f;
+
+  co_return value;
+}
+
+
+void test_variant_future()
+{
+  using future_type = agency::variant_future<std::future<int>, agency::always_ready_future<int>>;
+
+  {
+    future_type f = agency::make_always_ready_future(7);
+    assert(f.is_ready());
+
+    auto e = await_variant_future(std::move(f));
+    assert(e.result.get() == 7);
+  }
+
+  {
+    std::promise<int> p;
+    future_type f = p.get_future();
+    assert(!f.is_ready());
+
+    auto e = await_variant_future(std::move(f));
+
+    p.set_value(13);
+    assert(e.result.get() == 13);
+  }
+}
+
+
+eager<int> await_exceptional_future()
+{
+  std::promise<int> p;
+  p.set_exception(std::make_exception_ptr(std::runtime_error("error")));
+
+  try
+  {
+    co_await agency::make_awaitable(p.get_future());
+  }
+  catch(std::runtime_error&)
+  {
+    co_return 1;
+  }
+
+  co_return 0;
+}
+
+
+void test_exception()
+{
+  auto e = await_exceptional_future();
+  assert(e.result.get() == 1);
+}
+#endif
+
+
+int main()
+{
+#ifdef __AGENCY_HAS_COROUTINES
+  test_always_ready_future();
+  test_std_future();
+  test_variant_future();
+  test_exception();
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
@@ -0,0 +1,204 @@
+#include <agency/agency.hpp>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cassert>
+
+#ifdef __AGENCY_HAS_COROUTINES
+#include <agency/coroutine.hpp>
+
+
+struct square
+{
+  template<class Agent>
+  int operator()(Agent& self)
+  {
+    int i = static_cast<int>(self.index());
+    return i * i;
+  }
+};
+
+
+struct add_predecessor
+{
+  template<class Agent, class Container>
+  int operator()(Agent& self, Container& predecessor, int value)
+  {
+    return predecessor[self.index()] + value;
+  }
+};
+
+
+agency::task<int> answer()
+{
+  co_return 42;
+}
+
+
+agency::task<int> add_one_to_answer()
+{
+  int x = co_await answer();
+  co_return x + 1;
+}
+
+
+void test_nested_tasks()
+{
+  agency::task<int> t = add_one_to_answer();
+  assert(t.valid());
+  assert(!t.is_ready());
+
+  assert(t.get() == 43);
+  assert(!t.valid());
+}
+
+
+void test_move_assignment()
+{
+  agency::task<int> t = answer();
+  agency::task<int> u;
+  assert(!u.valid());
+
+  u = std::move(t);
+  assert(!t.valid());
+  assert(u.valid());
+
+  // self-move-assignment leaves the task intact
+  agency::task<int>& alias = u;
+  u = std::move(alias);
+  assert(u.valid());
+
+  assert(u.get() == 42);
+}
+
+
+// chains parallel stages without blocking the thread which executes the task
+agency::task<int> sum_of_squares_plus(size_t n, int value)
+{
+  auto squares = agency::bulk_async(agency::par(n), square());
+  auto results = co_await agency::bulk_then(agency::par(n), add_predecessor(), squares, value);
+
+  co_return std::accumulate(results.begin(), results.end(), 0);
+}
+
+
+void test_bulk_futures()
+{
+  int n = 10;
+  int expected = (n - 1) * n * (2 * n - 1) / 6 + n;
+
+  assert(sum_of_squares_plus(n, 1).get() == expected);
+}
+
+
+agency::task<bool> await_always_ready()
+{
+  std::thread::id before = std::this_thread::get_id();
+
+  int x = co_await agency::make_always_ready_future(13);
+  assert(x == 13);
+
+  // awaiting an always_ready_future does not suspend the task, so it continues on the same thread
+  co_return before == std::this_thread::get_id();
+}
+
+
+void test_always_ready_short_circuit()
+{
+  assert(await_always_ready().get());
+}
+
+
+agency::task<std::thread::id> thread_after_resume_on(std::shared_ptr<agency::detail::thread_pool> pool)
+{
+  co_await agency::resume_on(agency::detail::thread_pool_executor(pool));
+
+  // the task remains on its new executor after awaiting a future which is not ready
+  std::promise<int> p;
+  std::future<int> f = p.get_future();
+  std::thread setter([&p]
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    p.set_value(0);
+  });
+
+  co_await f;
+  setter.join();
+
+  co_return std::this_thread::get_id();
+}
+
+
+void test_resume_on()
+{
+  auto pool = std::make_shared<agency::detail::thread_pool>(1);
+
+  std::thread::id pool_thread = agency::detail::thread_pool_executor(pool).pool().async([]
+  {
+    return std::this_thread::get_id();
+  }).get();
+
+  assert(thread_after_resume_on(pool).get() == pool_thread);
+}
+
+
+agency::task<void> throw_error()
+{
+  co_await agency::make_always_ready_future();
+  throw std::runtime_error("error");
+}
+
+
+agency::task<int> catch_error()
+{
+  try
+  {
+    co_await throw_error();
+  }
+  catch(std::runtime_error&)
+  {
+    co_return 1;
+  }
+
+  co_return 0;
+}
+
+
+void test_exceptions()
+{
+  assert(catch_error().get() == 1);
+
+  bool caught = false;
+  try
+  {
+    throw_error().get();
+  }
+  catch(std::runtime_error&)
+  {
+    caught = true;
+  }
+
+  assert(caught);
+}
+#endif
+
+
+int main()
+{
+#ifdef __AGENCY_HAS_COROUTINES
+  test_nested_tasks();
+  test_move_assignment();
+  test_bulk_futures();
+  test_always_ready_short_circuit();
+  test_resume_on();
+  test_exceptions();
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
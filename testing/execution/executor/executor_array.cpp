@@ -2,8 +2,10 @@
 #include <type_traits>
 #include <vector>
 #include <cassert>
+#include <stdexcept>
 
 #include <agency/execution/executor/executor_array.hpp>
+#include <agency/execution/executor/parallel_executor.hpp>
 #include <agency/tuple.hpp>
 #include "test_executors.hpp"
 
@@ -92,6 +94,165 @@ void test(OuterExecutor, InnerExecutor inner_exec)
   }
 }
 
+void test_many_groups()
+{
+  using namespace agency;
+
+  // many more outer agents than inner executors, whose groups complete asynchronously and in any order
+  using executor_array_type = agency::executor_array<agency::parallel_executor, agency::parallel_executor>;
+
+  executor_array_type exec(4);
+
+  using shape_type  = executor_shape_t<executor_array_type>;
+  using index_type  = executor_index_t<executor_array_type>;
+  using result_type = agency::experimental::basic_ndarray<int, shape_type, agency::executor_allocator_t<executor_array_type, int>>;
+
+  for(size_t outer_size : {0, 1, 1000})
+  {
+    shape_type shape(outer_size, 10);
+    std::future<int> predecessor_fut = make_ready_future<int>(exec, 7);
+
+    auto f = exec.bulk_then_execute(
+      [=](index_type idx, int& predecessor, result_type& results, std::vector<int>& outer_shared_arg, std::vector<int>& inner_shared_arg)
+      {
+        auto outer_idx = agency::get<0>(idx);
+        auto inner_idx = agency::get<1>(idx);
+        results[idx] = predecessor + outer_shared_arg[outer_idx] + inner_shared_arg[inner_idx];
+      },
+      shape,
+      predecessor_fut,
+      [=]{ return result_type(shape); },                          // results
+      [=]{ return std::vector<int>(agency::get<0>(shape), 13); }, // outer_shared_arg
+      [=]{ return std::vector<int>(agency::get<1>(shape), 42); }  // inner_shared_arg
+    );
+
+    auto result = f.get();
+
+    assert(result_type(shape, 7 + 13 + 42) == result);
+  }
+}
+
+// a parallel_executor which creates an extra shared parameter for each group and immediately destroys it
+struct extra_shared_parameter_executor : agency::parallel_executor
+{
+  template<class Function, class Future, class ResultFactory, class SharedFactory>
+  std::future<agency::detail::result_of_t<ResultFactory()>>
+    bulk_then_execute(Function f, size_t n, Future& predecessor, ResultFactory result_factory, SharedFactory shared_factory)
+  {
+    shared_factory();
+
+    return agency::parallel_executor::bulk_then_execute(f, n, predecessor, result_factory, shared_factory);
+  }
+};
+
+void test_extra_shared_parameter()
+{
+  using namespace agency;
+
+  // the completion of groups does not depend on how many shared parameters the inner executor creates
+  using executor_array_type = agency::executor_array<agency::parallel_executor, extra_shared_parameter_executor>;
+
+  executor_array_type exec(4);
+
+  using shape_type  = executor_shape_t<executor_array_type>;
+  using index_type  = executor_index_t<executor_array_type>;
+  using result_type = agency::experimental::basic_ndarray<int, shape_type, agency::executor_allocator_t<executor_array_type, int>>;
+
+  shape_type shape(100, 10);
+  std::future<int> predecessor_fut = make_ready_future<int>(exec, 7);
+
+  auto f = exec.bulk_then_execute(
+    [=](index_type idx, int& predecessor, result_type& results, int& outer_shared_arg, int& inner_shared_arg)
+    {
+      results[idx] = predecessor + outer_shared_arg + inner_shared_arg;
+    },
+    shape,
+    predecessor_fut,
+    [=]{ return result_type(shape); },
+    []{ return 13; },
+    []{ return 42; }
+  );
+
+  assert(result_type(shape, 7 + 13 + 42) == f.get());
+}
+
+void test_exceptions()
+{
+  using namespace agency;
+
+  using executor_array_type = agency::executor_array<agency::parallel_executor, agency::parallel_executor>;
+
+  executor_array_type exec(4);
+
+  using shape_type  = executor_shape_t<executor_array_type>;
+  using index_type  = executor_index_t<executor_array_type>;
+
+  shape_type shape(100, 10);
+
+  {
+    // an exceptional predecessor's exception is delivered through the result
+    std::promise<int> promise;
+    std::future<int> predecessor_fut = promise.get_future();
+    promise.set_exception(std::make_exception_ptr(std::runtime_error("predecessor")));
+
+    auto f = exec.bulk_then_execute(
+      [](index_type, int&, int&, int&, int&)
+      {
+        assert(false);
+      },
+      shape,
+      predecessor_fut,
+      []{ return 0; },
+      []{ return 0; },
+      []{ return 0; }
+    );
+
+    bool caught = false;
+    try
+    {
+      f.get();
+    }
+    catch(std::runtime_error&)
+    {
+      caught = true;
+    }
+
+    assert(caught);
+  }
+
+  {
+    // an agent's exception is delivered through the result
+    std::future<int> predecessor_fut = make_ready_future<int>(exec, 7);
+
+    auto f = exec.bulk_then_execute(
+      [](index_type idx, int&, int&, int&, int&)
+      {
+        if(agency::get<0>(idx) == 50 && agency::get<1>(idx) == 5)
+        {
+          throw std::runtime_error("agent");
+        }
+      },
+      shape,
+      predecessor_fut,
+      []{ return 0; },
+      []{ return 0; },
+      []{ return 0; }
+    );
+
+    bool caught = false;
+    try
+    {
+      f.get();
+    }
+    catch(std::runtime_error&)
+    {
+      caught = true;
+    }
+
+    assert(caught);
+  }
+}
+
 int main()
 {
   test(bulk_continuation_executor(), bulk_continuation_executor());
@@ -106,6 +267,10 @@ int main()
   test(bulk_asynchronous_executor(), bulk_synchronous_executor());
   test(bulk_asynchronous_executor(), bulk_asynchronous_executor());
 
+  test_many_groups();
+  test_extra_shared_parameter();
+  test_exceptions();
+
   std::cout << "OK" << std::endl;
 
   return 0;
@@ -0,0 +1,307 @@
+#include <agency/agency.hpp>
+#include <agency/execution/executor/experimental/affinity_executor.hpp>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+
+void write_file(const std::string& filename, const std::string& contents)
+{
+  std::string directory = filename.substr(0, filename.rfind('/'));
+  std::string command = "mkdir -p " + directory;
+  assert(std::system(command.c_str()) == 0);
+
+  std::ofstream file(filename.c_str());
+  file << contents << std::endl;
+}
+
+
+// creates a sysfs tree describing two sockets, each with one NUMA node, one L3 cache, and two cores with two hardware threads
+// cpu ids are interleaved across each socket's cores, as many x86 machines number them:
+// socket 0: cores {0,4} and {1,5}; socket 1: cores {2,6} and {3,7}
+std::string make_fake_sysfs()
+{
+  std::string root = "/tmp/agency_affinity_executor_sysfs_" + std::to_string(getpid());
+  std::string cpu_root = root + "/devices/system/cpu/";
+  std::string node_root = root + "/devices/system/node/";
+
+  write_file(cpu_root + "online", "0-7");
+  write_file(node_root + "online", "0-1");
+  write_file(node_root + "node0/cpulist", "0-1,4-5");
+  write_file(node_root + "node1/cpulist", "2-3,6-7");
+
+  for(int cpu = 0; cpu < 8; ++cpu)
+  {
+    int package = (cpu % 4) / 2;
+    int core = cpu % 4;
+    std::string siblings = std::to_string(core) + "," + std::to_string(core + 4);
+    std::string l3_sharers = package == 0 ? "0-1,4-5" : "2-3,6-7";
+
+    std::string this_cpu = cpu_root + "cpu" + std::to_string(cpu) + "/";
+
+    write_file(this_cpu + "topology/physical_package_id", std::to_string(package));
+    write_file(this_cpu + "topology/core_id", std::to_string(core));
+    write_file(this_cpu + "topology/thread_siblings_list", siblings);
+
+    write_file(this_cpu + "cache/index0/level", "1");
+    write_file(this_cpu + "cache/index0/shared_cpu_list", siblings);
+    write_file(this_cpu + "cache/index1/level", "2");
+    write_file(this_cpu + "cache/index1/shared_cpu_list", siblings);
+    write_file(this_cpu + "cache/index2/level", "3");
+    write_file(this_cpu + "cache/index2/shared_cpu_list", l3_sharers);
+  }
+
+  return root;
+}
+
+
+void test_parse_cpu_list()
+{
+  using agency::detail::parse_cpu_list;
+
+  assert(parse_cpu_list("0") == std::vector<int>({0}));
+  assert(parse_cpu_list("0-3\n") == std::vector<int>({0,1,2,3}));
+  assert(parse_cpu_list("8,0-1,10-11") == std::vector<int>({0,1,8,10,11}));
+  assert(parse_cpu_list("") == std::vector<int>());
+}
+
+
+void test_discover()
+{
+  using namespace agency::detail;
+
+  std::string root = make_fake_sysfs();
+
+  cpu_topology topology = cpu_topology::discover(root);
+
+  assert(topology.size() == 8);
+  assert(topology.num_cores() == 4);
+
+  assert(topology.numa_nodes() == std::vector<std::vector<int>>({{0,1,4,5}, {2,3,6,7}}));
+  assert(topology.numa_node_ids() == std::vector<int>({0,1}));
+  assert(topology.l3_domains() == std::vector<std::vector<int>>({{0,1,4,5}, {2,3,6,7}}));
+
+  assert(topology.find(6).package == 1);
+  assert(topology.find(6).core == 2);
+  assert(topology.find(6).numa_node == 1);
+  assert(topology.find(6).smt_rank == 1);
+  assert(topology.find(2).smt_rank == 0);
+
+  std::string command = "rm -rf " + root;
+  assert(std::system(command.c_str()) == 0);
+
+  // a missing tree yields a uniform topology
+  cpu_topology fallback = cpu_topology::discover("/nonexistent");
+  assert(fallback.size() > 0);
+  assert(fallback.numa_nodes().size() == 1);
+
+  // the system's topology covers at least one cpu
+  assert(system_topology().size() > 0);
+}
+
+
+struct record_domain
+{
+  template<class Agent>
+  void operator()(Agent& self, int* domains, int* cpus)
+  {
+    size_t i = self.outer().index() * self.inner().group_size() + self.inner().index();
+
+    domains[i] = static_cast<int>(self.outer().index());
+
+#if defined(__linux__)
+    cpus[i] = sched_getcpu();
+#else
+    cpus[i] = -1;
+#endif
+  }
+};
+
+
+void test_affinity_executor(const agency::experimental::affinity_executor& exec)
+{
+  using namespace agency;
+
+  static_assert(is_bulk_executor<experimental::affinity_executor>::value,
+    "affinity_executor should be a bulk executor");
+
+  static_assert(executor_execution_depth<experimental::affinity_executor>::value == 2,
+    "affinity_executor should have execution_depth == 2");
+
+  assert(exec.size() > 0);
+
+  size_t num_domains = exec.size();
+  size_t group_size = 4;
+
+  std::vector<int> domains(num_domains * group_size, -1);
+  std::vector<int> cpus(num_domains * group_size, -1);
+
+  agency::bulk_invoke(agency::par(num_domains, agency::par(group_size)).on(exec), record_domain(), domains.data(), cpus.data());
+
+  for(size_t i = 0; i < domains.size(); ++i)
+  {
+    int domain = domains[i];
+    assert(domain == static_cast<int>(i / group_size));
+
+#if defined(__linux__)
+    // when the process is allowed to run on the domain's cpus, the group ran on one of them
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    sched_getaffinity(0, sizeof(allowed), &allowed);
+
+    bool domain_is_allowed = true;
+    for(int cpu : exec.cpus(domain))
+    {
+      domain_is_allowed = domain_is_allowed && CPU_ISSET(cpu, &allowed);
+    }
+
+    if(domain_is_allowed)
+    {
+      const std::vector<int>& domain_cpus = exec.cpus(domain);
+      assert(std::find(domain_cpus.begin(), domain_cpus.end(), cpus[i]) != domain_cpus.end());
+    }
+#endif
+  }
+}
+
+
+void test_domain_allocator(const agency::experimental::affinity_executor& exec)
+{
+  for(size_t domain = 0; domain < exec.size(); ++domain)
+  {
+    agency::vector<int, agency::detail::numa_allocator<int>> data(1000, 7, exec.domain_allocator<int>(domain));
+
+    // allocations are page-aligned
+    assert(reinterpret_cast<std::uintptr_t>(data.data()) % 4096 == 0);
+
+    for(int x : data)
+    {
+      assert(x == 7);
+    }
+
+    assert(data.get_allocator().resource().node() == exec.numa_node(domain));
+  }
+}
+
+
+void test_restricted_cpus()
+{
+  using namespace agency::detail;
+  using agency::experimental::affinity_executor;
+  using agency::experimental::affinity_domain;
+
+  std::string root = make_fake_sysfs();
+  cpu_topology topology = cpu_topology::discover(root);
+
+  std::string command = "rm -rf " + root;
+  assert(std::system(command.c_str()) == 0);
+
+  {
+    // only cpus of NUMA node 1 are allowed, so node 0 is omitted
+    affinity_executor exec(affinity_domain::numa_node, topology, {2,6});
+    assert(exec.size() == 1);
+    assert(exec.cpus(0) == std::vector<int>({2,6}));
+    assert(exec.numa_node(0) == 1);
+
+    test_affinity_executor(exec);
+  }
+
+  {
+    // one cpu of each L3 domain is allowed
+    affinity_executor exec(affinity_domain::l3_cache, topology, {5,3});
+    assert(exec.size() == 2);
+    assert(exec.cpus(0) == std::vector<int>({5}));
+    assert(exec.cpus(1) == std::vector<int>({3}));
+    assert(exec.numa_node(0) == 0);
+    assert(exec.numa_node(1) == 1);
+
+    test_affinity_executor(exec);
+  }
+
+  {
+    // no domain contains an allowed cpu, so the allowed cpus form a single domain
+    affinity_executor exec(affinity_domain::numa_node, topology, {100});
+    assert(exec.size() == 1);
+    assert(exec.cpus(0) == std::vector<int>({100}));
+
+    test_affinity_executor(exec);
+  }
+
+  {
+    // a cpu quota smaller than the allowed cpus limits the domains' threads, not the domains
+    affinity_executor exec(affinity_domain::numa_node, topology, {0,1,2,3,4,5,6,7}, 2);
+    assert(exec.size() == 2);
+    assert(exec.cpus(0) == std::vector<int>({0,1,4,5}));
+
+    test_affinity_executor(exec);
+  }
+
+  {
+    using agency::experimental::detail::affinity_executor_detail::domain_placement;
+
+    // without a binding quota, each cpu receives a thread pinned to it
+    assert(domain_placement({0,1}, 4, 0) == std::vector<std::vector<int>>({{0}, {1}}));
+    assert(domain_placement({0,1}, 4, 4) == std::vector<std::vector<int>>({{0}, {1}}));
+
+    // otherwise the domain receives its share of the quota, and at least one thread
+    assert(domain_placement({0,1,4,5}, 8, 2) == std::vector<std::vector<int>>({{0,1,4,5}}));
+    assert(domain_placement({0,1,4,5}, 8, 6) == std::vector<std::vector<int>>(3, std::vector<int>({0,1,4,5})));
+    assert(domain_placement({3}, 8, 2) == std::vector<std::vector<int>>({{3}}));
+  }
+}
+
+
+int main()
+{
+  test_parse_cpu_list();
+  test_discover();
+  test_restricted_cpus();
+
+  {
+    // the system's NUMA nodes
+    agency::experimental::affinity_executor exec;
+    assert(exec.size() <= agency::detail::system_topology().numa_nodes().size());
+
+    test_affinity_executor(exec);
+    test_domain_allocator(exec);
+  }
+
+  {
+    // the system's L3 domains
+    agency::experimental::affinity_executor exec(agency::experimental::affinity_domain::l3_cache);
+    assert(exec.size() <= agency::detail::system_topology().l3_domains().size());
+
+    test_affinity_executor(exec);
+  }
+
+  {
+    // a described topology with more domains than this machine may have
+    // cpus outside of the process's cpuset cannot be bound, but the executor must still execute
+    agency::detail::cpu_topology topology = agency::detail::cpu_topology::uniform(4);
+
+    std::vector<agency::detail::processing_unit> units = topology.processing_units();
+    units[2].numa_node = units[3].numa_node = 1;
+
+    agency::experimental::affinity_executor exec(agency::experimental::affinity_domain::numa_node, agency::detail::cpu_topology(units), {0,1,2,3});
+    assert(exec.size() == 2);
+    assert(exec.cpus(1) == std::vector<int>({2,3}));
+    assert(exec.numa_node(1) == 1);
+
+    test_affinity_executor(exec);
+    test_domain_allocator(exec);
+  }
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
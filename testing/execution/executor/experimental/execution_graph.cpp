@@ -0,0 +1,176 @@
+#include <agency/agency.hpp>
+#include <agency/execution/executor/experimental/execution_graph.hpp>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+
+
+struct fill
+{
+  template<class Agent>
+  void operator()(Agent& self, int* data, int value)
+  {
+    data[self.index()] = value;
+  }
+};
+
+
+struct increment
+{
+  template<class Agent>
+  void operator()(Agent& self, int* data)
+  {
+    data[self.index()] += 1;
+  }
+};
+
+
+struct read_element
+{
+  template<class Agent>
+  int operator()(Agent& self, const int* data)
+  {
+    return data[self.index()];
+  }
+};
+
+
+struct add_predecessor
+{
+  template<class Agent, class Container>
+  int operator()(Agent& self, Container& predecessor, int value)
+  {
+    return predecessor[self.index()] + value;
+  }
+};
+
+
+struct broadcast
+{
+  template<class Agent>
+  void operator()(Agent& self, int* results, int& shared_value)
+  {
+    if(self.index() == 0)
+    {
+      // each replay constructs a fresh shared parameter
+      assert(shared_value == 0);
+      shared_value = 7;
+    }
+
+    self.wait();
+
+    results[self.index()] = shared_value;
+  }
+};
+
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  using namespace agency;
+  using executor_type = typename ExecutionPolicy::executor_type;
+
+  static_assert(is_bulk_continuation_executor<experimental::graph_executor<executor_type>>::value,
+    "graph_executor should be a bulk continuation executor");
+
+  size_t n = 100;
+  std::vector<int> data(n, -1);
+
+  experimental::execution_graph graph;
+  auto exec = graph.capture(policy.executor());
+
+  // capture a chain of stages
+  auto stage1 = agency::bulk_async(policy(n).on(exec), fill(), data.data(), 0);
+  auto stage2 = agency::bulk_then(policy(n).on(exec), increment(), stage1, data.data());
+  auto stage3 = agency::bulk_then(policy(n).on(exec), read_element(), stage2, data.data());
+  auto stage4 = agency::bulk_then(policy(n).on(exec), add_predecessor(), stage3, 10);
+
+  assert(graph.size() == 4);
+
+  // nothing executes during capture
+  assert(data == std::vector<int>(n, -1));
+  assert(!stage4.is_ready());
+
+  for(int replay = 0; replay < 3; ++replay)
+  {
+    graph.replay();
+
+    assert(data == std::vector<int>(n, 1));
+
+    auto results = stage4.get();
+    assert(results.size() == n);
+
+    for(int x : results)
+    {
+      assert(x == 11);
+    }
+  }
+
+  graph.clear();
+  assert(graph.size() == 0);
+}
+
+
+void test_shared_parameters()
+{
+  using namespace agency;
+
+  size_t n = 4;
+  std::vector<int> results(n, 0);
+
+  experimental::execution_graph graph;
+  auto exec = graph.capture(concurrent_executor());
+
+  agency::bulk_async(con(n).on(exec), broadcast(), results.data(), share(0));
+
+  for(int replay = 0; replay < 2; ++replay)
+  {
+    std::fill(results.begin(), results.end(), 0);
+
+    graph.replay();
+
+    assert(results == std::vector<int>(n, 7));
+  }
+}
+
+
+void test_ready_predecessor()
+{
+  using namespace agency;
+
+  size_t n = 10;
+
+  experimental::execution_graph graph;
+  auto exec = graph.capture(sequenced_executor());
+
+  // a ready future's value is an input to every replay
+  std::vector<int> input(n, 5);
+  auto predecessor = experimental::graph_future<std::vector<int>>::make_ready(input);
+
+  auto result = agency::bulk_then(seq(n).on(exec), add_predecessor(), predecessor, 1);
+
+  graph.replay();
+
+  auto values = result.get();
+  for(int x : values)
+  {
+    assert(x == 6);
+  }
+}
+
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+  test_shared_parameters();
+  test_ready_predecessor();
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
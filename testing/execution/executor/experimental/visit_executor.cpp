@@ -0,0 +1,96 @@
+#include <agency/agency.hpp>
+#include <agency/execution/executor/experimental/visit_executor.hpp>
+#include <iostream>
+#include <typeinfo>
+#include <vector>
+#include <cassert>
+
+
+struct increment
+{
+  template<class Agent>
+  __AGENCY_ANNOTATION
+  void operator()(Agent& self, int* data)
+  {
+    data[self.index()] += 1;
+  }
+};
+
+
+// issues a batch of bulk_invokes through whichever executor it receives
+struct increment_many_times
+{
+  int* data;
+  size_t n;
+  size_t num_iterations;
+
+  template<class Executor>
+  const std::type_info* operator()(Executor& exec) const
+  {
+    for(size_t i = 0; i < num_iterations; ++i)
+    {
+      agency::bulk_invoke(agency::par(n).on(exec), increment(), data);
+    }
+
+    return &typeid(exec);
+  }
+};
+
+
+template<class VariantExecutor, class Executor>
+void test_alternative(Executor alternative)
+{
+  using namespace agency;
+
+  VariantExecutor exec = alternative;
+
+  size_t n = 100;
+  size_t num_iterations = 10;
+  std::vector<int> data(n, 0);
+
+  increment_many_times f{data.data(), n, num_iterations};
+
+  {
+    // the member function receives the active alternative
+    const std::type_info* type = exec.visit(f);
+    assert(*type == typeid(Executor));
+  }
+
+  {
+    // the free function does the same
+    const std::type_info* type = experimental::visit_executor(f, exec);
+    assert(*type == typeid(Executor));
+  }
+
+  {
+    // a const variant_executor yields a const alternative
+    const VariantExecutor& const_exec = exec;
+    const std::type_info* type = experimental::visit_executor(f, const_exec);
+    assert(*type == typeid(Executor));
+  }
+
+  {
+    // a non-variant executor is passed along unchanged
+    const std::type_info* type = experimental::visit_executor(f, alternative);
+    assert(*type == typeid(Executor));
+  }
+
+  assert(data == std::vector<int>(n, 4 * num_iterations));
+}
+
+
+int main()
+{
+  using namespace agency;
+
+  using executor_type = variant_executor<sequenced_executor, parallel_executor, concurrent_executor>;
+
+  test_alternative<executor_type>(sequenced_executor());
+  test_alternative<executor_type>(parallel_executor());
+  test_alternative<executor_type>(concurrent_executor());
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
@@ -0,0 +1,94 @@
+#include <agency/agency.hpp>
+#include <iostream>
+#include <vector>
+#include <cassert>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+
+
+struct increment
+{
+  template<class Agent>
+  void operator()(Agent& self, int* data)
+  {
+    data[self.index()] += 1;
+  }
+};
+
+
+void test(agency::omp::parallel_for_executor exec)
+{
+  using namespace agency;
+
+  static_assert(is_bulk_synchronous_executor<omp::parallel_for_executor>::value,
+    "omp::parallel_for_executor should be a bulk synchronous executor");
+
+  static_assert(detail::is_detected_exact<parallel_execution_tag, executor_execution_category_t, omp::parallel_for_executor>::value,
+    "omp::parallel_for_executor should have parallel_execution_tag execution_category");
+
+  assert(agency::unit_shape(exec) > 0);
+  assert(agency::max_shape_dimensions(exec) == std::numeric_limits<size_t>::max());
+
+  for(size_t n : {0, 1, 7, 1000, 10007})
+  {
+    std::vector<int> data(n, 0);
+
+    agency::bulk_invoke(omp::par(n).on(exec), increment(), data.data());
+
+    assert(data == std::vector<int>(n, 1));
+  }
+}
+
+
+void test_num_threads()
+{
+  using namespace agency;
+
+  omp::parallel_for_executor exec(omp::schedule_kind::static_, 0, 3);
+  assert(exec.num_threads() == 3);
+  assert(agency::unit_shape(exec) == 3);
+
+  std::vector<int> thread_ids(3, -1);
+  int* ids = thread_ids.data();
+
+  // with a static schedule and one iteration per thread, each iteration executes on a different thread
+  omp::parallel_for_executor one_per_thread(omp::schedule_kind::static_, 1, 3);
+  one_per_thread.bulk_sync_execute([=](size_t i, int&, int&)
+  {
+    ids[i] = omp_get_thread_num();
+  },
+  3,
+  []{ return 0; },
+  []{ return 0; });
+
+  // the runtime may provide fewer threads than requested only when dynamic adjustment is enabled
+  if(!omp_get_dynamic())
+  {
+    assert(thread_ids == std::vector<int>({0,1,2}));
+  }
+}
+#endif
+
+
+int main()
+{
+#ifdef _OPENMP
+  using namespace agency::omp;
+
+  test(parallel_for_executor());
+  test(parallel_for_executor(schedule_kind::static_, 16));
+  test(parallel_for_executor(schedule_kind::dynamic));
+  test(parallel_for_executor(schedule_kind::dynamic, 64, 2));
+  test(parallel_for_executor(schedule_kind::guided, 8));
+  test(parallel_for_executor(schedule_kind::automatic));
+  test(parallel_for_executor(schedule_kind::runtime));
+
+  test_num_threads();
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
@@ -0,0 +1,283 @@
+#include <agency/agency.hpp>
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <cassert>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+
+
+struct fill
+{
+  template<class Agent>
+  void operator()(Agent& self, int* data, int value)
+  {
+    data[self.index()] = value;
+  }
+};
+
+
+struct add_predecessor
+{
+  template<class Agent>
+  void operator()(Agent& self, int* data, int value)
+  {
+    data[self.index()] += value;
+  }
+};
+
+
+struct throw_from_agent
+{
+  template<class Agent>
+  void operator()(Agent& self)
+  {
+    if(self.index() == 3)
+    {
+      throw std::runtime_error("error");
+    }
+  }
+};
+
+
+struct add_predecessor_and_return
+{
+  template<class Agent>
+  int operator()(Agent&, int& predecessor)
+  {
+    return predecessor + 1;
+  }
+};
+
+
+struct add_one
+{
+  int operator()(int x) const
+  {
+    return x + 1;
+  }
+};
+
+
+struct throw_error
+{
+  int operator()(int) const
+  {
+    throw std::runtime_error("error");
+  }
+};
+
+
+void test_executor_traits()
+{
+  using namespace agency;
+
+  static_assert(is_bulk_continuation_executor<omp::task_executor>::value,
+    "omp::task_executor should be a bulk continuation executor");
+
+  static_assert(detail::is_detected_exact<parallel_execution_tag, executor_execution_category_t, omp::task_executor>::value,
+    "omp::task_executor should have parallel_execution_tag execution_category");
+
+  static_assert(detail::is_detected_exact<omp::task_future<int>, executor_future_t, omp::task_executor, int>::value,
+    "omp::task_executor should have omp::task_future future");
+
+  assert(agency::unit_shape(omp::task_executor()) > 0);
+}
+
+
+void test_task_future()
+{
+  using namespace agency;
+
+  omp::task_future<int> ready = omp::task_future<int>::make_ready(13);
+  assert(ready.valid());
+  assert(ready.is_ready());
+
+  omp::task_future<int> continuation = ready.then(add_one());
+  assert(!ready.valid());
+  assert(continuation.get() == 14);
+  assert(!continuation.valid());
+
+  // exceptions propagate through continuations
+  omp::task_future<int> exceptional = omp::task_future<int>::make_ready(0).then(throw_error()).then(add_one());
+
+  bool caught = false;
+  try
+  {
+    exceptional.get();
+  }
+  catch(std::runtime_error&)
+  {
+    caught = true;
+  }
+
+  assert(caught);
+}
+
+
+// submits a pipeline of dependent bulk operations
+void pipeline(int* data, size_t n)
+{
+  using namespace agency;
+
+  omp::task_executor exec;
+
+  // fill the data, then add to it twice
+  auto first = agency::bulk_async(par(n).on(exec), fill(), data, 1);
+  auto second = agency::bulk_then(par(n).on(exec), add_predecessor(), first, data, 2);
+  auto third = agency::bulk_then(par(n).on(exec), add_predecessor(), second, data, 3);
+
+  third.wait();
+}
+
+
+void test_pipeline_outside_parallel_region()
+{
+  size_t n = 1000;
+  std::vector<int> data(n, 0);
+
+  pipeline(data.data(), n);
+
+  assert(data == std::vector<int>(n, 6));
+}
+
+
+void test_pipeline_inside_parallel_region()
+{
+  size_t num_pipelines = 8;
+  size_t n = 1000;
+  std::vector<std::vector<int>> data(num_pipelines, std::vector<int>(n, 0));
+
+  #pragma omp parallel
+  #pragma omp single
+  {
+    for(size_t i = 0; i < num_pipelines; ++i)
+    {
+      int* ptr = data[i].data();
+
+      // each pipeline is a task, so that the pipelines may execute concurrently
+      #pragma omp task firstprivate(ptr, n)
+      {
+        pipeline(ptr, n);
+      }
+    }
+  }
+
+  for(auto& d : data)
+  {
+    assert(d == std::vector<int>(n, 6));
+  }
+}
+
+
+void test_bulk_then_with_result()
+{
+  using namespace agency;
+
+  size_t n = 100;
+
+  #pragma omp parallel
+  #pragma omp single
+  {
+    omp::task_executor exec;
+
+    omp::task_future<int> predecessor = omp::task_future<int>::make_ready(7);
+
+    // a legacy OpenMP task runs alongside the agency continuation
+    int legacy_result = 0;
+    #pragma omp task shared(legacy_result)
+    {
+      legacy_result = 42;
+    }
+
+    auto results = agency::bulk_then(par(n).on(exec), add_predecessor_and_return(), predecessor);
+
+    auto values = results.get();
+    assert(values.size() == n);
+    for(int x : values)
+    {
+      assert(x == 8);
+    }
+
+    #pragma omp taskwait
+    assert(legacy_result == 42);
+  }
+}
+
+
+void test_foreign_predecessor()
+{
+  using namespace agency;
+
+  omp::task_executor exec;
+
+  std::future<int> predecessor = agency::detail::make_ready_future(41);
+
+  auto results = agency::bulk_then(par(10).on(exec), add_predecessor_and_return(), predecessor);
+
+  auto values = results.get();
+  assert(values.size() == 10);
+  for(int x : values)
+  {
+    assert(x == 42);
+  }
+}
+
+
+bool bulk_async_throws(size_t n)
+{
+  using namespace agency;
+
+  omp::task_executor exec;
+
+  auto result = agency::bulk_async(par(n).on(exec), throw_from_agent());
+
+  try
+  {
+    result.get();
+  }
+  catch(std::runtime_error&)
+  {
+    return true;
+  }
+
+  return false;
+}
+
+
+void test_exception_from_agent()
+{
+  // an agent's exception is delivered through the future rather than escaping the taskloop
+  assert(bulk_async_throws(100));
+
+  bool caught = false;
+
+  #pragma omp parallel
+  #pragma omp single
+  {
+    caught = bulk_async_throws(100);
+  }
+
+  assert(caught);
+}
+#endif
+
+
+int main()
+{
+#ifdef _OPENMP
+  test_executor_traits();
+  test_task_future();
+  test_pipeline_outside_parallel_region();
+  test_pipeline_inside_parallel_region();
+  test_bulk_then_with_result();
+  test_foreign_predecessor();
+  test_exception_from_agent();
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
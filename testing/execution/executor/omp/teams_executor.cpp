@@ -0,0 +1,159 @@
+#include <agency/agency.hpp>
+#include <iostream>
+#include <vector>
+#include <cassert>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+
+
+struct increment
+{
+  template<class Agent>
+  void operator()(Agent& self, int* data)
+  {
+    size_t i = self.outer().index() * self.inner().group_size() + self.inner().index();
+    data[i] += 1;
+  }
+};
+
+
+template<class InnerExecutor, class InnerPolicy>
+void test(InnerPolicy inner_policy)
+{
+  using namespace agency;
+
+  using executor_type = omp::teams_executor<InnerExecutor>;
+
+  static_assert(is_bulk_synchronous_executor<executor_type>::value,
+    "omp::teams_executor should be a bulk synchronous executor");
+
+  static_assert(executor_execution_depth<executor_type>::value == 2,
+    "omp::teams_executor should have execution_depth == 2");
+
+  // nested OpenMP policies execute through teams_executor
+  using policy_type = decltype(omp::par(1, inner_policy(1)));
+  static_assert(std::is_base_of<executor_type, typename policy_type::executor_type>::value,
+    "nested OpenMP policies should execute through omp::teams_executor");
+
+  for(size_t num_teams : {0, 1, 3, 100})
+  {
+    for(size_t team_size : {0, 1, 13, 64})
+    {
+      std::vector<int> data(num_teams * team_size, 0);
+
+      agency::bulk_invoke(omp::par(num_teams, inner_policy(team_size)), increment(), data.data());
+
+      assert(data == std::vector<int>(num_teams * team_size, 1));
+    }
+  }
+
+  {
+    // the outer executor's schedule is used to distribute teams
+    omp::parallel_for_executor outer(omp::schedule_kind::dynamic, 2);
+    executor_type exec(outer);
+    assert(exec.outer_executor().kind() == omp::schedule_kind::dynamic);
+
+    size_t num_teams = 10;
+    size_t team_size = 16;
+    std::vector<int> data(num_teams * team_size, 0);
+
+    agency::bulk_invoke(par(num_teams, unseq(team_size)).on(exec), increment(), data.data());
+
+    assert(data == std::vector<int>(num_teams * team_size, 1));
+  }
+
+  {
+    // flattening a teams_executor yields a one-dimensional executor
+    flattened_executor<executor_type> exec;
+
+    size_t n = 1000;
+    std::vector<int> data(n, 0);
+    int* ptr = data.data();
+
+    agency::bulk_sync_execute(exec, [=](size_t i, int&, int&)
+    {
+      ptr[i] += 1;
+    },
+    n,
+    []{ return 0; },
+    []{ return 0; });
+
+    assert(data == std::vector<int>(n, 1));
+  }
+}
+
+
+struct make_par
+{
+  agency::omp::parallel_execution_policy operator()(size_t n) const
+  {
+    return agency::omp::par(n);
+  }
+};
+
+
+struct make_unseq
+{
+  agency::omp::unsequenced_execution_policy operator()(size_t n) const
+  {
+    return agency::omp::unseq(n);
+  }
+};
+
+
+void test_shared_parameters()
+{
+  using namespace agency;
+
+  size_t num_teams = 4;
+  size_t team_size = 8;
+
+  omp::teams_executor<> exec;
+
+  std::vector<int> team_counts(num_teams, 0);
+  int* counts = team_counts.data();
+
+  int total = exec.bulk_sync_execute([=](const omp::teams_executor<>::index_type& idx, int& result, int& outer_shared, int& inner_shared)
+  {
+    int team_arrivals;
+    #pragma omp atomic capture
+    team_arrivals = ++inner_shared;
+
+    #pragma omp atomic
+    outer_shared += 1;
+
+    #pragma omp atomic
+    result += 1;
+
+    // each team has its own inner shared parameter, so exactly one agent of each team observes a full count
+    if(team_arrivals == static_cast<int>(team_size))
+    {
+      counts[agency::get<0>(idx)] += 1;
+    }
+  },
+  omp::teams_executor<>::shape_type(num_teams, team_size),
+  []{ return 0; },
+  []{ return 0; },
+  []{ return 0; });
+
+  assert(total == static_cast<int>(num_teams * team_size));
+  assert(team_counts == std::vector<int>(num_teams, 1));
+}
+#endif
+
+
+int main()
+{
+#ifdef _OPENMP
+  test<agency::omp::parallel_for_executor>(make_par());
+  test<agency::omp::simd_executor>(make_unseq());
+
+  test_shared_parameters();
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
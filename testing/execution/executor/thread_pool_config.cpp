@@ -0,0 +1,255 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cassert>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <set>
+
+// XXX use parallel_executor.hpp instead of thread_pool.hpp due to circular #inclusion problems
+#include <agency/execution/executor/parallel_executor.hpp>
+#include <agency/agency.hpp>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+
+void write_file(const std::string& filename, const std::string& contents)
+{
+  std::string directory = filename.substr(0, filename.rfind('/'));
+  std::string command = "mkdir -p " + directory;
+  assert(std::system(command.c_str()) == 0);
+
+  std::ofstream file(filename.c_str());
+  file << contents << std::endl;
+}
+
+
+void remove_directory(const std::string& directory)
+{
+  std::string command = "rm -rf " + directory;
+  assert(std::system(command.c_str()) == 0);
+}
+
+
+void test_cgroup_cpu_limit()
+{
+  using agency::detail::cgroup_cpu_limit;
+
+  std::string root = "/tmp/agency_thread_pool_config_" + std::to_string(getpid());
+
+  // no cgroup files means no limit
+  assert(cgroup_cpu_limit(root + "/sys", root + "/proc") == 0);
+
+  // v2 without a quota
+  write_file(root + "/sys/fs/cgroup/cpu.max", "max 100000");
+  assert(cgroup_cpu_limit(root + "/sys", root + "/proc") == 0);
+
+  // v2 with a fractional quota rounds up
+  write_file(root + "/sys/fs/cgroup/cpu.max", "150000 100000");
+  assert(cgroup_cpu_limit(root + "/sys", root + "/proc") == 2);
+
+  // v2 prefers the process's own cgroup
+  write_file(root + "/proc/self/cgroup", "0::/service");
+  write_file(root + "/sys/fs/cgroup/service/cpu.max", "300000 100000");
+  assert(cgroup_cpu_limit(root + "/sys", root + "/proc") == 3);
+
+  remove_directory(root);
+
+  // v1
+  write_file(root + "/sys/fs/cgroup/cpu,cpuacct/cpu.cfs_quota_us", "50000");
+  write_file(root + "/sys/fs/cgroup/cpu,cpuacct/cpu.cfs_period_us", "100000");
+  assert(cgroup_cpu_limit(root + "/sys", root + "/proc") == 1);
+
+  write_file(root + "/sys/fs/cgroup/cpu,cpuacct/cpu.cfs_quota_us", "-1");
+  assert(cgroup_cpu_limit(root + "/sys", root + "/proc") == 0);
+
+  remove_directory(root);
+}
+
+
+void test_placement()
+{
+  using namespace agency::detail;
+
+  // four cpus on two cores: cpus 2 & 3 are the second hardware threads of cores 0 & 1
+  std::vector<processing_unit> units = cpu_topology::uniform(4).processing_units();
+  units[2].core = 0;
+  units[2].smt_rank = 1;
+  units[3].core = 1;
+  units[3].smt_rank = 1;
+  cpu_topology topology(units);
+
+  {
+    // by default, threads are not bound
+    thread_pool_config config;
+    config.num_threads = 3;
+
+    std::vector<std::vector<int>> placement = config.placement(topology, 0);
+    assert(placement.size() == 3);
+    for(auto& cpus : placement) assert(cpus.empty());
+  }
+
+  {
+    // pinned threads are assigned cpus round robin
+    thread_pool_config config;
+    config.cpus = {0,1,2,3};
+    config.pin_threads = true;
+
+    std::vector<std::vector<int>> placement = config.placement(topology, 0);
+    assert(placement == std::vector<std::vector<int>>({{0},{1},{2},{3}}));
+  }
+
+  {
+    // idle SMT siblings leave cpus 2 & 3 unused
+    thread_pool_config config;
+    config.cpus = {0,1,2,3};
+    config.idle_smt_siblings = true;
+
+    std::vector<std::vector<int>> placement = config.placement(topology, 0);
+    assert(placement == std::vector<std::vector<int>>({{0,1},{0,1}}));
+
+    config.pin_threads = true;
+    placement = config.placement(topology, 0);
+    assert(placement == std::vector<std::vector<int>>({{0},{1}}));
+  }
+
+  {
+    // a cpu quota limits the default number of threads
+    thread_pool_config config;
+    config.cpus = {0,1,2,3};
+
+    assert(config.placement(topology, 2).size() == 2);
+    assert(config.placement(topology, 8).size() == 4);
+
+    // an explicit number of threads ignores the quota
+    config.num_threads = 6;
+    assert(config.placement(topology, 2).size() == 6);
+  }
+}
+
+
+void test_from_environment()
+{
+  using namespace agency::detail;
+
+  setenv("AGENCY_NUM_THREADS", "3", 1);
+  setenv("AGENCY_CPUS", "0-1,4", 1);
+  setenv("AGENCY_PIN_THREADS", "1", 1);
+  setenv("AGENCY_IDLE_SMT_SIBLINGS", "false", 1);
+
+  thread_pool_config config = thread_pool_config::from_environment();
+  assert(config.num_threads == 3);
+  assert(config.cpus == std::vector<int>({0,1,4}));
+  assert(config.pin_threads);
+  assert(!config.idle_smt_siblings);
+
+  unsetenv("AGENCY_NUM_THREADS");
+  unsetenv("AGENCY_CPUS");
+  unsetenv("AGENCY_PIN_THREADS");
+  unsetenv("AGENCY_IDLE_SMT_SIBLINGS");
+
+  // environment variables which are absent leave the given configuration alone
+  thread_pool_config defaults;
+  defaults.num_threads = 5;
+  config = thread_pool_config::from_environment(defaults);
+  assert(config.num_threads == 5);
+  assert(config.cpus.empty());
+  assert(!config.pin_threads);
+}
+
+
+void test_system_thread_pool()
+{
+  using namespace agency::detail;
+
+  thread_pool_config config;
+  config.num_threads = 2;
+
+  // the system pool may be configured before its first use, but not after
+  assert(configure_system_thread_pool(config));
+  assert(system_thread_pool().size() == 2);
+  assert(!configure_system_thread_pool(thread_pool_config()));
+  assert(system_thread_pool().size() == 2);
+
+  agency::parallel_executor exec;
+  assert(agency::unit_shape(exec) == 2);
+}
+
+
+void test_named_thread_pools()
+{
+  using namespace agency::detail;
+
+  thread_pool_config config;
+  config.num_threads = 3;
+
+  std::shared_ptr<thread_pool> io = named_thread_pool("io", config);
+  assert(io->size() == 3);
+
+  // the same name yields the same pool, regardless of config
+  assert(named_thread_pool("io") == io);
+
+  // a different name yields a different pool
+  std::shared_ptr<thread_pool> compute = named_thread_pool("compute", config);
+  assert(compute != io);
+
+  // executors submit work to their own pool
+  std::mutex mutex;
+  std::set<std::thread::id> ids;
+
+  parallel_thread_pool_executor exec = make_parallel_thread_pool_executor(io);
+  assert(agency::unit_shape(exec) == 3);
+
+  agency::bulk_invoke(agency::par(30).on(exec), [&](agency::parallel_agent&)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ids.insert(std::this_thread::get_id());
+  });
+
+  assert(ids.size() <= 3);
+  assert(ids.count(std::this_thread::get_id()) == 0);
+}
+
+
+void test_pinned_pool()
+{
+#if defined(__linux__)
+  using namespace agency::detail;
+
+  int cpu = this_process_cpus().back();
+
+  thread_pool_config config;
+  config.cpus = {cpu};
+  config.num_threads = 2;
+  config.pin_threads = true;
+
+  thread_pool pool(config);
+  assert(pool.size() == 2);
+
+  for(int i = 0; i < 10; ++i)
+  {
+    assert(pool.async([]{ return sched_getcpu(); }).get() == cpu);
+  }
+#endif
+}
+
+
+int main()
+{
+  test_cgroup_cpu_limit();
+  test_placement();
+  test_from_environment();
+  test_system_thread_pool();
+  test_named_thread_pools();
+  test_pinned_pool();
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
@@ -0,0 +1,215 @@
+#include <agency/agency.hpp>
+#include <agency/experimental.hpp>
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+using index2 = agency::point<size_t,2>;
+using index3 = agency::point<size_t,3>;
+
+template<class T, class Layout>
+void fill_2d(agency::experimental::ndarray<T,2,agency::allocator<T>,Layout>& array)
+{
+  for(size_t i = 0; i < array.shape()[0]; ++i)
+  {
+    for(size_t j = 0; j < array.shape()[1]; ++j)
+    {
+      array[index2{i,j}] = T(1000 * i + j);
+    }
+  }
+}
+
+template<class T, class Layout1, class Layout2, class ExecutionPolicy>
+void test_transpose(ExecutionPolicy policy, size_t m, size_t n)
+{
+  using namespace agency::experimental;
+
+  ndarray<T,2,agency::allocator<T>,Layout1> src(index2{m,n});
+  fill_2d(src);
+
+  ndarray<T,2,agency::allocator<T>,Layout2> dst(index2{n,m}, T(-1));
+
+  // transpose from a const view
+  const auto& const_src = src;
+  transpose(policy, const_src.all(), dst.all());
+
+  for(size_t i = 0; i < m; ++i)
+  {
+    for(size_t j = 0; j < n; ++j)
+    {
+      assert((dst[index2{j,i}] == src[index2{i,j}]));
+    }
+  }
+}
+
+template<class T, class ExecutionPolicy>
+void test_transposes(ExecutionPolicy policy)
+{
+  using namespace agency::experimental;
+
+  // shapes which are and are not multiples of the tile and SIMD block extents
+  size_t shapes[][2] = {{1,1}, {1,37}, {37,1}, {8,8}, {64,64}, {67,45}, {100,259}};
+
+  for(auto& shape : shapes)
+  {
+    test_transpose<T,row_major,row_major>(policy, shape[0], shape[1]);
+    test_transpose<T,row_major,column_major>(policy, shape[0], shape[1]);
+    test_transpose<T,column_major,row_major>(policy, shape[0], shape[1]);
+    test_transpose<T,padded_row_major<16>,padded_row_major<8>>(policy, shape[0], shape[1]);
+  }
+}
+
+template<class ExecutionPolicy>
+void test_layout_conversion(ExecutionPolicy policy)
+{
+  using namespace agency::experimental;
+
+  ndarray<double,2> src(index2{70,90});
+  fill_2d(src);
+
+  // convert to column-major
+  ndarray<double,2,agency::allocator<double>,column_major> dst(src.shape());
+  copy(policy, src.all(), dst.all());
+
+  assert((dst.shape() == src.shape()));
+  for(size_t i = 0; i < 70; ++i)
+  {
+    for(size_t j = 0; j < 90; ++j)
+    {
+      assert((dst[index2{i,j}] == src[index2{i,j}]));
+
+      // column-major storage is the transpose of row-major storage
+      assert((dst.data()[j * 70 + i] == src[index2{i,j}]));
+    }
+  }
+
+  // convert back, with a change of element type
+  ndarray<float,2> back(index2{70,90});
+  copy(policy, dst.all(), back.all());
+
+  for(size_t i = 0; i < 70; ++i)
+  {
+    for(size_t j = 0; j < 90; ++j)
+    {
+      assert((back[index2{i,j}] == float(src[index2{i,j}])));
+    }
+  }
+}
+
+template<class ExecutionPolicy>
+void test_subarray_copy(ExecutionPolicy policy)
+{
+  using namespace agency::experimental;
+
+  ndarray<int,2> src(index2{50,60});
+  fill_2d(src);
+
+  // copy the transpose of a subarray into a subarray
+  ndarray<int,2> dst(index2{60,50}, -1);
+  transpose(policy, subarray(src.all(), index2{5,7}, index2{45,52}), subarray(dst.all(), index2{3,4}, index2{48,44}));
+
+  for(size_t i = 0; i < 60; ++i)
+  {
+    for(size_t j = 0; j < 50; ++j)
+    {
+      bool inside = i >= 3 && i < 48 && j >= 4 && j < 44;
+      int expected = inside ? src[index2{j - 4 + 5, i - 3 + 7}] : -1;
+
+      assert((dst[index2{i,j}] == expected));
+    }
+  }
+}
+
+template<class ExecutionPolicy>
+void test_permute_axes(ExecutionPolicy policy)
+{
+  using namespace agency::experimental;
+
+  index3 shape{13,40,35};
+
+  ndarray<std::int64_t,3> src(shape);
+  for(size_t i = 0; i < shape[0]; ++i)
+  {
+    for(size_t j = 0; j < shape[1]; ++j)
+    {
+      for(size_t k = 0; k < shape[2]; ++k)
+      {
+        src[index3{i,j,k}] = 10000 * i + 100 * j + k;
+      }
+    }
+  }
+
+  agency::array<size_t,3> permutations[] = {{0,1,2}, {0,2,1}, {1,0,2}, {1,2,0}, {2,0,1}, {2,1,0}};
+
+  for(auto& axes : permutations)
+  {
+    index3 permuted_shape{shape[axes[0]], shape[axes[1]], shape[axes[2]]};
+    ndarray<std::int64_t,3> dst(permuted_shape);
+
+    permute_axes(policy, src.all(), axes, dst.all());
+
+    for(size_t i = 0; i < permuted_shape[0]; ++i)
+    {
+      for(size_t j = 0; j < permuted_shape[1]; ++j)
+      {
+        for(size_t k = 0; k < permuted_shape[2]; ++k)
+        {
+          index3 idx{i,j,k};
+
+          index3 original;
+          original[axes[0]] = i;
+          original[axes[1]] = j;
+          original[axes[2]] = k;
+
+          assert((dst[idx] == src[original]));
+        }
+      }
+    }
+  }
+}
+
+template<class ExecutionPolicy>
+void test_empty(ExecutionPolicy policy)
+{
+  using namespace agency::experimental;
+
+  ndarray<float,2> src(index2{0,10});
+  ndarray<float,2> dst(index2{10,0});
+
+  transpose(policy, src.all(), dst.all());
+}
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  test_transposes<float>(policy);
+  test_transposes<double>(policy);
+  test_transposes<int>(policy);
+  test_transposes<std::int64_t>(policy);
+  test_transposes<char>(policy);
+
+  test_layout_conversion(policy);
+  test_subarray_copy(policy);
+  test_permute_axes(policy);
+  test_empty(policy);
+}
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
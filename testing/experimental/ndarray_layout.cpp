@@ -0,0 +1,268 @@
+#include <agency/experimental/ndarray.hpp>
+#include <iostream>
+#include <cassert>
+#include <set>
+#include <vector>
+
+template<class Layout>
+void test_layout_is_injective(agency::point<size_t,2> shape)
+{
+  using namespace agency::experimental;
+
+  ndarray<int,2,agency::allocator<int>,Layout> array(shape);
+
+  assert(array.shape() == shape);
+  assert(array.size() == shape[0] * shape[1]);
+  assert(array.span_size() >= array.size());
+
+  // each index has its own element within the span
+  std::set<size_t> offsets;
+  for(size_t i = 0; i < shape[0]; ++i)
+  {
+    for(size_t j = 0; j < shape[1]; ++j)
+    {
+      size_t offset = &array[{i,j}] - array.data();
+
+      assert(offset < array.span_size());
+      assert(offsets.insert(offset).second);
+
+      array[{i,j}] = int(i * shape[1] + j);
+    }
+  }
+
+  for(size_t i = 0; i < shape[0]; ++i)
+  {
+    for(size_t j = 0; j < shape[1]; ++j)
+    {
+      assert((array[{i,j}] == int(i * shape[1] + j)));
+    }
+  }
+}
+
+template<class Layout>
+void test_layout_is_injective(agency::point<size_t,3> shape)
+{
+  using namespace agency::experimental;
+
+  ndarray<int,3,agency::allocator<int>,Layout> array(shape);
+
+  assert(array.size() == shape[0] * shape[1] * shape[2]);
+
+  std::set<size_t> offsets;
+  for(size_t i = 0; i < shape[0]; ++i)
+  {
+    for(size_t j = 0; j < shape[1]; ++j)
+    {
+      for(size_t k = 0; k < shape[2]; ++k)
+      {
+        size_t offset = &array[{i,j,k}] - array.data();
+
+        assert(offset < array.span_size());
+        assert(offsets.insert(offset).second);
+      }
+    }
+  }
+}
+
+void test_row_major()
+{
+  using namespace agency::experimental;
+
+  std::vector<int> data(12);
+  ndarray_ref<int,2> ref(data.data(), {3,4});
+
+  assert((&ref[{0,0}] == data.data()));
+  assert((&ref[{1,2}] == data.data() + 1 * 4 + 2));
+  assert((&ref[{2,3}] == data.data() + 11));
+  assert(ref.span_size() == 12);
+  assert(ref.end() - ref.begin() == 12);
+
+  // tuple shapes use the same layout as points
+  using shape_type = agency::tuple<size_t,size_t>;
+  basic_ndarray_ref<int,shape_type> tuple_ref(data.data(), shape_type(3,4));
+  assert(&tuple_ref[shape_type(1,2)] == data.data() + 6);
+}
+
+void test_column_major()
+{
+  using namespace agency::experimental;
+
+  std::vector<int> data(12);
+  ndarray_ref<int,2,column_major> ref(data.data(), {3,4});
+
+  assert((&ref[{1,2}] == data.data() + 2 * 3 + 1));
+  assert((&ref[{2,3}] == data.data() + 11));
+  assert(ref.span_size() == 12);
+}
+
+void test_strided()
+{
+  using namespace agency::experimental;
+
+  std::vector<int> data(100);
+
+  // by default, the strides are row-major
+  ndarray_ref<int,2,strided> row_major_ref(data.data(), {3,4});
+  assert(row_major_ref.mapping().stride(0) == 4);
+  assert(row_major_ref.mapping().stride(1) == 1);
+  assert((&row_major_ref[{1,2}] == data.data() + 6));
+  assert(row_major_ref.span_size() == 12);
+
+  // view every other column of a 5x10 array
+  using mapping_type = strided::mapping<agency::point<size_t,2>>;
+  ndarray_ref<int,2,strided> every_other_column(data.data(), mapping_type({5,5}, {10,2}));
+
+  assert((&every_other_column[{3,4}] == data.data() + 3 * 10 + 4 * 2));
+  assert(every_other_column.span_size() == 4 * 10 + 4 * 2 + 1);
+
+  // view a transposed 5x10 array
+  ndarray_ref<int,2,strided> transposed(data.data(), mapping_type({10,5}, {1,10}));
+  assert((&transposed[{7,3}] == data.data() + 3 * 10 + 7));
+}
+
+void test_padded_row_major()
+{
+  using namespace agency::experimental;
+
+  ndarray<int,2,agency::allocator<int>,padded_row_major<8>> array({3,5});
+
+  assert(array.mapping().leading_dimension() == 8);
+  assert(array.span_size() == 3 * 8);
+  assert((&array[{2,4}] - array.data() == 2 * 8 + 4));
+
+  // an explicit leading dimension
+  std::vector<int> data(100);
+  using mapping_type = padded_row_major<>::mapping<agency::point<size_t,2>>;
+  ndarray_ref<int,2,padded_row_major<>> ref(data.data(), mapping_type({4,3}, 10));
+  assert((&ref[{3,2}] == data.data() + 32));
+  assert(ref.span_size() == 40);
+}
+
+void test_tiled()
+{
+  using namespace agency::experimental;
+
+  std::vector<int> data(64);
+  ndarray_ref<int,2,tiled<2,4>> ref(data.data(), {4,8});
+
+  // each 2x4 tile is contiguous
+  assert((&ref[{0,3}] == data.data() + 3));
+  assert((&ref[{1,0}] == data.data() + 4));
+  assert((&ref[{0,4}] == data.data() + 8));
+  assert((&ref[{2,0}] == data.data() + 16));
+  assert((&ref[{3,7}] == data.data() + 31));
+  assert(ref.span_size() == 32);
+
+  // partial tiles are padded
+  ndarray_ref<int,2,tiled<2,4>> partial(data.data(), {3,5});
+  assert(partial.span_size() == 4 * 8);
+}
+
+void test_morton()
+{
+  using namespace agency::experimental;
+
+  std::vector<int> data(64);
+  ndarray_ref<int,2,morton> ref(data.data(), {4,4});
+
+  assert((&ref[{0,1}] == data.data() + 1));
+  assert((&ref[{1,0}] == data.data() + 2));
+  assert((&ref[{1,1}] == data.data() + 3));
+  assert((&ref[{0,2}] == data.data() + 4));
+  assert((&ref[{2,0}] == data.data() + 8));
+  assert((&ref[{3,3}] == data.data() + 15));
+  assert(ref.span_size() == 16);
+
+  ndarray_ref<int,3,morton> ref3(data.data(), {4,4,4});
+  assert((&ref3[{0,0,1}] == data.data() + 1));
+  assert((&ref3[{0,1,0}] == data.data() + 2));
+  assert((&ref3[{1,0,0}] == data.data() + 4));
+  assert((&ref3[{3,3,3}] == data.data() + 63));
+}
+
+template<class Layout>
+void test_construct_and_iterate(agency::point<size_t,2> shape)
+{
+  using namespace agency::experimental;
+
+  std::vector<int> src(shape[0] * shape[1]);
+  for(size_t i = 0; i < src.size(); ++i)
+  {
+    src[i] = int(i);
+  }
+
+  // elements are constructed from the source in the lexicographic order of their indices
+  ndarray<int,2,agency::allocator<int>,Layout> array(src.data(), shape);
+
+  for(size_t i = 0; i < shape[0]; ++i)
+  {
+    for(size_t j = 0; j < shape[1]; ++j)
+    {
+      assert((array[{i,j}] == src[i * shape[1] + j]));
+    }
+  }
+
+  // iteration visits each element once, in the same order, and skips padding
+  assert(size_t(array.end() - array.begin()) == array.size());
+  assert(std::vector<int>(array.begin(), array.end()) == src);
+
+  // copies have the same elements
+  ndarray<int,2,agency::allocator<int>,Layout> copy = array;
+  assert((copy[{shape[0] - 1, shape[1] - 1}] == src.back()));
+  assert(copy == array);
+  assert(array == src);
+
+  copy[{0,0}] = -1;
+  assert(!(copy == array));
+
+  // a value fills every element
+  ndarray<int,2,agency::allocator<int>,Layout> filled(shape, 7);
+  for(int x : filled)
+  {
+    assert(x == 7);
+  }
+}
+
+int main()
+{
+  using namespace agency::experimental;
+
+  test_row_major();
+  test_column_major();
+  test_strided();
+  test_padded_row_major();
+  test_tiled();
+  test_morton();
+
+  for(auto shape : {agency::point<size_t,2>{0,0}, agency::point<size_t,2>{1,1}, agency::point<size_t,2>{7,13}, agency::point<size_t,2>{16,16}})
+  {
+    test_layout_is_injective<row_major>(shape);
+    test_layout_is_injective<column_major>(shape);
+    test_layout_is_injective<strided>(shape);
+    test_layout_is_injective<padded_row_major<8>>(shape);
+    test_layout_is_injective<tiled<4,4>>(shape);
+    test_layout_is_injective<morton>(shape);
+  }
+
+  for(auto shape : {agency::point<size_t,2>{1,1}, agency::point<size_t,2>{3,3}, agency::point<size_t,2>{7,13}})
+  {
+    test_construct_and_iterate<row_major>(shape);
+    test_construct_and_iterate<column_major>(shape);
+    test_construct_and_iterate<strided>(shape);
+    test_construct_and_iterate<padded_row_major<64>>(shape);
+    test_construct_and_iterate<tiled<4,4>>(shape);
+    test_construct_and_iterate<morton>(shape);
+  }
+
+  agency::point<size_t,3> shape3{3,5,7};
+  test_layout_is_injective<row_major>(shape3);
+  test_layout_is_injective<column_major>(shape3);
+  test_layout_is_injective<strided>(shape3);
+  test_layout_is_injective<padded_row_major<4>>(shape3);
+  test_layout_is_injective<tiled<2,2,4>>(shape3);
+  test_layout_is_injective<morton>(shape3);
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
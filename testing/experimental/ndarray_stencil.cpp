@@ -0,0 +1,262 @@
+#include <agency/agency.hpp>
+#include <agency/experimental.hpp>
+#include <iostream>
+#include <cassert>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+using index2 = agency::point<size_t,2>;
+using index3 = agency::point<size_t,3>;
+
+using namespace agency::experimental;
+
+
+struct five_point
+{
+  int operator()(const stencil_neighborhood<int,2>& n) const
+  {
+    return (n(-1,0) + n(1,0) + n(0,-1) + n(0,1) + 4 * n(0,0)) / 8;
+  }
+};
+
+
+// a radius-2 cross which also depends on each point's index
+struct nine_point_cross
+{
+  int operator()(const stencil_neighborhood<int,2>& n) const
+  {
+    int sum = 0;
+    for(std::ptrdiff_t k = 1; k <= 2; ++k)
+    {
+      sum += n(-k,0) + n(k,0) + n(0,-k) + n(0,k);
+    }
+
+    return (sum + n.center()) / 9 + int(n.index()[0] % 3);
+  }
+};
+
+
+struct seven_point
+{
+  int operator()(const stencil_neighborhood<int,3>& n) const
+  {
+    using offset = stencil_neighborhood<int,3>::offset_type;
+
+    return (n[offset{{-1,0,0}}] + n[offset{{1,0,0}}] +
+            n(0,-1,0) + n(0,1,0) +
+            n(0,0,-1) + n(0,0,1) + 2 * n(0,0,0)) / 8;
+  }
+};
+
+
+// applies a kernel to every interior point of a rank-2 array one point at a time
+template<class Kernel, class Array>
+void reference_step_2d(Kernel kernel, size_t radius, const Array& src, Array& dst)
+{
+  auto shape = src.shape();
+
+  for(size_t i = 0; i < shape[0]; ++i)
+  {
+    for(size_t j = 0; j < shape[1]; ++j)
+    {
+      bool interior = i >= radius && i + radius < shape[0] && j >= radius && j + radius < shape[1];
+
+      if(interior)
+      {
+        agency::array<std::ptrdiff_t,2> strides = {{std::ptrdiff_t(shape[1]), 1}};
+        agency::array<size_t,2> idx = {{i,j}};
+
+        stencil_neighborhood<int,2> n(&src.data()[i * shape[1] + j], strides, idx);
+        dst[index2{i,j}] = kernel(n);
+      }
+      else
+      {
+        dst[index2{i,j}] = src.all()[index2{i,j}];
+      }
+    }
+  }
+}
+
+
+template<class Kernel, class Array>
+void reference_step_3d(Kernel kernel, size_t radius, const Array& src, Array& dst)
+{
+  auto shape = src.shape();
+
+  for(size_t i = 0; i < shape[0]; ++i)
+  {
+    for(size_t j = 0; j < shape[1]; ++j)
+    {
+      for(size_t k = 0; k < shape[2]; ++k)
+      {
+        bool interior = i >= radius && i + radius < shape[0] &&
+                        j >= radius && j + radius < shape[1] &&
+                        k >= radius && k + radius < shape[2];
+
+        if(interior)
+        {
+          agency::array<std::ptrdiff_t,3> strides = {{std::ptrdiff_t(shape[1] * shape[2]), std::ptrdiff_t(shape[2]), 1}};
+          agency::array<size_t,3> idx = {{i,j,k}};
+
+          stencil_neighborhood<int,3> n(&src.data()[(i * shape[1] + j) * shape[2] + k], strides, idx);
+          dst[index3{i,j,k}] = kernel(n);
+        }
+        else
+        {
+          dst[index3{i,j,k}] = src.all()[index3{i,j,k}];
+        }
+      }
+    }
+  }
+}
+
+
+template<class Array>
+void fill_pattern(Array& array)
+{
+  size_t x = 1;
+  for(auto& element : array.all())
+  {
+    x = (x * 1103515245 + 12345) % 2147483648u;
+    element = int(x % 1000);
+  }
+}
+
+
+template<class ExecutionPolicy, class Kernel>
+void test_2d_single_step(ExecutionPolicy policy, Kernel kernel, size_t radius, index2 shape)
+{
+  ndarray<int,2> src(shape);
+  fill_pattern(src);
+
+  ndarray<int,2> expected(shape);
+  reference_step_2d(kernel, radius, src, expected);
+
+  // read through a const view
+  ndarray<int,2> dst(shape, -1);
+  const ndarray<int,2>& const_src = src;
+  stencil(policy, const_src.all(), dst.all(), radius, kernel);
+
+  assert((dst == expected));
+
+  // write to an array with a different layout
+  ndarray<int,2,agency::allocator<int>,column_major> column_major_dst(shape, -1);
+  stencil(policy, src.all(), column_major_dst.all(), radius, kernel);
+
+  for(size_t i = 0; i < shape[0]; ++i)
+  {
+    for(size_t j = 0; j < shape[1]; ++j)
+    {
+      assert((column_major_dst[index2{i,j}] == expected[index2{i,j}]));
+    }
+  }
+}
+
+
+template<class ExecutionPolicy, class Kernel>
+void test_2d_multiple_steps(ExecutionPolicy policy, Kernel kernel, size_t radius, index2 shape, size_t num_steps, size_t steps_per_block)
+{
+  ndarray<int,2> initial(shape);
+  fill_pattern(initial);
+
+  // compute the expected result one step at a time
+  ndarray<int,2> expected = initial;
+  ndarray<int,2> temp(shape);
+  for(size_t step = 0; step < num_steps; ++step)
+  {
+    reference_step_2d(kernel, radius, expected, temp);
+    std::swap(expected, temp);
+  }
+
+  ndarray<int,2> a = initial;
+  ndarray<int,2> b(shape, -1);
+
+  auto result = stencil(policy, a.all(), b.all(), radius, kernel, num_steps, steps_per_block);
+
+  // the result lands in a after an even number of blocks
+  size_t num_blocks = (num_steps + steps_per_block - 1) / steps_per_block;
+  assert((result.data() == (num_blocks % 2 == 0 ? a.data() : b.data())));
+
+  for(size_t i = 0; i < shape[0]; ++i)
+  {
+    for(size_t j = 0; j < shape[1]; ++j)
+    {
+      assert((result[index2{i,j}] == expected[index2{i,j}]));
+    }
+  }
+}
+
+
+template<class ExecutionPolicy>
+void test_3d(ExecutionPolicy policy, index3 shape, size_t num_steps, size_t steps_per_block)
+{
+  ndarray<int,3> initial(shape);
+  fill_pattern(initial);
+
+  ndarray<int,3> expected = initial;
+  ndarray<int,3> temp(shape);
+  for(size_t step = 0; step < num_steps; ++step)
+  {
+    reference_step_3d(seven_point(), 1, expected, temp);
+    std::swap(expected, temp);
+  }
+
+  ndarray<int,3> a = initial;
+  ndarray<int,3> b(shape, -1);
+
+  auto result = stencil(policy, a.all(), b.all(), 1, seven_point(), num_steps, steps_per_block);
+
+  for(size_t i = 0; i < shape[0]; ++i)
+  {
+    for(size_t j = 0; j < shape[1]; ++j)
+    {
+      for(size_t k = 0; k < shape[2]; ++k)
+      {
+        assert((result[index3{i,j,k}] == expected[index3{i,j,k}]));
+      }
+    }
+  }
+}
+
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  // shapes smaller than, equal to, and not multiples of the tiles, including shapes without interior points
+  index2 shapes[] = {{1,1}, {3,2}, {2,9}, {5,5}, {40,530}, {70,1100}, {129,65}};
+
+  for(auto shape : shapes)
+  {
+    test_2d_single_step(policy, five_point(), 1, shape);
+    test_2d_single_step(policy, nine_point_cross(), 2, shape);
+
+    test_2d_multiple_steps(policy, five_point(), 1, shape, 5, 1);
+    test_2d_multiple_steps(policy, five_point(), 1, shape, 7, 3);
+    test_2d_multiple_steps(policy, nine_point_cross(), 2, shape, 8, 4);
+  }
+
+  test_2d_multiple_steps(policy, five_point(), 1, index2{70,1100}, 0, 4);
+
+  test_3d(policy, index3{20,19,30}, 4, 1);
+  test_3d(policy, index3{20,19,30}, 5, 2);
+  test_3d(policy, index3{3,33,600}, 6, 6);
+}
+
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
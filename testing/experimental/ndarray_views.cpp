@@ -0,0 +1,235 @@
+#include <agency/agency.hpp>
+#include <agency/experimental.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+
+using index2 = agency::point<size_t,2>;
+using index3 = agency::point<size_t,3>;
+
+template<class Layout>
+void test_subarray()
+{
+  using namespace agency::experimental;
+
+  ndarray<int,2,agency::allocator<int>,Layout> array(index2{6,8});
+  for(size_t i = 0; i < 6; ++i)
+  {
+    for(size_t j = 0; j < 8; ++j)
+    {
+      array[index2{i,j}] = int(10 * i + j);
+    }
+  }
+
+  {
+    // test subarray
+    auto view = subarray(array.all(), index2{1,2}, index2{4,7});
+
+    assert((view.shape() == index2(3,5)));
+    for(size_t i = 0; i < 3; ++i)
+    {
+      for(size_t j = 0; j < 5; ++j)
+      {
+        assert((view[index2{i,j}] == int(10 * (i + 1) + (j + 2))));
+      }
+    }
+
+    // the view shares the array's elements
+    view[index2{0,0}] = -1;
+    assert((array[index2{1,2}] == -1));
+    array[index2{1,2}] = 12;
+  }
+
+  {
+    // test empty subarray
+    auto view = subarray(array.all(), index2{3,3}, index2{3,5});
+    assert(view.size() == 0);
+    assert(view.span_size() == 0);
+  }
+
+  {
+    // test slice
+    auto view = slice(array.all(), index2{1,0}, index2{6,8}, index2{2,3});
+
+    assert((view.shape() == index2(3,3)));
+    for(size_t i = 0; i < 3; ++i)
+    {
+      for(size_t j = 0; j < 3; ++j)
+      {
+        assert((view[index2{i,j}] == int(10 * (1 + 2 * i) + 3 * j)));
+      }
+    }
+  }
+
+  {
+    // test transpose
+    auto view = transpose(array.all());
+
+    assert((view.shape() == index2(8,6)));
+    for(size_t i = 0; i < 8; ++i)
+    {
+      for(size_t j = 0; j < 6; ++j)
+      {
+        assert((view[index2{i,j}] == int(10 * j + i)));
+      }
+    }
+
+    // transposing twice is the identity
+    auto original = transpose(view);
+    assert((original.shape() == index2(6,8)));
+    assert((&original[index2{5,7}] == &array[index2{5,7}]));
+  }
+
+  {
+    // test a subarray of a transpose
+    auto view = subarray(transpose(array.all()), index2{2,1}, index2{5,3});
+
+    assert((view.shape() == index2(3,2)));
+    assert((view[index2{2,1}] == int(10 * 2 + 4)));
+  }
+}
+
+void test_iterate_views()
+{
+  using namespace agency::experimental;
+
+  ndarray<int,2> array(index2{4,4});
+  for(size_t i = 0; i < 16; ++i)
+  {
+    array.data()[i] = int(i);
+  }
+
+  {
+    // iterating a subarray visits only its elements, in row-major order
+    auto view = subarray(array.all(), index2{1,1}, index2{3,3});
+
+    assert(size_t(view.end() - view.begin()) == view.size());
+    assert(std::vector<int>(view.begin(), view.end()) == std::vector<int>({5, 6, 9, 10}));
+  }
+
+  {
+    // iterating a transpose visits the elements in transposed order
+    auto view = transpose(array.all());
+
+    std::vector<int> expected;
+    for(int j = 0; j < 4; ++j)
+    {
+      for(int i = 0; i < 4; ++i)
+      {
+        expected.push_back(4 * i + j);
+      }
+    }
+
+    assert(std::vector<int>(view.begin(), view.end()) == expected);
+  }
+
+  {
+    // range-based for over a slice
+    std::vector<int> elements;
+    for(int x : slice(array.all(), index2{0,0}, index2{4,4}, index2{2,3}))
+    {
+      elements.push_back(x);
+    }
+
+    assert(elements == std::vector<int>({0, 3, 8, 11}));
+  }
+
+  {
+    // writes through a view's iterators reach the array
+    auto view = subarray(array.all(), index2{2,0}, index2{3,4});
+    for(int& x : view)
+    {
+      x = -x;
+    }
+
+    assert((array[index2{2,3}] == -11));
+    assert((array[index2{1,3}] == 7));
+  }
+}
+
+void test_permute_axes()
+{
+  using namespace agency::experimental;
+
+  ndarray<int,3> array(index3{2,3,4});
+  for(size_t i = 0; i < 2; ++i)
+  {
+    for(size_t j = 0; j < 3; ++j)
+    {
+      for(size_t k = 0; k < 4; ++k)
+      {
+        array[index3{i,j,k}] = int(100 * i + 10 * j + k);
+      }
+    }
+  }
+
+  auto view = permute_axes(array.all(), {2,0,1});
+
+  assert((view.shape() == index3(4,2,3)));
+  for(size_t i = 0; i < 4; ++i)
+  {
+    for(size_t j = 0; j < 2; ++j)
+    {
+      for(size_t k = 0; k < 3; ++k)
+      {
+        assert((view[index3{i,j,k}] == int(100 * j + 10 * k + i)));
+      }
+    }
+  }
+}
+
+void test_tile()
+{
+  using namespace agency::experimental;
+
+  ndarray<int,2> array(index2{10,7}, 0);
+
+  auto tiles = tile(array.all(), index2{4,3});
+
+  assert((tiles.shape() == index2(3,3)));
+  assert(tiles.size() == 9);
+  assert((tiles[index2{0,0}].shape() == index2(4,3)));
+  assert((tiles[index2{2,2}].shape() == index2(2,1)));
+  assert((&tiles[index2{1,2}][index2{0,0}] == &array[index2{4,6}]));
+
+  // each agent increments each element of its tile
+  agency::bulk_invoke(agency::par2d(tiles.domain()), [=](agency::parallel_agent_2d& self)
+  {
+    auto my_tile = tiles[self.index()];
+
+    for(size_t i = 0; i < my_tile.shape()[0]; ++i)
+    {
+      for(size_t j = 0; j < my_tile.shape()[1]; ++j)
+      {
+        my_tile[index2{i,j}] += 1;
+      }
+    }
+  });
+
+  for(auto x : array)
+  {
+    assert(x == 1);
+  }
+
+  // ranges continue to use their own tile()
+  std::vector<int> vec(10);
+  auto chunks = tile(vec, 3);
+  assert(chunks.size() == 4);
+}
+
+int main()
+{
+  using namespace agency::experimental;
+
+  test_subarray<row_major>();
+  test_subarray<column_major>();
+  test_subarray<strided>();
+  test_subarray<padded_row_major<16>>();
+  test_iterate_views();
+  test_permute_axes();
+  test_tile();
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
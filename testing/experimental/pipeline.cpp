@@ -0,0 +1,176 @@
+#include <agency/agency.hpp>
+#include <agency/experimental.hpp>
+#include <iostream>
+#include <vector>
+#include <cassert>
+
+
+struct load
+{
+  const int* data;
+
+  template<class Agent>
+  int operator()(Agent& self) const
+  {
+    return data[self.index()];
+  }
+};
+
+
+struct times_two
+{
+  template<class Agent>
+  int operator()(Agent&, int x) const
+  {
+    return 2 * x;
+  }
+};
+
+
+struct plus_one
+{
+  template<class Agent>
+  int operator()(Agent&, int x) const
+  {
+    return x + 1;
+  }
+};
+
+
+struct store
+{
+  int* data;
+
+  template<class Agent>
+  void operator()(Agent& self, int x) const
+  {
+    data[self.index()] = x;
+  }
+};
+
+
+// a stage which needs the entirety of the previous segment's results
+struct reverse
+{
+  template<class Agent, class Container>
+  int operator()(Agent& self, Container& results) const
+  {
+    return results[results.size() - 1 - self.index()];
+  }
+};
+
+
+// a stage following a stage with void results
+struct load_after_store
+{
+  const int* data;
+
+  template<class Agent>
+  int operator()(Agent& self) const
+  {
+    return data[self.index()] + 100;
+  }
+};
+
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  using namespace agency;
+
+  size_t n = 100;
+  std::vector<int> input(n);
+  for(size_t i = 0; i < n; ++i)
+  {
+    input[i] = static_cast<int>(i);
+  }
+
+  {
+    // element-wise stages fuse into a single segment
+    auto p = experimental::make_pipeline(policy(n), load{input.data()})
+      .then(times_two())
+      .then(plus_one());
+
+    static_assert(decltype(p)::num_segments() == 1, "element-wise stages should fuse");
+
+    auto results = p.invoke();
+    assert(results.size() == n);
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      assert(results[i] == 2 * static_cast<int>(i) + 1);
+    }
+
+    auto future_results = p.async().get();
+    for(size_t i = 0; i < n; ++i)
+    {
+      assert(future_results[i] == 2 * static_cast<int>(i) + 1);
+    }
+  }
+
+  {
+    // a barrier begins a new segment which receives all of the previous segment's results
+    std::vector<int> output(n, -1);
+
+    auto p = experimental::make_pipeline(policy(n), load{input.data()})
+      .then(times_two())
+      .barrier_then(reverse())
+      .then(plus_one())
+      .then(store{output.data()});
+
+    static_assert(decltype(p)::num_segments() == 2, "a barrier should begin a new segment");
+
+    p.invoke();
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      assert(output[i] == 2 * static_cast<int>(n - 1 - i) + 1);
+    }
+
+    std::fill(output.begin(), output.end(), -1);
+
+    p.async().wait();
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      assert(output[i] == 2 * static_cast<int>(n - 1 - i) + 1);
+    }
+  }
+
+  {
+    // stages may follow a stage with void results
+    std::vector<int> output(n, -1);
+
+    auto p = experimental::make_pipeline(policy(n), load{input.data()})
+      .then(store{output.data()})
+      .barrier_then(load_after_store{output.data()})
+      .then(plus_one());
+
+    auto results = p.invoke();
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      assert(output[i] == static_cast<int>(i));
+      assert(results[i] == static_cast<int>(i) + 101);
+    }
+
+    auto future_results = p.async().get();
+    for(size_t i = 0; i < n; ++i)
+    {
+      assert(future_results[i] == static_cast<int>(i) + 101);
+    }
+  }
+}
+
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
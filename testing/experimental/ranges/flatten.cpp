@@ -232,9 +232,143 @@ void test()
   }
 }
 
+template<class View>
+void test_traversal(const View& view, const std::vector<int>& expected_values)
+{
+  assert(view.size() == expected_values.size());
+
+  for(size_t i = 0; i < view.size(); ++i)
+  {
+    assert(view[i] == expected_values[i]);
+  }
+
+  // forward traversal
+  size_t i = 0;
+  for(auto iter = view.begin(); iter != view.end(); ++iter, ++i)
+  {
+    assert(*iter == expected_values[i]);
+  }
+  assert(i == expected_values.size());
+
+  // backward traversal
+  for(auto iter = view.end(); iter != view.begin();)
+  {
+    --iter;
+    --i;
+    assert(*iter == expected_values[i]);
+  }
+  assert(i == 0);
+
+  // jumps forward and backward across segments
+  for(size_t from = 0; from <= view.size(); ++from)
+  {
+    for(size_t to = 0; to <= view.size(); ++to)
+    {
+      auto iter = view.begin() + from;
+
+      if(to >= from)
+      {
+        iter += to - from;
+      }
+      else
+      {
+        iter -= from - to;
+      }
+
+      assert(size_t(iter - view.begin()) == to);
+
+      if(to < view.size())
+      {
+        assert(*iter == expected_values[to]);
+      }
+    }
+  }
+}
+
+void test_segment_index()
+{
+  using namespace agency::experimental;
+
+  {
+    // segments of varying size, some empty
+    size_t sizes[] = {0, 4, 1, 0, 0, 3, 2, 0};
+
+    std::vector<std::vector<int>> v;
+    int init = 0;
+    for(size_t size : sizes)
+    {
+      v.emplace_back(std::vector<int>(size));
+      std::iota(v.back().begin(), v.back().end(), init);
+      init += int(size);
+    }
+
+    std::vector<int> expected_values(init);
+    std::iota(expected_values.begin(), expected_values.end(), 0);
+
+    // without a segment index
+    test_traversal(flatten(v), expected_values);
+
+    // with segment offsets
+    std::vector<size_t> offsets(v.size() + 1);
+    auto end = segment_offsets(v, offsets.begin());
+    assert(end == offsets.end());
+    assert(offsets.back() == expected_values.size());
+
+    auto indexed = flatten(v, offsets);
+    assert(indexed.segment_offsets().size() == std::ptrdiff_t(offsets.size()));
+    test_traversal(indexed, expected_values);
+
+    // the converting copy constructor preserves the segment offsets
+    flatten_view<const std::vector<std::vector<int>>> indexed2 = indexed;
+    assert(indexed2.segment_offsets().data() == offsets.data());
+    test_traversal(indexed2, expected_values);
+  }
+
+  {
+    // segments of uniform size, with a shorter last segment
+    std::vector<std::vector<int>> v;
+    for(size_t i = 0; i < 4; ++i)
+    {
+      v.emplace_back(std::vector<int>(i < 3 ? 5 : 2));
+      std::iota(v.back().begin(), v.back().end(), int(5 * i));
+    }
+
+    std::vector<int> expected_values(17);
+    std::iota(expected_values.begin(), expected_values.end(), 0);
+
+    test_traversal(flatten_uniform(v, 5), expected_values);
+  }
+
+  {
+    // segments of uniform size, with a longer last segment
+    std::vector<std::vector<int>> v;
+    for(size_t i = 0; i < 3; ++i)
+    {
+      v.emplace_back(std::vector<int>(i < 2 ? 3 : 7));
+      std::iota(v.back().begin(), v.back().end(), int(3 * i));
+    }
+
+    std::vector<int> expected_values(13);
+    std::iota(expected_values.begin(), expected_values.end(), 0);
+
+    test_traversal(flatten_uniform(v, 3), expected_values);
+  }
+
+  {
+    // no segments at all
+    std::vector<std::vector<int>> v;
+    std::vector<size_t> offsets(1, 0);
+
+    test_traversal(flatten(v), std::vector<int>());
+    test_traversal(flatten(v, offsets), std::vector<int>());
+    test_traversal(flatten_uniform(v, 3), std::vector<int>());
+  }
+}
+
 int main()
 {
   test();
+  test_segment_index();
 
   std::cout << "OK" << std::endl;
 
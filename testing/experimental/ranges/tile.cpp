@@ -0,0 +1,158 @@
+#include <agency/agency.hpp>
+#include <agency/experimental.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <numeric>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+
+void test_static_tiles()
+{
+  using namespace agency::experimental;
+
+  std::vector<int> ints(10);
+  std::iota(ints.begin(), ints.end(), 0);
+
+  auto tiles = tile<4>(ints);
+
+  static_assert(std::is_same<decltype(tiles[0]), span<int,4>>::value, "tile<4>() should yield span<int,4>");
+  static_assert(decltype(tiles[0])::extent == 4, "tile's extent should be static");
+
+  assert(tiles.size() == 2);
+  assert(tiles.end() - tiles.begin() == 2);
+
+  int expected = 0;
+  for(auto t : tiles)
+  {
+    assert(t.size() == 4);
+
+    for(int x : t)
+    {
+      assert(x == expected);
+      ++expected;
+    }
+  }
+
+  auto remainder = tiles.remainder();
+  assert(remainder.size() == 2);
+  assert(remainder[0] == 8);
+  assert(remainder[1] == 9);
+
+  // a range which is a multiple of the tile size has no remainder
+  auto even_tiles = tile<5>(ints);
+  assert(even_tiles.size() == 2);
+  assert(even_tiles.remainder().size() == 0);
+
+  // a range smaller than the tile size is all remainder
+  auto small_tiles = tile<16>(ints);
+  assert(small_tiles.size() == 0);
+  assert(small_tiles.remainder().size() == 10);
+
+  // empty ranges have neither tiles nor remainder
+  std::vector<int> empty;
+  auto empty_tiles = tile<4>(empty);
+  assert(empty_tiles.size() == 0);
+  assert(empty_tiles.remainder().size() == 0);
+}
+
+
+struct increment
+{
+  template<std::size_t N>
+  void operator()(agency::experimental::static_parallel_agent<N>& self, int& x, int increment)
+  {
+    static_assert(agency::experimental::static_parallel_agent<N>::static_group_size == N, "unexpected group size");
+    assert(self.group_size() == N);
+
+    x += increment;
+  }
+
+  void operator()(agency::parallel_agent& self, int& x, int increment)
+  {
+    assert(self.group_size() < 8);
+
+    x += 10 * increment;
+  }
+};
+
+
+template<class ExecutionPolicy>
+void test_bulk_invoke(ExecutionPolicy policy)
+{
+  using namespace agency::experimental;
+
+  for(size_t n : {0, 1, 7, 8, 9, 64, 1000, 1003})
+  {
+    std::vector<int> ints(n, 0);
+
+    bulk_invoke(policy, tile<8>(ints), increment(), 1);
+
+    // elements of whole tiles are visited by static_parallel_agents and the rest by parallel_agents
+    size_t num_whole = (n / 8) * 8;
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      assert(ints[i] == (i < num_whole ? 1 : 10));
+    }
+  }
+}
+
+
+void test_static_parallel_execution_policy()
+{
+  using namespace agency::experimental;
+
+  {
+    // a flat static_parallel_execution_policy creates exactly group_size agents
+    std::vector<int> ints(4, 0);
+
+    agency::bulk_invoke(static_parallel_execution_policy<4>(), [&](static_parallel_agent<4>& self)
+    {
+      ints[self.index()] = int(self.index());
+    });
+
+    std::vector<int> expected(4);
+    std::iota(expected.begin(), expected.end(), 0);
+    assert(ints == expected);
+  }
+
+  {
+    // nested inside par, each outer agent's group of 4 is visited in order
+    std::vector<int> ints(12, 0);
+
+    agency::bulk_invoke(agency::par(3, static_parallel_execution_policy<4>()), [&](agency::parallel_group<static_parallel_agent<4>>& self)
+    {
+      ints[4 * self.outer().index() + self.inner().index()] = int(4 * self.outer().index() + self.inner().index());
+    });
+
+    std::vector<int> expected(12);
+    std::iota(expected.begin(), expected.end(), 0);
+    assert(ints == expected);
+  }
+}
+
+
+int main()
+{
+  test_static_tiles();
+
+  test_static_parallel_execution_policy();
+
+  test_bulk_invoke(agency::seq);
+  test_bulk_invoke(agency::par);
+  test_bulk_invoke(agency::con);
+
+#ifdef _OPENMP
+  test_bulk_invoke(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
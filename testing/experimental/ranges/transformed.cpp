@@ -3,8 +3,14 @@
 #include <numeric>
 #include <typeinfo>
 #include <functional>
+#include <list>
+#include <iostream>
 
 #include <agency/experimental/ranges/transformed.hpp>
+#include <agency/experimental/ranges/block.hpp>
+#include <agency/experimental/span.hpp>
+#include <agency/execution/execution_policy.hpp>
+#include <agency/container/vector.hpp>
 
 int product(int x, int y, int z)
 {
@@ -120,9 +126,125 @@ void test()
   }
 }
 
+struct plus
+{
+  int operator()(int x, int y) const
+  {
+    return x + y;
+  }
+};
+
+struct record_blocks
+{
+  std::vector<int>* values;
+  size_t* num_blocks;
+
+  template<class Pack>
+  void operator()(size_t i, const Pack& pack, size_t count) const
+  {
+    assert(i == values->size());
+    assert(count <= pack.size());
+
+    for(size_t j = 0; j < count; ++j)
+    {
+      values->push_back(pack[j]);
+    }
+
+    ++*num_blocks;
+  }
+};
+
+void test_contiguity()
+{
+  using namespace agency::experimental;
+
+  std::vector<int> v0(100);
+  std::vector<int> v1(100);
+  std::list<int> l(100);
+
+  std::iota(v0.begin(), v0.end(), 0);
+  std::iota(v1.begin(), v1.end(), 1000);
+
+  auto contiguous = transformed(plus(), v0, span<int>(v1.data(), v1.size()));
+  auto not_contiguous = transformed(plus(), v0, l);
+
+  using contiguous_iterator = decltype(contiguous.begin());
+  using not_contiguous_iterator = decltype(not_contiguous.begin());
+
+  {
+    // test is_contiguous_per_component
+    static_assert(is_contiguous_per_component<contiguous_iterator>::value, "");
+    static_assert(!is_contiguous_per_component<not_contiguous_iterator>::value, "");
+    static_assert(is_contiguous_per_component<int*>::value, "");
+    static_assert(is_contiguous_per_component<std::vector<int>::const_iterator>::value, "");
+    static_assert(!is_contiguous_per_component<std::vector<bool>::iterator>::value, "");
+    static_assert(!is_contiguous_per_component<std::list<int>::iterator>::value, "");
+  }
+
+  {
+    // test iterator_category is the weakest of the components' categories
+    static_assert(std::is_same<std::random_access_iterator_tag, contiguous_iterator::iterator_category>::value, "");
+    static_assert(std::is_same<std::bidirectional_iterator_tag, not_contiguous_iterator::iterator_category>::value, "");
+  }
+
+  {
+    // test unwrap_contiguous
+    auto unwrapped = (contiguous.begin() + 10).unwrap_contiguous();
+
+    static_assert(std::is_same<decltype(unwrapped), agency::experimental::detail::zip_with_iterator<plus, int*, int*>>::value, "");
+
+    for(int i = 0; i < 90; ++i)
+    {
+      assert(unwrapped[i] == contiguous[10 + i]);
+    }
+  }
+
+  {
+    // test for_each_block with full and partial blocks
+    size_t sizes[] = {0, 1, 7, 8, 9, 100};
+
+    for(size_t n : sizes)
+    {
+      auto t = transformed(plus(), span<int>(v0.data(), n), span<int>(v1.data(), n));
+
+      std::vector<int> values;
+      size_t num_blocks = 0;
+
+      for_each_block<8>(t, record_blocks{&values, &num_blocks});
+
+      assert(num_blocks == (n + 7) / 8);
+      assert(values.size() == n);
+
+      for(size_t i = 0; i < n; ++i)
+      {
+        assert(values[i] == v0[i] + v1[i]);
+      }
+
+      // ranges whose components are not contiguous are also visited in blocks
+      values.clear();
+      num_blocks = 0;
+
+      for_each_block<8>(transformed(plus(), span<int>(v0.data(), n), std::vector<int>(v1.begin(), v1.begin() + n)), record_blocks{&values, &num_blocks});
+
+      assert(values.size() == n);
+    }
+  }
+
+  {
+    // test construction of a vector from a transformed range, which unwraps its components
+    agency::vector<int> result(agency::par, contiguous.begin(), contiguous.begin() + 100);
+
+    for(size_t i = 0; i < 100; ++i)
+    {
+      assert(result[i] == v0[i] + v1[i]);
+    }
+  }
+}
+
 int main()
 {
   test();
+  test_contiguity();
 
   std::cout << "OK" << std::endl;
 
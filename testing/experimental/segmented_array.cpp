@@ -81,6 +81,25 @@ void test()
     assert(copy.size() == segment_size * allocators.size());
     assert(std::equal(copy.begin(), copy.end(), expected_values.begin()));
   }
+
+  {
+    // test that segments may be modified through segment()
+
+    std::vector<allocator<int>> allocators(4);
+
+    segmented_array<int> array(10, 13, allocators);
+
+    span<int> segment = array.segment(1);
+    assert(size_t(segment.size()) == array.segment_offsets()[2] - array.segment_offsets()[1]);
+
+    for(auto& x : segment)
+    {
+      x = 7;
+    }
+
+    assert(array[array.segment_offsets()[1]] == 7);
+    assert(array.size() == 10);
+  }
 }
 
 int main()
@@ -0,0 +1,176 @@
+#include <agency/agency.hpp>
+#include <agency/experimental.hpp>
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <numeric>
+#include <functional>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+using agency::experimental::segmented_array;
+using agency::experimental::span;
+
+
+struct record_chunk
+{
+  template<class Agent>
+  void operator()(Agent& self, span<int> chunk, size_t first, const std::vector<size_t>* offsets, std::vector<int>* owners)
+  {
+    assert(chunk.size() > 0);
+
+    // chunks never span two segments
+    size_t s = std::upper_bound(offsets->begin(), offsets->end(), first) - offsets->begin() - 1;
+    assert(first + chunk.size() <= (*offsets)[s+1]);
+
+    for(span<int>::index_type i = 0; i < chunk.size(); ++i)
+    {
+      chunk[i] = int(first + i);
+      (*owners)[first + i] = int(self.rank());
+    }
+  }
+};
+
+
+struct twice
+{
+  long operator()(int x) const
+  {
+    return 2 * long(x);
+  }
+};
+
+
+segmented_array<int> make_array(size_t n, size_t num_segments)
+{
+  std::vector<agency::allocator<int>> allocators(num_segments);
+  return segmented_array<int>(n, 0, allocators);
+}
+
+
+template<class ExecutionPolicy>
+void test(ExecutionPolicy policy)
+{
+  using namespace agency::experimental;
+
+  // few large segments, which agents divide into chunks, and many small ones
+  size_t shapes[][2] = {{0,1}, {10,3}, {1 << 18, 1}, {1 << 18, 3}, {100000, 7}, {1 << 18, 64}, {5000, 1000}};
+
+  for(auto& shape : shapes)
+  {
+    size_t n = shape[0];
+    size_t num_segments = shape[1];
+
+    {
+      // test bulk_invoke
+      segmented_array<int> array = make_array(n, num_segments);
+
+      std::vector<size_t> offsets(array.segment_offsets().begin(), array.segment_offsets().end());
+      std::vector<int> owners(n, -1);
+
+      if(n > 0)
+      {
+        bulk_invoke(policy, array, record_chunk(), &offsets, &owners);
+      }
+
+      for(size_t i = 0; i < n; ++i)
+      {
+        assert(array[i] == int(i));
+        assert(owners[i] >= 0);
+      }
+    }
+
+    {
+      // test fill
+      segmented_array<int> array = make_array(n, num_segments);
+
+      fill(policy, array, 13);
+
+      assert(std::count(array.begin(), array.end(), 13) == std::ptrdiff_t(n));
+    }
+
+    segmented_array<int> input = make_array(n, num_segments);
+    std::iota(input.begin(), input.end(), 0);
+
+    {
+      // test reduce
+      long expected = std::accumulate(input.begin(), input.end(), 7L);
+
+      assert(reduce(policy, input, 7L, std::plus<long>()) == expected);
+    }
+
+    {
+      // test transform into a range
+      std::vector<long> result(n, -1);
+
+      auto end = transform(policy, input, result.begin(), twice());
+
+      assert(end == result.end());
+      for(size_t i = 0; i < n; ++i)
+      {
+        assert(result[i] == 2 * long(i));
+      }
+    }
+
+    {
+      // test copy into a range
+      std::vector<int> result(n, -1);
+
+      auto end = copy(policy, input, result.begin());
+
+      assert(end == result.end());
+      assert(std::equal(result.begin(), result.end(), input.begin()));
+    }
+
+    {
+      // test transform and copy into a segmented_array with the same segments
+      segmented_array<long> result(n, -1, std::vector<agency::allocator<long>>(num_segments));
+
+      transform(policy, input, result, twice());
+
+      for(size_t i = 0; i < n; ++i)
+      {
+        assert(result[i] == 2 * long(i));
+      }
+
+      copy(policy, input, result);
+
+      assert(std::equal(result.begin(), result.end(), input.begin()));
+    }
+
+    {
+      // test transform and copy into a segmented_array with different segments
+      segmented_array<long> result(n, -1);
+
+      transform(policy, input, result, twice());
+
+      for(size_t i = 0; i < n; ++i)
+      {
+        assert(result[i] == 2 * long(i));
+      }
+
+      copy(policy, input, result);
+
+      assert(std::equal(result.begin(), result.end(), input.begin()));
+    }
+  }
+}
+
+
+int main()
+{
+  test(agency::seq);
+  test(agency::par);
+  test(agency::con);
+
+#ifdef _OPENMP
+  test(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
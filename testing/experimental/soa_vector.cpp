@@ -0,0 +1,226 @@
+#include <agency/agency.hpp>
+#include <agency/experimental.hpp>
+#include <agency/detail/algorithm/copy.hpp>
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
+
+using agency::experimental::soa_vector;
+using particles = soa_vector<float, int, double>;
+using particle = particles::value_type;
+
+
+particle make_particle(size_t i)
+{
+  return particle(float(i), int(2 * i), 3. * i);
+}
+
+
+bool is_aligned(const void* ptr)
+{
+  return reinterpret_cast<std::uintptr_t>(ptr) % 64 == 0;
+}
+
+
+void test_fields()
+{
+  particles p(10, particle(1.f, 2, 3.));
+
+  assert(p.size() == 10);
+
+  // each field is a separate, aligned array
+  assert(is_aligned(p.data<0>()));
+  assert(is_aligned(p.data<1>()));
+  assert(is_aligned(p.data<2>()));
+
+  agency::experimental::span<int> ints = p.field<1>();
+  assert(ints.size() == 10);
+  assert(ints.data() == p.data<1>());
+  assert(std::count(ints.begin(), ints.end(), 2) == 10);
+
+  // writing through a field is visible through the element proxies
+  std::iota(ints.begin(), ints.end(), 0);
+  for(size_t i = 0; i < p.size(); ++i)
+  {
+    assert(agency::get<1>(p[i]) == int(i));
+  }
+
+  // writing through an element proxy is visible through the fields
+  p[3] = particle(7.f, 8, 9.);
+  assert(p.field<0>()[3] == 7.f);
+  assert(p.field<1>()[3] == 8);
+  assert(p.field<2>()[3] == 9.);
+
+  agency::get<2>(p[4]) = 13.;
+  assert(p.data<2>()[4] == 13.);
+
+  auto spans = p.spans();
+  assert(agency::get<0>(spans).data() == p.data<0>());
+  assert(agency::get<2>(spans).size() == 10);
+
+  const particles& cp = p;
+  agency::experimental::span<const double> doubles = cp.field<2>();
+  assert(doubles[4] == 13.);
+}
+
+
+void test_modifiers()
+{
+  particles p;
+  assert(p.empty());
+
+  for(size_t i = 0; i < 100; ++i)
+  {
+    p.push_back(make_particle(i));
+  }
+
+  assert(p.size() == 100);
+  assert(p.capacity() >= 100);
+
+  for(size_t i = 0; i < p.size(); ++i)
+  {
+    assert(particle(p[i]) == make_particle(i));
+  }
+
+  p.pop_back();
+  assert(p.size() == 99);
+  assert(particle(p.back()) == make_particle(98));
+
+  p.resize(10);
+  assert(p.size() == 10);
+
+  p.resize(20, make_particle(0));
+  assert(p.size() == 20);
+  assert(particle(p[19]) == make_particle(0));
+  assert(particle(p[9]) == make_particle(9));
+
+  p.shrink_to_fit();
+  assert(p.capacity() == 20);
+
+  particles copy = p;
+  assert(copy == p);
+
+  particles moved = std::move(copy);
+  assert(moved == p);
+  assert(copy.empty());
+
+  moved.clear();
+  assert(moved.empty());
+  assert(moved != p);
+
+  moved = p;
+  assert(moved == p);
+}
+
+
+template<class ExecutionPolicy>
+void test_parallel(ExecutionPolicy policy)
+{
+  for(size_t n : {0, 1, 10, 1000})
+  {
+    {
+      // construct from a value in parallel
+      particles p(policy, n, make_particle(13));
+
+      assert(p.size() == n);
+      for(size_t i = 0; i < n; ++i)
+      {
+        assert(particle(p[i]) == make_particle(13));
+      }
+    }
+
+    {
+      // value-initialize in parallel
+      particles p(policy, n);
+
+      assert(p.size() == n);
+      for(size_t i = 0; i < n; ++i)
+      {
+        assert(particle(p[i]) == particle(0.f, 0, 0.));
+      }
+    }
+
+    // construct from a range of tuples in parallel
+    std::vector<particle> aos(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+      aos[i] = make_particle(i);
+    }
+
+    particles soa(policy, aos.begin(), aos.end());
+
+    assert(soa.size() == n);
+    assert(std::equal(aos.begin(), aos.end(), soa.begin()));
+
+    {
+      // copy construct in parallel
+      particles copy(policy, soa);
+      assert(copy == soa);
+    }
+
+    {
+      // copy from a soa_vector into a range of tuples
+      std::vector<particle> result(n);
+      agency::detail::copy(policy, soa.begin(), soa.end(), result.begin());
+      assert(result == aos);
+    }
+
+    {
+      // copy into a soa_vector's elements
+      particles result(n);
+      agency::detail::copy(policy, aos.begin(), aos.end(), result.begin());
+      assert(result == soa);
+
+      // copy between soa_vectors
+      particles other(n);
+      agency::detail::copy(policy, soa.begin(), soa.end(), other.begin());
+      assert(other == soa);
+    }
+
+    {
+      // a kernel which reads only one field and writes another
+      particles result = soa;
+      agency::experimental::span<const float> x = soa.field<0>();
+      agency::experimental::span<double> y = result.field<2>();
+
+      if(n > 0)
+      {
+        agency::bulk_invoke(policy(n), [=](agency::detail::execution_policy_agent_t<ExecutionPolicy>& self)
+        {
+          y[self.rank()] = 2. * x[self.rank()];
+        });
+      }
+
+      for(size_t i = 0; i < n; ++i)
+      {
+        assert(agency::get<2>(result[i]) == 2. * i);
+        assert(agency::get<1>(result[i]) == int(2 * i));
+      }
+    }
+  }
+}
+
+
+int main()
+{
+  test_fields();
+  test_modifiers();
+
+  test_parallel(agency::seq);
+  test_parallel(agency::par);
+  test_parallel(agency::con);
+
+#ifdef _OPENMP
+  test_parallel(agency::omp::par);
+#endif
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
@@ -4,6 +4,13 @@
 #include <cassert>
 #include <vector>
 #include <algorithm>
+#include <numeric>
+#include <list>
+#include <type_traits>
+
+#ifdef _OPENMP
+#include <agency/omp.hpp>
+#endif
 
 void test()
 {
@@ -83,9 +90,124 @@ void test()
   }
 }
 
+struct write_tile_index
+{
+  template<class Agent>
+  void operator()(Agent& self, agency::experimental::span<int> tile, int offset)
+  {
+    for(auto& x : tile)
+    {
+      x = int(self.rank()) + offset;
+    }
+  }
+};
+
+template<class ExecutionPolicy>
+void test_many_tiles(ExecutionPolicy policy)
+{
+  using namespace agency;
+  using namespace agency::experimental;
+
+  // more tiles than small_untiled_view can hold, with sizes which do and do not divide evenly
+  size_t sizes[] = {0, 1, 9, 63, 64, 65, 1000, 1031};
+
+  for(size_t n : sizes)
+  {
+    std::vector<allocator<int>> allocators(64);
+
+    tiled_array<int> array(policy, n, 13, allocators);
+
+    assert(array.size() == n);
+    assert(array.num_tiles() <= allocators.size());
+    assert(std::count(array.begin(), array.end(), 13) == std::ptrdiff_t(n));
+
+    // every tile but the last is full and the last is not empty
+    for(size_t i = 0; i < array.num_tiles(); ++i)
+    {
+      if(i + 1 < array.num_tiles())
+      {
+        assert(array.tile(i).size() == array.tile_size());
+      }
+      else
+      {
+        assert(array.tile(i).size() > 0 && array.tile(i).size() <= array.tile_size());
+      }
+    }
+
+    // random access
+    std::iota(array.begin(), array.end(), 0);
+    for(size_t i = 0; i < n; ++i)
+    {
+      assert(array[i] == int(i));
+      assert(*(array.begin() + i) == int(i));
+    }
+
+    // each agent receives the tile with its index
+    agency::experimental::bulk_invoke(policy, array, write_tile_index(), 7);
+
+    for(size_t i = 0; i < n; ++i)
+    {
+      assert(array[i] == int(i / array.tile_size()) + 7);
+    }
+  }
+
+  {
+    // allocators which are not randomly accessible
+    std::list<allocator<int>> allocators(10);
+
+    tiled_array<int> array(policy, 95, 13, allocators);
+
+    assert(array.num_tiles() == 10);
+    assert(array.size() == 95);
+    assert(std::count(array.begin(), array.end(), 13) == 95);
+  }
+}
+
+void test_tile_iterator()
+{
+  using namespace agency;
+
+  using allocators_type = std::vector<allocator<int>>;
+  using iterator = experimental::detail::tiled_array_detail::tile_iterator<std::vector<int, allocator<int>>, allocators_type::iterator>;
+
+  static_assert(std::is_same<std::iterator_traits<iterator>::iterator_category, std::random_access_iterator_tag>::value, "tile_iterator should be random access");
+
+  // 4 tiles of 3 elements, followed by a last tile of 2 elements
+  allocators_type allocators(5);
+  iterator first(0, 5, 3, 2, 13, allocators.begin());
+  iterator last = first + 5;
+
+  assert(last - first == 5);
+  assert(first < last && first <= last && last > first && last >= first);
+  assert(!(first < first) && first <= first);
+
+  iterator i = last;
+  --i;
+  assert((*i).size() == 2);
+  assert(i[-1].size() == 3);
+
+  i -= 2;
+  assert(i - first == 2);
+  assert(i == first + 2);
+  assert(i == last - 3);
+  assert(2 + first == i);
+
+  assert((i--) - first == 2);
+  assert(i - first == 1);
+  assert(((*i) == std::vector<int, allocator<int>>(3, 13)));
+}
+
 int main()
 {
   test();
+  test_tile_iterator();
+
+  test_many_tiles(agency::seq);
+  test_many_tiles(agency::par);
+
+#ifdef _OPENMP
+  test_many_tiles(agency::omp::par);
+#endif
 
   std::cout << "OK" << std::endl;
 
@@ -0,0 +1,162 @@
+#include <agency/future.hpp>
+#include <agency/future/always_ready_future.hpp>
+#include <agency/future/variant_future.hpp>
+#include <agency/future/when_all.hpp>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <cassert>
+
+
+void test_range()
+{
+  using namespace agency;
+
+  {
+    // empty range
+    std::vector<std::future<int>> futures;
+    std::future<std::vector<int>> result = agency::when_all(futures.begin(), futures.end());
+    assert(result.get().empty());
+  }
+
+  {
+    // when_all() does not wait for its futures
+    std::vector<std::promise<int>> promises(10);
+    std::vector<std::future<int>> futures;
+    for(auto& p : promises)
+    {
+      futures.push_back(p.get_future());
+    }
+
+    std::future<std::vector<int>> result = agency::when_all(futures.begin(), futures.end());
+    assert(result.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+    // fulfill the promises in reverse order from another thread
+    std::thread t([&]
+    {
+      for(int i = 9; i >= 0; --i)
+      {
+        promises[i].set_value(i);
+      }
+    });
+
+    std::vector<int> values = result.get();
+    t.join();
+
+    assert(values.size() == 10);
+    for(int i = 0; i < 10; ++i)
+    {
+      assert(values[i] == i);
+    }
+  }
+
+  {
+    // heterogeneous futures via variant_future
+    using future_type = variant_future<std::future<int>, always_ready_future<int>>;
+
+    std::promise<int> p;
+
+    std::vector<future_type> futures;
+    futures.emplace_back(make_always_ready_future(0));
+    futures.emplace_back(p.get_future());
+    futures.emplace_back(make_always_ready_future(2));
+
+    std::future<std::vector<int>> result = agency::when_all(futures.begin(), futures.end());
+
+    p.set_value(1);
+
+    assert(result.get() == std::vector<int>({0, 1, 2}));
+  }
+
+  {
+    // void futures
+    std::promise<void> p;
+
+    std::vector<std::future<void>> futures;
+    futures.push_back(detail::make_ready_future());
+    futures.push_back(p.get_future());
+
+    std::future<void> result = agency::when_all(futures.begin(), futures.end());
+    assert(result.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+    p.set_value();
+    result.get();
+  }
+
+  {
+    // exceptions are collected into an exception_list
+    std::vector<always_ready_future<int>> futures;
+    futures.emplace_back(std::make_exception_ptr(std::runtime_error("error")));
+    futures.emplace_back(13);
+    futures.emplace_back(std::make_exception_ptr(std::runtime_error("error")));
+
+    std::future<std::vector<int>> result = agency::when_all(futures.begin(), futures.end());
+
+    bool caught = false;
+    try
+    {
+      result.get();
+    }
+    catch(exception_list& e)
+    {
+      caught = true;
+      assert(e.size() == 2);
+    }
+
+    assert(caught);
+  }
+}
+
+
+void test_variadic()
+{
+  using namespace agency;
+
+  {
+    std::promise<float> p;
+
+    std::future<int> f1 = detail::make_ready_future(7);
+    always_ready_future<void> f2 = always_ready_future<void>::make_ready();
+    std::future<float> f3 = p.get_future();
+
+    std::future<tuple<int,float>> result = agency::when_all(f1, f2, f3);
+    assert(result.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+    p.set_value(13.f);
+
+    tuple<int,float> values = result.get();
+    assert(agency::get<0>(values) == 7);
+    assert(agency::get<1>(values) == 13.f);
+  }
+
+  {
+    // a single non-void value is unwrapped
+    std::future<void> f1 = detail::make_ready_future();
+    always_ready_future<int> f2 = make_always_ready_future(42);
+
+    std::future<int> result = agency::when_all(f1, f2);
+    assert(result.get() == 42);
+  }
+
+  {
+    // only void values yield std::future<void>
+    std::future<void> f1 = detail::make_ready_future();
+    always_ready_future<void> f2 = always_ready_future<void>::make_ready();
+
+    std::future<void> result = agency::when_all(f1, f2);
+    result.get();
+  }
+}
+
+
+int main()
+{
+  test_range();
+  test_variadic();
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
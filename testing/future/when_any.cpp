@@ -0,0 +1,103 @@
+#include <agency/future.hpp>
+#include <agency/future/always_ready_future.hpp>
+#include <agency/future/variant_future.hpp>
+#include <agency/future/when_any.hpp>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cassert>
+
+
+void test_range()
+{
+  using namespace agency;
+
+  {
+    // empty range
+    std::vector<std::future<int>> futures;
+    auto result = agency::when_any(futures.begin(), futures.end()).get();
+    assert(result.index == static_cast<size_t>(-1));
+    assert(result.futures.empty());
+  }
+
+  {
+    // when_any() does not wait for its futures
+    std::vector<std::promise<int>> promises(10);
+    std::vector<std::future<int>> futures;
+    for(auto& p : promises)
+    {
+      futures.push_back(p.get_future());
+    }
+
+    std::future<when_any_result<std::vector<std::future<int>>>> result = agency::when_any(futures.begin(), futures.end());
+    assert(result.wait_for(std::chrono::milliseconds(10)) == std::future_status::timeout);
+
+    std::thread t([&]
+    {
+      promises[7].set_value(7);
+    });
+
+    auto any = result.get();
+    t.join();
+
+    assert(any.index == 7);
+    assert(any.futures.size() == 10);
+    assert(any.futures[7].get() == 7);
+
+    // the other futures are returned unconsumed
+    promises[3].set_value(3);
+    assert(any.futures[3].get() == 3);
+  }
+
+  {
+    // heterogeneous futures via variant_future
+    using future_type = variant_future<std::future<int>, always_ready_future<int>>;
+
+    std::promise<int> p;
+
+    std::vector<future_type> futures;
+    futures.emplace_back(p.get_future());
+    futures.emplace_back(make_always_ready_future(1));
+
+    auto any = agency::when_any(futures.begin(), futures.end()).get();
+
+    assert(any.index == 1);
+    assert(any.futures[1].get() == 1);
+  }
+}
+
+
+void test_variadic()
+{
+  using namespace agency;
+
+  std::promise<int> p1;
+  std::promise<void> p2;
+
+  std::future<int> f1 = p1.get_future();
+  std::future<void> f2 = p2.get_future();
+
+  std::future<when_any_result<tuple<std::future<int>, std::future<void>>>> result = agency::when_any(f1, f2);
+  assert(result.wait_for(std::chrono::milliseconds(10)) == std::future_status::timeout);
+
+  p2.set_value();
+
+  auto any = result.get();
+  assert(any.index == 1);
+  agency::get<1>(any.futures).get();
+
+  p1.set_value(13);
+  assert(agency::get<0>(any.futures).get() == 13);
+}
+
+
+int main()
+{
+  test_range();
+  test_variadic();
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
+
@@ -0,0 +1,46 @@
+#include <agency/memory/allocator/detail/aligned_allocator.hpp>
+#include <agency/container/vector.hpp>
+#include <iostream>
+#include <cassert>
+#include <cstdint>
+
+template<std::size_t alignment>
+void test()
+{
+  using allocator_type = agency::detail::aligned_allocator<double, alignment>;
+
+  allocator_type alloc;
+
+  for(std::size_t n : {1, 3, 64, 1000})
+  {
+    double* ptr = alloc.allocate(n);
+    assert(reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0);
+
+    // the whole allocation is usable
+    for(std::size_t i = 0; i < n; ++i)
+    {
+      ptr[i] = double(i);
+    }
+
+    alloc.deallocate(ptr, n);
+  }
+
+  // containers are able to use aligned_allocator
+  agency::vector<double, allocator_type> vec(100, 13.);
+  assert(reinterpret_cast<std::uintptr_t>(vec.data()) % alignment == 0);
+  assert(std::count(vec.begin(), vec.end(), 13.) == 100);
+
+  assert(alloc == allocator_type());
+}
+
+int main()
+{
+  test<sizeof(void*)>();
+  test<16>();
+  test<64>();
+  test<4096>();
+
+  std::cout << "OK" << std::endl;
+
+  return 0;
+}
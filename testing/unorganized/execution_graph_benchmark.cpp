@@ -0,0 +1,122 @@
+// measures the per-iteration overhead of a five-stage bulk_then pipeline
+// compares re-issuing the pipeline each iteration against replaying it from an execution_graph
+
+#include <agency/agency.hpp>
+#include <agency/execution/executor/experimental.hpp>
+#include <cstdio>
+#include <cassert>
+#include <chrono>
+#include <vector>
+
+
+template<class Function>
+double time_invocation_in_ms(size_t num_trials, Function f)
+{
+  // warm up
+  f();
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for(size_t i = 0; i < num_trials; ++i)
+  {
+    f();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count() / num_trials;
+}
+
+
+struct first_stage
+{
+  template<class Agent>
+  float operator()(Agent& self, const float* x)
+  {
+    return x[self.index()];
+  }
+};
+
+
+struct middle_stage
+{
+  template<class Agent, class Container>
+  float operator()(Agent& self, Container& predecessor, float a)
+  {
+    return a * predecessor[self.index()] + 1.f;
+  }
+};
+
+
+struct last_stage
+{
+  template<class Agent, class Container>
+  void operator()(Agent& self, Container& predecessor, float* y)
+  {
+    y[self.index()] = predecessor[self.index()];
+  }
+};
+
+
+// issues the five stages through exec and returns the last stage's future
+template<class ExecutionPolicy, class Executor>
+agency::executor_future_t<Executor,void>
+  issue_pipeline(ExecutionPolicy policy, Executor& exec, size_t n, const float* x, float* y)
+{
+  auto stage1 = agency::bulk_async(policy(n).on(exec), first_stage(), x);
+  auto stage2 = agency::bulk_then(policy(n).on(exec), middle_stage(), stage1, 2.f);
+  auto stage3 = agency::bulk_then(policy(n).on(exec), middle_stage(), stage2, 3.f);
+  auto stage4 = agency::bulk_then(policy(n).on(exec), middle_stage(), stage3, 4.f);
+  return agency::bulk_then(policy(n).on(exec), last_stage(), stage4, y);
+}
+
+
+template<class ExecutionPolicy>
+void benchmark(const char* name, ExecutionPolicy policy, size_t n, size_t num_trials)
+{
+  std::vector<float> x(n, 1.f);
+  std::vector<float> eager_y(n), replay_y(n);
+
+  auto exec = policy.executor();
+
+  double eager_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    issue_pipeline(policy, exec, n, x.data(), eager_y.data()).wait();
+  });
+
+  agency::experimental::execution_graph graph;
+  auto graph_exec = graph.capture(exec);
+  issue_pipeline(policy, graph_exec, n, x.data(), replay_y.data());
+
+  double replay_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    graph.replay();
+  });
+
+  // ((2x + 1) * 3 + 1) * 4 + 1 = 41 when x = 1
+  for(size_t i = 0; i < n; ++i)
+  {
+    assert(eager_y[i] == 41.f);
+    assert(replay_y[i] == 41.f);
+  }
+
+  printf("%6s %8zu %14.2f %14.2f %10.2fx\n", name, n,
+         eager_ms * 1e3,
+         replay_ms * 1e3,
+         eager_ms / replay_ms);
+}
+
+
+int main()
+{
+  const size_t num_trials = 1000;
+
+  printf("%6s %8s %14s %14s %11s\n", "policy", "n", "issue (us)", "replay (us)", "speedup");
+
+  for(size_t n : {1, 1 << 10, 1 << 16})
+  {
+    benchmark("seq", agency::seq, n, num_trials);
+    benchmark("par", agency::par, n, num_trials);
+  }
+
+  return 0;
+}
+
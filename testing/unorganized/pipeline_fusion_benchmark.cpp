@@ -0,0 +1,142 @@
+// measures the benefit of fusing consecutive element-wise bulk stages
+// compares a chain of bulk_async and bulk_then calls against the same stages fused by experimental::pipeline
+
+#include <agency/agency.hpp>
+#include <agency/experimental.hpp>
+#include <cstdio>
+#include <cassert>
+#include <chrono>
+#include <vector>
+
+
+template<class Function>
+double time_invocation_in_ms(size_t num_trials, Function f)
+{
+  // warm up
+  f();
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for(size_t i = 0; i < num_trials; ++i)
+  {
+    f();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count() / num_trials;
+}
+
+
+struct load
+{
+  const float* x;
+
+  template<class Agent>
+  float operator()(Agent& self) const
+  {
+    return x[self.index()];
+  }
+};
+
+
+// an element-wise stage
+struct axpb
+{
+  float a;
+
+  template<class Agent>
+  float operator()(Agent&, float x) const
+  {
+    return a * x + 1.f;
+  }
+};
+
+
+// the same stage, reading its input from the previous stage's results
+struct axpb_from_predecessor
+{
+  float a;
+
+  template<class Agent, class Container>
+  float operator()(Agent& self, Container& predecessor) const
+  {
+    return a * predecessor[self.index()] + 1.f;
+  }
+};
+
+
+struct store
+{
+  float* y;
+
+  template<class Agent>
+  void operator()(Agent& self, float x) const
+  {
+    y[self.index()] = x;
+  }
+};
+
+
+struct store_from_predecessor
+{
+  float* y;
+
+  template<class Agent, class Container>
+  void operator()(Agent& self, Container& predecessor) const
+  {
+    y[self.index()] = predecessor[self.index()];
+  }
+};
+
+
+template<class ExecutionPolicy>
+void benchmark(const char* name, ExecutionPolicy policy, size_t n, size_t num_trials)
+{
+  std::vector<float> x(n, 1.f);
+  std::vector<float> unfused_y(n), fused_y(n);
+
+  double unfused_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    auto stage1 = agency::bulk_async(policy(n), load{x.data()});
+    auto stage2 = agency::bulk_then(policy(n), axpb_from_predecessor{2.f}, stage1);
+    auto stage3 = agency::bulk_then(policy(n), axpb_from_predecessor{3.f}, stage2);
+    auto stage4 = agency::bulk_then(policy(n), axpb_from_predecessor{4.f}, stage3);
+    agency::bulk_then(policy(n), store_from_predecessor{unfused_y.data()}, stage4).wait();
+  });
+
+  auto fused = agency::experimental::make_pipeline(policy(n), load{x.data()})
+    .then(axpb{2.f})
+    .then(axpb{3.f})
+    .then(axpb{4.f})
+    .then(store{fused_y.data()});
+
+  double fused_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    fused.async().wait();
+  });
+
+  // ((2x + 1) * 3 + 1) * 4 + 1 = 41 when x = 1
+  for(size_t i = 0; i < n; ++i)
+  {
+    assert(unfused_y[i] == 41.f);
+    assert(fused_y[i] == 41.f);
+  }
+
+  printf("%6s %8zu %14.3f %14.3f %10.2fx\n", name, n, unfused_ms, fused_ms, unfused_ms / fused_ms);
+}
+
+
+int main()
+{
+  const size_t num_trials = 20;
+
+  printf("%6s %8s %14s %14s %11s\n", "policy", "n", "unfused (ms)", "fused (ms)", "speedup");
+
+  for(size_t n : {1 << 10, 1 << 16, 1 << 22})
+  {
+    benchmark("seq", agency::seq, n, num_trials);
+    benchmark("par", agency::par, n, num_trials);
+  }
+
+  return 0;
+}
+
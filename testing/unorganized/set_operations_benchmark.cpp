@@ -0,0 +1,132 @@
+// compares agency's batch lower_bound and set operations against their sequential std:: counterparts
+
+#include <agency/agency.hpp>
+#include <agency/algorithm/binary_search.hpp>
+#include <agency/algorithm/set_operations.hpp>
+#include <cstdio>
+#include <cassert>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+
+template<class Function>
+double time_invocation_in_ms(size_t num_trials, Function f)
+{
+  // warm up
+  f();
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for(size_t i = 0; i < num_trials; ++i)
+  {
+    f();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count() / num_trials;
+}
+
+
+void report(const char* name, double std_ms, double agency_ms)
+{
+  printf("%25s %12.2f %12.2f %10.2fx\n", name, std_ms, agency_ms, std_ms / agency_ms);
+}
+
+
+int main()
+{
+  const size_t n = 1 << 22;
+  const size_t num_trials = 5;
+
+  std::default_random_engine rng;
+
+  std::vector<int> a(n), b(n);
+  std::generate(a.begin(), a.end(), [&]{ return int(rng() % (4 * n)); });
+  std::generate(b.begin(), b.end(), [&]{ return int(rng() % (4 * n)); });
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+
+  // the needles are unsorted
+  std::vector<int> needles(n);
+  std::generate(needles.begin(), needles.end(), [&]{ return int(rng() % (4 * n)); });
+
+  std::vector<size_t> std_indices(n), agency_indices(n);
+  std::vector<int> std_result(2 * n), agency_result(2 * n);
+
+  printf("%25s %12s %12s %11s\n", "", "std (ms)", "agency (ms)", "speedup");
+
+  {
+    double std_ms = time_invocation_in_ms(num_trials, [&]
+    {
+      for(size_t i = 0; i < n; ++i)
+      {
+        std_indices[i] = std::lower_bound(a.begin(), a.end(), needles[i]) - a.begin();
+      }
+    });
+
+    double agency_ms = time_invocation_in_ms(num_trials, [&]
+    {
+      agency::lower_bound(agency::par, a.begin(), a.end(), needles.begin(), needles.end(), agency_indices.begin());
+    });
+
+    assert(std_indices == agency_indices);
+    report("lower_bound", std_ms, agency_ms);
+  }
+
+  {
+    auto std_end = std_result.begin();
+    double std_ms = time_invocation_in_ms(num_trials, [&]
+    {
+      std_end = std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std_result.begin());
+    });
+
+    auto agency_end = agency_result.begin();
+    double agency_ms = time_invocation_in_ms(num_trials, [&]
+    {
+      agency_end = agency::set_intersection(agency::par, a.begin(), a.end(), b.begin(), b.end(), agency_result.begin());
+    });
+
+    assert(std_end - std_result.begin() == agency_end - agency_result.begin());
+    assert(std::equal(std_result.begin(), std_end, agency_result.begin()));
+    report("set_intersection", std_ms, agency_ms);
+  }
+
+  {
+    auto std_end = std_result.begin();
+    double std_ms = time_invocation_in_ms(num_trials, [&]
+    {
+      std_end = std::set_union(a.begin(), a.end(), b.begin(), b.end(), std_result.begin());
+    });
+
+    auto agency_end = agency_result.begin();
+    double agency_ms = time_invocation_in_ms(num_trials, [&]
+    {
+      agency_end = agency::set_union(agency::par, a.begin(), a.end(), b.begin(), b.end(), agency_result.begin());
+    });
+
+    assert(std_end - std_result.begin() == agency_end - agency_result.begin());
+    assert(std::equal(std_result.begin(), std_end, agency_result.begin()));
+    report("set_union", std_ms, agency_ms);
+  }
+
+  {
+    auto std_end = std_result.begin();
+    double std_ms = time_invocation_in_ms(num_trials, [&]
+    {
+      std_end = std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std_result.begin());
+    });
+
+    auto agency_end = agency_result.begin();
+    double agency_ms = time_invocation_in_ms(num_trials, [&]
+    {
+      agency_end = agency::set_difference(agency::par, a.begin(), a.end(), b.begin(), b.end(), agency_result.begin());
+    });
+
+    assert(std_end - std_result.begin() == agency_end - agency_result.begin());
+    assert(std::equal(std_result.begin(), std_end, agency_result.begin()));
+    report("set_difference", std_ms, agency_ms);
+  }
+
+  return 0;
+}
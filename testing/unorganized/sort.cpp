@@ -25,9 +25,11 @@ void parallel_sort_recursive(Iterator first, Iterator last)
     });
 
     // XXX only works for num_agents == 2
-    //     generalization would be to bulk_invoke half as many agents
-    //     and do that many inplace_merges
-    std::inplace_merge(first, first + partition_size, last);
+    //     generalization would be to multiway_merge num_agents partitions
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    std::vector<value_type> merged(n);
+    agency::merge(agency::par, first, first + partition_size, first + partition_size, last, merged.begin());
+    std::copy(merged.begin(), merged.end(), first);
   }
   else
   {
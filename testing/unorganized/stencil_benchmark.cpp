@@ -0,0 +1,246 @@
+// compares agency::experimental::stencil against a naive stencil which creates one agent per point
+// the bandwidth of a copy of the array is reported as the bound which a stencil limited by memory traffic approaches
+
+#include <agency/agency.hpp>
+#include <agency/experimental.hpp>
+#include <cstdio>
+#include <cassert>
+#include <chrono>
+#include <algorithm>
+#include <utility>
+
+
+using index2 = agency::point<size_t,2>;
+using index3 = agency::point<size_t,3>;
+
+
+template<class Function>
+double time_invocation_in_ms(size_t num_trials, Function f)
+{
+  // warm up
+  f();
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for(size_t i = 0; i < num_trials; ++i)
+  {
+    f();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count() / num_trials;
+}
+
+
+struct five_point
+{
+  double operator()(const agency::experimental::stencil_neighborhood<double,2>& n) const
+  {
+    return 0.5 * n(0,0) + 0.125 * (n(-1,0) + n(1,0) + n(0,-1) + n(0,1));
+  }
+};
+
+
+struct seven_point
+{
+  double operator()(const agency::experimental::stencil_neighborhood<double,3>& n) const
+  {
+    return 0.4 * n(0,0,0) + 0.1 * (n(-1,0,0) + n(1,0,0) + n(0,-1,0) + n(0,1,0) + n(0,0,-1) + n(0,0,1));
+  }
+};
+
+
+struct naive_five_point
+{
+  void operator()(agency::parallel_agent_2d& self, const double* src, double* dst, size_t m, size_t n)
+  {
+    size_t i = self.index()[0];
+    size_t j = self.index()[1];
+    size_t k = i * n + j;
+
+    if(i > 0 && i + 1 < m && j > 0 && j + 1 < n)
+    {
+      dst[k] = 0.5 * src[k] + 0.125 * (src[k - n] + src[k + n] + src[k - 1] + src[k + 1]);
+    }
+    else
+    {
+      dst[k] = src[k];
+    }
+  }
+};
+
+
+struct naive_seven_point
+{
+  void operator()(agency::parallel_agent& self, const double* src, double* dst, size_t l, size_t m, size_t n)
+  {
+    size_t k = self.index();
+    size_t plane = m * n;
+
+    size_t x = k / plane;
+    size_t y = (k / n) % m;
+    size_t z = k % n;
+
+    if(x > 0 && x + 1 < l && y > 0 && y + 1 < m && z > 0 && z + 1 < n)
+    {
+      dst[k] = 0.4 * src[k] + 0.1 * (src[k - plane] + src[k + plane] + src[k - n] + src[k + n] + src[k - 1] + src[k + 1]);
+    }
+    else
+    {
+      dst[k] = src[k];
+    }
+  }
+};
+
+
+void report(const char* name, size_t num_points, size_t num_steps, double ms)
+{
+  // each step reads and writes each point once
+  double gigabytes = 2. * num_points * sizeof(double) * num_steps * 1e-9;
+
+  printf("%40s %12.2f %12.2f\n", name, ms, gigabytes / (ms * 1e-3));
+}
+
+
+template<class Array>
+void fill(Array& array)
+{
+  size_t x = 1;
+  for(auto& element : array.all())
+  {
+    x = (x * 1103515245 + 12345) % 2147483648u;
+    element = double(x % 1000);
+  }
+}
+
+
+template<class Array1, class Array2>
+bool equal(const Array1& a, const Array2& b)
+{
+  return std::equal(a.begin(), a.end(), b.begin());
+}
+
+
+void benchmark_2d(size_t m, size_t n, size_t num_steps, size_t num_trials)
+{
+  using namespace agency::experimental;
+
+  printf("\n5-point stencil, %zu x %zu, %zu steps\n", m, n, num_steps);
+
+  ndarray<double,2> initial(index2{m,n});
+  fill(initial);
+
+  ndarray<double,2> a(index2{m,n}), b(index2{m,n});
+
+  double copy_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    for(size_t step = 0; step < num_steps; ++step)
+    {
+      std::copy(initial.begin(), initial.end(), a.begin());
+    }
+  });
+  report("copy", m * n, num_steps, copy_ms);
+
+  auto naive = [&]
+  {
+    for(size_t step = 0; step < num_steps; ++step)
+    {
+      agency::bulk_invoke(agency::par2d(index2{m,n}), naive_five_point(), a.data(), b.data(), m, n);
+      std::swap(a, b);
+    }
+  };
+
+  a = initial;
+  naive();
+  ndarray<double,2> naive_result = a;
+
+  double naive_ms = time_invocation_in_ms(num_trials, naive);
+  report("naive bulk_invoke(par2d)", m * n, num_steps, naive_ms);
+
+  size_t steps_per_block[] = {1, 2, 4, 8};
+  for(size_t s : steps_per_block)
+  {
+    auto blocked = [&]
+    {
+      return stencil(agency::par, a.all(), b.all(), 1, five_point(), num_steps, s);
+    };
+
+    a = initial;
+    assert(equal(blocked(), naive_result.all()));
+
+    double ms = time_invocation_in_ms(num_trials, blocked);
+
+    char name[64];
+    snprintf(name, sizeof(name), "stencil, %zu steps per block", s);
+    report(name, m * n, num_steps, ms);
+  }
+}
+
+
+void benchmark_3d(size_t l, size_t m, size_t n, size_t num_steps, size_t num_trials)
+{
+  using namespace agency::experimental;
+
+  printf("\n7-point stencil, %zu x %zu x %zu, %zu steps\n", l, m, n, num_steps);
+
+  ndarray<double,3> initial(index3{l,m,n});
+  fill(initial);
+
+  ndarray<double,3> a(index3{l,m,n}), b(index3{l,m,n});
+
+  double copy_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    for(size_t step = 0; step < num_steps; ++step)
+    {
+      std::copy(initial.begin(), initial.end(), a.begin());
+    }
+  });
+  report("copy", l * m * n, num_steps, copy_ms);
+
+  auto naive = [&]
+  {
+    for(size_t step = 0; step < num_steps; ++step)
+    {
+      agency::bulk_invoke(agency::par(l * m * n), naive_seven_point(), a.data(), b.data(), l, m, n);
+      std::swap(a, b);
+    }
+  };
+
+  a = initial;
+  naive();
+  ndarray<double,3> naive_result = a;
+
+  double naive_ms = time_invocation_in_ms(num_trials, naive);
+  report("naive bulk_invoke(par)", l * m * n, num_steps, naive_ms);
+
+  size_t steps_per_block[] = {1, 2, 4};
+  for(size_t s : steps_per_block)
+  {
+    auto blocked = [&]
+    {
+      return stencil(agency::par, a.all(), b.all(), 1, seven_point(), num_steps, s);
+    };
+
+    a = initial;
+    assert(equal(blocked(), naive_result.all()));
+
+    double ms = time_invocation_in_ms(num_trials, blocked);
+
+    char name[64];
+    snprintf(name, sizeof(name), "stencil, %zu steps per block", s);
+    report(name, l * m * n, num_steps, ms);
+  }
+}
+
+
+int main()
+{
+  const size_t num_trials = 3;
+
+  printf("%40s %12s %12s\n", "", "time (ms)", "GB/s");
+
+  benchmark_2d(4096, 4096, 8, num_trials);
+  benchmark_3d(256, 256, 256, 8, num_trials);
+
+  return 0;
+}
+
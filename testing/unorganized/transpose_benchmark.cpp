@@ -0,0 +1,106 @@
+// compares agency::experimental::transpose against a naive transpose which creates one agent per element
+
+#include <agency/agency.hpp>
+#include <agency/experimental.hpp>
+#include <cstdio>
+#include <cassert>
+#include <chrono>
+#include <numeric>
+
+
+template<class Function>
+double time_invocation_in_ms(size_t num_trials, Function f)
+{
+  // warm up
+  f();
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for(size_t i = 0; i < num_trials; ++i)
+  {
+    f();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count() / num_trials;
+}
+
+
+struct naive_transpose
+{
+  template<class T>
+  void operator()(agency::parallel_agent_2d& self, const T* src, T* dst, size_t m, size_t n)
+  {
+    auto idx = self.index();
+    dst[idx[1] * m + idx[0]] = src[idx[0] * n + idx[1]];
+  }
+};
+
+
+template<class T>
+void benchmark(const char* name, size_t m, size_t n, size_t num_trials)
+{
+  using namespace agency::experimental;
+  using index2 = agency::point<size_t,2>;
+
+  ndarray<T,2> src(index2{m,n});
+  std::iota(src.begin(), src.end(), T(0));
+
+  ndarray<T,2> naive_dst(index2{n,m});
+  ndarray<T,2> seq_dst(index2{n,m});
+  ndarray<T,2> par_dst(index2{n,m});
+
+  const T* src_ptr = src.data();
+  T* naive_ptr = naive_dst.data();
+
+  double naive_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    agency::bulk_invoke(agency::par2d(index2{m,n}), naive_transpose(), src_ptr, naive_ptr, m, n);
+  });
+
+  double seq_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    transpose(agency::seq, src.all(), seq_dst.all());
+  });
+
+  double par_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    transpose(agency::par, src.all(), par_dst.all());
+  });
+
+  for(size_t i = 0; i < m; ++i)
+  {
+    for(size_t j = 0; j < n; ++j)
+    {
+      assert((naive_dst[index2{j,i}] == src[index2{i,j}]));
+      assert((seq_dst[index2{j,i}] == src[index2{i,j}]));
+      assert((par_dst[index2{j,i}] == src[index2{i,j}]));
+    }
+  }
+
+  // each element is read once and written once
+  double gigabytes = 2. * m * n * sizeof(T) * 1e-9;
+
+  printf("%10s %6zu x %-6zu %14.2f %14.2f %14.2f %10.2fx\n", name, m, n,
+         gigabytes / (naive_ms * 1e-3),
+         gigabytes / (seq_ms * 1e-3),
+         gigabytes / (par_ms * 1e-3),
+         naive_ms / par_ms);
+}
+
+
+int main()
+{
+  const size_t num_trials = 10;
+
+  printf("%10s %15s %14s %14s %14s %11s\n", "type", "shape", "naive (GB/s)", "seq (GB/s)", "par (GB/s)", "speedup");
+
+  benchmark<float>("float", 1024, 1024, num_trials);
+  benchmark<float>("float", 4096, 4096, num_trials);
+  benchmark<float>("float", 4099, 3071, num_trials);
+  benchmark<double>("double", 4096, 4096, num_trials);
+  benchmark<int>("int", 4096, 4096, num_trials);
+  benchmark<short>("short", 4096, 4096, num_trials);
+
+  return 0;
+}
+
@@ -0,0 +1,116 @@
+// measures the per-call overhead of issuing work through a variant_executor
+// compares calling bulk_invoke on a statically-typed executor, on a variant_executor, and
+// on a variant_executor whose dispatch has been hoisted out of the loop with experimental::visit_executor
+
+#include <agency/agency.hpp>
+#include <agency/execution/executor/experimental.hpp>
+#include <cstdio>
+#include <cassert>
+#include <chrono>
+#include <vector>
+
+
+template<class Function>
+double time_invocation_in_ms(size_t num_trials, Function f)
+{
+  // warm up
+  f();
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for(size_t i = 0; i < num_trials; ++i)
+  {
+    f();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count() / num_trials;
+}
+
+
+struct increment
+{
+  template<class Agent>
+  void operator()(Agent& self, int* data)
+  {
+    data[self.index()] += 1;
+  }
+};
+
+
+struct increment_loop
+{
+  int* data;
+  size_t n;
+  size_t num_calls;
+
+  template<class Executor>
+  void operator()(Executor& exec) const
+  {
+    for(size_t i = 0; i < num_calls; ++i)
+    {
+      agency::bulk_invoke(agency::seq(n).on(exec), increment(), data);
+    }
+  }
+};
+
+
+template<class VariantExecutor, class Executor>
+void benchmark(const char* name, Executor alternative, size_t n, size_t num_calls, size_t num_trials)
+{
+  VariantExecutor variant_exec = alternative;
+
+  std::vector<int> data(n, 0);
+  increment_loop loop{data.data(), n, num_calls};
+
+  double static_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    loop(alternative);
+  });
+
+  double variant_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    loop(variant_exec);
+  });
+
+  double hoisted_ms = time_invocation_in_ms(num_trials, [&]
+  {
+    agency::experimental::visit_executor(loop, variant_exec);
+  });
+
+  // each of the three measurements ran num_trials + 1 batches, including warm up
+  for(int x : data)
+  {
+    assert(x == static_cast<int>(3 * (num_trials + 1) * num_calls));
+  }
+
+  double ns_per_call = 1e6 / num_calls;
+
+  printf("%12s %6zu %14.1f %14.1f %14.1f %10.2fx\n", name, n,
+         static_ms * ns_per_call,
+         variant_ms * ns_per_call,
+         hoisted_ms * ns_per_call,
+         variant_ms / hoisted_ms);
+}
+
+
+int main()
+{
+  using namespace agency;
+
+  // the alternatives are all sequenced so that dispatch is not hidden behind thread launch costs
+  using executor_type = variant_executor<sequenced_executor, this_thread::parallel_executor, experimental::unrolling_executor<4>>;
+
+  const size_t num_calls = 100000;
+  const size_t num_trials = 10;
+
+  printf("%12s %6s %14s %14s %14s %11s\n", "alternative", "n", "static (ns)", "variant (ns)", "hoisted (ns)", "speedup");
+
+  for(size_t n : {1, 16, 256})
+  {
+    benchmark<executor_type>("sequenced", sequenced_executor(), n, num_calls, num_trials);
+    benchmark<executor_type>("unrolling", experimental::unrolling_executor<4>(), n, num_calls, num_trials);
+  }
+
+  return 0;
+}
+